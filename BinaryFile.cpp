@@ -0,0 +1,370 @@
+#include "BinaryFile.h"
+
+#include "Box.h"
+#include "Matrix33.h"
+#include "Sphere.h"
+
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+char const   MAGIC[4]    = { 'M', 'Y', 'M', 'B' };
+size_t const HEADER_SIZE = 4 * sizeof(uint32_t);
+size_t const ENTRY_SIZE  = 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+bool IsLittleEndian()
+{
+    uint32_t const one = 1;
+    unsigned char  first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+// Returns the size of the records of a type of chunk, or 0 if the type is unknown
+size_t GetRecordSize(MyMath::ChunkType type)
+{
+    switch (type)
+    {
+    case MyMath::ChunkType::VECTOR3:    return sizeof(Vector3);
+    case MyMath::ChunkType::QUATERNION: return sizeof(Quaternion);
+    case MyMath::ChunkType::MATRIX43:   return sizeof(Matrix43);
+    case MyMath::ChunkType::MATRIX44:   return sizeof(Matrix44);
+    case MyMath::ChunkType::AABOX:      return sizeof(MyMath::AABoxRecord);
+    case MyMath::ChunkType::SPHERE:     return sizeof(MyMath::SphereRecord);
+    case MyMath::ChunkType::BOX:        return sizeof(MyMath::BoxRecord);
+    default:                            return 0;
+    }
+}
+
+// Returns n rounded up to a multiple of FILE_ALIGNMENT
+uint64_t Align(uint64_t n)
+{
+    return (n + MyMath::FILE_ALIGNMENT - 1) & ~uint64_t(MyMath::FILE_ALIGNMENT - 1);
+}
+
+// Appends a value in little-endian order
+template <typename T>
+void Append(std::vector<char> * pBuffer, T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        pBuffer->push_back(char((value >> (8 * i)) & 0xff));
+    }
+}
+
+// Reads a little-endian value
+template <typename T>
+T Extract(char const * p)
+{
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        value |= T(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return value;
+}
+} // anonymous namespace
+
+namespace MyMath
+{
+//! @param	aabox	Box
+
+AABoxRecord AABoxRecord::From(AABox const & aabox)
+{
+    AABoxRecord record;
+    std::memcpy(record.m_Position, aabox.m_Position.m_V, sizeof(record.m_Position));
+    std::memcpy(record.m_Scale, aabox.m_Scale.m_V, sizeof(record.m_Scale));
+    return record;
+}
+
+AABox AABoxRecord::ToAABox() const
+{
+    return AABox(Vector3(m_Position), Vector3(m_Scale));
+}
+
+//! @param	sphere	Sphere
+
+SphereRecord SphereRecord::From(Sphere const & sphere)
+{
+    SphereRecord record;
+    std::memcpy(record.m_C, sphere.m_C.m_V, sizeof(record.m_C));
+    record.m_R = sphere.m_R;
+    return record;
+}
+
+Sphere SphereRecord::ToSphere() const
+{
+    return Sphere(Vector3(m_C), m_R);
+}
+
+//! @param	box		Box
+
+BoxRecord BoxRecord::From(Box const & box)
+{
+    BoxRecord record;
+    std::memcpy(record.m_InverseOrientation, box.m_InverseOrientation.m_M, sizeof(record.m_InverseOrientation));
+    std::memcpy(record.m_Position, box.m_Position.m_V, sizeof(record.m_Position));
+    std::memcpy(record.m_Scale, box.m_Scale.m_V, sizeof(record.m_Scale));
+    return record;
+}
+
+Box BoxRecord::ToBox() const
+{
+    // The constructor takes the orientation, which is the transpose of the inverse
+
+    Matrix33 orientation(&m_InverseOrientation[0][0]);
+    orientation.Transpose();
+
+    return Box(orientation, Vector3(m_Position), Vector3(m_Scale));
+}
+
+//! @param	p	Boxes
+//! @param	n	Number of boxes
+
+void BinaryFileWriter::Add(AABox const * p, size_t n)
+{
+    std::vector<AABoxRecord> records(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        records[i] = AABoxRecord::From(p[i]);
+    }
+    AddRecords(records.data(), n);
+}
+
+//! @param	p	Spheres
+//! @param	n	Number of spheres
+
+void BinaryFileWriter::Add(Sphere const * p, size_t n)
+{
+    std::vector<SphereRecord> records(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        records[i] = SphereRecord::From(p[i]);
+    }
+    AddRecords(records.data(), n);
+}
+
+//! @param	p	Boxes
+//! @param	n	Number of boxes
+
+void BinaryFileWriter::Add(Box const * p, size_t n)
+{
+    std::vector<BoxRecord> records(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        records[i] = BoxRecord::From(p[i]);
+    }
+    AddRecords(records.data(), n);
+}
+
+//! @param	out		Stream opened in binary mode
+//!
+//! All the records consist of 32-bit floats, so on a big-endian machine each 4-byte word is reversed.
+
+bool BinaryFileWriter::Write(std::ostream & out) const
+{
+    // Header and chunk table
+
+    std::vector<char> header;
+    header.insert(header.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    Append<uint32_t>(&header, FILE_VERSION);
+    Append<uint32_t>(&header, uint32_t(m_Chunks.size()));
+    Append<uint32_t>(&header, uint32_t(HEADER_SIZE));
+
+    uint64_t offset = Align(HEADER_SIZE + ENTRY_SIZE * m_Chunks.size());
+    for (Chunk const & chunk : m_Chunks)
+    {
+        Append<uint32_t>(&header, uint32_t(chunk.m_Type));
+        Append<uint32_t>(&header, chunk.m_RecordSize);
+        Append<uint64_t>(&header, chunk.m_Count);
+        Append<uint64_t>(&header, offset);
+        offset = Align(offset + chunk.m_Data.size());
+    }
+    header.resize(size_t(Align(header.size())), 0);
+    out.write(header.data(), std::streamsize(header.size()));
+
+    // Data
+
+    char const        padding[FILE_ALIGNMENT] = {};
+    bool const        swap                    = !IsLittleEndian();
+    std::vector<char> swapped;
+
+    for (Chunk const & chunk : m_Chunks)
+    {
+        char const * data = chunk.m_Data.data();
+
+        if (swap)
+        {
+            swapped = chunk.m_Data;
+            for (size_t i = 0; i + 4 <= swapped.size(); i += 4)
+            {
+                std::swap(swapped[i + 0], swapped[i + 3]);
+                std::swap(swapped[i + 1], swapped[i + 2]);
+            }
+            data = swapped.data();
+        }
+
+        out.write(data, std::streamsize(chunk.m_Data.size()));
+        out.write(padding, std::streamsize(Align(chunk.m_Data.size()) - chunk.m_Data.size()));
+    }
+
+    return bool(out);
+}
+
+//! @param	path	Name of the file
+
+bool BinaryFileWriter::Write(char const * path) const
+{
+    std::ofstream out(path, std::ios::binary);
+
+    return out && Write(out);
+}
+
+//! @param	path	Name of the file
+//!
+//! Files can only be read in place on little-endian machines, so this fails on big-endian machines.
+
+bool BinaryFileReader::Open(char const * path)
+{
+    Close();
+
+    if (!IsLittleEndian())
+        return false;
+
+#if defined(_WIN32)
+    HANDLE const file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_hMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (m_hMapping == nullptr)
+        return false;
+
+    m_pData = static_cast<char const *>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+    m_Size  = size_t(size.QuadPart);
+#else // defined(_WIN32)
+    int const file = open(path, O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void * const p = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (p == MAP_FAILED)
+        return false;
+
+    m_pData = static_cast<char const *>(p);
+    m_Size  = size_t(status.st_size);
+#endif // defined(_WIN32)
+
+    if (m_pData == nullptr || !Parse())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void BinaryFileReader::Close()
+{
+#if defined(_WIN32)
+    if (m_pData)
+        UnmapViewOfFile(m_pData);
+    if (m_hMapping)
+        CloseHandle(m_hMapping);
+#else // defined(_WIN32)
+    if (m_pData)
+        munmap(const_cast<char *>(m_pData), m_Size);
+#endif // defined(_WIN32)
+
+    m_pData    = nullptr;
+    m_Size     = 0;
+    m_hMapping = nullptr;
+    m_Chunks.clear();
+}
+
+//! @param	type	Type of chunk to find
+//! @param	start	Index of the first chunk to check
+
+int BinaryFileReader::FindChunk(ChunkType type, int start) const
+{
+    for (int i = start; i < GetChunkCount(); ++i)
+    {
+        if (m_Chunks[i].m_Type == type)
+            return i;
+    }
+
+    return -1;
+}
+
+bool BinaryFileReader::Parse()
+{
+    if (m_Size < HEADER_SIZE || std::memcmp(m_pData, MAGIC, sizeof(MAGIC)) != 0)
+        return false;
+
+    uint32_t const version    = Extract<uint32_t>(m_pData + 4);
+    uint32_t const nChunks    = Extract<uint32_t>(m_pData + 8);
+    uint32_t const headerSize = Extract<uint32_t>(m_pData + 12);
+
+    // Later versions may only extend the header (its size is stored in it) and add new types of chunks, so any
+    // version is accepted.
+
+    if (version < 1 || headerSize < HEADER_SIZE || headerSize + uint64_t(nChunks) * ENTRY_SIZE > m_Size)
+        return false;
+
+    m_Chunks.resize(nChunks);
+    for (uint32_t i = 0; i < nChunks; ++i)
+    {
+        char const * const entry = m_pData + headerSize + i * ENTRY_SIZE;
+        Chunk &            chunk = m_Chunks[i];
+
+        chunk.m_Type       = ChunkType(Extract<uint32_t>(entry + 0));
+        chunk.m_RecordSize = Extract<uint32_t>(entry + 4);
+        chunk.m_Count      = Extract<uint64_t>(entry + 8);
+        chunk.m_Offset     = Extract<uint64_t>(entry + 16);
+
+        // The data must be aligned and inside the file. Chunks of unknown types (from later versions) are allowed,
+        // but they can't be read.
+
+        size_t const recordSize = GetRecordSize(chunk.m_Type);
+
+        if (  (recordSize != 0 && chunk.m_RecordSize != recordSize)
+           || chunk.m_Offset % FILE_ALIGNMENT != 0
+           || chunk.m_Offset > m_Size
+           || chunk.m_RecordSize == 0
+           || chunk.m_Count > (m_Size - chunk.m_Offset) / chunk.m_RecordSize)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+} // namespace MyMath
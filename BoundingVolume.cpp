@@ -0,0 +1,1428 @@
+#include "BoundingVolume.h"
+
+#include "Box.h"
+#include "Matrix33.h"
+#include "Matrix43.h"
+#include "Matrix43SoA.h"
+#include "Matrix44.h"
+#include "MyMath.h"
+#include "Parallel.h"
+#include "Sphere.h"
+#include "Vector3.h"
+#include "Vector3d.h"
+#include "Vector3SoA.h"
+
+#include "Misc/Assertx.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+size_t const GRAIN = 4096;  // Smallest number of points handled by one task
+
+// A box can't have a size of 0, so a flat set of points gets a box this thick
+float const MIN_BOX_SIZE = float(4.0 * MyMath::DEFAULT_FLOAT_TOLERANCE);
+
+// A box is enlarged on each side by this fraction of the largest projected coordinate to allow for rounding
+float const BOX_MARGIN = 16.0f * std::numeric_limits<float>::epsilon();
+
+// A point is outside a sphere if its squared distance exceeds the squared radius by more than this fraction. This
+// keeps points on the surface from being found outside because of rounding.
+double const SPHERE_TOLERANCE = 1.0e-9;
+
+int const NUM_DITO_NORMALS = 7;     // Number of directions in which DiTO-14 finds extremal points
+
+// Directions in which the extremal points are found (not normalized, since only the order of the points matters)
+Vector3 const DITO_NORMALS[NUM_DITO_NORMALS] =
+{
+    Vector3(1.0f,  0.0f,  0.0f),
+    Vector3(0.0f,  1.0f,  0.0f),
+    Vector3(0.0f,  0.0f,  1.0f),
+    Vector3(1.0f,  1.0f,  1.0f),
+    Vector3(1.0f,  1.0f, -1.0f),
+    Vector3(1.0f, -1.0f,  1.0f),
+    Vector3(1.0f, -1.0f, -1.0f)
+};
+
+// Calls body(begin, end, &partial) for parts of [0, n) and combines the partial results with combine(&total,
+// partial). If there is a scheduler, the parts are done in parallel, otherwise there is one part.
+template <typename T, typename Body, typename Combine>
+T Reduce(MyMath::TaskScheduler * pScheduler, size_t n, T const & identity, Body const & body, Combine const & combine)
+{
+    T total = identity;
+
+    if (pScheduler == nullptr)
+    {
+        body(size_t(0), n, &total);
+        return total;
+    }
+
+    std::mutex mutex;
+    MyMath::ParallelFor(*pScheduler, n, GRAIN, [&](size_t begin, size_t end)
+    {
+        T partial = identity;
+        body(begin, end, &partial);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        combine(&total, partial);
+    });
+
+    return total;
+}
+
+Vector3d ToDouble(Vector3 const & v)
+{
+    return Vector3d(v.m_X, v.m_Y, v.m_Z);
+}
+
+Vector3 ToFloat(Vector3d const & v)
+{
+    return Vector3(float(v.m_X), float(v.m_Y), float(v.m_Z));
+}
+
+// Minimum and maximum of a set of points
+struct Bounds
+{
+    Vector3 m_Min;
+    Vector3 m_Max;
+};
+
+Bounds const EMPTY_BOUNDS =
+{
+    Vector3( std::numeric_limits<float>::infinity(),  std::numeric_limits<float>::infinity(),
+             std::numeric_limits<float>::infinity()),
+    Vector3(-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity())
+};
+
+void Include(Bounds * pBounds, Bounds const & b)
+{
+    for (int k = 0; k < 3; ++k)
+    {
+        pBounds->m_Min.m_V[k] = std::min(pBounds->m_Min.m_V[k], b.m_Min.m_V[k]);
+        pBounds->m_Max.m_V[k] = std::max(pBounds->m_Max.m_V[k], b.m_Max.m_V[k]);
+    }
+}
+
+// Returns the box, enlarged if necessary so that rounding its size does not leave the maximum outside
+AABox ToAABox(Bounds const & b)
+{
+    Vector3 size = b.m_Max - b.m_Min;
+    for (int k = 0; k < 3; ++k)
+    {
+        while (b.m_Min.m_V[k] + size.m_V[k] < b.m_Max.m_V[k])
+        {
+            size.m_V[k] = std::nextafter(size.m_V[k], std::numeric_limits<float>::infinity());
+        }
+    }
+
+    return AABox(b.m_Min, size);
+}
+
+// Includes an array of points in bounds
+void Include(Bounds * pBounds, Vector3 const * p, size_t n)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    // 8 points are 24 floats, which are loaded as 3 registers. Since 24 is a multiple of 3, lane j of register k
+    // always holds element (8 * k + j) % 3 of a point, so the registers can be reduced separately and sorted out at
+    // the end.
+
+    static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be 3 packed floats");
+
+    if (n >= 8)
+    {
+        __m256 min0 = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+        __m256 min1 = min0;
+        __m256 min2 = min0;
+        __m256 max0 = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+        __m256 max1 = max0;
+        __m256 max2 = max0;
+
+        for (; i + 8 <= n; i += 8)
+        {
+            float const * const s  = &p[i].m_X;
+            __m256 const        v0 = _mm256_loadu_ps(s + 0);
+            __m256 const        v1 = _mm256_loadu_ps(s + 8);
+            __m256 const        v2 = _mm256_loadu_ps(s + 16);
+
+            min0 = _mm256_min_ps(min0, v0);
+            min1 = _mm256_min_ps(min1, v1);
+            min2 = _mm256_min_ps(min2, v2);
+            max0 = _mm256_max_ps(max0, v0);
+            max1 = _mm256_max_ps(max1, v1);
+            max2 = _mm256_max_ps(max2, v2);
+        }
+
+        alignas(32) float mins[24];
+        alignas(32) float maxs[24];
+        _mm256_store_ps(mins + 0, min0);
+        _mm256_store_ps(mins + 8, min1);
+        _mm256_store_ps(mins + 16, min2);
+        _mm256_store_ps(maxs + 0, max0);
+        _mm256_store_ps(maxs + 8, max1);
+        _mm256_store_ps(maxs + 16, max2);
+
+        for (int j = 0; j < 24; ++j)
+        {
+            pBounds->m_Min.m_V[j % 3] = std::min(pBounds->m_Min.m_V[j % 3], mins[j]);
+            pBounds->m_Max.m_V[j % 3] = std::max(pBounds->m_Max.m_V[j % 3], maxs[j]);
+        }
+    }
+#endif // defined(__AVX2__)
+
+    for (; i < n; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            pBounds->m_Min.m_V[k] = std::min(pBounds->m_Min.m_V[k], p[i].m_V[k]);
+            pBounds->m_Max.m_V[k] = std::max(pBounds->m_Max.m_V[k], p[i].m_V[k]);
+        }
+    }
+}
+
+// Returns the minimum and maximum of the first n values of a stream
+void ComputeRange(float const * p, size_t n, float * pMin, float * pMax)
+{
+    float  lo = std::numeric_limits<float>::infinity();
+    float  hi = -std::numeric_limits<float>::infinity();
+    size_t i  = 0;
+
+#if defined(__AVX2__)
+    // The streams are aligned, but the padding is not part of the set, so the tail is done separately.
+
+    if (n >= 8)
+    {
+        __m256 vLo = _mm256_set1_ps(lo);
+        __m256 vHi = _mm256_set1_ps(hi);
+
+        for (; i + 8 <= n; i += 8)
+        {
+            __m256 const v = _mm256_load_ps(p + i);
+            vLo = _mm256_min_ps(vLo, v);
+            vHi = _mm256_max_ps(vHi, v);
+        }
+
+        alignas(32) float los[8];
+        alignas(32) float his[8];
+        _mm256_store_ps(los, vLo);
+        _mm256_store_ps(his, vHi);
+        lo = *std::min_element(los, los + 8);
+        hi = *std::max_element(his, his + 8);
+    }
+#endif // defined(__AVX2__)
+
+    for (; i < n; ++i)
+    {
+        lo = std::min(lo, p[i]);
+        hi = std::max(hi, p[i]);
+    }
+
+    *pMin = lo;
+    *pMax = hi;
+}
+
+// A sphere computed in double precision
+struct Ball
+{
+    Vector3d m_C;
+    double m_R;
+};
+
+bool IsOutside(Ball const & ball, Vector3d const & p)
+{
+    return (p - ball.m_C).Length2() > ball.m_R * ball.m_R * (1.0 + SPHERE_TOLERANCE);
+}
+
+// Returns the sphere, enlarged to allow for rounding its center and radius to float
+Sphere ToSphere(Ball const & ball)
+{
+    Vector3 const center = ToFloat(ball.m_C);
+    double const  error  = (ToDouble(center) - ball.m_C).Length();
+    float         r      = float(ball.m_R + error);
+
+    r = std::nextafter(r, std::numeric_limits<float>::infinity());
+
+    return Sphere(center, r);
+}
+
+Ball ToBall(Sphere const & sphere)
+{
+    return Ball{ ToDouble(sphere.m_C), double(sphere.m_R) };
+}
+
+// Grows a ball just enough to enclose a point (Ritter)
+void Grow(Ball * pBall, Vector3d const & p)
+{
+    Vector3d const d      = p - pBall->m_C;
+    double const   length = d.Length();
+
+    if (length <= pBall->m_R)
+        return;
+
+    double const r = (pBall->m_R + length) * 0.5;
+
+    pBall->m_C += d * ((r - pBall->m_R) / length);
+    pBall->m_R  = r;
+}
+
+// Returns the smallest ball enclosing two balls
+Ball Merge(Ball const & a, Ball const & b)
+{
+    Vector3d const d      = b.m_C - a.m_C;
+    double const   length = d.Length();
+
+    if (length + b.m_R <= a.m_R)
+        return a;
+    if (length + a.m_R <= b.m_R)
+        return b;
+
+    double const r = (length + a.m_R + b.m_R) * 0.5;
+
+    return Ball{ a.m_C + d * ((r - a.m_R) / length), r };
+}
+
+// Returns the ball with two points on opposite sides
+Ball BallFrom(Vector3d const & a, Vector3d const & b)
+{
+    return Ball{ (a + b) * 0.5, (b - a).Length() * 0.5 };
+}
+
+// Returns the smallest of the balls through 2 or 3 of the points that encloses all of them. This is for the
+// degenerate cases of the circumscribed balls.
+Ball SmallestEnclosing(Vector3d const * p, int n);
+
+// Returns the ball whose great circle passes through three points, or the smallest enclosing ball if they are
+// collinear
+Ball BallFrom(Vector3d const & a, Vector3d const & b, Vector3d const & c)
+{
+    Vector3d const u  = a - c;
+    Vector3d const v  = b - c;
+    Vector3d const w  = Cross(u, v);
+    double const   w2 = w.Length2();
+    double const   u2 = u.Length2();
+    double const   v2 = v.Length2();
+
+    if (w2 <= 1.0e-12 * u2 * v2)
+    {
+        Vector3d const p[3] = { a, b, c };
+        return SmallestEnclosing(p, 3);
+    }
+
+    Vector3d const offset = Cross(v * u2 - u * v2, w) * (0.5 / w2);
+
+    return Ball{ c + offset, offset.Length() };
+}
+
+// Returns the ball through four points, or the smallest enclosing ball if they are coplanar
+Ball BallFrom(Vector3d const & a, Vector3d const & b, Vector3d const & c, Vector3d const & d)
+{
+    Vector3d const u   = a - d;
+    Vector3d const v   = b - d;
+    Vector3d const w   = c - d;
+    Vector3d const vw  = Cross(v, w);
+    double const   det = Dot(u, vw);
+
+    if (det * det <= 1.0e-12 * u.Length2() * v.Length2() * w.Length2())
+    {
+        Vector3d const p[4] = { a, b, c, d };
+        return SmallestEnclosing(p, 4);
+    }
+
+    Vector3d const offset = (vw * u.Length2() + Cross(w, u) * v.Length2() + Cross(u, v) * w.Length2()) * (0.5 / det);
+
+    return Ball{ d + offset, offset.Length() };
+}
+
+Ball SmallestEnclosing(Vector3d const * p, int n)
+{
+    // Returns true if a ball encloses all the points
+    auto const encloses = [p, n](Ball const & ball)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            if (IsOutside(ball, p[i]))
+                return false;
+        }
+        return true;
+    };
+
+    Ball best = BallFrom(p[0], p[0]);
+    best.m_R = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = i + 1; j < n; ++j)
+        {
+            Ball const ball = BallFrom(p[i], p[j]);
+            if (ball.m_R < best.m_R && encloses(ball))
+                best = ball;
+
+            for (int k = j + 1; k < n; ++k)
+            {
+                // A circle through 3 points is only needed if they are not collinear.
+
+                Vector3d const w = Cross(p[i] - p[k], p[j] - p[k]);
+                if (w.Length2() > 0.0)
+                {
+                    Ball const circle = BallFrom(p[i], p[j], p[k]);
+                    if (circle.m_R < best.m_R && encloses(circle))
+                        best = circle;
+                }
+            }
+        }
+    }
+
+    // If rounding made every candidate fail, the ball around the farthest pair grown to include the rest will do.
+
+    if (best.m_R == std::numeric_limits<double>::infinity())
+    {
+        best = BallFrom(p[0], p[1]);
+        for (int i = 2; i < n; ++i)
+        {
+            Grow(&best, p[i]);
+        }
+    }
+
+    return best;
+}
+
+// Returns the smallest ball enclosing a set of points (Welzl's algorithm in its iterative move-to-front form). The
+// points are shuffled first, which makes the expected time linear. The points on the surface of the ball are
+// stored in pSupport.
+Ball ComputeMinimalBall(std::vector<Vector3d> * pPoints, std::vector<Vector3d> * pSupport)
+{
+    std::vector<Vector3d> & p = *pPoints;
+    size_t const            n = p.size();
+
+    assert(n > 0);
+
+    std::mt19937 random(12345);     // A fixed seed makes the results repeatable
+    std::shuffle(p.begin(), p.end(), random);
+
+    Ball     ball = BallFrom(p[0], p[0]);
+    Vector3d support[4] = { p[0] };
+    int      nSupport   = 1;
+
+    for (size_t i = 1; i < n; ++i)
+    {
+        if (!IsOutside(ball, p[i]))
+            continue;
+
+        ball       = BallFrom(p[i], p[i]);
+        support[0] = p[i];
+        nSupport   = 1;
+
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (!IsOutside(ball, p[j]))
+                continue;
+
+            ball       = BallFrom(p[i], p[j]);
+            support[1] = p[j];
+            nSupport   = 2;
+
+            for (size_t k = 0; k < j; ++k)
+            {
+                if (!IsOutside(ball, p[k]))
+                    continue;
+
+                ball       = BallFrom(p[i], p[j], p[k]);
+                support[2] = p[k];
+                nSupport   = 3;
+
+                for (size_t l = 0; l < k; ++l)
+                {
+                    if (!IsOutside(ball, p[l]))
+                        continue;
+
+                    ball       = BallFrom(p[i], p[j], p[k], p[l]);
+                    support[3] = p[l];
+                    nSupport   = 4;
+                }
+            }
+        }
+    }
+
+    // The degenerate cases do not guarantee that the earlier points stay inside, so any that fell out are added.
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Grow(&ball, p[i]);
+    }
+
+    if (pSupport)
+        pSupport->assign(support, support + nSupport);
+
+    return ball;
+}
+
+// Returns the ball enclosing a set of points computed with Ritter's method
+Ball ComputeRitterBall(MyMath::TaskScheduler * pScheduler, Vector3 const * paPoints, size_t n)
+{
+    assert(n > 0);
+
+    // The initial ball is around the pair of extreme points along the x, y and z axes that are farthest apart.
+
+    struct Extremes
+    {
+        size_t m_Min[3];
+        size_t m_Max[3];
+    };
+
+    Extremes const first = { { 0, 0, 0 }, { 0, 0, 0 } };
+
+    Extremes const extremes = Reduce(pScheduler, n, first,
+        [paPoints](size_t begin, size_t end, Extremes * pExtremes)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (paPoints[i].m_V[k] < paPoints[pExtremes->m_Min[k]].m_V[k])
+                        pExtremes->m_Min[k] = i;
+                    if (paPoints[i].m_V[k] > paPoints[pExtremes->m_Max[k]].m_V[k])
+                        pExtremes->m_Max[k] = i;
+                }
+            }
+        },
+        [paPoints](Extremes * pTotal, Extremes const & partial)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                if (paPoints[partial.m_Min[k]].m_V[k] < paPoints[pTotal->m_Min[k]].m_V[k])
+                    pTotal->m_Min[k] = partial.m_Min[k];
+                if (paPoints[partial.m_Max[k]].m_V[k] > paPoints[pTotal->m_Max[k]].m_V[k])
+                    pTotal->m_Max[k] = partial.m_Max[k];
+            }
+        });
+
+    int    axis     = 0;
+    double farthest = -1.0;
+    for (int k = 0; k < 3; ++k)
+    {
+        double const d2 = (ToDouble(paPoints[extremes.m_Max[k]]) - ToDouble(paPoints[extremes.m_Min[k]])).Length2();
+        if (d2 > farthest)
+        {
+            farthest = d2;
+            axis     = k;
+        }
+    }
+
+    Ball const initial = BallFrom(ToDouble(paPoints[extremes.m_Min[axis]]), ToDouble(paPoints[extremes.m_Max[axis]]));
+
+    // Each part grows its own copy of the initial ball, and the results are merged.
+
+    return Reduce(pScheduler, n, initial,
+        [paPoints](size_t begin, size_t end, Ball * pBall)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Grow(pBall, ToDouble(paPoints[i]));
+            }
+        },
+        [](Ball * pTotal, Ball const & partial)
+        {
+            *pTotal = Merge(*pTotal, partial);
+        });
+}
+
+// Returns the smallest ball enclosing a set of points
+Ball ComputeMinimalBall(MyMath::TaskScheduler * pScheduler, Vector3 const * paPoints, size_t n)
+{
+    assert(n > 0);
+
+    std::vector<Vector3d> support;
+
+    if (pScheduler == nullptr)
+    {
+        std::vector<Vector3d> points(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            points[i] = ToDouble(paPoints[i]);
+        }
+        return ComputeMinimalBall(&points, &support);
+    }
+
+    // The points on the surface of the balls of the parts are candidates for the surface of the whole ball. The
+    // ball of the candidates may leave some points outside, so those are added to the candidates until there are
+    // none. The ball grows each time, so this ends, and in practice it takes very few rounds.
+
+    using PointList = std::vector<Vector3d>;
+
+    auto const append = [](PointList * pTotal, PointList const & partial)
+    {
+        pTotal->insert(pTotal->end(), partial.begin(), partial.end());
+    };
+
+    PointList candidates = Reduce(pScheduler, n, PointList(),
+        [paPoints](size_t begin, size_t end, PointList * pSupport)
+        {
+            PointList points(end - begin);
+            for (size_t i = begin; i < end; ++i)
+            {
+                points[i - begin] = ToDouble(paPoints[i]);
+            }
+            ComputeMinimalBall(&points, pSupport);
+        },
+        append);
+
+    for (;;)
+    {
+        Ball const ball = ComputeMinimalBall(&candidates, &support);
+
+        PointList const outside = Reduce(pScheduler, n, PointList(),
+            [paPoints, &ball](size_t begin, size_t end, PointList * pOutside)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    Vector3d const p = ToDouble(paPoints[i]);
+                    if (IsOutside(ball, p))
+                        pOutside->push_back(p);
+                }
+            },
+            append);
+
+        if (outside.empty())
+            return ball;
+
+        candidates = support;
+        candidates.insert(candidates.end(), outside.begin(), outside.end());
+    }
+}
+
+// Returns the minimum and maximum of the projections of a set of points onto the axes of an orientation
+Bounds ComputeProjectedBounds(MyMath::TaskScheduler * pScheduler, Matrix33 const & orientation,
+                              Vector3 const * paPoints, size_t n)
+{
+    Vector3 const x(orientation.m_Xx, orientation.m_Xy, orientation.m_Xz);
+    Vector3 const y(orientation.m_Yx, orientation.m_Yy, orientation.m_Yz);
+    Vector3 const z(orientation.m_Zx, orientation.m_Zy, orientation.m_Zz);
+
+    return Reduce(pScheduler, n, EMPTY_BOUNDS,
+        [&](size_t begin, size_t end, Bounds * pBounds)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Vector3 const & p = paPoints[i];
+                float const     a = Dot(p, x);
+                float const     b = Dot(p, y);
+                float const     c = Dot(p, z);
+
+                pBounds->m_Min.m_X = std::min(pBounds->m_Min.m_X, a);
+                pBounds->m_Max.m_X = std::max(pBounds->m_Max.m_X, a);
+                pBounds->m_Min.m_Y = std::min(pBounds->m_Min.m_Y, b);
+                pBounds->m_Max.m_Y = std::max(pBounds->m_Max.m_Y, b);
+                pBounds->m_Min.m_Z = std::min(pBounds->m_Min.m_Z, c);
+                pBounds->m_Max.m_Z = std::max(pBounds->m_Max.m_Z, c);
+            }
+        },
+        [](Bounds * pTotal, Bounds const & partial)
+        {
+            Include(pTotal, partial);
+        });
+}
+
+// Returns the box with an orientation whose projections are the given bounds
+Box ToBox(Matrix33 const & orientation, Bounds const & bounds)
+{
+    Vector3 const x(orientation.m_Xx, orientation.m_Xy, orientation.m_Xz);
+    Vector3 const y(orientation.m_Yx, orientation.m_Yy, orientation.m_Yz);
+    Vector3 const z(orientation.m_Zx, orientation.m_Zy, orientation.m_Zz);
+
+    // The box is tested in its center/half-extent form, which is computed from the position and the axes in float,
+    // so the projections of the points onto the axes can be off by a few ulps of the largest coordinate. The box is
+    // enlarged on each side by a margin that covers that. Flat sides are given a small thickness around their middle.
+
+    float magnitude = 0.0f;
+    for (int k = 0; k < 3; ++k)
+    {
+        magnitude = std::max(magnitude, std::max(std::fabs(bounds.m_Min.m_V[k]), std::fabs(bounds.m_Max.m_V[k])));
+    }
+
+    float const margin = BOX_MARGIN * magnitude;
+
+    Vector3 lo   = bounds.m_Min - Vector3(margin, margin, margin);
+    Vector3 size = bounds.m_Max - bounds.m_Min + Vector3(2.0f * margin, 2.0f * margin, 2.0f * margin);
+    for (int k = 0; k < 3; ++k)
+    {
+        if (size.m_V[k] < MIN_BOX_SIZE)
+        {
+            lo.m_V[k]  -= (MIN_BOX_SIZE - size.m_V[k]) * 0.5f;
+            size.m_V[k] = MIN_BOX_SIZE;
+        }
+    }
+
+    Vector3 const position = x * lo.m_X + y * lo.m_Y + z * lo.m_Z;
+
+    return Box(orientation, position, size);
+}
+
+// Returns an orientation whose first axis is u and whose second axis is in the plane of u and v. Returns false if u
+// and v are parallel or either is 0.
+bool MakeOrientation(Vector3d const & u, Vector3d const & v, Matrix33 * pOrientation)
+{
+    double const u2 = u.Length2();
+    if (u2 <= 0.0)
+        return false;
+
+    Vector3d const x  = u * (1.0 / std::sqrt(u2));
+    Vector3d       y  = v - x * Dot(x, v);
+    double const   y2 = y.Length2();
+    if (y2 <= 1.0e-12 * v.Length2() || y2 <= 0.0)
+        return false;
+
+    y *= 1.0 / std::sqrt(y2);
+
+    Vector3d const z = Cross(x, y);
+
+    *pOrientation = Matrix33(ToFloat(x), ToFloat(y), ToFloat(z));
+    return true;
+}
+
+// Returns an orientation whose first axis is u, or false if u is 0
+bool MakeOrientation(Vector3d const & u, Matrix33 * pOrientation)
+{
+    // Any vector that is not parallel to u will do for the second axis.
+
+    Vector3d const v = (std::fabs(u.m_X) <= std::fabs(u.m_Y) && std::fabs(u.m_X) <= std::fabs(u.m_Z)) ?
+                       Vector3d(1.0, 0.0, 0.0) :
+                       (std::fabs(u.m_Y) <= std::fabs(u.m_Z)) ? Vector3d(0.0, 1.0, 0.0) : Vector3d(0.0, 0.0, 1.0);
+
+    return MakeOrientation(u, v, pOrientation);
+}
+
+// Computes the eigenvectors of a symmetric matrix with Jacobi rotations. The matrix is destroyed.
+void ComputeEigenvectors(double a[3][3], Vector3d axes[3])
+{
+    double v[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+
+    for (int sweep = 0; sweep < 32; ++sweep)
+    {
+        double const off  = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        double const diag = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (off <= 1.0e-24 * diag)
+            break;
+
+        for (int p = 0; p < 2; ++p)
+        {
+            for (int q = p + 1; q < 3; ++q)
+            {
+                if (a[p][q] == 0.0)
+                    continue;
+
+                // The rotation in the pq plane that zeros a[p][q]
+
+                double const theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                double const sign  = (theta >= 0.0) ? 1.0 : -1.0;
+                double const t     = sign / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                double const c     = 1.0 / std::sqrt(t * t + 1.0);
+                double const s     = t * c;
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    double const akp = a[k][p];
+                    double const akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    double const apk = a[p][k];
+                    double const aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    double const vkp = v[k][p];
+                    double const vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+        axes[i] = Vector3d(v[0][i], v[1][i], v[2][i]);
+    }
+}
+
+// Returns a tight oriented box enclosing a set of points
+//
+// This is DiTO-14 (Larsson and Kallberg, "Fast Computation of Tight-Fitting Oriented Bounding Boxes"): the extremal
+// points in 7 directions form a triangle and two tetrahedra, whose edges and normals give candidate orientations.
+// The principal axes of the points and the world axes are candidates too. The candidates are compared by the surface
+// areas of their boxes around the extremal points, and the box of the best one is fitted to all the points.
+Box ComputeTightBox(MyMath::TaskScheduler * pScheduler, Vector3 const * paPoints, size_t n)
+{
+    assert(n > 0);
+
+    // Extremal points, and the sums needed for the covariance, relative to the first point for accuracy
+
+    struct Statistics
+    {
+        float m_MinD[NUM_DITO_NORMALS];
+        float m_MaxD[NUM_DITO_NORMALS];
+        Vector3 m_MinP[NUM_DITO_NORMALS];
+        Vector3 m_MaxP[NUM_DITO_NORMALS];
+        double m_Sum[3];
+        double m_Sum2[3][3];
+    };
+
+    Statistics first;
+    for (int i = 0; i < NUM_DITO_NORMALS; ++i)
+    {
+        first.m_MinD[i] = std::numeric_limits<float>::infinity();
+        first.m_MaxD[i] = -std::numeric_limits<float>::infinity();
+        first.m_MinP[i] = paPoints[0];
+        first.m_MaxP[i] = paPoints[0];
+    }
+    std::fill(&first.m_Sum[0], &first.m_Sum[0] + 3, 0.0);
+    std::fill(&first.m_Sum2[0][0], &first.m_Sum2[0][0] + 9, 0.0);
+
+    Vector3d const origin = ToDouble(paPoints[0]);
+
+    Statistics const statistics = Reduce(pScheduler, n, first,
+        [paPoints, &origin](size_t begin, size_t end, Statistics * pStatistics)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Vector3 const & p = paPoints[i];
+
+                for (int j = 0; j < NUM_DITO_NORMALS; ++j)
+                {
+                    float const d = Dot(p, DITO_NORMALS[j]);
+                    if (d < pStatistics->m_MinD[j])
+                    {
+                        pStatistics->m_MinD[j] = d;
+                        pStatistics->m_MinP[j] = p;
+                    }
+                    if (d > pStatistics->m_MaxD[j])
+                    {
+                        pStatistics->m_MaxD[j] = d;
+                        pStatistics->m_MaxP[j] = p;
+                    }
+                }
+
+                Vector3d const q = ToDouble(p) - origin;
+                for (int r = 0; r < 3; ++r)
+                {
+                    pStatistics->m_Sum[r] += q.m_V[r];
+                    for (int c = r; c < 3; ++c)
+                    {
+                        pStatistics->m_Sum2[r][c] += q.m_V[r] * q.m_V[c];
+                    }
+                }
+            }
+        },
+        [](Statistics * pTotal, Statistics const & partial)
+        {
+            for (int j = 0; j < NUM_DITO_NORMALS; ++j)
+            {
+                if (partial.m_MinD[j] < pTotal->m_MinD[j])
+                {
+                    pTotal->m_MinD[j] = partial.m_MinD[j];
+                    pTotal->m_MinP[j] = partial.m_MinP[j];
+                }
+                if (partial.m_MaxD[j] > pTotal->m_MaxD[j])
+                {
+                    pTotal->m_MaxD[j] = partial.m_MaxD[j];
+                    pTotal->m_MaxP[j] = partial.m_MaxP[j];
+                }
+            }
+            for (int r = 0; r < 3; ++r)
+            {
+                pTotal->m_Sum[r] += partial.m_Sum[r];
+                for (int c = r; c < 3; ++c)
+                {
+                    pTotal->m_Sum2[r][c] += partial.m_Sum2[r][c];
+                }
+            }
+        });
+
+    Vector3d extremal[2 * NUM_DITO_NORMALS];
+    for (int j = 0; j < NUM_DITO_NORMALS; ++j)
+    {
+        extremal[2 * j + 0] = ToDouble(statistics.m_MinP[j]);
+        extremal[2 * j + 1] = ToDouble(statistics.m_MaxP[j]);
+    }
+
+    std::vector<Matrix33> candidates;
+    candidates.reserve(24);
+    candidates.push_back(Matrix33::Identity());
+
+    // The principal axes
+
+    {
+        double covariance[3][3];
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = r; c < 3; ++c)
+            {
+                double const mean = statistics.m_Sum[r] * statistics.m_Sum[c] / double(n);
+                covariance[r][c] = covariance[c][r] = (statistics.m_Sum2[r][c] - mean) / double(n);
+            }
+        }
+
+        Vector3d axes[3];
+        ComputeEigenvectors(covariance, axes);
+
+        Matrix33 orientation;
+        if (MakeOrientation(axes[0], axes[1], &orientation))
+            candidates.push_back(orientation);
+    }
+
+    // The triangle: the farthest pair of extremal points and the extremal point farthest from the line through them
+
+    int    iBase    = 0;
+    double farthest = -1.0;
+    for (int j = 0; j < NUM_DITO_NORMALS; ++j)
+    {
+        double const d2 = (extremal[2 * j + 1] - extremal[2 * j]).Length2();
+        if (d2 > farthest)
+        {
+            farthest = d2;
+            iBase    = j;
+        }
+    }
+
+    Vector3d const p0 = extremal[2 * iBase];
+    Vector3d const p1 = extremal[2 * iBase + 1];
+    Vector3d const e0 = p1 - p0;
+
+    Vector3d p2;
+    double   farthestFromLine = -1.0;
+    for (Vector3d const & p : extremal)
+    {
+        double const d2 = Cross(p - p0, e0).Length2();
+        if (d2 > farthestFromLine)
+        {
+            farthestFromLine = d2;
+            p2               = p;
+        }
+    }
+
+    // Adds the orientations given by the edges and normal of a triangle
+    auto const addTriangle = [&candidates](Vector3d const & a, Vector3d const & b, Vector3d const & c)
+    {
+        Vector3d const edges[3] = { b - a, c - b, a - c };
+        Vector3d const normal   = Cross(edges[0], edges[1]);
+
+        for (Vector3d const & edge : edges)
+        {
+            Matrix33 orientation;
+            if (MakeOrientation(edge, Cross(normal, edge), &orientation))
+                candidates.push_back(orientation);
+        }
+    };
+
+    if (farthestFromLine <= 1.0e-12 * e0.Length2() * e0.Length2())
+    {
+        // The points are (nearly) on a line.
+
+        Matrix33 orientation;
+        if (MakeOrientation(e0, &orientation))
+            candidates.push_back(orientation);
+    }
+    else
+    {
+        addTriangle(p0, p1, p2);
+
+        // The tetrahedra on both sides of the triangle, made with the extremal points farthest from its plane
+
+        Vector3d const normal = Cross(e0, p2 - p0);
+        Vector3d const *pBelow = &extremal[0];
+        Vector3d const *pAbove = &extremal[0];
+        for (Vector3d const & p : extremal)
+        {
+            if (Dot(p - p0, normal) < Dot(*pBelow - p0, normal))
+                pBelow = &p;
+            if (Dot(p - p0, normal) > Dot(*pAbove - p0, normal))
+                pAbove = &p;
+        }
+
+        double const threshold = 1.0e-6 * normal.Length() * std::sqrt(e0.Length2());
+        for (Vector3d const * pApex : { pBelow, pAbove })
+        {
+            if (std::fabs(Dot(*pApex - p0, normal)) > threshold)
+            {
+                addTriangle(*pApex, p0, p1);
+                addTriangle(*pApex, p1, p2);
+                addTriangle(*pApex, p2, p0);
+            }
+        }
+    }
+
+    // Choose the candidate whose box around the extremal points has the smallest surface area.
+
+    Matrix33 const * pBest    = &candidates[0];
+    float            bestArea = std::numeric_limits<float>::infinity();
+    for (Matrix33 const & orientation : candidates)
+    {
+        Bounds bounds = EMPTY_BOUNDS;
+        for (int j = 0; j < NUM_DITO_NORMALS; ++j)
+        {
+            Vector3 const points[2] = { statistics.m_MinP[j], statistics.m_MaxP[j] };
+            Include(&bounds, ComputeProjectedBounds(nullptr, orientation, points, 2));
+        }
+
+        Vector3 const size = bounds.m_Max - bounds.m_Min;
+        float const   area = size.m_X * size.m_Y + size.m_Y * size.m_Z + size.m_Z * size.m_X;
+        if (area < bestArea)
+        {
+            bestArea = area;
+            pBest    = &orientation;
+        }
+    }
+
+    return ToBox(*pBest, ComputeProjectedBounds(pScheduler, *pBest, paPoints, n));
+}
+// Returns an upper bound on the largest factor by which a matrix with rows x, y and z stretches a vector. The square
+// of the largest stretch is the largest eigenvalue of the matrix of the dot products of the rows, which is at most
+// the largest sum of the absolute values in a row of that matrix. The bound is exact if the rows are orthogonal.
+float MaxStretch(Vector3 const & x, Vector3 const & y, Vector3 const & z)
+{
+    float const xy = std::fabs(Dot(x, y));
+    float const yz = std::fabs(Dot(y, z));
+    float const zx = std::fabs(Dot(z, x));
+
+    float const a = Dot(x, x) + xy + zx;
+    float const b = Dot(y, y) + xy + yz;
+    float const c = Dot(z, z) + yz + zx;
+
+    return std::sqrt(std::max(a, std::max(b, c)));
+}
+} // anonymous namespace
+
+namespace MyMath
+{
+//! @param	paPoints	Points
+//! @param	n			Number of points
+//!
+//! With AVX2, 8 points are processed at a time.
+
+AABox ComputeAABox(Vector3 const * paPoints, size_t n)
+{
+    assert(n > 0);
+
+    Bounds bounds = EMPTY_BOUNDS;
+    Include(&bounds, paPoints, n);
+    return ToAABox(bounds);
+}
+
+//! @param	scheduler	Scheduler that runs the tasks
+//! @param	paPoints	Points
+//! @param	n			Number of points
+
+AABox ComputeAABox(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n)
+{
+    assert(n > 0);
+
+    Bounds const bounds = Reduce(&scheduler, n, EMPTY_BOUNDS,
+        [paPoints](size_t begin, size_t end, Bounds * pBounds)
+        {
+            Include(pBounds, paPoints + begin, end - begin);
+        },
+        [](Bounds * pTotal, Bounds const & partial)
+        {
+            Include(pTotal, partial);
+        });
+
+    return ToAABox(bounds);
+}
+
+//! @param	points	Points
+//!
+//! With AVX2, 8 values of each stream are processed at a time.
+
+AABox ComputeAABox(Vector3SoA const & points)
+{
+    assert(points.Size() > 0);
+
+    Bounds bounds;
+    ComputeRange(points.GetX(), points.Size(), &bounds.m_Min.m_X, &bounds.m_Max.m_X);
+    ComputeRange(points.GetY(), points.Size(), &bounds.m_Min.m_Y, &bounds.m_Max.m_Y);
+    ComputeRange(points.GetZ(), points.Size(), &bounds.m_Min.m_Z, &bounds.m_Max.m_Z);
+    return ToAABox(bounds);
+}
+
+//! @param	paPoints	Points
+//! @param	n			Number of points
+//!
+//! The initial sphere is around the pair of extreme points along the x, y and z axes that are farthest apart, and
+//! it is grown to include each point outside it in turn.
+
+Sphere ComputeBoundingSphere(Vector3 const * paPoints, size_t n)
+{
+    return ToSphere(ComputeRitterBall(nullptr, paPoints, n));
+}
+
+//! @param	scheduler	Scheduler that runs the tasks
+//! @param	paPoints	Points
+//! @param	n			Number of points
+//!
+//! Each task grows its own copy of the initial sphere, and the results are merged, so the sphere may be a little
+//! larger than the serial one.
+
+Sphere ComputeBoundingSphere(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n)
+{
+    return ToSphere(ComputeRitterBall(&scheduler, paPoints, n));
+}
+
+//! @param	paPoints	Points
+//! @param	n			Number of points
+//!
+//! The points are copied and shuffled, which makes the expected time linear.
+
+Sphere ComputeMinimalSphere(Vector3 const * paPoints, size_t n)
+{
+    return ToSphere(ComputeMinimalBall(nullptr, paPoints, n));
+}
+
+//! @param	scheduler	Scheduler that runs the tasks
+//! @param	paPoints	Points
+//! @param	n			Number of points
+//!
+//! The minimal spheres of the parts of the set are computed in parallel. The points on their surfaces are
+//! candidates for the surface of the whole sphere, and points that are outside the sphere of the candidates are
+//! found in parallel and added to the candidates until there are none.
+
+Sphere ComputeMinimalSphere(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n)
+{
+    return ToSphere(ComputeMinimalBall(&scheduler, paPoints, n));
+}
+
+//! @param	paPoints	Points
+//! @param	n			Number of points
+
+Box ComputeBox(Vector3 const * paPoints, size_t n)
+{
+    return ComputeTightBox(nullptr, paPoints, n);
+}
+
+//! @param	scheduler	Scheduler that runs the tasks
+//! @param	paPoints	Points
+//! @param	n			Number of points
+
+Box ComputeBox(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n)
+{
+    return ComputeTightBox(&scheduler, paPoints, n);
+}
+
+//! @param	orientation		Orientation of the box (e.g. Box::GetOrientation() of the box to refit)
+//! @param	paPoints		Points
+//! @param	n				Number of points
+//!
+//! A box can't have a size of 0, so a flat set of points gets a very thin box.
+
+Box ComputeBox(Matrix33 const & orientation, Vector3 const * paPoints, size_t n)
+{
+    assert(n > 0);
+
+    return ToBox(orientation, ComputeProjectedBounds(nullptr, orientation, paPoints, n));
+}
+
+//! @param	scheduler		Scheduler that runs the tasks
+//! @param	orientation		Orientation of the box (e.g. Box::GetOrientation() of the box to refit)
+//! @param	paPoints		Points
+//! @param	n				Number of points
+
+Box ComputeBox(TaskScheduler & scheduler, Matrix33 const & orientation, Vector3 const * paPoints, size_t n)
+{
+    assert(n > 0);
+
+    return ToBox(orientation, ComputeProjectedBounds(&scheduler, orientation, paPoints, n));
+}
+
+//! @param	pAABox		Box to grow
+//! @param	paPoints	Points
+//! @param	n			Number of points
+
+void Extend(AABox * pAABox, Vector3 const * paPoints, size_t n)
+{
+    Bounds bounds = { pAABox->m_Position, pAABox->m_Position + pAABox->m_Scale };
+    Include(&bounds, paPoints, n);
+    *pAABox = ToAABox(bounds);
+}
+
+//! @param	pSphere		Sphere to grow
+//! @param	paPoints	Points
+//! @param	n			Number of points
+//!
+//! Each point outside the sphere moves the sphere toward it just enough to include it (as in Ritter's method).
+
+void Extend(Sphere * pSphere, Vector3 const * paPoints, size_t n)
+{
+    Ball ball = ToBall(*pSphere);
+    bool grew = false;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vector3d const p = ToDouble(paPoints[i]);
+        if (IsOutside(ball, p))
+        {
+            Grow(&ball, p);
+            grew = true;
+        }
+    }
+
+    if (grew)
+        *pSphere = ToSphere(ball);
+}
+
+//! @param	a	Box
+//! @param	b	Box
+
+AABox Merge(AABox const & a, AABox const & b)
+{
+    Bounds bounds = { a.m_Position, a.m_Position + a.m_Scale };
+    Include(&bounds, Bounds{ b.m_Position, b.m_Position + b.m_Scale });
+    return ToAABox(bounds);
+}
+
+//! @param	a	Sphere
+//! @param	b	Sphere
+
+Sphere Merge(Sphere const & a, Sphere const & b)
+{
+    Ball const   ballA    = ToBall(a);
+    Ball const   ballB    = ToBall(b);
+    double const distance = (ballB.m_C - ballA.m_C).Length();
+
+    // If one sphere encloses the other, it is returned as it is.
+
+    if (distance + ballB.m_R <= ballA.m_R)
+        return a;
+    if (distance + ballA.m_R <= ballB.m_R)
+        return b;
+
+    return ToSphere(Merge(ballA, ballB));
+}
+
+//! @param	aabox	Box
+//! @param	m		Transformation
+//!
+//! The center is transformed, and the half-extent along each world axis is the sum of the half-extents scaled by the
+//! absolute values of the matrix elements.
+
+AABox Transform(AABox const & aabox, Matrix43 const & m)
+{
+    Vector3 const e = aabox.m_Scale * 0.5f;
+    Vector3 const c = (aabox.m_Position + e) * m;
+
+    Vector3 extents;
+    for (int k = 0; k < 3; ++k)
+    {
+        extents.m_V[k] = std::fabs(m.m_M[0][k]) * e.m_X
+                       + std::fabs(m.m_M[1][k]) * e.m_Y
+                       + std::fabs(m.m_M[2][k]) * e.m_Z;
+    }
+
+    return AABox(c - extents, extents * 2.0f);
+}
+
+//! @param	aabox	Box
+//! @param	m		Transformation (affine)
+
+AABox Transform(AABox const & aabox, Matrix44 const & m)
+{
+    assert(m.m_Xw == 0.0f && m.m_Yw == 0.0f && m.m_Zw == 0.0f && m.m_Tw == 1.0f);
+
+    return Transform(aabox, Matrix43(m));
+}
+
+//! @param	sphere	Sphere
+//! @param	m		Transformation
+
+Sphere Transform(Sphere const & sphere, Matrix43 const & m)
+{
+    Vector3 const x(m.m_Xx, m.m_Xy, m.m_Xz);
+    Vector3 const y(m.m_Yx, m.m_Yy, m.m_Yz);
+    Vector3 const z(m.m_Zx, m.m_Zy, m.m_Zz);
+
+    return Sphere(sphere.m_C * m, sphere.m_R * MaxStretch(x, y, z));
+}
+
+//! @param	sphere	Sphere
+//! @param	m		Transformation (affine)
+
+Sphere Transform(Sphere const & sphere, Matrix44 const & m)
+{
+    assert(m.m_Xw == 0.0f && m.m_Yw == 0.0f && m.m_Zw == 0.0f && m.m_Tw == 1.0f);
+
+    return Transform(sphere, Matrix43(m));
+}
+
+//! @param	aabox	Box
+//! @param	m		Transformation
+//!
+//! The axes of the box are the normalized rows of the matrix, and the lengths of the rows scale its size.
+//!
+//! @note	The rows of the matrix must be orthogonal, and the box must not be flat.
+
+Box TransformToBox(AABox const & aabox, Matrix43 const & m)
+{
+    Vector3 x(m.m_Xx, m.m_Xy, m.m_Xz);
+    Vector3 y(m.m_Yx, m.m_Yy, m.m_Yz);
+    Vector3 z(m.m_Zx, m.m_Zy, m.m_Zz);
+
+    Vector3 const scale(x.Length(), y.Length(), z.Length());
+
+    assert(!MyMath::IsCloseToZero(scale.m_X));
+    assert(!MyMath::IsCloseToZero(scale.m_Y));
+    assert(!MyMath::IsCloseToZero(scale.m_Z));
+
+    x *= 1.0f / scale.m_X;
+    y *= 1.0f / scale.m_Y;
+    z *= 1.0f / scale.m_Z;
+
+    Vector3 const size(aabox.m_Scale.m_X * scale.m_X, aabox.m_Scale.m_Y * scale.m_Y, aabox.m_Scale.m_Z * scale.m_Z);
+
+    return Box(Matrix33(x, y, z), aabox.m_Position * m, size);
+}
+
+//! @param	centers			Centers of the boxes
+//! @param	halfExtents		Half-extents of the boxes
+//! @param	m				Transformations
+//! @param	pCenters		Centers of the transformed boxes
+//! @param	pHalfExtents	Half-extents of the transformed boxes
+//!
+//! The loop over the streams has no branches, so the compiler can vectorize it.
+
+void Transform(Vector3SoA const & centers, Vector3SoA const & halfExtents, Matrix43SoA const & m,
+               Vector3SoA * pCenters, Vector3SoA * pHalfExtents)
+{
+    assert(centers.Size() == m.Size());
+    assert(halfExtents.Size() == m.Size());
+
+    pCenters->Resize(m.Size());
+    pHalfExtents->Resize(m.Size());
+
+    float const * const cx  = centers.GetX();
+    float const * const cy  = centers.GetY();
+    float const * const cz  = centers.GetZ();
+    float const * const ex  = halfExtents.GetX();
+    float const * const ey  = halfExtents.GetY();
+    float const * const ez  = halfExtents.GetZ();
+    float const * const mXx = m.GetStream(0, 0);
+    float const * const mXy = m.GetStream(0, 1);
+    float const * const mXz = m.GetStream(0, 2);
+    float const * const mYx = m.GetStream(1, 0);
+    float const * const mYy = m.GetStream(1, 1);
+    float const * const mYz = m.GetStream(1, 2);
+    float const * const mZx = m.GetStream(2, 0);
+    float const * const mZy = m.GetStream(2, 1);
+    float const * const mZz = m.GetStream(2, 2);
+    float const * const mTx = m.GetStream(3, 0);
+    float const * const mTy = m.GetStream(3, 1);
+    float const * const mTz = m.GetStream(3, 2);
+    float * const       rcx = pCenters->GetX();
+    float * const       rcy = pCenters->GetY();
+    float * const       rcz = pCenters->GetZ();
+    float * const       rex = pHalfExtents->GetX();
+    float * const       rey = pHalfExtents->GetY();
+    float * const       rez = pHalfExtents->GetZ();
+    size_t const        n   = m.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const x  = cx[i];
+        float const y  = cy[i];
+        float const z  = cz[i];
+        float const hx = ex[i];
+        float const hy = ey[i];
+        float const hz = ez[i];
+
+        rcx[i] = x * mXx[i] + y * mYx[i] + z * mZx[i] + mTx[i];
+        rcy[i] = x * mXy[i] + y * mYy[i] + z * mZy[i] + mTy[i];
+        rcz[i] = x * mXz[i] + y * mYz[i] + z * mZz[i] + mTz[i];
+
+        rex[i] = hx * std::fabs(mXx[i]) + hy * std::fabs(mYx[i]) + hz * std::fabs(mZx[i]);
+        rey[i] = hx * std::fabs(mXy[i]) + hy * std::fabs(mYy[i]) + hz * std::fabs(mZy[i]);
+        rez[i] = hx * std::fabs(mXz[i]) + hy * std::fabs(mYz[i]) + hz * std::fabs(mZz[i]);
+    }
+}
+
+//! @param	centers				Centers of the spheres
+//! @param	paRadii				Radii of the spheres
+//! @param	m					Transformations
+//! @param	pCenters			Centers of the transformed spheres
+//! @param	paTransformedRadii	Radii of the transformed spheres
+
+void Transform(Vector3SoA const & centers, float const * paRadii, Matrix43SoA const & m,
+               Vector3SoA * pCenters, float * paTransformedRadii)
+{
+    assert(centers.Size() == m.Size());
+
+    pCenters->Resize(m.Size());
+
+    float const * const cx  = centers.GetX();
+    float const * const cy  = centers.GetY();
+    float const * const cz  = centers.GetZ();
+    float const * const mXx = m.GetStream(0, 0);
+    float const * const mXy = m.GetStream(0, 1);
+    float const * const mXz = m.GetStream(0, 2);
+    float const * const mYx = m.GetStream(1, 0);
+    float const * const mYy = m.GetStream(1, 1);
+    float const * const mYz = m.GetStream(1, 2);
+    float const * const mZx = m.GetStream(2, 0);
+    float const * const mZy = m.GetStream(2, 1);
+    float const * const mZz = m.GetStream(2, 2);
+    float const * const mTx = m.GetStream(3, 0);
+    float const * const mTy = m.GetStream(3, 1);
+    float const * const mTz = m.GetStream(3, 2);
+    float * const       rcx = pCenters->GetX();
+    float * const       rcy = pCenters->GetY();
+    float * const       rcz = pCenters->GetZ();
+
+    // The centers are padded, so the whole streams are transformed. The radii are not.
+
+    for (size_t i = 0; i < m.PaddedSize(); ++i)
+    {
+        float const x = cx[i];
+        float const y = cy[i];
+        float const z = cz[i];
+
+        rcx[i] = x * mXx[i] + y * mYx[i] + z * mZx[i] + mTx[i];
+        rcy[i] = x * mXy[i] + y * mYy[i] + z * mZy[i] + mTy[i];
+        rcz[i] = x * mXz[i] + y * mYz[i] + z * mZz[i] + mTz[i];
+    }
+
+    for (size_t i = 0; i < m.Size(); ++i)
+    {
+        Vector3 const x(mXx[i], mXy[i], mXz[i]);
+        Vector3 const y(mYx[i], mYy[i], mYz[i]);
+        Vector3 const z(mZx[i], mZy[i], mZz[i]);
+
+        paTransformedRadii[i] = paRadii[i] * MaxStretch(x, y, z);
+    }
+}
+
+//! @param	aabox		Box
+//! @param	m			Transformations
+//! @param	pBoxes		Transformed boxes
+
+void TransformToBox(AABox const & aabox, Matrix43SoA const & m, std::vector<Box> * pBoxes)
+{
+    pBoxes->clear();
+    pBoxes->reserve(m.Size());
+
+    for (size_t i = 0; i < m.Size(); ++i)
+    {
+        pBoxes->push_back(TransformToBox(aabox, m[i]));
+    }
+}
+} // namespace MyMath
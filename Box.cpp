@@ -1,9 +1,26 @@
 #include "Box.h"
 
+#include "Line.h"
 #include "Matrix33.h"
 #include "Matrix44.h"
+#include "Point.h"
+#include "Sphere.h"
 #include "Vector3.h"
 
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Returns the position of a point relative to the center of a box along each of the box's axes
+Vector3 ToBoxSpace(Box const & box, Vector3 const & point)
+{
+    Vector3 const d = point - box.GetCenter();
+
+    return Vector3(Dot(d, box.GetAxis(0)), Dot(d, box.GetAxis(1)), Dot(d, box.GetAxis(2)));
+}
+} // anonymous namespace
+
 //!
 //! @param	position	Location of the box's origin
 //! @param	size		Size of the box
@@ -52,6 +69,8 @@ Box::Box(Matrix33 const & orientation, Vector3 const & position, Vector3 const &
     assert(m_InverseOrientation.IsOrthonormal());
 
     m_InverseOrientation.Transpose();
+
+    Update();
 }
 
 //! This function constructs an oriented box given a matrix which transforms an axis-aligned unit cube at the origin
@@ -82,4 +101,132 @@ Box::Box(Matrix44 const & transform)
                                     x.m_Z, y.m_Z, z.m_Z);
 
     assert(m_InverseOrientation.IsOrthonormal());
+
+    Update();
+}
+
+//! The box is the set of points p such that for each axis i, |Dot(p - center, axis i)| <= half-extent i. Tests in
+//! this form need no transformation matrix and do not depend on which corner is the origin.
+
+void Box::Update()
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        m_Axes[i] = Vector3(m_InverseOrientation.m_M[0][i],
+                            m_InverseOrientation.m_M[1][i],
+                            m_InverseOrientation.m_M[2][i]);
+    }
+
+    Vector3 const halfScale = m_Scale * 0.5f;
+
+    m_Center      = m_Position + m_Axes[0] * halfScale.m_X + m_Axes[1] * halfScale.m_Y + m_Axes[2] * halfScale.m_Z;
+    m_HalfExtents = Vector3(std::fabs(halfScale.m_X), std::fabs(halfScale.m_Y), std::fabs(halfScale.m_Z));
+}
+
+//! The half-size of the enclosing box along each world axis is the sum of the projections of the box's half-extents
+//! onto that axis.
+
+AABox Box::GetAABox() const
+{
+    Vector3 extents;
+    for (int k = 0; k < 3; ++k)
+    {
+        extents.m_V[k] = std::fabs(m_Axes[0].m_V[k]) * m_HalfExtents.m_X
+                       + std::fabs(m_Axes[1].m_V[k]) * m_HalfExtents.m_Y
+                       + std::fabs(m_Axes[2].m_V[k]) * m_HalfExtents.m_Z;
+    }
+
+    return AABox(m_Center - extents, extents * 2.0f);
+}
+
+namespace MyMath
+{
+//! @param	point		Point
+//! @param	paBoxes		Boxes
+//! @param	nBoxes		Number of boxes
+//! @param	paResults	Where to store the results: NO_INTERSECTION or INTERSECTS
+
+void Classify(Point const & point, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults)
+{
+    for (int i = 0; i < nBoxes; ++i)
+    {
+        Box const &   box   = paBoxes[i];
+        Vector3 const local = ToBoxSpace(box, point.value_);
+        Vector3 const h     = box.GetHalfExtents();
+
+        if (std::fabs(local.m_X) <= h.m_X && std::fabs(local.m_Y) <= h.m_Y && std::fabs(local.m_Z) <= h.m_Z)
+            paResults[i] = Intersectable::INTERSECTS;
+        else
+            paResults[i] = Intersectable::NO_INTERSECTION;
+    }
+}
+
+//! @param	sphere		Sphere
+//! @param	paBoxes		Boxes
+//! @param	nBoxes		Number of boxes
+//! @param	paResults	Where to store the results: NO_INTERSECTION, INTERSECTS, ENCLOSES (the sphere encloses the
+//!						box) or ENCLOSED_BY (the box encloses the sphere)
+
+void Classify(Sphere const & sphere, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults)
+{
+    float const r  = sphere.m_R;
+    float const r2 = r * r;
+
+    for (int i = 0; i < nBoxes; ++i)
+    {
+        Box const &   box   = paBoxes[i];
+        Vector3 const local = ToBoxSpace(box, sphere.m_C);
+        Vector3 const h     = box.GetHalfExtents();
+
+        // Squared distances from the center to the nearest and farthest points of the box
+
+        float nearest2  = 0.0f;
+        float farthest2 = 0.0f;
+        bool  enclosed  = true;
+        for (int k = 0; k < 3; ++k)
+        {
+            float const d      = std::fabs(local.m_V[k]);
+            float const excess = d - h.m_V[k];
+
+            if (excess > 0.0f)
+                nearest2 += excess * excess;
+            farthest2 += (d + h.m_V[k]) * (d + h.m_V[k]);
+            enclosed   = enclosed && d + r <= h.m_V[k];
+        }
+
+        if (nearest2 > r2)
+            paResults[i] = Intersectable::NO_INTERSECTION;
+        else if (enclosed)
+            paResults[i] = Intersectable::ENCLOSED_BY;
+        else if (farthest2 <= r2)
+            paResults[i] = Intersectable::ENCLOSES;
+        else
+            paResults[i] = Intersectable::INTERSECTS;
+    }
+}
+
+//! @param	ray			Ray
+//! @param	paBoxes		Boxes
+//! @param	nBoxes		Number of boxes
+//! @param	paResults	Where to store the results: NO_INTERSECTION or INTERSECTS
+
+void Classify(Ray const & ray, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults)
+{
+    for (int i = 0; i < nBoxes; ++i)
+    {
+        Box const &   box       = paBoxes[i];
+        Vector3 const origin    = ToBoxSpace(box, ray.m_B);
+        Vector3 const direction = Vector3(Dot(ray.m_M, box.GetAxis(0)),
+                                          Dot(ray.m_M, box.GetAxis(1)),
+                                          Dot(ray.m_M, box.GetAxis(2)));
+        Vector3 const bounds[2] = { -box.GetHalfExtents(), box.GetHalfExtents() };
+        float         enter;
+        float         exit;
+
+        bool const hit = IntersectSlabs(RayPrecomputed(origin, direction), bounds, 0.0f,
+                                        std::numeric_limits<float>::infinity(), &enter, &exit);
+
+        paResults[i] = hit ? Intersectable::INTERSECTS : Intersectable::NO_INTERSECTION;
+    }
 }
+} // namespace MyMath
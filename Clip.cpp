@@ -0,0 +1,358 @@
+#include "Clip.h"
+
+#include "Frustum.h"
+#include "Plane.h"
+#include "PolyBuffer.h"
+#include "Vector3.h"
+
+#include "Misc/Assertx.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+int const MIN_VERTICES = 3; // Results with fewer vertices than this are empty
+
+// Returns the signed distance from a plane to a point
+float DistanceTo(Plane const & plane, Vector3 const & v)
+{
+    return Dot(plane.m_N, v) + plane.m_D;
+}
+
+// Returns the point where the edge a-b crosses a plane, given the distances of a and b from the plane
+Vector3 Crossing(Vector3 const & a, Vector3 const & b, float da, float db)
+{
+    return a + (b - a) * (da / (da - db));
+}
+
+// Appends a vertex to a result with room for capacity vertices. Clipping a convex polygon never fills the result, but
+// rounding can make a nearly degenerate polygon slightly non-convex, giving it extra crossings. They are dropped
+// rather than written past the end.
+void Append(Vector3 const & v, Vector3 * paResult, int * pn, int capacity)
+{
+    assert(*pn < capacity);
+    if (*pn < capacity)
+        paResult[(*pn)++] = v;
+}
+
+// Clips a polygon against one plane, keeping the part behind it, and returns the number of vertices in the result.
+// paResult has room for capacity vertices and must not overlap paVertices.
+int ClipBehind(Vector3 const * paVertices, int nVertices, Plane const & plane, Vector3 * paResult, int capacity)
+{
+    if (nVertices == 0)
+        return 0;
+
+    int             n  = 0;
+    Vector3 const * a  = &paVertices[nVertices - 1];
+    float           da = DistanceTo(plane, *a);
+
+    for (int i = 0; i < nVertices; ++i)
+    {
+        Vector3 const & b  = paVertices[i];
+        float const     db = DistanceTo(plane, b);
+
+        if (db <= 0.0f)
+        {
+            // If b is in the plane, the crossing is b itself.
+
+            if (da > 0.0f && db < 0.0f)
+                Append(Crossing(*a, b, da, db), paResult, &n, capacity);
+            Append(b, paResult, &n, capacity);
+        }
+        else if (da < 0.0f)
+        {
+            Append(Crossing(*a, b, da, db), paResult, &n, capacity);
+        }
+
+        a  = &b;
+        da = db;
+    }
+
+    return (n >= MIN_VERTICES) ? n : 0;
+}
+
+// Computes which sides of a frustum have any vertices in front of them (pAnyOutside) and which have all of them in
+// front (pAllOutside), as bit masks indexed by side.
+void ClassifyVertices(Vector3 const * paVertices, int nVertices, Frustum const & frustum,
+                      int * pAnyOutside, int * pAllOutside)
+{
+    int const ALL_SIDES = (1 << Frustum::NUM_SIDES) - 1;
+
+    int anyOutside = 0;
+    int allOutside = ALL_SIDES;
+    int i          = 0;
+
+#if defined(__AVX2__)
+    static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be 3 packed floats");
+
+    // 8 vertices at a time: the coordinates are gathered and the distances to each side are computed together. The
+    // last group is padded by repeating the last vertex, which does not change the result.
+
+    __m256i const vIndex = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    __m256 const  vZero  = _mm256_setzero_ps();
+
+    for (; i < nVertices; i += 8)
+    {
+        __m256i index = _mm256_add_epi32(_mm256_set1_epi32(3 * i), vIndex);
+        index = _mm256_min_epi32(index, _mm256_set1_epi32(3 * (nVertices - 1)));
+
+        float const * const base = &paVertices[0].m_X;
+        __m256 const        x    = _mm256_i32gather_ps(base + 0, index, 4);
+        __m256 const        y    = _mm256_i32gather_ps(base + 1, index, 4);
+        __m256 const        z    = _mm256_i32gather_ps(base + 2, index, 4);
+
+        for (int s = 0; s < Frustum::NUM_SIDES; ++s)
+        {
+            Plane const & side = frustum.sides_[s];
+            __m256 const  d    = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(side.m_N.m_X)),
+                                                             _mm256_mul_ps(y, _mm256_set1_ps(side.m_N.m_Y))),
+                                               _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(side.m_N.m_Z)),
+                                                             _mm256_set1_ps(side.m_D)));
+            int const outside = _mm256_movemask_ps(_mm256_cmp_ps(d, vZero, _CMP_GT_OQ));
+
+            if (outside != 0)
+                anyOutside |= 1 << s;
+            if (outside != 0xff)
+                allOutside &= ~(1 << s);
+        }
+    }
+#else // defined(__AVX2__)
+    for (; i < nVertices; ++i)
+    {
+        for (int s = 0; s < Frustum::NUM_SIDES; ++s)
+        {
+            if (DistanceTo(frustum.sides_[s], paVertices[i]) > 0.0f)
+                anyOutside |= 1 << s;
+            else
+                allOutside &= ~(1 << s);
+        }
+    }
+#endif // defined(__AVX2__)
+
+    *pAnyOutside = anyOutside;
+    *pAllOutside = (nVertices > 0) ? allOutside : 0;
+}
+
+// Clips a polygon against the sides of a frustum given by a mask and returns the number of vertices in the result.
+// The result is in paResult. paResult and paScratch have room for nVertices + Frustum::NUM_SIDES vertices.
+int ClipSides(Vector3 const * paVertices, int nVertices, Frustum const & frustum, int sides,
+              Vector3 * paResult, Vector3 * paScratch)
+{
+    int const capacity = nVertices + Frustum::NUM_SIDES;
+
+    // The results alternate between the two buffers, arranged so that the last one is written to paResult.
+
+    int count = 0;
+    for (int s = 0; s < Frustum::NUM_SIDES; ++s)
+    {
+        if (sides & (1 << s))
+            ++count;
+    }
+
+    Vector3 const * pIn  = paVertices;
+    int             n    = nVertices;
+    Vector3 *       pOut = (count % 2 == 0) ? paScratch : paResult;
+
+    for (int s = 0; s < Frustum::NUM_SIDES && n > 0; ++s)
+    {
+        if ((sides & (1 << s)) == 0)
+            continue;
+
+        n    = ClipBehind(pIn, n, frustum.sides_[s], pOut, capacity);
+        pIn  = pOut;
+        pOut = (pOut == paResult) ? paScratch : paResult;
+    }
+
+    if (n > 0 && pIn != paResult)
+        std::copy(pIn, pIn + n, paResult);
+
+    return n;
+}
+} // anonymous namespace
+
+namespace MyMath
+{
+//! @param	paVertices	Vertices of a convex polygon
+//! @param	nVertices	Number of vertices
+//! @param	halfspace	Half-space
+//! @param	paResult	Where to store the vertices of the result. There must be room for @a nVertices + 1 vertices,
+//!						and it must not overlap @a paVertices.
+
+int Clip(Vector3 const * paVertices, int nVertices, HalfSpace const & halfspace, Vector3 * paResult)
+{
+    return ClipBehind(paVertices, nVertices, halfspace.m_Plane, paResult, nVertices + 1);
+}
+
+//! @param	paVertices	Vertices of a convex polygon
+//! @param	nVertices	Number of vertices
+//! @param	plane		Plane
+//! @param	paFront		Where to store the vertices of the part in front of the plane. There must be room for
+//!						@a nVertices + 1 vertices.
+//! @param	pnFront		Where to store the number of vertices in front of the plane
+//! @param	paBack		Where to store the vertices of the part behind the plane. There must be room for
+//!						@a nVertices + 1 vertices.
+//! @param	pnBack		Where to store the number of vertices behind the plane
+//!
+//! Vertices in the plane are included in both parts.
+
+void Split(Vector3 const * paVertices, int nVertices, Plane const & plane,
+           Vector3 * paFront, int * pnFront, Vector3 * paBack, int * pnBack)
+{
+    int const capacity = nVertices + 1;
+    int       nFront   = 0;
+    int       nBack    = 0;
+
+    if (nVertices > 0)
+    {
+        Vector3 const * a  = &paVertices[nVertices - 1];
+        float           da = DistanceTo(plane, *a);
+
+        for (int i = 0; i < nVertices; ++i)
+        {
+            Vector3 const & b  = paVertices[i];
+            float const     db = DistanceTo(plane, b);
+
+            if ((da > 0.0f && db < 0.0f) || (da < 0.0f && db > 0.0f))
+            {
+                Vector3 const p = Crossing(*a, b, da, db);
+                Append(p, paFront, &nFront, capacity);
+                Append(p, paBack, &nBack, capacity);
+            }
+            if (db >= 0.0f)
+                Append(b, paFront, &nFront, capacity);
+            if (db <= 0.0f)
+                Append(b, paBack, &nBack, capacity);
+
+            a  = &b;
+            da = db;
+        }
+    }
+
+    *pnFront = (nFront >= MIN_VERTICES) ? nFront : 0;
+    *pnBack  = (nBack >= MIN_VERTICES) ? nBack : 0;
+}
+
+//! @param	paVertices	Vertices of a convex polygon
+//! @param	nVertices	Number of vertices
+//! @param	frustum		Frustum
+//! @param	paResult	Where to store the vertices of the result. There must be room for
+//!						@a nVertices + Frustum::NUM_SIDES vertices.
+//! @param	paScratch	Temporary storage with room for @a nVertices + Frustum::NUM_SIDES vertices
+//!
+//! Only the sides that some vertex is in front of are clipped against.
+
+int Clip(Vector3 const * paVertices, int nVertices, Frustum const & frustum, Vector3 * paResult, Vector3 * paScratch)
+{
+    int anyOutside;
+    int allOutside;
+    ClassifyVertices(paVertices, nVertices, frustum, &anyOutside, &allOutside);
+
+    if (allOutside != 0 || nVertices < MIN_VERTICES)
+        return 0;
+
+    return ClipSides(paVertices, nVertices, frustum, anyOutside, paResult, paScratch);
+}
+
+//! @param	poly		Convex polygon
+//! @param	halfspace	Half-space
+//! @param	pResult		Where to store the result. It has the same plane as @a poly. It must not be @a poly.
+
+bool Clip(Poly const & poly, HalfSpace const & halfspace, Poly * pResult)
+{
+    assert(pResult != &poly);
+
+    pResult->Plane::operator =(poly);
+    pResult->Resize(poly.GetVertexCount() + 1);
+    pResult->Resize(Clip(poly.GetVertices(), poly.GetVertexCount(), halfspace, pResult->GetVertices()));
+
+    return pResult->GetVertexCount() > 0;
+}
+
+//! @param	poly	Convex polygon
+//! @param	plane	Plane
+//! @param	pFront	Where to store the part in front of the plane. It must not be @a poly.
+//! @param	pBack	Where to store the part behind the plane. It must not be @a poly.
+
+void Split(Poly const & poly, Plane const & plane, Poly * pFront, Poly * pBack)
+{
+    assert(pFront != &poly && pBack != &poly && pFront != pBack);
+
+    int nFront;
+    int nBack;
+
+    pFront->Plane::operator =(poly);
+    pBack->Plane::operator =(poly);
+    pFront->Resize(poly.GetVertexCount() + 1);
+    pBack->Resize(poly.GetVertexCount() + 1);
+    Split(poly.GetVertices(), poly.GetVertexCount(), plane,
+          pFront->GetVertices(), &nFront, pBack->GetVertices(), &nBack);
+    pFront->Resize(nFront);
+    pBack->Resize(nBack);
+}
+
+//! @param	poly		Convex polygon
+//! @param	frustum		Frustum
+//! @param	pResult		Where to store the result. It has the same plane as @a poly. It must not be @a poly.
+
+bool Clip(Poly const & poly, Frustum const & frustum, Poly * pResult)
+{
+    assert(pResult != &poly);
+
+    Poly scratch;
+    scratch.Resize(poly.GetVertexCount() + Frustum::NUM_SIDES);
+
+    pResult->Plane::operator =(poly);
+    pResult->Resize(poly.GetVertexCount() + Frustum::NUM_SIDES);
+    pResult->Resize(Clip(poly.GetVertices(), poly.GetVertexCount(), frustum,
+                         pResult->GetVertices(), scratch.GetVertices()));
+
+    return pResult->GetVertexCount() > 0;
+}
+
+//! @param	polys		Convex polygons
+//! @param	frustum		Frustum
+//! @param	pResult		Buffer to append the results to. It must not be @a polys.
+//!
+//! The vertices of each polygon are first classified against all the sides at once (8 vertices at a time with
+//! AVX2). Polygons entirely outside a side are dropped and polygons entirely inside are copied, so only polygons
+//! that cross the frustum's sides are clipped, and only against the sides they cross.
+
+void Clip(PolyBuffer const & polys, Frustum const & frustum, PolyBuffer * pResult)
+{
+    assert(pResult != &polys);
+
+    Poly result;
+    Poly scratch;
+
+    for (int i = 0; i < polys.Size(); ++i)
+    {
+        Vector3 const * const paVertices = polys.GetVertices(i);
+        int const             nVertices  = polys.GetVertexCount(i);
+
+        int anyOutside;
+        int allOutside;
+        ClassifyVertices(paVertices, nVertices, frustum, &anyOutside, &allOutside);
+
+        if (allOutside != 0 || nVertices < MIN_VERTICES)
+            continue;
+
+        if (anyOutside == 0)
+        {
+            pResult->PushBack(polys.GetPlane(i), paVertices, nVertices);
+            continue;
+        }
+
+        result.Resize(nVertices + Frustum::NUM_SIDES);
+        scratch.Resize(nVertices + Frustum::NUM_SIDES);
+
+        int const n = ClipSides(paVertices, nVertices, frustum, anyOutside,
+                                result.GetVertices(), scratch.GetVertices());
+        if (n > 0)
+            pResult->PushBack(polys.GetPlane(i), result.GetVertices(), n);
+    }
+}
+} // namespace MyMath
@@ -0,0 +1,580 @@
+#include "ClosestPoint.h"
+
+#include "Box.h"
+#include "Line.h"
+#include "SegmentSoA.h"
+#include "Sphere.h"
+#include "TriangleMesh.h"
+#include "Vector3SoA.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+// Squared lengths below this are treated as 0 (the segment is a point)
+float const DEGENERATE_LENGTH2 = 1.0e-12f;
+
+float Clamp01(float x)
+{
+    return std::min(std::max(x, 0.0f), 1.0f);
+}
+
+// Returns the point in the box [lo, hi] closest to a point
+Vector3 Clamp(Vector3 const & p, Vector3 const & lo, Vector3 const & hi)
+{
+    return Vector3(std::min(std::max(p.m_X, lo.m_X), hi.m_X),
+                   std::min(std::max(p.m_Y, lo.m_Y), hi.m_Y),
+                   std::min(std::max(p.m_Z, lo.m_Z), hi.m_Z));
+}
+
+#if defined(__AVX2__)
+// Stores the first n lanes of a group of results
+void StoreLanes(int n, float const * d, float const (*p)[8], float const (*q)[8],
+                float * paDistances, Vector3 * paP, Vector3 * paQ)
+{
+    for (int k = 0; k < n; ++k)
+    {
+        paDistances[k] = d[k];
+        if (paP)
+            paP[k] = Vector3(p[0][k], p[1][k], p[2][k]);
+        if (paQ)
+            paQ[k] = Vector3(q[0][k], q[1][k], q[2][k]);
+    }
+}
+
+__m256 Clamp01(__m256 x)
+{
+    return _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+
+// Returns 1 / x in lanes where x > DEGENERATE_LENGTH2, and 0 elsewhere
+__m256 SafeReciprocal(__m256 x)
+{
+    __m256 const valid = _mm256_cmp_ps(x, _mm256_set1_ps(DEGENERATE_LENGTH2), _CMP_GT_OQ);
+    return _mm256_and_ps(valid, _mm256_div_ps(_mm256_set1_ps(1.0f), x));
+}
+
+__m256 Length(__m256 x, __m256 y, __m256 z)
+{
+    return _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+}
+#endif // defined(__AVX2__)
+} // anonymous namespace
+
+namespace MyMath
+{
+//! @param	a	Segment
+//! @param	b	Segment
+//! @param	pA	Where to store the point on @a a
+//! @param	pB	Where to store the point on @a b
+//!
+//! @return		Distance between the segments
+//!
+//! If the segments are parallel, the point on @a a is the one nearest its start (Ericson, Real-Time Collision
+//! Detection, 5.1.9).
+
+float ClosestPoints(Segment const & a, Segment const & b, Vector3 * pA, Vector3 * pB)
+{
+    Vector3 const r  = a.m_B - b.m_B;
+    float const   aa = Dot(a.m_M, a.m_M);
+    float const   ee = Dot(b.m_M, b.m_M);
+    float const   f  = Dot(b.m_M, r);
+    float         s  = 0.0f;
+    float         t  = 0.0f;
+
+    if (aa <= DEGENERATE_LENGTH2)
+    {
+        if (ee > DEGENERATE_LENGTH2)
+            t = Clamp01(f / ee);
+    }
+    else
+    {
+        float const c = Dot(a.m_M, r);
+
+        if (ee <= DEGENERATE_LENGTH2)
+        {
+            s = Clamp01(-c / aa);
+        }
+        else
+        {
+            float const bb    = Dot(a.m_M, b.m_M);
+            float const denom = aa * ee - bb * bb;
+
+            if (denom != 0.0f)
+                s = Clamp01((bb * f - c * ee) / denom);
+
+            t = (bb * s + f) / ee;
+
+            if (t < 0.0f)
+            {
+                t = 0.0f;
+                s = Clamp01(-c / aa);
+            }
+            else if (t > 1.0f)
+            {
+                t = 1.0f;
+                s = Clamp01((bb - c) / aa);
+            }
+        }
+    }
+
+    *pA = a.m_B + a.m_M * s;
+    *pB = b.m_B + b.m_M * t;
+
+    return (*pA - *pB).Length();
+}
+
+//! @param	point	Point
+//! @param	aabox	Box
+//! @param	pPoint	Where to store the point in the box
+//!
+//! @return		Distance from the point to the box
+
+float ClosestPoints(Vector3 const & point, AABox const & aabox, Vector3 * pPoint)
+{
+    *pPoint = Clamp(point, aabox.m_Position, aabox.m_Position + aabox.m_Scale);
+
+    return (*pPoint - point).Length();
+}
+
+//! @param	point	Point
+//! @param	box		Box
+//! @param	pPoint	Where to store the point in the box
+//!
+//! @return		Distance from the point to the box
+
+float ClosestPoints(Vector3 const & point, Box const & box, Vector3 * pPoint)
+{
+    // Clamp the offset from the center along each axis to the half-extents. This form does not depend on the signs
+    // of the scale.
+
+    Vector3 const & h       = box.GetHalfExtents();
+    Vector3 const   d       = point - box.GetCenter();
+    Vector3         closest = box.GetCenter();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        float const t = std::min(std::max(Dot(d, box.GetAxis(i)), -h.m_V[i]), h.m_V[i]);
+        closest += box.GetAxis(i) * t;
+    }
+
+    *pPoint = closest;
+
+    return (*pPoint - point).Length();
+}
+
+//! @param	point	Point
+//! @param	v0		Vertex of the triangle
+//! @param	v1		Vertex of the triangle
+//! @param	v2		Vertex of the triangle
+//! @param	pPoint	Where to store the point on the triangle
+//!
+//! @return		Distance from the point to the triangle
+
+float ClosestPoints(Vector3 const & point, Vector3 const & v0, Vector3 const & v1, Vector3 const & v2,
+                    Vector3 * pPoint)
+{
+    *pPoint = ClosestPointOnTriangle(point, v0, v1, v2);
+
+    return (*pPoint - point).Length();
+}
+
+//! @param	segment		Segment
+//! @param	aabox		Box
+//! @param	pSegment	Where to store the point on the segment
+//! @param	pAABox		Where to store the point in the box
+//!
+//! @return		Distance between the segment and the box
+//!
+//! The squared distance from the box is a piecewise quadratic function of the segment's t, whose pieces are separated
+//! by the values of t where the segment crosses the planes of the box's faces. Between them, each coordinate is
+//! either inside the box's slab or clamped to the same face, so the minimum of each piece is found directly.
+
+float ClosestPoints(Segment const & segment, AABox const & aabox, Vector3 * pSegment, Vector3 * pAABox)
+{
+    Vector3 const lo = aabox.m_Position;
+    Vector3 const hi = aabox.m_Position + aabox.m_Scale;
+
+    float breaks[8];
+    int   nBreaks = 0;
+
+    breaks[nBreaks++] = 0.0f;
+    for (int k = 0; k < 3; ++k)
+    {
+        if (segment.m_M.m_V[k] != 0.0f)
+        {
+            float const t0 = (lo.m_V[k] - segment.m_B.m_V[k]) / segment.m_M.m_V[k];
+            float const t1 = (hi.m_V[k] - segment.m_B.m_V[k]) / segment.m_M.m_V[k];
+            if (t0 > 0.0f && t0 < 1.0f)
+                breaks[nBreaks++] = t0;
+            if (t1 > 0.0f && t1 < 1.0f)
+                breaks[nBreaks++] = t1;
+        }
+    }
+    breaks[nBreaks++] = 1.0f;
+
+    // Insertion sort, since there are at most 8 values
+
+    for (int i = 1; i < nBreaks; ++i)
+    {
+        float const t = breaks[i];
+        int         j = i;
+        for (; j > 0 && breaks[j - 1] > t; --j)
+        {
+            breaks[j] = breaks[j - 1];
+        }
+        breaks[j] = t;
+    }
+
+    float bestT  = 0.0f;
+    float bestD2 = std::numeric_limits<float>::infinity();
+
+    for (int i = 0; i + 1 < nBreaks; ++i)
+    {
+        // Find which faces the coordinates are clamped to in this piece and minimize the sum of their squares.
+
+        float const   middle = (breaks[i] + breaks[i + 1]) * 0.5f;
+        Vector3 const p      = segment.m_B + segment.m_M * middle;
+        float         num    = 0.0f;
+        float         den    = 0.0f;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            float face;
+            if (p.m_V[k] < lo.m_V[k])
+                face = lo.m_V[k];
+            else if (p.m_V[k] > hi.m_V[k])
+                face = hi.m_V[k];
+            else
+                continue;
+
+            num += segment.m_M.m_V[k] * (segment.m_B.m_V[k] - face);
+            den += segment.m_M.m_V[k] * segment.m_M.m_V[k];
+        }
+
+        float t = breaks[i];
+        if (den > 0.0f)
+            t = std::min(std::max(-num / den, breaks[i]), breaks[i + 1]);
+
+        Vector3 const q  = segment.m_B + segment.m_M * t;
+        float const   d2 = (Clamp(q, lo, hi) - q).Length2();
+        if (d2 < bestD2)
+        {
+            bestD2 = d2;
+            bestT  = t;
+        }
+    }
+
+    *pSegment = segment.m_B + segment.m_M * bestT;
+    *pAABox   = Clamp(*pSegment, lo, hi);
+
+    return std::sqrt(bestD2);
+}
+
+//! @param	sphere		Sphere
+//! @param	box			Box
+//! @param	pSphere		Where to store the point in the sphere
+//! @param	pBox		Where to store the point in the box
+//!
+//! @return		Distance between the sphere and the box
+
+float ClosestPoints(Sphere const & sphere, Box const & box, Vector3 * pSphere, Vector3 * pBox)
+{
+    float const d = ClosestPoints(sphere.m_C, box, pBox);
+
+    if (d <= sphere.m_R)
+    {
+        *pSphere = *pBox;
+        return 0.0f;
+    }
+
+    *pSphere = sphere.m_C + (*pBox - sphere.m_C) * (sphere.m_R / d);
+
+    return d - sphere.m_R;
+}
+
+//! @param	a	Box
+//! @param	b	Box
+//! @param	pA	Where to store the point in @a a
+//! @param	pB	Where to store the point in @a b
+//!
+//! @return		Distance between the boxes
+//!
+//! On each axis where the boxes overlap, the points are in the middle of the overlap.
+
+float ClosestPoints(AABox const & a, AABox const & b, Vector3 * pA, Vector3 * pB)
+{
+    for (int k = 0; k < 3; ++k)
+    {
+        float const aLo = a.m_Position.m_V[k];
+        float const aHi = a.m_Position.m_V[k] + a.m_Scale.m_V[k];
+        float const bLo = b.m_Position.m_V[k];
+        float const bHi = b.m_Position.m_V[k] + b.m_Scale.m_V[k];
+
+        if (aHi < bLo)
+        {
+            pA->m_V[k] = aHi;
+            pB->m_V[k] = bLo;
+        }
+        else if (bHi < aLo)
+        {
+            pA->m_V[k] = aLo;
+            pB->m_V[k] = bHi;
+        }
+        else
+        {
+            pA->m_V[k] = pB->m_V[k] = (std::max(aLo, bLo) + std::min(aHi, bHi)) * 0.5f;
+        }
+    }
+
+    return (*pA - *pB).Length();
+}
+
+//! @param	point		Point
+//! @param	minimums	Minimum corners of the boxes
+//! @param	maximums	Maximum corners of the boxes
+//! @param	paDistances	Where to store the distances from the point to the boxes
+//! @param	paPoints	Where to store the points in the boxes (or nullptr)
+
+void ClosestPoints(Vector3 const & point, Vector3SoA const & minimums, Vector3SoA const & maximums,
+                   float * paDistances, Vector3 * paPoints)
+{
+    assert(minimums.Size() == maximums.Size());
+
+    int const n = int(minimums.Size());
+
+#if defined(__AVX2__)
+    float const * const loX = minimums.GetX();
+    float const * const loY = minimums.GetY();
+    float const * const loZ = minimums.GetZ();
+    float const * const hiX = maximums.GetX();
+    float const * const hiY = maximums.GetY();
+    float const * const hiZ = maximums.GetZ();
+    __m256 const        pX  = _mm256_set1_ps(point.m_X);
+    __m256 const        pY  = _mm256_set1_ps(point.m_Y);
+    __m256 const        pZ  = _mm256_set1_ps(point.m_Z);
+
+    for (int i = 0; i < n; i += 8)
+    {
+        __m256 const qX = _mm256_min_ps(_mm256_max_ps(pX, _mm256_load_ps(loX + i)), _mm256_load_ps(hiX + i));
+        __m256 const qY = _mm256_min_ps(_mm256_max_ps(pY, _mm256_load_ps(loY + i)), _mm256_load_ps(hiY + i));
+        __m256 const qZ = _mm256_min_ps(_mm256_max_ps(pZ, _mm256_load_ps(loZ + i)), _mm256_load_ps(hiZ + i));
+
+        alignas(32) float d[8];
+        alignas(32) float q[3][8];
+        _mm256_store_ps(d, Length(_mm256_sub_ps(qX, pX), _mm256_sub_ps(qY, pY), _mm256_sub_ps(qZ, pZ)));
+        _mm256_store_ps(q[0], qX);
+        _mm256_store_ps(q[1], qY);
+        _mm256_store_ps(q[2], qZ);
+
+        StoreLanes(std::min(8, n - i), d, q, q, paDistances + i, paPoints ? paPoints + i : nullptr, nullptr);
+    }
+#else // defined(__AVX2__)
+    for (int i = 0; i < n; ++i)
+    {
+        Vector3 const q = Clamp(point, minimums[i], maximums[i]);
+
+        paDistances[i] = (q - point).Length();
+        if (paPoints)
+            paPoints[i] = q;
+    }
+#endif // defined(__AVX2__)
+}
+
+//! @param	point		Point
+//! @param	segments	Segments
+//! @param	paDistances	Where to store the distances from the point to the segments
+//! @param	paPoints	Where to store the points on the segments (or nullptr)
+
+void ClosestPoints(Vector3 const & point, SegmentSoA const & segments, float * paDistances, Vector3 * paPoints)
+{
+    int const n = int(segments.Size());
+
+#if defined(__AVX2__)
+    float const * const bX = segments.GetStream(SegmentSoA::B_X);
+    float const * const bY = segments.GetStream(SegmentSoA::B_Y);
+    float const * const bZ = segments.GetStream(SegmentSoA::B_Z);
+    float const * const mX = segments.GetStream(SegmentSoA::M_X);
+    float const * const mY = segments.GetStream(SegmentSoA::M_Y);
+    float const * const mZ = segments.GetStream(SegmentSoA::M_Z);
+    __m256 const        pX = _mm256_set1_ps(point.m_X);
+    __m256 const        pY = _mm256_set1_ps(point.m_Y);
+    __m256 const        pZ = _mm256_set1_ps(point.m_Z);
+
+    for (int i = 0; i < n; i += 8)
+    {
+        __m256 const sBX = _mm256_load_ps(bX + i);
+        __m256 const sBY = _mm256_load_ps(bY + i);
+        __m256 const sBZ = _mm256_load_ps(bZ + i);
+        __m256 const sMX = _mm256_load_ps(mX + i);
+        __m256 const sMY = _mm256_load_ps(mY + i);
+        __m256 const sMZ = _mm256_load_ps(mZ + i);
+
+        // t = clamp((p - B) . M / M . M)
+
+        __m256 const mm = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sMX, sMX), _mm256_mul_ps(sMY, sMY)),
+                                        _mm256_mul_ps(sMZ, sMZ));
+        __m256 const pm = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(pX, sBX), sMX),
+                                                      _mm256_mul_ps(_mm256_sub_ps(pY, sBY), sMY)),
+                                        _mm256_mul_ps(_mm256_sub_ps(pZ, sBZ), sMZ));
+        __m256 const t  = Clamp01(_mm256_mul_ps(pm, SafeReciprocal(mm)));
+
+        __m256 const qX = _mm256_add_ps(sBX, _mm256_mul_ps(sMX, t));
+        __m256 const qY = _mm256_add_ps(sBY, _mm256_mul_ps(sMY, t));
+        __m256 const qZ = _mm256_add_ps(sBZ, _mm256_mul_ps(sMZ, t));
+
+        alignas(32) float d[8];
+        alignas(32) float q[3][8];
+        _mm256_store_ps(d, Length(_mm256_sub_ps(qX, pX), _mm256_sub_ps(qY, pY), _mm256_sub_ps(qZ, pZ)));
+        _mm256_store_ps(q[0], qX);
+        _mm256_store_ps(q[1], qY);
+        _mm256_store_ps(q[2], qZ);
+
+        StoreLanes(std::min(8, n - i), d, q, q, paDistances + i, paPoints ? paPoints + i : nullptr, nullptr);
+    }
+#else // defined(__AVX2__)
+    for (int i = 0; i < n; ++i)
+    {
+        Segment const segment = segments[i];
+        float const   mm      = Dot(segment.m_M, segment.m_M);
+        float const   t       = (mm > DEGENERATE_LENGTH2) ? Clamp01(Dot(point - segment.m_B, segment.m_M) / mm) : 0.0f;
+        Vector3 const q       = segment.m_B + segment.m_M * t;
+
+        paDistances[i] = (q - point).Length();
+        if (paPoints)
+            paPoints[i] = q;
+    }
+#endif // defined(__AVX2__)
+}
+
+//! @param	segment		Segment
+//! @param	segments	Segments
+//! @param	paDistances	Where to store the distances from @a segment to the segments
+//! @param	paA			Where to store the points on @a segment (or nullptr)
+//! @param	paB			Where to store the points on the segments (or nullptr)
+//!
+//! The results are the same as ClosestPoints(Segment const &, Segment const &, Vector3 *, Vector3 *). With AVX2, the
+//! cases of that function are computed for 8 segments at a time and selected per lane.
+
+void ClosestPoints(Segment const & segment, SegmentSoA const & segments, float * paDistances, Vector3 * paA,
+                   Vector3 * paB)
+{
+    int const n = int(segments.Size());
+
+#if defined(__AVX2__)
+    float const * const bX = segments.GetStream(SegmentSoA::B_X);
+    float const * const bY = segments.GetStream(SegmentSoA::B_Y);
+    float const * const bZ = segments.GetStream(SegmentSoA::B_Z);
+    float const * const mX = segments.GetStream(SegmentSoA::M_X);
+    float const * const mY = segments.GetStream(SegmentSoA::M_Y);
+    float const * const mZ = segments.GetStream(SegmentSoA::M_Z);
+
+    float const  aa     = Dot(segment.m_M, segment.m_M);
+    bool const   pointA = aa <= DEGENERATE_LENGTH2;
+    __m256 const vZero  = _mm256_setzero_ps();
+    __m256 const vOne   = _mm256_set1_ps(1.0f);
+    __m256 const vInvA  = _mm256_set1_ps(pointA ? 0.0f : 1.0f / aa);
+    __m256 const vAA    = _mm256_set1_ps(aa);
+    __m256 const aBX    = _mm256_set1_ps(segment.m_B.m_X);
+    __m256 const aBY    = _mm256_set1_ps(segment.m_B.m_Y);
+    __m256 const aBZ    = _mm256_set1_ps(segment.m_B.m_Z);
+    __m256 const aMX    = _mm256_set1_ps(segment.m_M.m_X);
+    __m256 const aMY    = _mm256_set1_ps(segment.m_M.m_Y);
+    __m256 const aMZ    = _mm256_set1_ps(segment.m_M.m_Z);
+
+    for (int i = 0; i < n; i += 8)
+    {
+        __m256 const sBX = _mm256_load_ps(bX + i);
+        __m256 const sBY = _mm256_load_ps(bY + i);
+        __m256 const sBZ = _mm256_load_ps(bZ + i);
+        __m256 const sMX = _mm256_load_ps(mX + i);
+        __m256 const sMY = _mm256_load_ps(mY + i);
+        __m256 const sMZ = _mm256_load_ps(mZ + i);
+        __m256 const rX  = _mm256_sub_ps(aBX, sBX);
+        __m256 const rY  = _mm256_sub_ps(aBY, sBY);
+        __m256 const rZ  = _mm256_sub_ps(aBZ, sBZ);
+
+        __m256 const ee   = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sMX, sMX), _mm256_mul_ps(sMY, sMY)),
+                                          _mm256_mul_ps(sMZ, sMZ));
+        __m256 const f    = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sMX, rX), _mm256_mul_ps(sMY, rY)),
+                                          _mm256_mul_ps(sMZ, rZ));
+        __m256 const invE = SafeReciprocal(ee);
+
+        __m256 s;
+        __m256 t;
+
+        if (pointA)
+        {
+            s = vZero;
+            t = Clamp01(_mm256_mul_ps(f, invE));
+        }
+        else
+        {
+            __m256 const c     = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aMX, rX), _mm256_mul_ps(aMY, rY)),
+                                               _mm256_mul_ps(aMZ, rZ));
+            __m256 const bb    = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aMX, sMX), _mm256_mul_ps(aMY, sMY)),
+                                               _mm256_mul_ps(aMZ, sMZ));
+            __m256 const denom = _mm256_sub_ps(_mm256_mul_ps(vAA, ee), _mm256_mul_ps(bb, bb));
+            __m256 const sC    = Clamp01(_mm256_mul_ps(_mm256_sub_ps(vZero, c), vInvA));    // s when t = 0
+            __m256 const sD    = Clamp01(_mm256_mul_ps(_mm256_sub_ps(bb, c), vInvA));       // s when t = 1
+
+            // General case, with s = 0 if the segments are parallel
+
+            __m256 const nonParallel = _mm256_cmp_ps(denom, vZero, _CMP_NEQ_OQ);
+            s = _mm256_and_ps(nonParallel,
+                              Clamp01(_mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(bb, f), _mm256_mul_ps(c, ee)), denom)));
+            t = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(bb, s), f), invE);
+
+            __m256 const below = _mm256_cmp_ps(t, vZero, _CMP_LT_OQ);
+            __m256 const above = _mm256_cmp_ps(t, vOne, _CMP_GT_OQ);
+            s = _mm256_blendv_ps(_mm256_blendv_ps(s, sD, above), sC, below);
+            t = Clamp01(t);
+
+            // Lanes whose segment is a point
+
+            __m256 const pointB = _mm256_cmp_ps(ee, _mm256_set1_ps(DEGENERATE_LENGTH2), _CMP_LE_OQ);
+            s = _mm256_blendv_ps(s, sC, pointB);
+            t = _mm256_blendv_ps(t, vZero, pointB);
+        }
+
+        __m256 const pX = _mm256_add_ps(aBX, _mm256_mul_ps(aMX, s));
+        __m256 const pY = _mm256_add_ps(aBY, _mm256_mul_ps(aMY, s));
+        __m256 const pZ = _mm256_add_ps(aBZ, _mm256_mul_ps(aMZ, s));
+        __m256 const qX = _mm256_add_ps(sBX, _mm256_mul_ps(sMX, t));
+        __m256 const qY = _mm256_add_ps(sBY, _mm256_mul_ps(sMY, t));
+        __m256 const qZ = _mm256_add_ps(sBZ, _mm256_mul_ps(sMZ, t));
+
+        alignas(32) float d[8];
+        alignas(32) float p[3][8];
+        alignas(32) float q[3][8];
+        _mm256_store_ps(d, Length(_mm256_sub_ps(qX, pX), _mm256_sub_ps(qY, pY), _mm256_sub_ps(qZ, pZ)));
+        _mm256_store_ps(p[0], pX);
+        _mm256_store_ps(p[1], pY);
+        _mm256_store_ps(p[2], pZ);
+        _mm256_store_ps(q[0], qX);
+        _mm256_store_ps(q[1], qY);
+        _mm256_store_ps(q[2], qZ);
+
+        StoreLanes(std::min(8, n - i), d, p, q, paDistances + i, paA ? paA + i : nullptr, paB ? paB + i : nullptr);
+    }
+#else // defined(__AVX2__)
+    for (int i = 0; i < n; ++i)
+    {
+        Vector3 a;
+        Vector3 b;
+
+        paDistances[i] = ClosestPoints(segment, segments[i], &a, &b);
+        if (paA)
+            paA[i] = a;
+        if (paB)
+            paB[i] = b;
+    }
+#endif // defined(__AVX2__)
+}
+} // namespace MyMath
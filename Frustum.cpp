@@ -1,6 +1,389 @@
 #include "Frustum.h"
 
+#include "Box.h"
+#include "Matrix44.h"
 #include "Plane.h"
+#include "Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+// Returns the point where three planes meet
+Vector3 Meet(Plane const & a, Plane const & b, Plane const & c)
+{
+    Vector3 const bc  = Cross(b.m_N, c.m_N);
+    float const   det = Dot(a.m_N, bc);
+
+    assert(!MyMath::IsCloseToZero(det));
+
+    return (bc * -a.m_D - Cross(c.m_N, a.m_N) * b.m_D - Cross(a.m_N, b.m_N) * c.m_D) * (1.0f / det);
+}
+
+// Returns the plane whose coefficients are a * column i + b * column w of a matrix
+Plane Side(Matrix44 const & m, int i, float a, float b)
+{
+    return Plane(a * m.m_M[0][i] + b * m.m_M[0][3],
+                 a * m.m_M[1][i] + b * m.m_M[1][3],
+                 a * m.m_M[2][i] + b * m.m_M[2][3],
+                 a * m.m_M[3][i] + b * m.m_M[3][3]);
+}
+
+int const NUM_EDGES    = 12;                // Number of edges of a frustum
+int const PADDED_EDGES = 16;                // Number of edges, rounded up to a multiple of 8
+int const NUM_AXES     = 3 * NUM_EDGES;     // Number of separating axes that are cross products of edges
+int const PADDED_AXES  = 40;                // Number of separating axes, rounded up to a multiple of 8
+
+// Values derived from a frustum that are used by the exact tests. They are computed once for each batch.
+struct ExactData
+{
+    // Edges: start point, direction and 1 / length^2 as x, y and z streams. The padding repeats the first edge.
+    alignas(32) float m_EdgeA[3][PADDED_EDGES];
+    alignas(32) float m_EdgeD[3][PADDED_EDGES];
+    alignas(32) float m_EdgeInvLength2[PADDED_EDGES];
+
+    // Corners as x, y and z streams
+    alignas(32) float m_Corners[3][Frustum::NUM_CORNERS];
+
+    // Dot products of the normals of the sides
+    float m_NormalDots[Frustum::NUM_SIDES][Frustum::NUM_SIDES];
+
+    // Cross products of the x, y and z axes with the edges, their absolute values, and the extents of the frustum
+    // along them. The padding is 0, which never separates anything.
+    alignas(32) float m_Axes[3][PADDED_AXES];
+    alignas(32) float m_AbsAxes[3][PADDED_AXES];
+    alignas(32) float m_AxisMin[PADDED_AXES];
+    alignas(32) float m_AxisMax[PADDED_AXES];
+
+    // Bounds of the frustum
+    Vector3 m_BoundsMin;
+    Vector3 m_BoundsMax;
+};
+
+// Computes the values used by the exact tests
+void Prepare(Frustum const & frustum, ExactData * pData)
+{
+    *pData = ExactData();
+
+    // Corners and bounds
+
+    pData->m_BoundsMin = frustum.GetCorner(0);
+    pData->m_BoundsMax = frustum.GetCorner(0);
+
+    for (int i = 0; i < Frustum::NUM_CORNERS; ++i)
+    {
+        Vector3 const & c = frustum.GetCorner(i);
+        for (int k = 0; k < 3; ++k)
+        {
+            pData->m_Corners[k][i]    = c.m_V[k];
+            pData->m_BoundsMin.m_V[k] = std::min(pData->m_BoundsMin.m_V[k], c.m_V[k]);
+            pData->m_BoundsMax.m_V[k] = std::max(pData->m_BoundsMax.m_V[k], c.m_V[k]);
+        }
+    }
+
+    // Each edge joins two corners whose indexes differ in one bit.
+
+    int e = 0;
+    for (int i = 0; i < Frustum::NUM_CORNERS; ++i)
+    {
+        for (int bit = 1; bit < Frustum::NUM_CORNERS; bit <<= 1)
+        {
+            if (i & bit)
+                continue;
+
+            Vector3 const & a      = frustum.GetCorner(i);
+            Vector3 const   d      = frustum.GetCorner(i | bit) - a;
+            float const     length = d.Length2();
+
+            for (int k = 0; k < 3; ++k)
+            {
+                pData->m_EdgeA[k][e] = a.m_V[k];
+                pData->m_EdgeD[k][e] = d.m_V[k];
+            }
+            pData->m_EdgeInvLength2[e] = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+            // Separating axes: the cross products of the edge with the x, y and z axes
+
+            Vector3 const axes[3] =
+            {
+                Vector3(0.0f, -d.m_Z, d.m_Y),
+                Vector3(d.m_Z, 0.0f, -d.m_X),
+                Vector3(-d.m_Y, d.m_X, 0.0f)
+            };
+
+            for (int j = 0; j < 3; ++j)
+            {
+                int const a3 = 3 * e + j;
+                float     lo = std::numeric_limits<float>::infinity();
+                float     hi = -std::numeric_limits<float>::infinity();
+
+                for (int c = 0; c < Frustum::NUM_CORNERS; ++c)
+                {
+                    float const x = Dot(axes[j], frustum.GetCorner(c));
+                    lo = std::min(lo, x);
+                    hi = std::max(hi, x);
+                }
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    pData->m_Axes[k][a3]    = axes[j].m_V[k];
+                    pData->m_AbsAxes[k][a3] = std::fabs(axes[j].m_V[k]);
+                }
+                pData->m_AxisMin[a3] = lo;
+                pData->m_AxisMax[a3] = hi;
+            }
+
+            ++e;
+        }
+    }
+    assert(e == NUM_EDGES);
+
+    for (int i = NUM_EDGES; i < PADDED_EDGES; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            pData->m_EdgeA[k][i] = pData->m_EdgeA[k][0];
+            pData->m_EdgeD[k][i] = pData->m_EdgeD[k][0];
+        }
+        pData->m_EdgeInvLength2[i] = pData->m_EdgeInvLength2[0];
+    }
+
+    for (int i = 0; i < Frustum::NUM_SIDES; ++i)
+    {
+        for (int j = 0; j < Frustum::NUM_SIDES; ++j)
+        {
+            pData->m_NormalDots[i][j] = Dot(frustum.sides_[i].m_N, frustum.sides_[j].m_N);
+        }
+    }
+}
+
+// Returns the squared distance from a point outside a frustum to the frustum. d contains the distances from the
+// sides to the point.
+float DistanceSquaredOutside(ExactData const & data, Vector3 const & p, float const d[Frustum::NUM_SIDES])
+{
+    float best = std::numeric_limits<float>::infinity();
+
+    // If the point's projection onto a side it is in front of is behind all the other sides, then the projection
+    // is on the face, and it is a candidate for the closest point.
+
+    for (int i = 0; i < Frustum::NUM_SIDES; ++i)
+    {
+        if (d[i] <= 0.0f)
+            continue;
+
+        bool onFace = true;
+        for (int j = 0; j < Frustum::NUM_SIDES && onFace; ++j)
+        {
+            if (j != i && d[j] - d[i] * data.m_NormalDots[i][j] > 0.0f)
+                onFace = false;
+        }
+
+        if (onFace)
+            best = std::min(best, d[i] * d[i]);
+    }
+
+    // The closest points on the edges (which include the corners)
+
+#if defined(__AVX2__)
+    __m256 const px   = _mm256_set1_ps(p.m_X);
+    __m256 const py   = _mm256_set1_ps(p.m_Y);
+    __m256 const pz   = _mm256_set1_ps(p.m_Z);
+    __m256 const zero = _mm256_setzero_ps();
+    __m256 const one  = _mm256_set1_ps(1.0f);
+    __m256       vMin = _mm256_set1_ps(best);
+
+    for (int i = 0; i < PADDED_EDGES; i += 8)
+    {
+        __m256 const wx = _mm256_sub_ps(px, _mm256_load_ps(&data.m_EdgeA[0][i]));
+        __m256 const wy = _mm256_sub_ps(py, _mm256_load_ps(&data.m_EdgeA[1][i]));
+        __m256 const wz = _mm256_sub_ps(pz, _mm256_load_ps(&data.m_EdgeA[2][i]));
+        __m256 const dx = _mm256_load_ps(&data.m_EdgeD[0][i]);
+        __m256 const dy = _mm256_load_ps(&data.m_EdgeD[1][i]);
+        __m256 const dz = _mm256_load_ps(&data.m_EdgeD[2][i]);
+
+        __m256 t = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(wx, dx), _mm256_mul_ps(wy, dy)), _mm256_mul_ps(wz, dz));
+        t = _mm256_mul_ps(t, _mm256_load_ps(&data.m_EdgeInvLength2[i]));
+        t = _mm256_min_ps(_mm256_max_ps(t, zero), one);
+
+        __m256 const qx = _mm256_sub_ps(wx, _mm256_mul_ps(dx, t));
+        __m256 const qy = _mm256_sub_ps(wy, _mm256_mul_ps(dy, t));
+        __m256 const qz = _mm256_sub_ps(wz, _mm256_mul_ps(dz, t));
+
+        __m256 const d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(qx, qx), _mm256_mul_ps(qy, qy)),
+                                        _mm256_mul_ps(qz, qz));
+        vMin = _mm256_min_ps(vMin, d2);
+    }
+
+    alignas(32) float mins[8];
+    _mm256_store_ps(mins, vMin);
+    best = *std::min_element(mins, mins + 8);
+#else // defined(__AVX2__)
+    for (int i = 0; i < NUM_EDGES; ++i)
+    {
+        Vector3 const w(p.m_X - data.m_EdgeA[0][i], p.m_Y - data.m_EdgeA[1][i], p.m_Z - data.m_EdgeA[2][i]);
+        Vector3 const e(data.m_EdgeD[0][i], data.m_EdgeD[1][i], data.m_EdgeD[2][i]);
+        float const   t = std::min(std::max(Dot(w, e) * data.m_EdgeInvLength2[i], 0.0f), 1.0f);
+
+        best = std::min(best, (w - e * t).Length2());
+    }
+#endif // defined(__AVX2__)
+
+    return best;
+}
+
+// Returns true if all the corners of a frustum are within a sphere
+bool Encloses(ExactData const & data, Vector3 const & c, float r)
+{
+    float const r2 = r * r;
+
+    for (int i = 0; i < Frustum::NUM_CORNERS; ++i)
+    {
+        float const dx = data.m_Corners[0][i] - c.m_X;
+        float const dy = data.m_Corners[1][i] - c.m_Y;
+        float const dz = data.m_Corners[2][i] - c.m_Z;
+        if (dx * dx + dy * dy + dz * dz > r2)
+            return false;
+    }
+
+    return true;
+}
+
+// Returns true if an axis separates a box and a frustum. The axes of the frustum's sides are not tested.
+bool Separated(ExactData const & data, Vector3 const & center, Vector3 const & halfSize)
+{
+    // The x, y and z axes
+
+    for (int k = 0; k < 3; ++k)
+    {
+        if (center.m_V[k] - halfSize.m_V[k] > data.m_BoundsMax.m_V[k] ||
+            center.m_V[k] + halfSize.m_V[k] < data.m_BoundsMin.m_V[k])
+        {
+            return true;
+        }
+    }
+
+    // The cross products of the x, y and z axes with the edges of the frustum
+
+#if defined(__AVX2__)
+    __m256 const cx = _mm256_set1_ps(center.m_X);
+    __m256 const cy = _mm256_set1_ps(center.m_Y);
+    __m256 const cz = _mm256_set1_ps(center.m_Z);
+    __m256 const ex = _mm256_set1_ps(halfSize.m_X);
+    __m256 const ey = _mm256_set1_ps(halfSize.m_Y);
+    __m256 const ez = _mm256_set1_ps(halfSize.m_Z);
+
+    for (int i = 0; i < PADDED_AXES; i += 8)
+    {
+        __m256 const c = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, _mm256_load_ps(&data.m_Axes[0][i])),
+                                                     _mm256_mul_ps(cy, _mm256_load_ps(&data.m_Axes[1][i]))),
+                                       _mm256_mul_ps(cz, _mm256_load_ps(&data.m_Axes[2][i])));
+        __m256 const r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_load_ps(&data.m_AbsAxes[0][i])),
+                                                     _mm256_mul_ps(ey, _mm256_load_ps(&data.m_AbsAxes[1][i]))),
+                                       _mm256_mul_ps(ez, _mm256_load_ps(&data.m_AbsAxes[2][i])));
+
+        __m256 const above = _mm256_cmp_ps(_mm256_sub_ps(c, r), _mm256_load_ps(&data.m_AxisMax[i]), _CMP_GT_OQ);
+        __m256 const below = _mm256_cmp_ps(_mm256_add_ps(c, r), _mm256_load_ps(&data.m_AxisMin[i]), _CMP_LT_OQ);
+
+        if (_mm256_movemask_ps(_mm256_or_ps(above, below)) != 0)
+            return true;
+    }
+#else // defined(__AVX2__)
+    for (int i = 0; i < NUM_AXES; ++i)
+    {
+        float const c = center.m_X * data.m_Axes[0][i] +
+                        center.m_Y * data.m_Axes[1][i] +
+                        center.m_Z * data.m_Axes[2][i];
+        float const r = halfSize.m_X * data.m_AbsAxes[0][i] +
+                        halfSize.m_Y * data.m_AbsAxes[1][i] +
+                        halfSize.m_Z * data.m_AbsAxes[2][i];
+
+        if (c - r > data.m_AxisMax[i] || c + r < data.m_AxisMin[i])
+            return true;
+    }
+#endif // defined(__AVX2__)
+
+    return false;
+}
+
+// Returns true if an axis separates an oriented box and a frustum. The axes of the frustum's sides are not tested.
+bool Separated(ExactData const & data, Box const & box)
+{
+    Vector3 const & center = box.GetCenter();
+    Vector3 const & h      = box.GetHalfExtents();
+
+    // Returns true if the projections of the box and the frustum onto an axis do not overlap. An axis of 0 (the
+    // cross product of parallel edges) never separates them.
+    auto const separates = [&](Vector3 const & axis)
+    {
+        float const c = Dot(center, axis);
+        float const r = h.m_X * std::fabs(Dot(box.GetAxis(0), axis)) +
+                        h.m_Y * std::fabs(Dot(box.GetAxis(1), axis)) +
+                        h.m_Z * std::fabs(Dot(box.GetAxis(2), axis));
+        float       lo = std::numeric_limits<float>::infinity();
+        float       hi = -std::numeric_limits<float>::infinity();
+
+        for (int i = 0; i < Frustum::NUM_CORNERS; ++i)
+        {
+            float const x = data.m_Corners[0][i] * axis.m_X +
+                            data.m_Corners[1][i] * axis.m_Y +
+                            data.m_Corners[2][i] * axis.m_Z;
+            lo = std::min(lo, x);
+            hi = std::max(hi, x);
+        }
+
+        return c - r > hi || c + r < lo;
+    };
+
+    // The axes of the box and their cross products with the edges of the frustum
+
+    for (int j = 0; j < 3; ++j)
+    {
+        if (separates(box.GetAxis(j)))
+            return true;
+    }
+
+    for (int e = 0; e < NUM_EDGES; ++e)
+    {
+        Vector3 const d(data.m_EdgeD[0][e], data.m_EdgeD[1][e], data.m_EdgeD[2][e]);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            if (separates(Cross(box.GetAxis(j), d)))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// Returns true if all the corners of a frustum are within an oriented box
+bool Encloses(ExactData const & data, Box const & box)
+{
+    Vector3 const & center = box.GetCenter();
+    Vector3 const & h      = box.GetHalfExtents();
+
+    for (int i = 0; i < Frustum::NUM_CORNERS; ++i)
+    {
+        Vector3 const d(data.m_Corners[0][i] - center.m_X,
+                        data.m_Corners[1][i] - center.m_Y,
+                        data.m_Corners[2][i] - center.m_Z);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            if (std::fabs(Dot(d, box.GetAxis(j))) > h.m_V[j])
+                return false;
+        }
+    }
+
+    return true;
+}
+} // anonymous namespace
 
 Frustum::Frustum(Plane const & left, Plane const & right,
                  Plane const & bottom, Plane const & top,
@@ -12,4 +395,230 @@ Frustum::Frustum(Plane const & left, Plane const & right,
     sides_[BOTTOM_SIDE] = bottom;
     sides_[FRONT_SIDE]  = n;
     sides_[BACK_SIDE]   = f;
+
+    Update();
+}
+
+//! @param	viewProjection	World-to-clip-space transformation (a row vector is transformed by v * M)
+//!
+//! The sides are extracted from the columns of the matrix and normalized (Gribb and Hartmann). Clip space is
+//! -w <= x <= w, -w <= y <= w and 0 <= z <= w, as in Direct3D.
+
+Frustum Frustum::FromViewProjection(Matrix44 const & viewProjection)
+{
+    Matrix44 const & m = viewProjection;
+
+    return Frustum(Side(m, 0, -1.0f, -1.0f),   // -x <= w
+                   Side(m, 0, 1.0f, -1.0f),    //  x <= w
+                   Side(m, 1, -1.0f, -1.0f),   // -y <= w
+                   Side(m, 1, 1.0f, -1.0f),    //  y <= w
+                   Side(m, 2, -1.0f, 0.0f),    //  z >= 0
+                   Side(m, 2, 1.0f, -1.0f));   //  z <= w
+}
+
+//! @param	fovY	Vertical field of view (radians)
+//! @param	aspect	Width / height
+//! @param	nearZ	Distance to the front side
+//! @param	farZ	Distance to the back side
+//!
+//! The view looks down the +Z axis with +Y up and +X to the right.
+
+Frustum Frustum::Perspective(float fovY, float aspect, float nearZ, float farZ)
+{
+    assert(fovY > 0.0f && aspect > 0.0f);
+    assert(nearZ >= 0.0f && farZ > nearZ);
+
+    float const tanY = std::tan(fovY * 0.5f);
+    float const tanX = tanY * aspect;
+
+    return Frustum(Plane(-1.0f, 0.0f, -tanX, 0.0f),
+                   Plane(1.0f, 0.0f, -tanX, 0.0f),
+                   Plane(0.0f, -1.0f, -tanY, 0.0f),
+                   Plane(0.0f, 1.0f, -tanY, 0.0f),
+                   Plane(0.0f, 0.0f, -1.0f, nearZ),
+                   Plane(0.0f, 0.0f, 1.0f, -farZ));
+}
+
+//! @param	width	Width of the view
+//! @param	height	Height of the view
+//! @param	nearZ	Distance to the front side
+//! @param	farZ	Distance to the back side
+//!
+//! The view is centered on the +Z axis with +Y up and +X to the right.
+
+Frustum Frustum::Orthographic(float width, float height, float nearZ, float farZ)
+{
+    assert(width > 0.0f && height > 0.0f);
+    assert(farZ > nearZ);
+
+    return Frustum(Plane(-1.0f, 0.0f, 0.0f, -0.5f * width),
+                   Plane(1.0f, 0.0f, 0.0f, -0.5f * width),
+                   Plane(0.0f, -1.0f, 0.0f, -0.5f * height),
+                   Plane(0.0f, 1.0f, 0.0f, -0.5f * height),
+                   Plane(0.0f, 0.0f, -1.0f, nearZ),
+                   Plane(0.0f, 0.0f, 1.0f, -farZ));
+}
+
+void Frustum::Update()
+{
+    for (int i = 0; i < NUM_SIDES; ++i)
+    {
+        Vector3 const & n = sides_[i].m_N;
+
+        m_AbsNormals[i]    = Vector3(std::fabs(n.m_X), std::fabs(n.m_Y), std::fabs(n.m_Z));
+        m_PositiveMasks[i] = ((n.m_X >= 0.0f) ? 1 : 0) | ((n.m_Y >= 0.0f) ? 2 : 0) | ((n.m_Z >= 0.0f) ? 4 : 0);
+    }
+
+    for (int i = 0; i < NUM_CORNERS; ++i)
+    {
+        m_Corners[i] = Meet(sides_[(i & RIGHT_CORNER) ? RIGHT_SIDE : LEFT_SIDE],
+                            sides_[(i & TOP_CORNER) ? TOP_SIDE : BOTTOM_SIDE],
+                            sides_[(i & BACK_CORNER) ? BACK_SIDE : FRONT_SIDE]);
+    }
+}
+
+namespace MyMath
+{
+//! @param	frustum		Frustum
+//! @param	paSpheres	Spheres
+//! @param	nSpheres	Number of spheres
+//! @param	paResults	Where to store the results
+//! @param	accuracy	CONSERVATIVE or EXACT
+//!
+//! Each sphere is first classified against the sides, as by Intersects(Sphere, Frustum). This is exact except for
+//! a sphere that crosses a side, which is INTERSECTS even if it is outside the frustum near an edge or corner, or
+//! encloses the frustum. In EXACT mode, these spheres are then classified by their distance from the frustum's
+//! faces and edges (8 edges at a time with AVX2) and by whether they contain the frustum's corners.
+
+void Classify(Frustum const & frustum, Sphere const * paSpheres, int nSpheres, Intersectable::Result * paResults,
+              Frustum::Accuracy accuracy)
+{
+    alignas(32) ExactData data;
+    bool prepared = false;
+
+    for (int i = 0; i < nSpheres; ++i)
+    {
+        Sphere const & sphere = paSpheres[i];
+        Intersectable::Result result = sphere.Intersects(frustum);
+
+        if (result == Intersectable::INTERSECTS && accuracy == Frustum::EXACT)
+        {
+            if (!prepared)
+            {
+                Prepare(frustum, &data);
+                prepared = true;
+            }
+
+            float d[Frustum::NUM_SIDES];
+            bool  outside = false;
+            for (int s = 0; s < Frustum::NUM_SIDES; ++s)
+            {
+                d[s] = frustum.sides_[s].DirectedDistance(sphere.m_C);
+                if (d[s] > 0.0f)
+                    outside = true;
+            }
+
+            if (outside && DistanceSquaredOutside(data, sphere.m_C, d) > sphere.m_R * sphere.m_R)
+                result = Intersectable::NO_INTERSECTION;
+            else if (Encloses(data, sphere.m_C, sphere.m_R))
+                result = Intersectable::ENCLOSES;
+        }
+
+        paResults[i] = result;
+    }
+}
+
+//! @param	frustum		Frustum
+//! @param	paBoxes		Boxes
+//! @param	nBoxes		Number of boxes
+//! @param	paResults	Where to store the results
+//! @param	accuracy	CONSERVATIVE or EXACT
+//!
+//! Each box is first classified against the sides, as by Intersects(AABox, Frustum). This is exact except for a box
+//! that crosses a side, which is INTERSECTS even if it is outside the frustum near an edge or corner, or encloses
+//! the frustum. In EXACT mode, the remaining separating axes (the x, y and z axes and their cross products with
+//! the frustum's edges, 8 at a time with AVX2) are tested for these boxes, and whether they contain the frustum's
+//! corners.
+
+void Classify(Frustum const & frustum, AABox const * paBoxes, int nBoxes, Intersectable::Result * paResults,
+              Frustum::Accuracy accuracy)
+{
+    alignas(32) ExactData data;
+    bool prepared = false;
+
+    for (int i = 0; i < nBoxes; ++i)
+    {
+        AABox const &         aabox  = paBoxes[i];
+        Intersectable::Result result = aabox.Intersects(frustum);
+
+        if (result == Intersectable::INTERSECTS && accuracy == Frustum::EXACT)
+        {
+            if (!prepared)
+            {
+                Prepare(frustum, &data);
+                prepared = true;
+            }
+
+            Vector3 const halfSize = aabox.m_Scale * 0.5f;
+            Vector3 const center   = aabox.m_Position + halfSize;
+
+            if (Separated(data, center, halfSize))
+            {
+                result = Intersectable::NO_INTERSECTION;
+            }
+            else
+            {
+                Vector3 const max = aabox.m_Position + aabox.m_Scale;
+                if (aabox.m_Position.m_X <= data.m_BoundsMin.m_X && data.m_BoundsMax.m_X <= max.m_X &&
+                    aabox.m_Position.m_Y <= data.m_BoundsMin.m_Y && data.m_BoundsMax.m_Y <= max.m_Y &&
+                    aabox.m_Position.m_Z <= data.m_BoundsMin.m_Z && data.m_BoundsMax.m_Z <= max.m_Z)
+                {
+                    result = Intersectable::ENCLOSES;
+                }
+            }
+        }
+
+        paResults[i] = result;
+    }
+}
+
+//! @param	frustum		Frustum
+//! @param	paBoxes		Boxes
+//! @param	nBoxes		Number of boxes
+//! @param	paResults	Where to store the results
+//! @param	accuracy	CONSERVATIVE or EXACT
+//!
+//! Each box is first classified against the sides, as by Intersects(Box, Frustum). As with axis-aligned boxes, a box
+//! that crosses a side is INTERSECTS even if it is outside the frustum near an edge or corner, or encloses the
+//! frustum. In EXACT mode, the remaining separating axes (the box's axes and their cross products with the
+//! frustum's edges) are tested for these boxes, and whether they contain the frustum's corners.
+
+void Classify(Frustum const & frustum, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults,
+              Frustum::Accuracy accuracy)
+{
+    alignas(32) ExactData data;
+    bool prepared = false;
+
+    for (int i = 0; i < nBoxes; ++i)
+    {
+        Box const &           box    = paBoxes[i];
+        Intersectable::Result result = box.Intersects(frustum);
+
+        if (result == Intersectable::INTERSECTS && accuracy == Frustum::EXACT)
+        {
+            if (!prepared)
+            {
+                Prepare(frustum, &data);
+                prepared = true;
+            }
+
+            if (Separated(data, box))
+                result = Intersectable::NO_INTERSECTION;
+            else if (Encloses(data, box))
+                result = Intersectable::ENCLOSES;
+        }
+
+        paResults[i] = result;
+    }
 }
+} // namespace MyMath
@@ -0,0 +1,93 @@
+#include "Grid2.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(__AVX2__)
+// Returns the offset of a coordinate in the data of a Grid2<float> along one axis:
+// (c >> TILE_SHIFT) * stride + (c & TILE_MASK) << shift
+__m256i Offset8(__m256i c, __m256i stride, int shift)
+{
+    __m256i const mask = _mm256_set1_epi32(Grid2<float>::TILE_MASK);
+
+    return _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(c, Grid2<float>::TILE_SHIFT), stride),
+                            _mm256_sll_epi32(_mm256_and_si256(c, mask), _mm_cvtsi32_si128(shift)));
+}
+
+// Returns a + (b - a) * t
+__m256 Lerp8(__m256 a, __m256 b, __m256 t)
+{
+    return _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+}
+#endif // defined(__AVX2__)
+} // anonymous namespace
+
+namespace MyMath
+{
+//! @param	grid	Grid
+//! @param	p		Points in grid coordinates. Points outside the grid are clamped to its edges,
+//!					and NaN coordinates are clamped to 0.
+//! @param	pR		Where to store the values
+//! @param	count	Number of points
+//!
+//! With AVX2, 8 points are processed at a time: the coordinates are gathered from the points, the offsets of the
+//! corners in the grid's data are computed separately for each axis and summed, and the corner values are gathered.
+
+void SampleBilinear(Grid2<float> const & grid, Vector2 const * p, float * pR, size_t count)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be 2 packed floats");
+
+    int const     strideY = grid.GetTilesX() * Grid2<float>::TILE_COUNT;
+    float const * data    = grid.GetData();
+
+    __m256i const vIndex   = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+    __m256i const vOne     = _mm256_set1_epi32(1);
+    __m256i const vStrideX = _mm256_set1_epi32(Grid2<float>::TILE_COUNT);
+    __m256i const vStrideY = _mm256_set1_epi32(strideY);
+    __m256i const vMaxX    = _mm256_set1_epi32(grid.GetSizeX() - 1);
+    __m256i const vMaxY    = _mm256_set1_epi32(grid.GetSizeY() - 1);
+    __m256 const  vZero    = _mm256_setzero_ps();
+    __m256 const  vLimitX  = _mm256_set1_ps(float(grid.GetSizeX() - 1));
+    __m256 const  vLimitY  = _mm256_set1_ps(float(grid.GetSizeY() - 1));
+
+    for (; i + 8 <= count; i += 8)
+    {
+        float const * const base = &p[i].m_X;
+
+        __m256 const x = _mm256_min_ps(_mm256_max_ps(_mm256_i32gather_ps(base + 0, vIndex, 4), vZero), vLimitX);
+        __m256 const y = _mm256_min_ps(_mm256_max_ps(_mm256_i32gather_ps(base + 1, vIndex, 4), vZero), vLimitY);
+
+        __m256i const x0 = _mm256_cvttps_epi32(x);
+        __m256i const y0 = _mm256_cvttps_epi32(y);
+        __m256i const x1 = _mm256_min_epi32(_mm256_add_epi32(x0, vOne), vMaxX);
+        __m256i const y1 = _mm256_min_epi32(_mm256_add_epi32(y0, vOne), vMaxY);
+
+        __m256 const fx = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+        __m256 const fy = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+
+        __m256i const ox0 = Offset8(x0, vStrideX, 0);
+        __m256i const ox1 = Offset8(x1, vStrideX, 0);
+        __m256i const oy0 = Offset8(y0, vStrideY, Grid2<float>::TILE_SHIFT);
+        __m256i const oy1 = Offset8(y1, vStrideY, Grid2<float>::TILE_SHIFT);
+
+        __m256 const z00 = _mm256_i32gather_ps(data, _mm256_add_epi32(ox0, oy0), 4);
+        __m256 const z01 = _mm256_i32gather_ps(data, _mm256_add_epi32(ox1, oy0), 4);
+        __m256 const z10 = _mm256_i32gather_ps(data, _mm256_add_epi32(ox0, oy1), 4);
+        __m256 const z11 = _mm256_i32gather_ps(data, _mm256_add_epi32(ox1, oy1), 4);
+
+        _mm256_storeu_ps(pR + i, Lerp8(Lerp8(z00, z01, fx), Lerp8(z10, z11, fx), fy));
+    }
+#endif // defined(__AVX2__)
+
+    for (; i < count; ++i)
+    {
+        pR[i] = SampleBilinear(grid, p[i]);
+    }
+}
+} // namespace MyMath
@@ -0,0 +1,306 @@
+#include "Instrumentation.h"
+
+#if MYMATH_INSTRUMENTATION
+
+#include "Misc/Assertx.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace
+{
+using namespace MyMath::Instrumentation;
+
+// The counters of one thread. Only the owning thread writes them, so the updates are relaxed loads and stores, which
+// other threads can read at any time.
+struct ThreadCounters
+{
+    ThreadCounters();
+    ~ThreadCounters();
+
+    std::atomic<uint64_t> m_Count[MAX_COUNTERS];
+    std::atomic<uint64_t> m_Cycles[MAX_COUNTERS];
+    std::atomic<uint64_t> m_Histogram[MAX_COUNTERS][NUM_BUCKETS];
+};
+
+// The names of the counters and the counters of all threads
+struct Registry
+{
+    std::mutex m_Mutex;
+    char const * m_Names[MAX_COUNTERS];
+    int m_nCounters = 0;
+    std::vector<ThreadCounters *> m_Threads;    // Counters of the running threads
+    Snapshot::Entry m_Retired[MAX_COUNTERS];    // Sums of the counters of the threads that have ended
+};
+
+Registry & GetRegistry()
+{
+    static Registry * const pRegistry = new Registry();   // Never destroyed, since threads may end after exit()
+    return *pRegistry;
+}
+
+ThreadCounters & GetThreadCounters()
+{
+    static thread_local ThreadCounters counters;
+    return counters;
+}
+
+void Increment(std::atomic<uint64_t> & counter, uint64_t n)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// Returns the histogram bucket of a number of cycles
+int GetBucket(uint64_t cycles)
+{
+    if (cycles == 0)
+        return 0;
+
+#if defined(_MSC_VER)
+    unsigned long bit;
+    _BitScanReverse64(&bit, cycles);
+    int const log2 = int(bit);
+#else
+    int const log2 = 63 - __builtin_clzll(cycles);
+#endif
+
+    return std::min(log2, NUM_BUCKETS - 1);
+}
+
+ThreadCounters::ThreadCounters()
+{
+    for (int i = 0; i < MAX_COUNTERS; ++i)
+    {
+        m_Count[i].store(0, std::memory_order_relaxed);
+        m_Cycles[i].store(0, std::memory_order_relaxed);
+        for (int b = 0; b < NUM_BUCKETS; ++b)
+        {
+            m_Histogram[i][b].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    Registry &                  registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+    registry.m_Threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters()
+{
+    // Keep the counts of the thread after it ends
+
+    Registry &                  registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+    for (int i = 0; i < registry.m_nCounters; ++i)
+    {
+        Snapshot::Entry & retired = registry.m_Retired[i];
+
+        retired.m_Count  += m_Count[i].load(std::memory_order_relaxed);
+        retired.m_Cycles += m_Cycles[i].load(std::memory_order_relaxed);
+        for (int b = 0; b < NUM_BUCKETS; ++b)
+        {
+            retired.m_Histogram[b] += m_Histogram[i][b].load(std::memory_order_relaxed);
+        }
+    }
+
+    registry.m_Threads.erase(std::find(registry.m_Threads.begin(), registry.m_Threads.end(), this));
+}
+
+// Adds the values of one entry to another
+void Add(Snapshot::Entry const & from, Snapshot::Entry * pTo)
+{
+    pTo->m_Count  += from.m_Count;
+    pTo->m_Cycles += from.m_Cycles;
+    for (int b = 0; b < NUM_BUCKETS; ++b)
+    {
+        pTo->m_Histogram[b] += from.m_Histogram[b];
+    }
+}
+
+// Writes a string as a JSON string, escaping quotes and backslashes
+void WriteJsonString(std::ostream & out, std::string const & s)
+{
+    out << '"';
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+} // anonymous namespace
+
+namespace MyMath
+{
+namespace Instrumentation
+{
+//! @param	name	Name of the counter. Counters with the same name are the same counter.
+//!
+//! @return		Id of the counter
+
+int Register(char const * name)
+{
+    Registry &                  registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+    for (int i = 0; i < registry.m_nCounters; ++i)
+    {
+        if (std::strcmp(registry.m_Names[i], name) == 0)
+            return i;
+    }
+
+    assert(registry.m_nCounters < MAX_COUNTERS);
+
+    int const id = registry.m_nCounters++;
+
+    registry.m_Names[id]   = name;
+    registry.m_Retired[id] = Snapshot::Entry{ name, 0, 0, {} };
+
+    return id;
+}
+
+//! @param	id	Id of the counter (see Register())
+
+void Count(int id)
+{
+    Increment(GetThreadCounters().m_Count[id], 1);
+}
+
+//! @param	id		Id of the counter (see Register())
+//! @param	cycles	Duration of the call
+
+void Count(int id, uint64_t cycles)
+{
+    ThreadCounters & counters = GetThreadCounters();
+
+    Increment(counters.m_Count[id], 1);
+    Increment(counters.m_Cycles[id], cycles);
+    Increment(counters.m_Histogram[id][GetBucket(cycles)], 1);
+}
+
+//! Where the time stamp counter is not available, nanoseconds are counted instead.
+
+uint64_t ReadCycles()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+//! The counts of the other threads are read while they may be changing, so the total is only as consistent as the
+//! moment it is read.
+
+Snapshot Snapshot::Take()
+{
+    Registry &                  registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+    Snapshot                    snapshot;
+
+    for (int i = 0; i < registry.m_nCounters; ++i)
+    {
+        Entry entry = registry.m_Retired[i];
+
+        for (ThreadCounters const * pThread : registry.m_Threads)
+        {
+            entry.m_Count  += pThread->m_Count[i].load(std::memory_order_relaxed);
+            entry.m_Cycles += pThread->m_Cycles[i].load(std::memory_order_relaxed);
+            for (int b = 0; b < NUM_BUCKETS; ++b)
+            {
+                entry.m_Histogram[b] += pThread->m_Histogram[i][b].load(std::memory_order_relaxed);
+            }
+        }
+
+        if (entry.m_Count > 0)
+            snapshot.m_Entries.push_back(entry);
+    }
+
+    return snapshot;
+}
+
+//! @param	other	Snapshot to add
+
+void Snapshot::Merge(Snapshot const & other)
+{
+    for (Entry const & from : other.m_Entries)
+    {
+        auto to = std::find_if(m_Entries.begin(), m_Entries.end(),
+                               [&from](Entry const & e) { return e.m_Name == from.m_Name; });
+        if (to != m_Entries.end())
+            Add(from, &*to);
+        else
+            m_Entries.push_back(from);
+    }
+}
+
+//! @param	out		Stream to write to
+//!
+//! Each object has the members "name", "count", "cycles" and "histogram" (an array of NUM_BUCKETS counts).
+
+void Snapshot::WriteJson(std::ostream & out) const
+{
+    out << "[\n";
+    for (size_t i = 0; i < m_Entries.size(); ++i)
+    {
+        Entry const & entry = m_Entries[i];
+
+        out << "  { \"name\": ";
+        WriteJsonString(out, entry.m_Name);
+        out << ", \"count\": " << entry.m_Count << ", \"cycles\": " << entry.m_Cycles << ", \"histogram\": [";
+        for (int b = 0; b < NUM_BUCKETS; ++b)
+        {
+            out << (b > 0 ? ", " : "") << entry.m_Histogram[b];
+        }
+        out << "] }" << (i + 1 < m_Entries.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+//! @param	out		Stream to write to
+//!
+//! The columns are name, count, cycles and one column per histogram bucket. Names are quoted.
+
+void Snapshot::WriteCsv(std::ostream & out) const
+{
+    out << "name,count,cycles";
+    for (int b = 0; b < NUM_BUCKETS; ++b)
+    {
+        out << ",bucket" << b;
+    }
+    out << '\n';
+
+    for (Entry const & entry : m_Entries)
+    {
+        out << '"';
+        for (char c : entry.m_Name)
+        {
+            out << c;
+            if (c == '"')
+                out << c;
+        }
+        out << "\"," << entry.m_Count << ',' << entry.m_Cycles;
+        for (int b = 0; b < NUM_BUCKETS; ++b)
+        {
+            out << ',' << entry.m_Histogram[b];
+        }
+        out << '\n';
+    }
+}
+} // namespace Instrumentation
+} // namespace MyMath
+
+#endif // MYMATH_INSTRUMENTATION
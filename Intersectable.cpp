@@ -1,21 +1,202 @@
 #include "Intersectable.h"
 
 #include "Box.h"
+#include "ClosestPoint.h"
 #include "Cone.h"
 #include "Frustum.h"
+#include "Instrumentation.h"
 #include "Line.h"
 #include "MyMath.h"
 #include "Plane.h"
 #include "Point.h"
+#include "SegmentSoA.h"
 #include "Sphere.h"
 
 #pragma warning( disable : 4100 )   // 'identifier' : unreferenced formal parameter
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+float const INFINITE_T = std::numeric_limits<float>::infinity();
+
+// Returns INTERSECTS if a ray is inside an axis-aligned box for some t in [tMin, tMax]
+Intersectable::Result SlabTest(RayPrecomputed const & ray, AABox const & aabox, float tMin, float tMax)
+{
+    Vector3 const bounds[2] = { aabox.m_Position, aabox.m_Position + aabox.m_Scale };
+    float         enter;
+    float         exit;
+
+    if (MyMath::IntersectSlabs(ray, bounds, tMin, tMax, &enter, &exit))
+        return Intersectable::INTERSECTS;
+    else
+        return Intersectable::NO_INTERSECTION;
+}
+
+// Returns INTERSECTS if the ray b + m * t is inside an oriented box for some t in [tMin, tMax]
+Intersectable::Result SlabTest(Vector3 const & m, Vector3 const & b, Box const & box, float tMin, float tMax)
+{
+    // Transform the ray into the box's space, relative to its center
+
+    Vector3 const & x = box.GetAxis(0);
+    Vector3 const & y = box.GetAxis(1);
+    Vector3 const & z = box.GetAxis(2);
+    Vector3 const   d = b - box.GetCenter();
+
+    RayPrecomputed const ray(Vector3(Dot(d, x), Dot(d, y), Dot(d, z)), Vector3(Dot(m, x), Dot(m, y), Dot(m, z)));
+    Vector3 const        bounds[2] = { -box.GetHalfExtents(), box.GetHalfExtents() };
+    float                enter;
+    float                exit;
+
+    if (MyMath::IntersectSlabs(ray, bounds, tMin, tMax, &enter, &exit))
+        return Intersectable::INTERSECTS;
+    else
+        return Intersectable::NO_INTERSECTION;
+}
+
+// Returns the class of intersection between a half-space and an axis-aligned box
+Intersectable::Result HalfSpaceAABoxTest(HalfSpace const & halfspace, AABox const & aabox)
+{
+    // from Moller, Thomas. Realtime Rendering, 2nd Ed., pp. 586-8
+    //
+    // The box intersects the plane if at least one of the vertexes of the box is not on the same side as the
+    // one of the others. An optimization is to test only two vertexes along the diagonal most closely aligned
+    // with the plane's normal.
+
+    Point p0;
+    Point p1;
+
+    // Find the diagonal of the box (with endpoints p0 and p1) most closely aligned with the plane's normal
+
+    if (halfspace.m_Plane.m_N.m_X >= 0.0f)
+    {
+        p0.value_.m_X = aabox.m_Position.m_X;
+        p1.value_.m_X = aabox.m_Position.m_X + aabox.m_Scale.m_X;
+    }
+    else
+    {
+        p0.value_.m_X = aabox.m_Position.m_X + aabox.m_Scale.m_X;
+        p1.value_.m_X = aabox.m_Position.m_X;
+    }
+
+    if (halfspace.m_Plane.m_N.m_Y >= 0.0f)
+    {
+        p0.value_.m_Y = aabox.m_Position.m_Y;
+        p1.value_.m_Y = aabox.m_Position.m_Y + aabox.m_Scale.m_Y;
+    }
+    else
+    {
+        p0.value_.m_Y = aabox.m_Position.m_Y + aabox.m_Scale.m_Y;
+        p1.value_.m_Y = aabox.m_Position.m_Y;
+    }
+
+    if (halfspace.m_Plane.m_N.m_Z >= 0.0f)
+    {
+        p0.value_.m_Z = aabox.m_Position.m_Z;
+        p1.value_.m_Z = aabox.m_Position.m_Z + aabox.m_Scale.m_Z;
+    }
+    else
+    {
+        p0.value_.m_Z = aabox.m_Position.m_Z + aabox.m_Scale.m_Z;
+        p1.value_.m_Z = aabox.m_Position.m_Z;
+    }
+
+    // If p0 is in front of the plane then the box is outside the half-space. If p1 is behind the plane then the
+    // box is enclosed by the half-space. Otherwise, the box intersects the plane. Other cases do not need to be
+    // considered because in the direction of the normal p1 is always greater than p0.
+
+    if (halfspace.m_Plane.DirectedDistance(p0) > 0.0f)
+        return Intersectable::NO_INTERSECTION;
+    else if (halfspace.m_Plane.DirectedDistance(p1) < 0.0f)
+        return Intersectable::ENCLOSES;
+    else
+        return Intersectable::INTERSECTS;
+}
+
+// Computes the parameters of the intersection of two lines and returns the number of intersections
+int LineLineIntersection(Line const & a, Line const & b, float * ps, float * pt)
+{
+    Vector3 const n  = Cross(a.m_M, b.m_M);
+    Vector3 const ab = b.m_B - a.m_B;
+
+    // If the lines are parallel, then there are either 0 or infinite intersections ...
+
+    if (MyMath::IsCloseToZero(n.Length2(), 2. * MyMath::DEFAULT_FLOAT_TOLERANCE))
+    {
+        float const d = Dot(ab, a.m_M);
+
+        if (MyMath::IsRelativelyCloseTo(ab.Length2(), d * d, 2. * MyMath::DEFAULT_FLOAT_TOLERANCE))
+            return std::numeric_limits<int>::max(); // Co-linear, return infinity
+        else
+            return 0;   // No intersection, return 0
+    }
+
+    // ... they are not parallel but if the distance between them is > 0 ...
+
+    else if (!MyMath::IsCloseToZero(Dot(n, ab)))
+    {
+        return 0;   // No intersection, return 0
+    }
+
+    // ... otherwise, they intersect at a single point ...
+
+    else
+    {
+        // Source: http://www.flipcode.com/geometry/gprimer2_issue02.shtml
+
+        // Use the minor with largest determinant to maintain precision and prevent divide-by-0
+
+        if (fabs(n.m_Z) > fabs(n.m_X)  &&  fabs(n.m_Z) > fabs(n.m_Y))
+        {
+            *ps =   (ab.m_X * b.m_M.m_Y - ab.m_Y * b.m_M.m_X) / n.m_Z;
+            *pt = -(ab.m_X * a.m_M.m_Y - ab.m_Y * a.m_M.m_X) / n.m_Z;
+        }
+        else if (fabs(n.m_X) > fabs(n.m_Y))
+        {
+            *ps =   (ab.m_Y * b.m_M.m_Z - ab.m_Z * b.m_M.m_Y) / n.m_X;
+            *pt = -(ab.m_Y * a.m_M.m_Z - ab.m_Z * a.m_M.m_Y) / n.m_X;
+        }
+        else
+        {
+            *ps =   (ab.m_Z * b.m_M.m_X - ab.m_X * b.m_M.m_Z) / n.m_Y;
+            *pt = -(ab.m_Z * a.m_M.m_X - ab.m_X * a.m_M.m_Z) / n.m_Y;
+        }
+
+        return 1;   // 1 intersection, return 1
+    }
+}
+
+// Computes the parameter of the intersection of a line and a plane and returns the number of intersections
+int LinePlaneIntersection(Line const & line, Plane const & plane, float * pt)
+{
+    float const dot      = Dot(line.m_M, plane.m_N);
+    float const distance = Distance(line.m_B, plane);
+
+    // If the line and the plane are parallel then there are 0 or > 1 intersections
+
+    if (MyMath::IsCloseToZero(dot))
+    {
+        if (MyMath::IsCloseToZero(distance))
+            return std::numeric_limits<int>::max(); // Line is co-planar
+        else
+            return 0;   // Line does not intersect
+    }
+
+    *pt = -distance / dot;
+
+    return 1;       // 1 intersection
+}
+} // anonymous namespace
+
 //! @param	a		The point to test.
 //! @param	b		The point to test.
 
 Intersectable::Result Intersectable::Intersects(Point const & a, Point const & b)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Point)");
+
     if (  MyMath::IsRelativelyCloseTo(a.value_.m_X, b.value_.m_X)
        && MyMath::IsRelativelyCloseTo(a.value_.m_Y, b.value_.m_Y)
        && MyMath::IsRelativelyCloseTo(a.value_.m_Z, b.value_.m_Z))
@@ -33,6 +214,8 @@ Intersectable::Result Intersectable::Intersects(Point const & a, Point const & b
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Line const & line)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Line)");
+
 //	// The point is on the line if the distance is close to 0
 //
 //	return MyMath::IsCloseToZero( line.Distance( point ) );
@@ -57,6 +240,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Line const
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Ray const & ray)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Ray)");
+
 //	// The point is on the line if the distance is close to 0
 //
 //	return MyMath::IsCloseToZero( ray.Distance( point ) );
@@ -82,6 +267,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Ray const &
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Segment const & segment)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Segment)");
+
 //	// The point is on the segment if the distance is close to 0
 //
 //	return MyMath::IsCloseToZero( segment.Distance( point ) );
@@ -109,6 +296,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Segment con
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Plane const & plane)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Plane)");
+
     if (MyMath::IsCloseToZero(Distance(point, plane)))
         return INTERSECTS;
     else
@@ -132,6 +321,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Poly const
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Sphere const & sphere)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Sphere)");
+
     float const d2 = (point.value_ - sphere.m_C).Length2();    // Distance from center to point squared
 
     if (d2 <= sphere.m_R * sphere.m_R)
@@ -147,6 +338,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Sphere cons
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Cone const & cone)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Cone)");
+
     Vector3 const p   = point.value_ - cone.m_V;
     float const   ddp = Dot(cone.m_D, p);
 
@@ -163,6 +356,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Cone const
 
 Intersectable::Result Intersectable::Intersects(Point const & point, AABox const & aabox)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, AABox)");
+
     Vector3 const xpoint = point.value_ - aabox.m_Position;
 
     if (  0 <= xpoint.m_X && xpoint.m_X <= aabox.m_Scale.m_X
@@ -182,16 +377,11 @@ Intersectable::Result Intersectable::Intersects(Point const & point, AABox const
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Box const & box)
 {
-    Vector3 const xpoint = box.m_InverseOrientation * (point.value_ - box.m_Position);
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Box)");
 
-    if (  0 <= xpoint.m_X && xpoint.m_X <= box.m_Scale.m_X
-       && 0 <= xpoint.m_Y && xpoint.m_Y <= box.m_Scale.m_Y
-       && 0 <= xpoint.m_Z && xpoint.m_Z <= box.m_Scale.m_Z)
-    {
-        return INTERSECTS;
-    }
-    else
-        return NO_INTERSECTION;
+    Result result;
+    MyMath::Classify(point, &box, 1, &result);
+    return result;
 }
 
 //! @param	point		The point to test
@@ -201,6 +391,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Box const &
 
 Intersectable::Result Intersectable::Intersects(Point const & point, Frustum const & frustum)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, Frustum)");
+
     for (auto const & side : frustum.sides_)
     {
         if (side.DirectedDistance(point) > 0.f)
@@ -217,6 +409,8 @@ Intersectable::Result Intersectable::Intersects(Point const & point, Frustum con
 
 Intersectable::Result Intersectable::Intersects(Line const & a, Line const & b)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Line, Line)");
+
     if (MyMath::IsCloseToZero(Distance(a, b)))
         return INTERSECTS;
     else
@@ -250,6 +444,8 @@ Intersectable::Result Intersectable::Intersects(Line const & line, Segment const
 
 Intersectable::Result Intersectable::Intersects(Line const & line, Plane const & plane)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Line, Plane)");
+
     if (!MyMath::IsCloseToZero(Dot(line.m_M, plane.m_N)))
         return INTERSECTS;
     else
@@ -273,6 +469,8 @@ Intersectable::Result Intersectable::Intersects(Line const & line, Poly const &
 
 Intersectable::Result Intersectable::Intersects(Line const & line, Sphere const & sphere)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Line, Sphere)");
+
     if (Distance(sphere.m_C, line) <= sphere.m_R)
         return INTERSECTS;
     else
@@ -296,96 +494,9 @@ Intersectable::Result Intersectable::Intersects(Line const & line, Cone const &
 
 Intersectable::Result Intersectable::Intersects(Line const & line, AABox const & aabox)
 {
-    Vector3 const box_max = aabox.m_Position + aabox.m_Scale;   // Convenience and speed
-
-    // If the line intersects the yz planes, check each plane to see if any intersection is within the box
-
-    if (!MyMath::IsCloseToZero(line.m_M.m_X))
-    {
-        // Check the min yz plane
-
-        float const umin = (aabox.m_Position.m_X - line.m_B.m_X) / line.m_M.m_X;
-        float const ymin = line.m_B.m_Y + umin * line.m_M.m_Y;
-        float const zmin = line.m_B.m_Z + umin * line.m_M.m_Z;
-
-        if (  ymin >= aabox.m_Position.m_Y && ymin <= box_max.m_Y
-           && zmin >= aabox.m_Position.m_Z && zmin <= box_max.m_Z)
-        {
-            return INTERSECTS;
-        }
-
-        // Check the max yz plane
-
-        float const umax = (box_max.m_X - line.m_B.m_X) / line.m_M.m_X;
-        float const ymax = line.m_B.m_Y + umax * line.m_M.m_Y;
-        float const zmax = line.m_B.m_Z + umax * line.m_M.m_Z;
-
-        if (  ymax >= aabox.m_Position.m_Y && ymax <= box_max.m_Y
-           && zmax >= aabox.m_Position.m_Z && zmax <= box_max.m_Z)
-        {
-            return INTERSECTS;
-        }
-    }
-
-    // If the line intersects the xz planes, check each plane to see if any intersection is within the box
-
-    if (!MyMath::IsCloseToZero(line.m_M.m_Y))
-    {
-        // Check the min xz plane
-
-        float const umin = (aabox.m_Position.m_Y - line.m_B.m_Y) / line.m_M.m_Y;
-        float const xmin = line.m_B.m_X + umin * line.m_M.m_X;
-        float const zmin = line.m_B.m_Z + umin * line.m_M.m_Z;
-
-        if (  xmin >= aabox.m_Position.m_X && xmin <= box_max.m_X
-           && zmin >= aabox.m_Position.m_Z && zmin <= box_max.m_Z)
-        {
-            return INTERSECTS;
-        }
-
-        // Check the max xz plane
-
-        float const umax = (box_max.m_Y - line.m_B.m_Y) / line.m_M.m_Y;
-        float const xmax = line.m_B.m_X + umax * line.m_M.m_X;
-        float const zmax = line.m_B.m_Z + umax * line.m_M.m_Z;
-
-        if (  xmax >= aabox.m_Position.m_X && xmax <= box_max.m_X
-           && zmax >= aabox.m_Position.m_Z && zmax <= box_max.m_Z)
-        {
-            return INTERSECTS;
-        }
-    }
-
-    // If the line intersects the xy planes, check each plane to see if any intersection is within the box
-
-    if (!MyMath::IsCloseToZero(line.m_M.m_Z))
-    {
-        // Check the min xy plane
+    MYMATH_INSTRUMENT_CALL("Intersects(Line, AABox)");
 
-        float const umin = (aabox.m_Position.m_Z - line.m_B.m_Z) / line.m_M.m_Z;
-        float const xmin = line.m_B.m_X + umin * line.m_M.m_X;
-        float const ymin = line.m_B.m_Y + umin * line.m_M.m_Y;
-
-        if (  xmin >= aabox.m_Position.m_X && xmin <= box_max.m_X
-           && ymin >= aabox.m_Position.m_Y && ymin <= box_max.m_Y)
-        {
-            return INTERSECTS;
-        }
-
-        // Check the max xy plane
-
-        float const umax = (box_max.m_Z - line.m_B.m_Z) / line.m_M.m_Z;
-        float const xmax = line.m_B.m_X + umax * line.m_M.m_X;
-        float const ymax = line.m_B.m_Y + umax * line.m_M.m_Y;
-
-        if (  xmax >= aabox.m_Position.m_X && xmax <= box_max.m_X
-           && ymax >= aabox.m_Position.m_Y && ymax <= box_max.m_Y)
-        {
-            return INTERSECTS;
-        }
-    }
-
-    return NO_INTERSECTION;
+    return SlabTest(RayPrecomputed(line), aabox, -INFINITE_T, INFINITE_T);
 }
 
 //! @param	line	The line to test
@@ -395,81 +506,9 @@ Intersectable::Result Intersectable::Intersects(Line const & line, AABox const &
 
 Intersectable::Result Intersectable::Intersects(Line const & line, Box const & box)
 {
-    // Transform the line into the box's space (except for scale)
-
-    Vector3 const tb = box.m_InverseOrientation * (line.m_B - box.m_Position);
-    Vector3 const tm = box.m_InverseOrientation * line.m_M;
-
-    // If the line intersects the yz planes, check each plane to see if any intersection is within the box
-
-    if (!MyMath::IsCloseToZero(tm.m_X))
-    {
-        // Check the min yz plane
-
-        float const umin = (0.f - tb.m_X) / tm.m_X;
-        float const ymin = tb.m_Y + umin * tm.m_Y;
-        float const zmin = tb.m_Z + umin * tm.m_Z;
-
-        if (ymin >= 0.f && ymin <= box.m_Scale.m_Y && zmin >= 0.f && zmin <= box.m_Scale.m_Z)
-            return INTERSECTS;
-
-        // Check the max yz plane
-
-        float const umax = (box.m_Scale.m_X - tb.m_X) / tm.m_X;
-        float const ymax = tb.m_Y + umax * tm.m_Y;
-        float const zmax = tb.m_Z + umax * tm.m_Z;
-
-        if (ymax >= 0.f && ymax <= box.m_Scale.m_Y && zmax >= 0.f && zmax <= box.m_Scale.m_Z)
-            return INTERSECTS;
-    }
-
-    // If the line intersects the xz planes, check each plane to see if any intersection is within the box
-
-    if (!MyMath::IsCloseToZero(tm.m_Y))
-    {
-        // Check the min xz plane
-
-        float const umin = (0.f - tb.m_Y) / tm.m_Y;
-        float const xmin = tb.m_X + umin * tm.m_X;
-        float const zmin = tb.m_Z + umin * tm.m_Z;
-
-        if (xmin >= 0.f && xmin <= box.m_Scale.m_X && zmin >= 0.f && zmin <= box.m_Scale.m_Z)
-            return INTERSECTS;
+    MYMATH_INSTRUMENT_CALL("Intersects(Line, Box)");
 
-        // Check the max xz plane
-
-        float const umax = (box.m_Scale.m_Y - tb.m_Y) / tm.m_Y;
-        float const xmax = tb.m_X + umax * tm.m_X;
-        float const zmax = tb.m_Z + umax * tm.m_Z;
-
-        if (xmax >= 0.f && xmax <= box.m_Scale.m_X && zmax >= 0.f && zmax <= box.m_Scale.m_Z)
-            return INTERSECTS;
-    }
-
-    // If the line intersects the xy planes, check each plane to see if any intersection is within the box
-
-    if (!MyMath::IsCloseToZero(tm.m_Z))
-    {
-        // Check the min xy plane
-
-        float const umin = (0.f - tb.m_Z) / tm.m_Z;
-        float const xmin = tb.m_X + umin * tm.m_X;
-        float const ymin = tb.m_Y + umin * tm.m_Y;
-
-        if (xmin >= 0.f && xmin <= box.m_Scale.m_X && ymin >= 0.f && ymin <= box.m_Scale.m_Y)
-            return INTERSECTS;
-
-        // Check the max xy plane
-
-        float const umax = (box.m_Scale.m_Z - tb.m_Z) / tm.m_Z;
-        float const xmax = tb.m_X + umax * tm.m_X;
-        float const ymax = tb.m_Y + umax * tm.m_Y;
-
-        if (xmax >= 0.f && xmax <= box.m_Scale.m_X && ymax >= 0.f && ymax <= box.m_Scale.m_Y)
-            return INTERSECTS;
-    }
-
-    return NO_INTERSECTION;
+    return SlabTest(line.m_M, line.m_B, box, -INFINITE_T, INFINITE_T);
 }
 
 //! @param	line		The line to test.
@@ -545,21 +584,25 @@ Intersectable::Result Intersectable::Intersects(Ray const & ray, Cone const & co
 //! @param	ray			The ray to test.
 //! @param	aabox		The AA box to test.
 //!
-//! @todo	Not implemented
+//! @return		Returns NO_INTERSECTION or INTERSECTS.
 
 Intersectable::Result Intersectable::Intersects(Ray const & ray, AABox const & aabox)
 {
-    return NO_INTERSECTION;
+    MYMATH_INSTRUMENT_CALL("Intersects(Ray, AABox)");
+
+    return SlabTest(RayPrecomputed(ray), aabox, 0.0f, INFINITE_T);
 }
 
 //! @param	ray		The ray to test.
 //! @param	box		The oriented box to test.
 //!
-//! @todo	Not implemented
+//! @return		Returns NO_INTERSECTION or INTERSECTS.
 
 Intersectable::Result Intersectable::Intersects(Ray const & ray, Box const & box)
 {
-    return NO_INTERSECTION;
+    MYMATH_INSTRUMENT_CALL("Intersects(Ray, Box)");
+
+    return SlabTest(ray.m_M, ray.m_B, box, 0.0f, INFINITE_T);
 }
 
 //! @param	ray			The ray to test.
@@ -579,10 +622,22 @@ Intersectable::Result Intersectable::Intersects(Ray const & ray, Frustum const &
 
 Intersectable::Result Intersectable::Intersects(Segment const & a, Segment const & b)
 {
-    // First of all, reject if the AABoxes don't intersect.
+    MYMATH_INSTRUMENT_CALL("Intersects(Segment, Segment)");
 
-    if (Intersectable::Intersects(AABox(a.m_B, a.m_M), AABox(b.m_B, b.m_M)) == NO_INTERSECTION)
-        return NO_INTERSECTION;
+    // First of all, reject if the bounding boxes don't intersect.
+
+    Vector3 const aE = a.m_B + a.m_M;
+    Vector3 const bE = b.m_B + b.m_M;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (  std::min(a.m_B.m_V[i], aE.m_V[i]) > std::max(b.m_B.m_V[i], bE.m_V[i])
+           || std::max(a.m_B.m_V[i], aE.m_V[i]) < std::min(b.m_B.m_V[i], bE.m_V[i]))
+        {
+            MYMATH_INSTRUMENT_EVENT("Intersects(Segment, Segment): bounds reject");
+            return NO_INTERSECTION;
+        }
+    }
 
 // The line segments a and b intersect if 0<=s<=1 and 0<=t<=1 when a.m_B + s * a.m_M == b.m_B + t * b.m_M.
 //
@@ -605,73 +660,20 @@ Intersectable::Result Intersectable::Intersects(Segment const & a, Segment const
 //
 // The segments intersect if sxy == sxz == syz and txy == txz == tyz, and 0<=s<=1 and 0<=t<=1, s = sxy and t = txy.
 //
-// Ideally only two of each of the three computations need to be checked, because the third is redundant. Rather
-// than just picking two, all three are checked and the segments are considered to intersect if two of the three
-// pass. Also, the division is never done -- it is integrated into the range test. These steps avoid precision
-// problems and divide-by-0 when one or both segments are (nearly) parallel to an axis.
-
-    Vector3 const c    = a.m_B - b.m_B;
-    int           pass = 0;         // Number of tests that pass
-
-    // Check if they intersect in the xy plane.
-
-    float const sxy = (c.m_X * b.m_M.m_Y - c.m_Y * b.m_M.m_X);
-    float const txy = (c.m_X * a.m_M.m_Y - c.m_Y * a.m_M.m_X);
-    float const dxy = b.m_M.m_X * a.m_M.m_Y - b.m_M.m_Y * a.m_M.m_X;
-
-    if (dxy > 0.f)
-    {
-        if (sxy >= 0.f && sxy <= dxy && txy >= 0 && txy <= dxy)
-            ++pass;
-    }
-    else
-    {
-        if (sxy <= 0.f && sxy >= dxy && txy <= 0 && txy >= dxy)
-            ++pass;
-    }
-
-    // Check if they intersect in the xz plane.
-
-    float const sxz = (c.m_X * b.m_M.m_Z - c.m_Z * b.m_M.m_X);
-    float const txz = (c.m_X * a.m_M.m_Z - c.m_Z * a.m_M.m_X);
-    float const dxz = b.m_M.m_X * a.m_M.m_Z - b.m_M.m_Z * a.m_M.m_X;
-
-    if (dxz > 0.f)
-    {
-        if (sxz >= 0.f && sxz <= dxz && txz >= 0 && txz <= dxz)
-            ++pass;
-    }
-    else
-    {
-        if (sxz <= 0.f && sxz >= dxz && txz <= 0 && txz >= dxz)
-            ++pass;
-    }
-
-    // Check if they intersect in the yz plane.
-    // The third test is needed only if one of the previous passed and one failed.
+// Only one of the three projections is needed to find s and t, if the segments are coplanar. The one with the
+// largest determinant is used, and the division is never done -- it is integrated into the range test. These steps
+// avoid precision problems and divide-by-0 when one or both segments are (nearly) parallel to an axis. Checking that
+// two of the three projections pass is not enough, since skew segments and segments in an axis-aligned plane can do
+// that without meeting. See MyMath::Intersect(Segment const &, Segment const &, float *, float *).
 
-    if (pass == 1)
-    {
-        float const syz = (c.m_Y * b.m_M.m_Z - c.m_Z * b.m_M.m_Y);
-        float const tyz = (c.m_Y * a.m_M.m_Z - c.m_Z * a.m_M.m_Y);
-        float const dyz = b.m_M.m_Y * a.m_M.m_Z - b.m_M.m_Z * a.m_M.m_Y;
-
-        if (dyz > 0.f)
-        {
-            if (syz >= 0.f && syz <= dyz && tyz >= 0 && tyz <= dyz)
-                ++pass;
-        }
-        else
-        {
-            if (syz <= 0.f && syz >= dyz && tyz <= 0 && tyz >= dyz)
-                ++pass;
-        }
-    }
+    float s;
+    float t;
 
-    if (pass >= 2)
+    if (MyMath::Intersect(a, b, &s, &t))
         return INTERSECTS;
-    else
-        return NO_INTERSECTION;
+
+    MYMATH_INSTRUMENT_EVENT("Intersects(Segment, Segment): projection reject");
+    return NO_INTERSECTION;
 }
 
 //! @param	segment	The line segment to test.
@@ -681,6 +683,8 @@ Intersectable::Result Intersectable::Intersects(Segment const & a, Segment const
 
 Intersectable::Result Intersectable::Intersects(Segment const & segment, Plane const & plane)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Segment, Plane)");
+
     float const da = plane.DirectedDistance(segment.m_B);
     float const db = plane.DirectedDistance(segment.m_B + segment.m_M);
     if (MyMath::IsCloseToZero(da) || MyMath::IsCloseToZero(db) || da * db < 0.f)
@@ -690,13 +694,20 @@ Intersectable::Result Intersectable::Intersects(Segment const & segment, Plane c
 }
 
 //! @param	segment	The line segment to test.
-//! @param	poly	The poly to test.
+//! @param	poly	The poly to test. It must be convex.
 //!
-//! @todo	Not implemented
+//! @return		Returns NO_INTERSECTION or INTERSECTS.
 
 Intersectable::Result Intersectable::Intersects(Segment const & segment, Poly const & poly)
 {
-    return NO_INTERSECTION;
+    MYMATH_INSTRUMENT_CALL("Intersects(Segment, Poly)");
+
+    float t;
+
+    if (MyMath::Intersect(segment, poly, poly.GetVertices(), poly.GetVertexCount(), &t))
+        return INTERSECTS;
+    else
+        return NO_INTERSECTION;
 }
 
 //! @param	segment	The line segment to test.
@@ -720,23 +731,27 @@ Intersectable::Result Intersectable::Intersects(Segment const & segment, Cone co
 }
 
 //! @param	segment	The line segment to test.
-//! @param	aabox	The line AA box to test.
+//! @param	aabox	The AA box to test.
 //!
-//! @todo	Not implemented
+//! @return		Returns NO_INTERSECTION or INTERSECTS.
 
 Intersectable::Result Intersectable::Intersects(Segment const & segment, AABox const & aabox)
 {
-    return NO_INTERSECTION;
+    MYMATH_INSTRUMENT_CALL("Intersects(Segment, AABox)");
+
+    return SlabTest(RayPrecomputed(segment), aabox, 0.0f, 1.0f);
 }
 
 //! @param	segment	The line segment to test.
 //! @param	box		The oriented box to test.
 //!
-//! @todo	Not implemented
+//! @return		Returns NO_INTERSECTION or INTERSECTS.
 
 Intersectable::Result Intersectable::Intersects(Segment const & segment, Box const & box)
 {
-    return NO_INTERSECTION;
+    MYMATH_INSTRUMENT_CALL("Intersects(Segment, Box)");
+
+    return SlabTest(segment.m_M, segment.m_B, box, 0.0f, 1.0f);
 }
 
 //! @param	segment	The line segment to test.
@@ -756,6 +771,8 @@ Intersectable::Result Intersectable::Intersects(Segment const & segment, Frustum
 
 Intersectable::Result Intersectable::Intersects(Plane const & a, Plane const & b)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Plane, Plane)");
+
     float const dot = Dot(a.m_N, b.m_N);
 
     if (!MyMath::IsCloseTo(fabsf(dot), 1.0))
@@ -781,6 +798,8 @@ Intersectable::Result Intersectable::Intersects(Plane const & plane, Poly const
 
 Intersectable::Result Intersectable::Intersects(Plane const & plane, Sphere const & sphere)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Plane, Sphere)");
+
     if (Distance(sphere.m_C, plane) <= sphere.m_R)
         return INTERSECTS;
     else
@@ -804,9 +823,11 @@ Intersectable::Result Intersectable::Intersects(Plane const & plane, Cone const
 
 Intersectable::Result Intersectable::Intersects(Plane const & plane, AABox const & aabox)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Plane, AABox)");
+
     HalfSpace const halfspace(plane);
 
-    if (Intersects(halfspace, aabox) == INTERSECTS)
+    if (HalfSpaceAABoxTest(halfspace, aabox) == INTERSECTS)
         return INTERSECTS;
     else
         return NO_INTERSECTION;
@@ -1003,6 +1024,8 @@ Intersectable::Result Intersectable::Intersects(Poly const & poly, Frustum const
 
 Intersectable::Result Intersectable::Intersects(Sphere const & a, Sphere const & b)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Sphere, Sphere)");
+
     float const dc2 = (a.m_C - b.m_C).Length2();
 
     if (dc2 <= (a.m_R + b.m_R) * (a.m_R + b.m_R))
@@ -1034,6 +1057,8 @@ Intersectable::Result Intersectable::Intersects(Sphere const & a, Sphere const &
 
 Intersectable::Result Intersectable::Intersects(Sphere const & sphere, Cone const & cone)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Sphere, Cone)");
+
     float const   c2   = cone.m_A * cone.m_A;
     Vector3 const v1   = sphere.m_C - cone.m_V;
     Vector3 const v2   = sqrtf(1.f - c2) * v1 + sphere.m_R * cone.m_D;
@@ -1064,11 +1089,15 @@ Intersectable::Result Intersectable::Intersects(Sphere const & sphere, AABox con
 //! @param	sphere	The sphere to test.
 //! @param	box		The oriented box to test.
 //!
-//! @todo	Not implemented
+//! @return		Returns NO_INTERSECTION, INTERSECTS, ENCLOSES, or ENCLOSED_BY.
 
 Intersectable::Result Intersectable::Intersects(Sphere const & sphere, Box const & box)
 {
-    return NO_INTERSECTION;
+    MYMATH_INSTRUMENT_CALL("Intersects(Sphere, Box)");
+
+    Result result;
+    MyMath::Classify(sphere, &box, 1, &result);
+    return result;
 }
 
 //! @param	sphere	The sphere to test.
@@ -1078,9 +1107,13 @@ Intersectable::Result Intersectable::Intersects(Sphere const & sphere, Box const
 //!
 //! @warning	This test returns false positives near the corners of the frustum.
 //! @warning	This function returns INTERSECTS when it should return ENCLOSES.
+//!
+//! @note	MyMath::Classify() with Frustum::EXACT refines the INTERSECTS results of this test.
 
 Intersectable::Result Intersectable::Intersects(Sphere const & sphere, Frustum const & frustum)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Sphere, Frustum)");
+
     Result intersection = ENCLOSED_BY;
     for (auto const & side : frustum.sides_)
     {
@@ -1142,6 +1175,8 @@ Intersectable::Result Intersectable::Intersects(Cone const & cone, Frustum const
 
 Intersectable::Result Intersectable::Intersects(AABox const & a, AABox const & b)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(AABox, AABox)");
+
     float const ax0 = a.m_Position.m_X;
     float const ay0 = a.m_Position.m_Y;
     float const az0 = a.m_Position.m_Z;
@@ -1193,23 +1228,38 @@ Intersectable::Result Intersectable::Intersects(AABox const & aabox, Box const &
 //! @return		Returns NO_INTERSECTION, INTERSECTS, or ENCLOSED_BY
 //!
 //! @warning	Returns INTERSECTS when it should return ENCLOSES.
+//! @warning	Returns false positives near the edges of the frustum.
+//!
+//! @note	MyMath::Classify() with Frustum::EXACT refines the INTERSECTS results of this test.
 
 Intersectable::Result Intersectable::Intersects(AABox const & aabox, Frustum const & frustum)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(AABox, Frustum)");
+
     // from Moller, Thomas. Realtime Rendering, 2nd Ed., pp. 612-3
     //
     // The box intersects the frustum if it is not in front of any of the planes of the frustum. The box is enclosed by the frustum
     // if none of its vertexes is in front of any of the planes
     // of the frustum.
+    //
+    // The distances from a plane to the vertexes of the box nearest and farthest along its normal are the distance
+    // to the center of the box minus and plus the projection of the half-size onto the absolute value of the normal,
+    // which the frustum caches.
+
+    Vector3 const halfSize = aabox.m_Scale * 0.5f;
+    Vector3 const center   = aabox.m_Position + halfSize;
 
     bool intersectsAnyPlane = false;
 
-    for (auto const & side : frustum.sides_)
+    for (int i = 0; i < Frustum::NUM_SIDES; ++i)
     {
-        Result ic = Intersects(HalfSpace(side), aabox);
-        if (ic == NO_INTERSECTION)
+        Plane const & side = frustum.sides_[i];
+        float const   d    = Dot(side.m_N, center) + side.m_D;
+        float const   r    = Dot(frustum.GetAbsNormal(i), halfSize);
+
+        if (d - r > 0.0f)
             return NO_INTERSECTION;
-        if (ic == INTERSECTS)
+        if (d + r >= 0.0f)
             intersectsAnyPlane = true;
     }
 
@@ -1235,11 +1285,41 @@ Intersectable::Result Intersectable::Intersects(Box const & a, Box const & b)
 //! @param	box			The oriented box to test.
 //! @param	frustum		The frustum to test.
 //!
-//! @todo	Not implemented
+//! @return		Returns NO_INTERSECTION, INTERSECTS or ENCLOSED_BY.
+//!
+//! @warning	This test returns false positives near the edges and corners of the frustum.
+//!
+//! @note	MyMath::Classify() with Frustum::EXACT refines the INTERSECTS results of this test.
 
 Intersectable::Result Intersectable::Intersects(Box const & box, Frustum const & frustum)
 {
-    return NO_INTERSECTION;
+    MYMATH_INSTRUMENT_CALL("Intersects(Box, Frustum)");
+
+    // As with an axis-aligned box, the distances from a plane to the vertexes of the box nearest and farthest along
+    // its normal are the distance to the center plus and minus the projection of the half-extents onto the normal.
+
+    Vector3 const & center = box.GetCenter();
+    Vector3 const & h      = box.GetHalfExtents();
+
+    bool intersectsAnyPlane = false;
+
+    for (auto const & side : frustum.sides_)
+    {
+        float const d = side.DirectedDistance(center);
+        float const r = h.m_X * std::fabs(Dot(side.m_N, box.GetAxis(0))) +
+                        h.m_Y * std::fabs(Dot(side.m_N, box.GetAxis(1))) +
+                        h.m_Z * std::fabs(Dot(side.m_N, box.GetAxis(2)));
+
+        if (d - r > 0.0f)
+            return NO_INTERSECTION;
+        if (d + r >= 0.0f)
+            intersectsAnyPlane = true;
+    }
+
+    if (intersectsAnyPlane)
+        return INTERSECTS;
+    else
+        return ENCLOSED_BY;
 }
 
 //! @param	a		The frustum to test.
@@ -1259,6 +1339,8 @@ Intersectable::Result Intersectable::Intersects(Frustum const & a, Frustum const
 
 Intersectable::Result Intersectable::Intersects(Point const & point, HalfSpace const & halfspace)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Point, HalfSpace)");
+
     if (halfspace.m_Plane.DirectedDistance(point) <= 0.0f)
         return INTERSECTS;
     else
@@ -1272,8 +1354,10 @@ Intersectable::Result Intersectable::Intersects(Point const & point, HalfSpace c
 
 Intersectable::Result Intersectable::Intersects(Line const & line, HalfSpace const & halfspace)
 {
+    MYMATH_INSTRUMENT_CALL("Intersects(Line, HalfSpace)");
+
     if (MyMath::IsCloseToZero(Dot(line.m_M, halfspace.m_Plane.m_N)))
-        return Intersects(Point(line.m_B), halfspace);
+        return halfspace.m_Plane.DirectedDistance(Point(line.m_B)) <= 0.0f ? INTERSECTS : NO_INTERSECTION;
     else
         return INTERSECTS;
 }
@@ -1355,60 +1439,9 @@ Intersectable::Result Intersectable::Intersects(HalfSpace const & halfspace, Con
 
 Intersectable::Result Intersectable::Intersects(HalfSpace const & halfspace, AABox const & aabox)
 {
-    // from Moller, Thomas. Realtime Rendering, 2nd Ed., pp. 586-8
-    //
-    // The box intersects the plane if at least one of the vertexes of the box is not on the same side as the
-    // one of the others. An optimization is to test only two vertexes along the diagonal most closely aligned
-    // with the plane's normal.
-
-    Point p0;
-    Point p1;
+    MYMATH_INSTRUMENT_CALL("Intersects(HalfSpace, AABox)");
 
-    // Find the diagonal of the box (with endpoints p0 and p1) most closely aligned with the plane's normal
-
-    if (halfspace.m_Plane.m_N.m_X >= 0.0f)
-    {
-        p0.value_.m_X = aabox.m_Position.m_X;
-        p1.value_.m_X = aabox.m_Position.m_X + aabox.m_Scale.m_X;
-    }
-    else
-    {
-        p0.value_.m_X = aabox.m_Position.m_X + aabox.m_Scale.m_X;
-        p1.value_.m_X = aabox.m_Position.m_X;
-    }
-
-    if (halfspace.m_Plane.m_N.m_Y >= 0.0f)
-    {
-        p0.value_.m_Y = aabox.m_Position.m_Y;
-        p1.value_.m_Y = aabox.m_Position.m_Y + aabox.m_Scale.m_Y;
-    }
-    else
-    {
-        p0.value_.m_Y = aabox.m_Position.m_Y + aabox.m_Scale.m_Y;
-        p1.value_.m_Y = aabox.m_Position.m_Y;
-    }
-
-    if (halfspace.m_Plane.m_N.m_Z >= 0.0f)
-    {
-        p0.value_.m_Z = aabox.m_Position.m_Z;
-        p1.value_.m_Z = aabox.m_Position.m_Z + aabox.m_Scale.m_Z;
-    }
-    else
-    {
-        p0.value_.m_Z = aabox.m_Position.m_Z + aabox.m_Scale.m_Z;
-        p1.value_.m_Z = aabox.m_Position.m_Z;
-    }
-
-    // If p0 is in front of the plane then the box is outside the half-space. If p1 is behind the plane then the
-    // box is enclosed by the half-space. Otherwise, the box intersects the plane. Other cases do not need to be
-    // considered because in the direction of the normal p1 is always greater than p0.
-
-    if (halfspace.m_Plane.DirectedDistance(p0) > 0.0f)
-        return NO_INTERSECTION;
-    else if (halfspace.m_Plane.DirectedDistance(p1) < 0.0f)
-        return ENCLOSES;
-    else
-        return INTERSECTS;
+    return HalfSpaceAABoxTest(halfspace, aabox);
 }
 
 //! @param	halfspace	halfspace to test
@@ -1440,54 +1473,9 @@ Intersectable::Result Intersectable::Intersects(HalfSpace const & halfspace, Fru
 
 int Intersectable::Intersection(Line const & a, Line const & b, float * ps, float * pt)
 {
-    Vector3 const n  = Cross(a.m_M, b.m_M);
-    Vector3 const ab = b.m_B - a.m_B;
-
-    // If the lines are parallel, then there are either 0 or infinite intersections ...
-
-    if (MyMath::IsCloseToZero(n.Length2(), 2. * MyMath::DEFAULT_FLOAT_TOLERANCE))
-    {
-        float const d = Dot(ab, a.m_M);
-
-        if (MyMath::IsRelativelyCloseTo(ab.Length2(), d * d, 2. * MyMath::DEFAULT_FLOAT_TOLERANCE))
-            return std::numeric_limits<int>::max(); // Co-linear, return infinity
-        else
-            return 0;   // No intersection, return 0
-    }
+    MYMATH_INSTRUMENT_CALL("Intersection(Line, Line)");
 
-    // ... they are not parallel but if the distance between them is > 0 ...
-
-    else if (!MyMath::IsCloseToZero(Dot(n, ab)))
-    {
-        return 0;   // No intersection, return 0
-    }
-
-    // ... otherwise, they intersect at a single point ...
-
-    else
-    {
-        // Source: http://www.flipcode.com/geometry/gprimer2_issue02.shtml
-
-        // Use the minor with largest determinant to maintain precision and prevent divide-by-0
-
-        if (fabs(n.m_Z) > fabs(n.m_X)  &&  fabs(n.m_Z) > fabs(n.m_Y))
-        {
-            *ps =   (ab.m_X * b.m_M.m_Y - ab.m_Y * b.m_M.m_X) / n.m_Z;
-            *pt = -(ab.m_X * a.m_M.m_Y - ab.m_Y * a.m_M.m_X) / n.m_Z;
-        }
-        else if (fabs(n.m_X) > fabs(n.m_Y))
-        {
-            *ps =   (ab.m_Y * b.m_M.m_Z - ab.m_Z * b.m_M.m_Y) / n.m_X;
-            *pt = -(ab.m_Y * a.m_M.m_Z - ab.m_Z * a.m_M.m_Y) / n.m_X;
-        }
-        else
-        {
-            *ps =   (ab.m_Z * b.m_M.m_X - ab.m_X * b.m_M.m_Z) / n.m_Y;
-            *pt = -(ab.m_Z * a.m_M.m_X - ab.m_X * a.m_M.m_Z) / n.m_Y;
-        }
-
-        return 1;   // 1 intersection, return 1
-    }
+    return LineLineIntersection(a, b, ps, pt);
 }
 
 //! @param	a		The line to test.
@@ -1498,8 +1486,10 @@ int Intersectable::Intersection(Line const & a, Line const & b, float * ps, floa
 
 int Intersectable::Intersection(Line const & a, Line const & b, Point * pi)
 {
+    MYMATH_INSTRUMENT_CALL("Intersection(Line, Line)");
+
     float     t, u;
-    int const n = Intersection(a, b, &t, &u);
+    int const n = LineLineIntersection(a, b, &t, &u);
 
     if (n == 1)
         *pi = a.m_M * t + a.m_B;
@@ -1515,8 +1505,10 @@ int Intersectable::Intersection(Line const & a, Line const & b, Point * pi)
 
 int Intersectable::Intersection(Segment const & a, Segment const & b, Point * pi)
 {
+    MYMATH_INSTRUMENT_CALL("Intersection(Segment, Segment)");
+
     float     t, u;
-    int const n = Intersection(Line(a.m_M, a.m_B), Line(b.m_M, b.m_B), &t, &u);
+    int const n = LineLineIntersection(Line(a.m_M, a.m_B), Line(b.m_M, b.m_B), &t, &u);
 
     if (n == 1)
     {
@@ -1540,22 +1532,9 @@ int Intersectable::Intersection(Segment const & a, Segment const & b, Point * pi
 
 int Intersectable::Intersection(Line const & line, Plane const & plane, float * pt)
 {
-    float const dot      = Dot(line.m_M, plane.m_N);
-    float const distance = Distance(line.m_B, plane);
-
-    // If the line and the plane are parallel then there are 0 or > 1 intersections
-
-    if (MyMath::IsCloseToZero(dot))
-    {
-        if (MyMath::IsCloseToZero(distance))
-            return std::numeric_limits<int>::max(); // Line is co-planar
-        else
-            return 0;   // Line does not intersect
-    }
+    MYMATH_INSTRUMENT_CALL("Intersection(Line, Plane)");
 
-    *pt = -distance / dot;
-
-    return 1;       // 1 intersection
+    return LinePlaneIntersection(line, plane, pt);
 }
 
 //! @param	line	The line to test.
@@ -1566,8 +1545,10 @@ int Intersectable::Intersection(Line const & line, Plane const & plane, float *
 
 int Intersectable::Intersection(Line const & line, Plane const & plane, Point * pi)
 {
+    MYMATH_INSTRUMENT_CALL("Intersection(Line, Plane)");
+
     float     t;
-    int const n = Intersection(line, plane, &t);
+    int const n = LinePlaneIntersection(line, plane, &t);
 
     if (n == 1)
         *pi = line.m_M * t + line.m_B;
@@ -1583,6 +1564,8 @@ int Intersectable::Intersection(Line const & line, Plane const & plane, Point *
 
 int Intersectable::Intersection(Plane const & a, Plane const & b, Line * pi)
 {
+    MYMATH_INSTRUMENT_CALL("Intersection(Plane, Plane)");
+
     float const n1n2 = Dot(a.m_N, b.m_N);
 
     // If the Cross product of the normals is close to 0, the planes are parallel and possibly coincident
@@ -1705,3 +1688,79 @@ float Distance(Line const & a, Line const & b)
     else
         return Distance(a.m_B, b);
 }
+
+//! @param	a		The line segment to test.
+//! @param	b		The line segment to test.
+//!
+//! Returns the distance between the line segments (see MyMath::ClosestPoints()).
+
+float Distance(Segment const & a, Segment const & b)
+{
+    Vector3 pa;
+    Vector3 pb;
+
+    return MyMath::ClosestPoints(a, b, &pa, &pb);
+}
+
+//! @param	point		The point to test.
+//! @param	aabox		The box to test.
+//!
+//! Returns the distance between the point and the box, or 0 if the point is inside it.
+
+float Distance(Point const & point, AABox const & aabox)
+{
+    Vector3 p;
+
+    return MyMath::ClosestPoints(point.value_, aabox, &p);
+}
+
+//! @param	point		The point to test.
+//! @param	box			The box to test.
+//!
+//! Returns the distance between the point and the box, or 0 if the point is inside it.
+
+float Distance(Point const & point, Box const & box)
+{
+    Vector3 p;
+
+    return MyMath::ClosestPoints(point.value_, box, &p);
+}
+
+//! @param	segment		The line segment to test.
+//! @param	aabox		The box to test.
+//!
+//! Returns the distance between the line segment and the box, or 0 if they intersect.
+
+float Distance(Segment const & segment, AABox const & aabox)
+{
+    Vector3 ps;
+    Vector3 pb;
+
+    return MyMath::ClosestPoints(segment, aabox, &ps, &pb);
+}
+
+//! @param	sphere		The sphere to test.
+//! @param	box			The box to test.
+//!
+//! Returns the distance between the sphere and the box, or 0 if they intersect.
+
+float Distance(Sphere const & sphere, Box const & box)
+{
+    Vector3 ps;
+    Vector3 pb;
+
+    return MyMath::ClosestPoints(sphere, box, &ps, &pb);
+}
+
+//! @param	a		The box to test.
+//! @param	b		The box to test.
+//!
+//! Returns the distance between the boxes, or 0 if they intersect.
+
+float Distance(AABox const & a, AABox const & b)
+{
+    Vector3 pa;
+    Vector3 pb;
+
+    return MyMath::ClosestPoints(a, b, &pa, &pb);
+}
@@ -1,6 +1,7 @@
 #include "Matrix22.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix22d.h"
 #include "Vector2.h"
 
@@ -42,6 +43,8 @@ Matrix22 & Matrix22::Transpose()
 
 Matrix22 & Matrix22::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix22::Invert");
+
     Matrix22 const a(*this);
     float const    det = float(a.Determinant());
 
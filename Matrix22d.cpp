@@ -1,6 +1,7 @@
 #include "Matrix22d.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix22.h"
 #include "Vector2d.h"
 
@@ -42,6 +43,8 @@ Matrix22d & Matrix22d::Transpose()
 
 Matrix22d & Matrix22d::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix22d::Invert");
+
     double const det = Determinant();
 
     assert(!MyMath::IsCloseToZero(det, MyMath::DEFAULT_DOUBLE_TOLERANCE));
@@ -1,6 +1,7 @@
 #include "Matrix33.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix33d.h"
 #include "Matrix43.h"
 #include "Matrix44.h"
@@ -99,6 +100,8 @@ Matrix33 & Matrix33::Transpose()
 
 Matrix33 & Matrix33::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix33::Invert");
+
     Matrix33 const a(*this);
     double const   det = a.Determinant();
 
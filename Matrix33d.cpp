@@ -1,6 +1,7 @@
 #include "Matrix33d.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix33.h"
 #include "Matrix43d.h"
 #include "Matrix44d.h"
@@ -80,6 +81,8 @@ Matrix33d & Matrix33d::Transpose()
 
 Matrix33d & Matrix33d::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix33d::Invert");
+
     double const det = Determinant();
 
     assert(!MyMath::IsCloseToZero(det, MyMath::DEFAULT_DOUBLE_TOLERANCE));
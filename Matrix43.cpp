@@ -1,6 +1,7 @@
 #include "Matrix43.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix33.h"
 #include "Matrix43d.h"
 #include "Matrix44.h"
@@ -110,6 +111,8 @@ double Matrix43::Determinant() const
 
 Matrix43 & Matrix43::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix43::Invert");
+
     // Ok, now for the cleverness...
     //
     // M = ( S * R ) * T, where
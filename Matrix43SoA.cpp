@@ -0,0 +1,201 @@
+#include "Matrix43SoA.h"
+
+#include "Vector3SoA.h"
+
+//! @param	a	Array
+//! @param	i	Index of the element
+
+Matrix43SoA::Reference::Reference(Matrix43SoA & a, size_t i)
+    : m_Xx(a.GetStream(0, 0)[i])
+    , m_Xy(a.GetStream(0, 1)[i])
+    , m_Xz(a.GetStream(0, 2)[i])
+    , m_Yx(a.GetStream(1, 0)[i])
+    , m_Yy(a.GetStream(1, 1)[i])
+    , m_Yz(a.GetStream(1, 2)[i])
+    , m_Zx(a.GetStream(2, 0)[i])
+    , m_Zy(a.GetStream(2, 1)[i])
+    , m_Zz(a.GetStream(2, 2)[i])
+    , m_Tx(a.GetStream(3, 0)[i])
+    , m_Ty(a.GetStream(3, 1)[i])
+    , m_Tz(a.GetStream(3, 2)[i])
+{
+}
+
+Matrix43SoA::Reference & Matrix43SoA::Reference::operator =(Matrix43 const & m)
+{
+    m_Xx = m.m_Xx; m_Xy = m.m_Xy; m_Xz = m.m_Xz;
+    m_Yx = m.m_Yx; m_Yy = m.m_Yy; m_Yz = m.m_Yz;
+    m_Zx = m.m_Zx; m_Zy = m.m_Zy; m_Zz = m.m_Zz;
+    m_Tx = m.m_Tx; m_Ty = m.m_Ty; m_Tz = m.m_Tz;
+
+    return *this;
+}
+
+Matrix43SoA::Reference::operator Matrix43() const
+{
+    return Matrix43(m_Xx, m_Xy, m_Xz,
+                    m_Yx, m_Yy, m_Yz,
+                    m_Zx, m_Zy, m_Zz,
+                    m_Tx, m_Ty, m_Tz);
+}
+
+//! @param	m	Matrix to append
+
+void Matrix43SoA::PushBack(Matrix43 const & m)
+{
+    size_t const i = Size();
+
+    Resize(i + 1);
+    (*this)[i] = m;
+}
+
+//! @param	i	Index of the element
+
+Matrix43 Matrix43SoA::operator [](size_t i) const
+{
+    Matrix43 m;
+
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            m.m_M[r][c] = GetStream(r, c)[i];
+        }
+    }
+
+    return m;
+}
+
+//! @param	p	Matrices
+//! @param	n	Number of matrices
+
+void Matrix43SoA::Load(Matrix43 const * p, size_t n)
+{
+    Resize(n);
+
+    // Each stream is written sequentially.
+
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            float * const s = GetStream(r, c);
+            for (size_t i = 0; i < n; ++i)
+            {
+                s[i] = p[i].m_M[r][c];
+            }
+        }
+    }
+}
+
+//! @param	p	Where to store the matrices. There must be room for Size() matrices.
+
+void Matrix43SoA::Store(Matrix43 * p) const
+{
+    size_t const n = Size();
+
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            float const * const s = GetStream(r, c);
+            for (size_t i = 0; i < n; ++i)
+            {
+                p[i].m_M[r][c] = s[i];
+            }
+        }
+    }
+}
+
+namespace MyMath
+{
+// The operations process the padding too, so that the loops have no remainder when vectorized.
+
+void Multiply(Matrix43SoA const & a, Matrix43SoA const & b, Matrix43SoA * pR)
+{
+    assert(a.Size() == b.Size());
+
+    pR->Resize(a.Size());
+
+    float const * am[4][3];
+    float const * bm[4][3];
+    float *       rm[4][3];
+
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            am[r][c] = a.GetStream(r, c);
+            bm[r][c] = b.GetStream(r, c);
+            rm[r][c] = pR->GetStream(r, c);
+        }
+    }
+
+    size_t const n = a.PaddedSize();
+    for (size_t i = 0; i < n; ++i)
+    {
+        // Since the 4th column is [ 0, 0, 0, 1 ], only the T row gets b's translation.
+
+        float c[4][3];
+
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                c[r][j] = am[r][0][i] * bm[0][j][i] + am[r][1][i] * bm[1][j][i] + am[r][2][i] * bm[2][j][i];
+            }
+        }
+
+        for (int j = 0; j < 3; ++j)
+        {
+            c[3][j] += bm[3][j][i];
+        }
+
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                rm[r][j][i] = c[r][j];
+            }
+        }
+    }
+}
+
+void Transform(Vector3SoA const & v, Matrix43SoA const & m, Vector3SoA * pR)
+{
+    assert(v.Size() == m.Size());
+
+    pR->Resize(v.Size());
+
+    float const * const vx  = v.GetX();
+    float const * const vy  = v.GetY();
+    float const * const vz  = v.GetZ();
+    float const * const mXx = m.GetStream(0, 0);
+    float const * const mXy = m.GetStream(0, 1);
+    float const * const mXz = m.GetStream(0, 2);
+    float const * const mYx = m.GetStream(1, 0);
+    float const * const mYy = m.GetStream(1, 1);
+    float const * const mYz = m.GetStream(1, 2);
+    float const * const mZx = m.GetStream(2, 0);
+    float const * const mZy = m.GetStream(2, 1);
+    float const * const mZz = m.GetStream(2, 2);
+    float const * const mTx = m.GetStream(3, 0);
+    float const * const mTy = m.GetStream(3, 1);
+    float const * const mTz = m.GetStream(3, 2);
+    float * const       rx  = pR->GetX();
+    float * const       ry  = pR->GetY();
+    float * const       rz  = pR->GetZ();
+    size_t const        n   = v.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const x = vx[i];
+        float const y = vy[i];
+        float const z = vz[i];
+
+        rx[i] = x * mXx[i] + y * mYx[i] + z * mZx[i] + mTx[i];
+        ry[i] = x * mXy[i] + y * mYy[i] + z * mZy[i] + mTy[i];
+        rz[i] = x * mXz[i] + y * mYz[i] + z * mZz[i] + mTz[i];
+    }
+}
+} // namespace MyMath
@@ -1,6 +1,7 @@
 #include "Matrix43d.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix33d.h"
 #include "Matrix43.h"
 #include "Matrix44d.h"
@@ -111,6 +112,8 @@ double Matrix43d::Determinant() const
 
 Matrix43d & Matrix43d::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix43d::Invert");
+
     // Ok, now for the cleverness...
     //
     // M = ( S * R ) * T, where
@@ -1,6 +1,7 @@
 #include "Matrix44.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix33.h"
 #include "Matrix43.h"
 #include "Matrix44d.h"
@@ -98,6 +99,8 @@ Matrix44 & Matrix44::Transpose()
 
 Matrix44 & Matrix44::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix44::Invert");
+
     Matrix44 const a(*this);
     double const   det = a.Determinant();
 
@@ -1,6 +1,7 @@
 #include "Matrix44d.h"
 
 #include "Determinant.h"
+#include "Instrumentation.h"
 #include "Matrix33d.h"
 #include "Matrix43d.h"
 #include "Matrix44.h"
@@ -97,6 +98,8 @@ Matrix44d & Matrix44d::Transpose()
 
 Matrix44d & Matrix44d::Invert()
 {
+    MYMATH_INSTRUMENT_CALL("Matrix44d::Invert");
+
     double const det = Determinant();
 
     if (!MyMath::IsCloseToZero(det, MyMath::DEFAULT_DOUBLE_TOLERANCE))
@@ -1,20 +1,234 @@
 #include "Constants.h"
 #include "MyMath.h"
 
+#include <array>
+#include <cmath>
+#include <limits>
+
+#if !defined(MYMATH_LOG_GAMMA_TABLE_SIZE)
+#define MYMATH_LOG_GAMMA_TABLE_SIZE 1024    // Number of integer arguments for which log(gamma(x)) is precomputed
+#endif
+
+namespace
+{
+int const LOG_GAMMA_TABLE_SIZE = MYMATH_LOG_GAMMA_TABLE_SIZE;
+int const MAX_FACTORIAL        = 170;       // Maximum n whose factorial can be represented as a double
+double const MAX_GAMMA         = 171.62437695630272;    // Maximum x whose gamma can be represented as a double
+double const STIRLING_MIN_X    = 10.0;      // Minimum x for which the Stirling series is accurate to double precision
+
+// Returns the sum of the correction terms of Stirling's series for log(gamma(x)), i.e.
+//	log(gamma(x)) - ((x - 1/2) * log(x) - x + log(sqrt(2 * pi)))
+//	= 1/(12x) - 1/(360x^3) + 1/(1260x^5) - 1/(1680x^7) + ... B(2k) / (2k(2k-1)x^(2k-1))
+double StirlingCorrection(double x)
+{
+    double const z = 1.0 / (x * x);
+
+    return (1.0 / 12.0
+            + z * (-1.0 / 360.0
+                   + z * (1.0 / 1260.0
+                          + z * (-1.0 / 1680.0
+                                 + z * (1.0 / 1188.0
+                                        + z * (-691.0 / 360360.0
+                                               + z * (1.0 / 156.0
+                                                      + z * (-3617.0 / 122400.0)))))))) / x;
+}
+
+// Returns log(gamma(x)) for x > 0 that is not an integer in the table
+double LogGammaPositive(double x)
+{
+    if (x == std::numeric_limits<double>::infinity())
+        return x;
+
+    // The Stirling series is used after the recurrence gamma(x) = gamma(x + 1) / x moves x into its accurate range.
+
+    double p = 1.0;
+    while (x < STIRLING_MIN_X)
+    {
+        p *= x;
+        x += 1.0;
+    }
+
+    return (x - 0.5) * std::log(x) - x + MyMath::LOGE_OF_SQRT_OF_TWO_PI + StirlingCorrection(x) - std::log(p);
+}
+
+// Returns the table of log(gamma(n + 1)) = log(n!) for 0 <= n < LOG_GAMMA_TABLE_SIZE. The table is computed the
+// first time it is needed.
+double const * LogFactorialTable()
+{
+    static std::array<double, LOG_GAMMA_TABLE_SIZE> const table = []() {
+        std::array<double, LOG_GAMMA_TABLE_SIZE> t;
+        t[0] = 0.0;
+        for (int n = 1; n < LOG_GAMMA_TABLE_SIZE; ++n)
+        {
+            t[n] = n < STIRLING_MIN_X ? std::log(MyMath::Factorial(double(n))) : LogGammaPositive(double(n) + 1.0);
+        }
+        return t;
+    }();
+
+    return table.data();
+}
+
+// Returns the table of n! for 0 <= n <= MAX_FACTORIAL. The table is computed the first time it is needed.
+double const * FactorialTable()
+{
+    static std::array<double, MAX_FACTORIAL + 1> const table = []() {
+        std::array<double, MAX_FACTORIAL + 1> t;
+        t[0] = 1.0;
+        for (int n = 1; n <= MAX_FACTORIAL; ++n)
+        {
+            t[n] = t[n - 1] * n;
+        }
+        return t;
+    }();
+
+    return table.data();
+}
+
+// Returns sin(pi * x). The argument is reduced exactly so that the result is accurate near integers.
+double SinPi(double x)
+{
+    double const n = std::nearbyint(x);
+    double const s = std::sin(MyMath::PI * (x - n));
+
+    return std::fmod(n, 2.0) == 0.0 ? s : -s;
+}
+
+// Returns true if x is an integer that can be used to index a table of the given size
+bool IsTableIndex(double x, int size)
+{
+    return x >= 0.0 && x < double(size) && x == std::floor(x);
+}
+} // anonymous namespace
+
 namespace MyMath
 {
-//!
 //! @param	n	Number to factorialize (<i>n</i> > 0)
+//!
+//! The result is accurate to double precision for n >= 10. Factorial() is accurate for all n.
 
 double Stirling(double n)
 {
+    assert(n > 0.0);
+
 //	double const	f	= SQRT_OF_TWO_PI * pow( n, n + .5 ) * exp( -n )
 //	double const	f	= SQRT_OF_TWO_PI * sqrt( n ) * pow( n/E, n )
-    double const f = SQRT_OF_TWO_PI * exp((n + .5) * log(n) - n);
+    double const f = SQRT_OF_TWO_PI * exp((n + .5) * log(n) - n + StirlingCorrection(n));
 
     return f;
 }
 
+//! @param	x	Value (not 0 or a negative integer)
+//!
+//! @return		log(|gamma(x)|), +infinity if @a x is 0 or a negative integer, or NaN if @a x is NaN
+//!
+//! Values of log(gamma(n)) for integers n up to MYMATH_LOG_GAMMA_TABLE_SIZE (1024 by default) are looked up in a
+//! table. Other values are computed using Stirling's series.
+
+double LogGamma(double x)
+{
+    if (IsTableIndex(x - 1.0, LOG_GAMMA_TABLE_SIZE))
+        return LogFactorialTable()[int(x) - 1];
+
+    if (x > 0.0)
+        return LogGammaPositive(x);
+
+    if (std::isnan(x))
+        return x;
+
+    // Reflection: gamma(x) * gamma(1 - x) = pi / sin(pi * x)
+
+    double const s = SinPi(x);
+    if (s == 0.0)
+        return std::numeric_limits<double>::infinity();
+
+    return std::log(PI / std::fabs(s)) - LogGamma(1.0 - x);
+}
+
+//! @param	x		Values
+//! @param	pR		Where to store the values of log(|gamma(x)|). May be the same as @a x.
+//! @param	count	Number of values
+//!
+//! The results are identical to those of LogGamma(double). The table is fetched once for the whole batch.
+
+void LogGamma(double const * x, double * pR, size_t count)
+{
+    double const * const table = LogFactorialTable();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        double const xi = x[i];
+        if (IsTableIndex(xi - 1.0, LOG_GAMMA_TABLE_SIZE))
+            pR[i] = table[int(xi) - 1];
+        else if (xi > 0.0)
+            pR[i] = LogGammaPositive(xi);
+        else
+            pR[i] = LogGamma(xi);
+    }
+}
+
+//! @param	x	Value (not 0 or a negative integer)
+//!
+//! @return		gamma(x), or NaN if @a x is 0 or a negative integer
+//!
+//! Values for integers are looked up in a table. Other values are computed using the Lanczos approximation.
+
+double Gamma(double x)
+{
+    if (IsTableIndex(x - 1.0, MAX_FACTORIAL + 1))
+        return FactorialTable()[int(x) - 1];
+
+    if (x < 0.5)
+    {
+        // Reflection: gamma(x) * gamma(1 - x) = pi / sin(pi * x)
+
+        double const s = SinPi(x);
+        if (s == 0.0)
+            return std::numeric_limits<double>::quiet_NaN();
+
+        return PI / (s * Gamma(1.0 - x));
+    }
+
+    if (x > MAX_GAMMA)
+        return std::numeric_limits<double>::infinity();
+
+    // Lanczos approximation with g = 7 and n = 9
+
+    static double const LANCZOS_G = 7.0;
+    static double const LANCZOS[] =
+    {
+        0.99999999999980993,
+        676.5203681218851,
+        -1259.1392167224028,
+        771.32342877765313,
+        -176.61502916214059,
+        12.507343278686905,
+        -0.13857109526572012,
+        9.9843695780195716e-6,
+        1.5056327351493116e-7
+    };
+
+    double const z = x - 1.0;
+    double       a = LANCZOS[0];
+    for (int i = 1; i < 9; ++i)
+    {
+        a += LANCZOS[i] / (z + i);
+    }
+
+    // t^(z + 1/2) is computed in two halves so that it does not overflow before e^-t is applied.
+
+    double const t = z + LANCZOS_G + 0.5;
+    double const h = std::pow(t, 0.5 * (z + 0.5));
+
+    return SQRT_OF_TWO_PI * h * (h * std::exp(-t)) * a;
+}
+
+//! @param	n	Value (not a negative integer)
+
+double Factorial(double n)
+{
+    return Gamma(n + 1.0);
+}
+
 //! @param	z00		Value when y = 0 and x = 0
 //! @param	z01		Value when y = 0 and x = 1
 //! @param	z10		Value when y = 1 and x = 0
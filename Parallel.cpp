@@ -0,0 +1,189 @@
+#include "Parallel.h"
+
+namespace
+{
+// The scheduler and queue of the worker running in this thread, if any
+thread_local MyMath::TaskScheduler * t_pScheduler = nullptr;
+thread_local int                     t_Queue      = -1;
+} // anonymous namespace
+
+namespace MyMath
+{
+//! @param	nThreads	Number of worker threads (0 for one per hardware thread)
+
+TaskScheduler::TaskScheduler(int nThreads)
+    : m_nPending(0)
+    , m_NextQueue(0)
+    , m_Stop(false)
+{
+    if (nThreads <= 0)
+        nThreads = std::max(1, int(std::thread::hardware_concurrency()));
+
+    m_Queues.reserve(nThreads);
+    for (int i = 0; i < nThreads; ++i)
+    {
+        m_Queues.emplace_back(new Queue);
+    }
+
+    m_Threads.reserve(nThreads);
+    for (int i = 0; i < nThreads; ++i)
+    {
+        m_Threads.emplace_back(&TaskScheduler::Work, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_all();
+
+    for (auto & thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+//! @param	task	Task to run
+
+void TaskScheduler::Submit(Task task)
+{
+    int const queue = (t_pScheduler == this) ? t_Queue : int(m_NextQueue++ % m_Queues.size());
+
+    {
+        std::lock_guard<std::mutex> lock(m_Queues[queue]->m_Mutex);
+        m_Queues[queue]->m_Tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        ++m_nPending;
+    }
+    m_Wake.notify_one();
+}
+
+bool TaskScheduler::RunOne()
+{
+    Task task;
+
+    if (!Take((t_pScheduler == this) ? t_Queue : 0, &task))
+        return false;
+
+    task();
+    return true;
+}
+
+TaskScheduler & TaskScheduler::GetDefault()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+void TaskScheduler::Work(int index)
+{
+    t_pScheduler = this;
+    t_Queue      = index;
+
+    for (;;)
+    {
+        Task task;
+
+        if (Take(index, &task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        m_Wake.wait(lock, [this] { return m_Stop || m_nPending > 0; });
+        if (m_Stop && m_nPending == 0)
+            break;
+    }
+}
+
+bool TaskScheduler::Take(int first, Task * pTask)
+{
+    int const n = int(m_Queues.size());
+
+    if (m_nPending.load(std::memory_order_acquire) == 0)
+        return false;
+
+    // The owner takes the newest task (its data is most likely to be in the cache) and thieves take the oldest.
+
+    {
+        Queue &                     own = *m_Queues[first];
+        std::lock_guard<std::mutex> lock(own.m_Mutex);
+        if (!own.m_Tasks.empty())
+        {
+            *pTask = std::move(own.m_Tasks.back());
+            own.m_Tasks.pop_back();
+            --m_nPending;
+            return true;
+        }
+    }
+
+    for (int i = 1; i < n; ++i)
+    {
+        Queue &                     victim = *m_Queues[(first + i) % n];
+        std::lock_guard<std::mutex> lock(victim.m_Mutex);
+        if (!victim.m_Tasks.empty())
+        {
+            *pTask = std::move(victim.m_Tasks.front());
+            victim.m_Tasks.pop_front();
+            --m_nPending;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! @param	scheduler	Scheduler running the tasks
+//!
+//! The calling thread runs queued tasks (of any group) while there are any. Then it blocks until the tasks of this
+//! group that other threads are running are done.
+
+void TaskGroup::Wait(TaskScheduler & scheduler)
+{
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_nRemaining == 0)
+                break;
+        }
+
+        if (!scheduler.RunOne())
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Done.wait(lock, [this] { return m_nRemaining == 0; });
+            break;
+        }
+    }
+
+    if (m_pException)
+        std::rethrow_exception(m_pException);
+}
+
+//! @param	pException	Exception thrown by a task
+
+void TaskGroup::Cancel(std::exception_ptr pException)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_pException)
+        m_pException = pException;
+    m_Cancelled.store(true, std::memory_order_relaxed);
+}
+
+//! The waiting thread is notified while the lock is held, so that it can't destroy the group before this is done
+//! with it.
+
+void TaskGroup::Finish()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (--m_nRemaining == 0)
+        m_Done.notify_all();
+}
+} // namespace MyMath
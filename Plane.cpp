@@ -2,6 +2,127 @@
 
 #include "Matrix43.h"
 #include "Vector3.h"
+#include "Vector3SoA.h"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace
+{
+int const POOL_SMALLEST     = 16;  // Number of vertices in the smallest pooled block
+int const POOL_NUM_CLASSES  = 8;   // Number of block sizes (16, 32, ... 2048 vertices)
+int const POOL_MAX_FREE     = 64;  // Maximum number of free blocks kept for each size
+
+// True once the calling thread's pool has been destroyed. It is trivially destructible, so it can still be read by
+// polygons that are destroyed after the pool (during the thread's exit or static destruction).
+thread_local bool s_VertexPoolDestroyed = false;
+
+// A per-thread cache of freed vertex blocks, one list for each block size. Blocks larger than the largest size are
+// allocated and freed directly.
+class VertexPool
+{
+public:
+
+    ~VertexPool()
+    {
+        s_VertexPoolDestroyed = true;
+
+        for (Block * pBlock : m_apFree)
+        {
+            while (pBlock)
+            {
+                Block * const pNext = pBlock->m_pNext;
+                ::operator delete(pBlock);
+                pBlock = pNext;
+            }
+        }
+    }
+
+    // Returns a block with room for at least n vertices. Its size is returned in pCapacity.
+    Vector3 * Allocate(int n, int * pCapacity)
+    {
+        int c        = 0;
+        int capacity = POOL_SMALLEST;
+        while (c < POOL_NUM_CLASSES && capacity < n)
+        {
+            ++c;
+            capacity *= 2;
+        }
+
+        if (c == POOL_NUM_CLASSES)
+            capacity = n;
+
+        *pCapacity = capacity;
+
+        if (c < POOL_NUM_CLASSES && m_apFree[c])
+        {
+            Block * const pBlock = m_apFree[c];
+            m_apFree[c] = pBlock->m_pNext;
+            --m_anFree[c];
+            return reinterpret_cast<Vector3 *>(pBlock);
+        }
+
+        return static_cast<Vector3 *>(::operator new(capacity * sizeof(Vector3)));
+    }
+
+    // Returns a block to the pool
+    void Free(Vector3 * p, int capacity)
+    {
+        int c    = 0;
+        int size = POOL_SMALLEST;
+        while (c < POOL_NUM_CLASSES && size < capacity)
+        {
+            ++c;
+            size *= 2;
+        }
+
+        if (c == POOL_NUM_CLASSES || m_anFree[c] >= POOL_MAX_FREE)
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        Block * const pBlock = reinterpret_cast<Block *>(p);
+        pBlock->m_pNext = m_apFree[c];
+        m_apFree[c]     = pBlock;
+        ++m_anFree[c];
+    }
+
+private:
+
+    struct Block
+    {
+        Block * m_pNext;
+    };
+
+    Block * m_apFree[POOL_NUM_CLASSES] = {};
+    int m_anFree[POOL_NUM_CLASSES]     = {};
+};
+
+thread_local VertexPool s_VertexPool;
+
+// Returns a block with room for at least n vertices. Its size is returned in pCapacity.
+Vector3 * AllocateVertices(int n, int * pCapacity)
+{
+    if (s_VertexPoolDestroyed)
+    {
+        *pCapacity = n;
+        return static_cast<Vector3 *>(::operator new(n * sizeof(Vector3)));
+    }
+
+    return s_VertexPool.Allocate(n, pCapacity);
+}
+
+// Returns a block to the pool, or frees it if the pool no longer exists
+void FreeVertices(Vector3 * p, int capacity)
+{
+    if (s_VertexPoolDestroyed)
+        ::operator delete(p);
+    else
+        s_VertexPool.Free(p, capacity);
+}
+} // anonymous namespace
 
 Matrix43 Plane::GetReflectionMatrix() const
 {
@@ -60,3 +181,290 @@ Matrix43 Plane::GetProjectionMatrix(Vector3 const & v) const
                     vpx * m_N.m_Z,        vpy * m_N.m_Z, 1.0f + vpz * m_N.m_Z,
                     vpx *     m_D,        vpy *     m_D,        vpz *     m_D);
 }
+
+//! @param	paPoints		Points
+//! @param	paDistances		Where to store the distances
+//! @param	n				Number of points
+
+void Plane::DirectedDistances(Vector3 const * paPoints, float * paDistances, size_t n) const
+{
+    float const nx = m_N.m_X;
+    float const ny = m_N.m_Y;
+    float const nz = m_N.m_Z;
+    float const d  = m_D;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        paDistances[i] = paPoints[i].m_X * nx + paPoints[i].m_Y * ny + paPoints[i].m_Z * nz + d;
+    }
+}
+
+//! @param	points			Points
+//! @param	paDistances		Where to store the distances
+
+void Plane::DirectedDistances(Vector3SoA const & points, float * paDistances) const
+{
+    float const * const x  = points.GetX();
+    float const * const y  = points.GetY();
+    float const * const z  = points.GetZ();
+    float const         nx = m_N.m_X;
+    float const         ny = m_N.m_Y;
+    float const         nz = m_N.m_Z;
+    float const         d  = m_D;
+    size_t const        n  = points.Size();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        paDistances[i] = x[i] * nx + y[i] * ny + z[i] * nz + d;
+    }
+}
+
+//! @param	paPoints	Points
+//! @param	paResults	Where to store the reflected points
+//! @param	n			Number of points
+//!
+//! The points are transformed by GetReflectionMatrix(), which is computed once.
+
+void Plane::Reflect(Vector3 const * paPoints, Vector3 * paResults, size_t n) const
+{
+    Matrix43 const m = GetReflectionMatrix();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        paResults[i] = paPoints[i] * m;
+    }
+}
+
+//! @param	points		Points
+//! @param	pResults	Reflected points
+
+void Plane::Reflect(Vector3SoA const & points, Vector3SoA * pResults) const
+{
+    MyMath::Transform(points, GetReflectionMatrix(), pResults);
+}
+
+//! @param	paPoints	Points
+//! @param	paResults	Where to store the projected points
+//! @param	n			Number of points
+//!
+//! The points are transformed by GetProjectionMatrix(), which is computed once.
+
+void Plane::Project(Vector3 const * paPoints, Vector3 * paResults, size_t n) const
+{
+    Matrix43 const m = GetProjectionMatrix();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        paResults[i] = paPoints[i] * m;
+    }
+}
+
+//! @param	points		Points
+//! @param	pResults	Projected points
+
+void Plane::Project(Vector3SoA const & points, Vector3SoA * pResults) const
+{
+    MyMath::Transform(points, GetProjectionMatrix(), pResults);
+}
+
+Poly::Poly()
+    : m_paVertices(m_aInline)
+    , m_nVertices(0)
+    , m_Capacity(INLINE_CAPACITY)
+{
+}
+
+//! @param	paVertices	Vertices
+//! @param	nVertices	Number of vertices (at least 3)
+
+Poly::Poly(Vector3 const * paVertices, int nVertices)
+    : Plane(ComputePlane(paVertices, nVertices))
+    , m_paVertices(m_aInline)
+    , m_nVertices(0)
+    , m_Capacity(INLINE_CAPACITY)
+{
+    Assign(paVertices, nVertices);
+}
+
+//! @param	plane		The plane containing the polygon
+//! @param	paVertices	Vertices
+//! @param	nVertices	Number of vertices
+
+Poly::Poly(Plane const & plane, Vector3 const * paVertices, int nVertices)
+    : Plane(plane)
+    , m_paVertices(m_aInline)
+    , m_nVertices(0)
+    , m_Capacity(INLINE_CAPACITY)
+{
+    Assign(paVertices, nVertices);
+}
+
+Poly::Poly(Poly const & poly)
+    : Plane(poly)
+    , m_paVertices(m_aInline)
+    , m_nVertices(0)
+    , m_Capacity(INLINE_CAPACITY)
+{
+    Assign(poly.m_paVertices, poly.m_nVertices);
+}
+
+Poly::Poly(Poly && poly) noexcept
+    : Plane(poly)
+    , m_paVertices(m_aInline)
+    , m_nVertices(0)
+    , m_Capacity(INLINE_CAPACITY)
+{
+    *this = std::move(poly);
+}
+
+Poly::~Poly()
+{
+    Release();
+}
+
+Poly & Poly::operator =(Poly const & poly)
+{
+    if (this != &poly)
+    {
+        Plane::operator =(poly);
+        Assign(poly.m_paVertices, poly.m_nVertices);
+    }
+    return *this;
+}
+
+//! The moved-from polygon is left empty.
+
+Poly & Poly::operator =(Poly && poly) noexcept
+{
+    if (this != &poly)
+    {
+        Plane::operator =(poly);
+
+        if (poly.m_paVertices != poly.m_aInline)
+        {
+            // Take the pooled block
+
+            Release();
+            m_paVertices      = poly.m_paVertices;
+            m_nVertices       = poly.m_nVertices;
+            m_Capacity        = poly.m_Capacity;
+            poly.m_paVertices = poly.m_aInline;
+            poly.m_Capacity   = INLINE_CAPACITY;
+        }
+        else
+        {
+            // The vertices fit in the inline storage, so they fit in this polygon's storage too.
+
+            std::copy(poly.m_paVertices, poly.m_paVertices + poly.m_nVertices, m_paVertices);
+            m_nVertices = poly.m_nVertices;
+        }
+
+        poly.m_nVertices = 0;
+    }
+    return *this;
+}
+
+//! @param	n	Number of vertices
+//!
+//! The existing vertices are preserved.
+
+void Poly::Reserve(int n)
+{
+    if (n <= m_Capacity)
+        return;
+
+    int             capacity;
+    Vector3 * const paVertices = AllocateVertices(n, &capacity);
+    std::copy(m_paVertices, m_paVertices + m_nVertices, paVertices);
+
+    int const nVertices = m_nVertices;
+    Release();
+    m_paVertices = paVertices;
+    m_nVertices  = nVertices;
+    m_Capacity   = capacity;
+}
+
+//! @param	n	Number of vertices
+
+void Poly::Resize(int n)
+{
+    assert(n >= 0);
+
+    Reserve(n);
+    m_nVertices = n;
+}
+
+//! @param	v	Vertex
+
+void Poly::PushBack(Vector3 const & v)
+{
+    if (m_nVertices == m_Capacity)
+    {
+        Vector3 const copy = v; // v may be one of the vertices
+        Reserve(m_nVertices + 1);
+        m_paVertices[m_nVertices++] = copy;
+    }
+    else
+    {
+        m_paVertices[m_nVertices++] = v;
+    }
+}
+
+//! @param	paVertices	Vertices. They must not be this polygon's own vertices.
+//! @param	nVertices	Number of vertices
+//!
+//! The plane is not changed.
+
+void Poly::Assign(Vector3 const * paVertices, int nVertices)
+{
+    assert(nVertices >= 0);
+    assert(nVertices == 0 || paVertices + nVertices <= m_paVertices || paVertices >= m_paVertices + m_Capacity);
+
+    m_nVertices = 0;
+    Reserve(nVertices);
+    std::copy(paVertices, paVertices + nVertices, m_paVertices);
+    m_nVertices = nVertices;
+}
+
+//! @param	paVertices	Vertices
+//! @param	nVertices	Number of vertices (at least 3)
+//!
+//! The normal faces the side from which the vertices are counter-clockwise. Newell's method gives the best-fit
+//! plane if the vertices are not quite coplanar.
+
+Plane Poly::ComputePlane(Vector3 const * paVertices, int nVertices)
+{
+    assert(nVertices >= 3);
+
+    Vector3 n = Vector3::Origin();
+    Vector3 c = Vector3::Origin();
+
+    for (int i = 0; i < nVertices; ++i)
+    {
+        Vector3 const & a = paVertices[i];
+        Vector3 const & b = paVertices[(i + 1 < nVertices) ? i + 1 : 0];
+
+        n.m_X += (a.m_Y - b.m_Y) * (a.m_Z + b.m_Z);
+        n.m_Y += (a.m_Z - b.m_Z) * (a.m_X + b.m_X);
+        n.m_Z += (a.m_X - b.m_X) * (a.m_Y + b.m_Y);
+        c     += a;
+    }
+
+    float const length = n.Length();
+
+    Plane plane;
+    plane.m_N = !MyMath::IsCloseToZero(length) ? n * (1.0f / length) : Vector3::XAxis();
+    plane.m_D = -Dot(plane.m_N, c) / float(nVertices);
+    return plane;
+}
+
+void Poly::Release()
+{
+    if (m_paVertices != m_aInline)
+    {
+        FreeVertices(m_paVertices, m_Capacity);
+        m_paVertices = m_aInline;
+        m_Capacity   = INLINE_CAPACITY;
+    }
+    m_nVertices = 0;
+}
@@ -0,0 +1,66 @@
+#include "PolyBuffer.h"
+
+#include <algorithm>
+#include <functional>
+
+//! @param	poly	Polygon to append
+
+int PolyBuffer::PushBack(Poly const & poly)
+{
+    return PushBack(poly, poly.GetVertices(), poly.GetVertexCount());
+}
+
+//! @param	paVertices	Vertices
+//! @param	nVertices	Number of vertices (at least 3)
+
+int PolyBuffer::PushBack(Vector3 const * paVertices, int nVertices)
+{
+    return PushBack(Poly::ComputePlane(paVertices, nVertices), paVertices, nVertices);
+}
+
+//! @param	plane		The plane containing the polygon
+//! @param	paVertices	Vertices
+//! @param	nVertices	Number of vertices
+
+int PolyBuffer::PushBack(Plane const & plane, Vector3 const * paVertices, int nVertices)
+{
+    assert(nVertices >= 0);
+
+    int const index = Size();
+
+    // The vertices may be in this buffer (e.g. from GetVertices()), so they are found again after the buffer grows,
+    // since growing it may move them.
+
+    std::less<Vector3 const *> const before;
+    Vector3 const * const            pBegin   = m_Vertices.data();
+    size_t const                     first    = m_Vertices.size();
+    bool const                       inBuffer = !before(paVertices, pBegin) && before(paVertices, pBegin + first);
+    size_t const                     offset   = inBuffer ? size_t(paVertices - pBegin) : 0;
+
+    m_Vertices.resize(first + nVertices);
+
+    Vector3 const * const pSource = inBuffer ? m_Vertices.data() + offset : paVertices;
+    std::copy(pSource, pSource + nVertices, m_Vertices.begin() + first);
+
+    m_Offsets.push_back(int(m_Vertices.size()));
+    m_Planes.push_back(plane);
+
+    return index;
+}
+
+//! @param	nPolys		Number of polygons
+//! @param	nVertices	Total number of vertices
+
+void PolyBuffer::Reserve(int nPolys, int nVertices)
+{
+    m_Vertices.reserve(nVertices);
+    m_Offsets.reserve(nPolys + 1);
+    m_Planes.reserve(nPolys);
+}
+
+void PolyBuffer::Clear()
+{
+    m_Vertices.clear();
+    m_Offsets.resize(1);
+    m_Planes.clear();
+}
@@ -1,6 +1,84 @@
 #include "Probability.h"
 
+#include "MyMath.h"
+
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+int const PASCAL_MAX_N = 66;        // Maximum n for which all nCr can be represented in 64 bits (signed)
+
+// Returns the number of entries in the first n rows of Pascal's triangle
+constexpr int PascalIndex(int n)
+{
+    return n * (n + 1) / 2;
+}
+
+// Returns Pascal's triangle up to row PASCAL_MAX_N. Row n starts at PascalIndex(n).
+constexpr std::array<int64_t, PascalIndex(PASCAL_MAX_N + 1)> MakePascalsTriangle()
+{
+    std::array<int64_t, PascalIndex(PASCAL_MAX_N + 1)> t = {};
+
+    for (int n = 0; n <= PASCAL_MAX_N; ++n)
+    {
+        t[PascalIndex(n)]     = 1;
+        t[PascalIndex(n) + n] = 1;
+        for (int r = 1; r < n; ++r)
+        {
+            t[PascalIndex(n) + r] = t[PascalIndex(n - 1) + r - 1] + t[PascalIndex(n - 1) + r];
+        }
+    }
+
+    return t;
+}
+
+constexpr std::array<int64_t, PascalIndex(PASCAL_MAX_N + 1)> PASCALS_TRIANGLE = MakePascalsTriangle();
+
+// Multiplies a 128-bit value by a 32-bit value. Returns false if the product overflows.
+bool Multiply128(uint64_t * pHi, uint64_t * pLo, uint32_t m)
+{
+    uint64_t const p0 = (*pLo & 0xffffffff) * m;
+    uint64_t const p1 = (*pLo >> 32) * m + (p0 >> 32);
+    uint64_t const p2 = (*pHi & 0xffffffff) * m + (p1 >> 32);
+    uint64_t const p3 = (*pHi >> 32) * m + (p2 >> 32);
+
+    if ((p3 >> 32) != 0)
+        return false;
+
+    *pLo = (p1 << 32) | (p0 & 0xffffffff);
+    *pHi = (p3 << 32) | (p2 & 0xffffffff);
+    return true;
+}
+
+// Divides a 128-bit value by a 32-bit value. Returns the remainder.
+uint32_t Divide128(uint64_t * pHi, uint64_t * pLo, uint32_t d)
+{
+    uint64_t r = 0;
+    uint32_t q[4];
+    uint32_t const x[4] = { uint32_t(*pHi >> 32), uint32_t(*pHi), uint32_t(*pLo >> 32), uint32_t(*pLo) };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t const a = (r << 32) | x[i];
+        q[i] = uint32_t(a / d);
+        r    = a % d;
+    }
+
+    *pHi = (uint64_t(q[0]) << 32) | q[1];
+    *pLo = (uint64_t(q[2]) << 32) | q[3];
+    return uint32_t(r);
+}
+
+// Returns the remainder of a 128-bit value divided by a 32-bit value
+uint32_t Remainder128(uint64_t hi, uint64_t lo, uint32_t d)
+{
+    return Divide128(&hi, &lo, d);
+}
+} // anonymous namespace
 
 int Factorial(int n)
 {
@@ -29,33 +107,33 @@ int Factorial(int n)
         return f[n];
 }
 
-__int64 Factorial64(int n)
+int64_t Factorial64(int n)
 {
     int const MAX_N = 20;           // Maximum n whose factorial can be represented in 64 bits
 
-    static __int64 const f[MAX_N + 1] =
+    static int64_t const f[MAX_N + 1] =
     {
-        1i64,                   //  0!
-        1i64,                   //  1!
-        2i64,                   //  2!
-        6i64,                   //  3!
-        24i64,                  //  4!
-        120i64,                 //  5!
-        720i64,                 //  6!
-        5040i64,                //  7!
-        40320i64,               //  8!
-        362880i64,              //  9!
-        3628800i64,             // 10!
-        39916800i64,            // 11!
-        479001600i64,           // 12!
-        6227020800i64,          // 13!
-        87178291200i64,         // 14!
-        1307674368000i64,       // 15!
-        20922789888000i64,      // 16!
-        355687428096000i64,     // 17!
-        6402373705728000i64,    // 18!
-        121645100408832000i64,  // 19!
-        2432902008176640000i64, // 20!
+        INT64_C(1),                     //  0!
+        INT64_C(1),                     //  1!
+        INT64_C(2),                     //  2!
+        INT64_C(6),                     //  3!
+        INT64_C(24),                    //  4!
+        INT64_C(120),                   //  5!
+        INT64_C(720),                   //  6!
+        INT64_C(5040),                  //  7!
+        INT64_C(40320),                 //  8!
+        INT64_C(362880),                //  9!
+        INT64_C(3628800),               // 10!
+        INT64_C(39916800),              // 11!
+        INT64_C(479001600),             // 12!
+        INT64_C(6227020800),            // 13!
+        INT64_C(87178291200),           // 14!
+        INT64_C(1307674368000),         // 15!
+        INT64_C(20922789888000),        // 16!
+        INT64_C(355687428096000),       // 17!
+        INT64_C(6402373705728000),      // 18!
+        INT64_C(121645100408832000),    // 19!
+        INT64_C(2432902008176640000),   // 20!
     };
 
     if (n < 0 || n > MAX_N)
@@ -64,46 +142,146 @@ __int64 Factorial64(int n)
         return f[n];
 }
 
+//! @param	n		Value
+//! @param	pHi		Where to store the high 64 bits of n!
+//! @param	pLo		Where to store the low 64 bits of n!
+//!
+//! @return		false if n < 0 or if n! cannot be represented in 128 bits (n > 34)
+
+bool Factorial128(int n, uint64_t * pHi, uint64_t * pLo)
+{
+    if (n < 0)
+        return false;
+
+    uint64_t hi = 0;
+    uint64_t lo = 1;
+
+    for (int i = 2; i <= n; ++i)
+    {
+        if (!Multiply128(&hi, &lo, uint32_t(i)))
+            return false;
+    }
+
+    *pHi = hi;
+    *pLo = lo;
+    return true;
+}
+
+//! Values are looked up in the table used by MyMath::LogGamma() when possible.
+
+double LogFactorial(int n)
+{
+    if (n < 0)
+        return -std::numeric_limits<double>::infinity();
+    else
+        return MyMath::LogGamma(double(n) + 1.0);
+}
+
 int Combinations(int n, int r)
 {
-    // nCr = nPr / r! = n! / ( n - r )! / r!
-    //
-    // In order to expand the possible range of values without encountering overflow, we have to rewrite the
-    // equation. Note that nCr = nC(r-1) * (n-r+1)/r and nCr is always an integer, i.e. nC(r-1) * (n-r+1) is
-    // a multiple of r.
-    //
+    int64_t const c = Combinations64(n, r);
+
+    return c <= std::numeric_limits<int>::max() ? int(c) : 0;
+}
+
+int64_t Combinations64(int n, int r)
+{
+    if (n < 0 || r < 0 || r > n)
+        return 0;
+
+    if (n <= PASCAL_MAX_N)
+        return PASCALS_TRIANGLE[PascalIndex(n) + r];
+
+    // nC0 = 1
     // nC1 = n/1
     // nC2 = nC1 * (n-1)/2 = n/1 * (n-1)/2
-    // nC3 = nC2 * (n-2)/3 = n/1 * (n-1)/2 * (n-2)/3
     // nCr = n/1 * (n-1)/2 * (n-2)/3 * ... (n-r+1)/r
     //
-    // Note also that nCr = nC(r+1) * (r+1)/(n-r) and the same logic applies.
-    //
-    // nCn = 1
-    // nC(n-1) = nCn * n/1 = 1 * n/1 = n/1
-    // nC(n-2) = nC(n-1) * (n-1)/2 = n/1 * (n-1)/2
-    // nC(n-3) = nC(n-2) * (n-2)/3 = n/1 * (n-1)/2 * (n-2)/3
-    // nCr = n/1 * (n-1)/2 * (n-2)/3 * ... (r+1)/(n-r)
-    //
-    // Since both arrive at the same result using a different number of iterations, we simply choose the smaller of
-    // r and n-r.
-
-    int c = 1;
-    int k = std::min(r, n - r);
+    // Since nCr = nC(n-r), the smaller of r and n-r (k) is used. The factors are taken in the order
+    // (n-k+1)/1 * (n-k+2)/2 * ... n/k so that each intermediate value is (n-k+i)Ci, which is never larger than the
+    // result. (n-k+i-1)C(i-1) * (n-k+i) is a multiple of i, so the common factors of the intermediate value and i are
+    // removed first and the remaining divisor divides (n-k+i) exactly. As a result, the product overflows only if
+    // the result cannot be represented.
 
-    int a = n;
+    int const k = std::min(r, n - r);
+    int64_t   c = 1;
 
     for (int i = 1; i <= k; ++i)
     {
-        c *= a;
-        c /= i;
-        --a;
+        int64_t       m = n - k + i;
+        int64_t const g = std::gcd(c, int64_t(i));
+
+        c /= g;
+        m /= i / g;
+
+        if (c > std::numeric_limits<int64_t>::max() / m)
+            return 0;
+
+        c *= m;
     }
 
     return c;
 }
 
+//! @param	n		Number of items
+//! @param	r		Number of items chosen
+//! @param	pHi		Where to store the high 64 bits of nCr
+//! @param	pLo		Where to store the low 64 bits of nCr
+//!
+//! @return		false if the arguments are invalid or if the result cannot be represented in 128 bits
+
+bool Combinations128(int n, int r, uint64_t * pHi, uint64_t * pLo)
+{
+    if (n < 0 || r < 0 || r > n)
+        return false;
+
+    if (n <= PASCAL_MAX_N)
+    {
+        *pHi = 0;
+        *pLo = uint64_t(PASCALS_TRIANGLE[PascalIndex(n) + r]);
+        return true;
+    }
+
+    // See Combinations64()
+
+    int const k  = std::min(r, n - r);
+    uint64_t  hi = 0;
+    uint64_t  lo = 1;
+
+    for (int i = 1; i <= k; ++i)
+    {
+        uint32_t const g = std::gcd(Remainder128(hi, lo, uint32_t(i)), uint32_t(i));
+
+        Divide128(&hi, &lo, g);
+
+        if (!Multiply128(&hi, &lo, uint32_t(n - k + i) / (uint32_t(i) / g)))
+            return false;
+    }
+
+    *pHi = hi;
+    *pLo = lo;
+    return true;
+}
+
+double LogCombinations(int n, int r)
+{
+    if (n < 0 || r < 0 || r > n)
+        return -std::numeric_limits<double>::infinity();
+
+    if (n <= PASCAL_MAX_N)
+        return std::log(double(PASCALS_TRIANGLE[PascalIndex(n) + r]));
+
+    return LogFactorial(n) - LogFactorial(r) - LogFactorial(n - r);
+}
+
 int Permutations(int n, int r)
+{
+    int64_t const p = Permutations64(n, r);
+
+    return p <= std::numeric_limits<int>::max() ? int(p) : 0;
+}
+
+int64_t Permutations64(int n, int r)
 {
     // nPr = n! / ( n - r )!
     //
@@ -113,12 +291,75 @@ int Permutations(int n, int r)
     if (n < 0 || r < 0 || n < r)
         return 0;
 
-    int p = 1;
+    int64_t p = 1;
 
     for (int i = n - r + 1; i <= n; ++i)
     {
+        if (p > std::numeric_limits<int64_t>::max() / i)
+            return 0;
+
         p *= i;
     }
 
     return p;
 }
+
+//! @param	n		Number of items
+//! @param	r		Number of items chosen
+//! @param	pHi		Where to store the high 64 bits of nPr
+//! @param	pLo		Where to store the low 64 bits of nPr
+//!
+//! @return		false if the arguments are invalid or if the result cannot be represented in 128 bits
+
+bool Permutations128(int n, int r, uint64_t * pHi, uint64_t * pLo)
+{
+    if (n < 0 || r < 0 || n < r)
+        return false;
+
+    uint64_t hi = 0;
+    uint64_t lo = 1;
+
+    for (int i = n - r + 1; i <= n; ++i)
+    {
+        if (!Multiply128(&hi, &lo, uint32_t(i)))
+            return false;
+    }
+
+    *pHi = hi;
+    *pLo = lo;
+    return true;
+}
+
+double LogPermutations(int n, int r)
+{
+    if (n < 0 || r < 0 || n < r)
+        return -std::numeric_limits<double>::infinity();
+
+    return LogFactorial(n) - LogFactorial(n - r);
+}
+
+//! @param	n		Numbers of items
+//! @param	r		Numbers of items chosen
+//! @param	pC		Where to store the values of nCr
+//! @param	count	Number of (n, r) pairs
+
+void Combinations64(int const * n, int const * r, int64_t * pC, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pC[i] = Combinations64(n[i], r[i]);
+    }
+}
+
+//! @param	n		Numbers of items
+//! @param	r		Numbers of items chosen
+//! @param	pC		Where to store the values of log(nCr)
+//! @param	count	Number of (n, r) pairs
+
+void LogCombinations(int const * n, int const * r, double * pC, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pC[i] = LogCombinations(n[i], r[i]);
+    }
+}
@@ -0,0 +1,233 @@
+#include "QuaternionSoA.h"
+
+#include "Vector3SoA.h"
+
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+//! @param	q	Quaternion to append
+
+void QuaternionSoA::PushBack(Quaternion const & q)
+{
+    size_t const i = Size();
+
+    Resize(i + 1);
+    (*this)[i] = q;
+}
+
+//! @param	p	Quaternions
+//! @param	n	Number of quaternions
+//!
+//! With SSE, 4 quaternions are converted at a time with a 4x4 transpose.
+
+void QuaternionSoA::Load(Quaternion const * p, size_t n)
+{
+    Resize(n);
+
+    float * const x = GetX();
+    float * const y = GetY();
+    float * const z = GetZ();
+    float * const w = GetW();
+    size_t        i = 0;
+
+#if defined(__SSE2__)
+    static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be 4 packed floats");
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 r0 = _mm_loadu_ps(p[i + 0].m_Q);
+        __m128 r1 = _mm_loadu_ps(p[i + 1].m_Q);
+        __m128 r2 = _mm_loadu_ps(p[i + 2].m_Q);
+        __m128 r3 = _mm_loadu_ps(p[i + 3].m_Q);
+
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        _mm_store_ps(x + i, r0);
+        _mm_store_ps(y + i, r1);
+        _mm_store_ps(z + i, r2);
+        _mm_store_ps(w + i, r3);
+    }
+#endif // defined(__SSE2__)
+
+    for (; i < n; ++i)
+    {
+        x[i] = p[i].m_X;
+        y[i] = p[i].m_Y;
+        z[i] = p[i].m_Z;
+        w[i] = p[i].m_W;
+    }
+}
+
+//! @param	p	Where to store the quaternions. There must be room for Size() quaternions.
+//!
+//! With SSE, 4 quaternions are converted at a time with a 4x4 transpose.
+
+void QuaternionSoA::Store(Quaternion * p) const
+{
+    size_t const        n = Size();
+    float const * const x = GetX();
+    float const * const y = GetY();
+    float const * const z = GetZ();
+    float const * const w = GetW();
+    size_t              i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 r0 = _mm_load_ps(x + i);
+        __m128 r1 = _mm_load_ps(y + i);
+        __m128 r2 = _mm_load_ps(z + i);
+        __m128 r3 = _mm_load_ps(w + i);
+
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        _mm_storeu_ps(p[i + 0].m_Q, r0);
+        _mm_storeu_ps(p[i + 1].m_Q, r1);
+        _mm_storeu_ps(p[i + 2].m_Q, r2);
+        _mm_storeu_ps(p[i + 3].m_Q, r3);
+    }
+#endif // defined(__SSE2__)
+
+    for (; i < n; ++i)
+    {
+        p[i].m_X = x[i];
+        p[i].m_Y = y[i];
+        p[i].m_Z = z[i];
+        p[i].m_W = w[i];
+    }
+}
+
+namespace MyMath
+{
+// The operations process the padding too, so that the loops have no remainder when vectorized.
+
+void Multiply(QuaternionSoA const & a, QuaternionSoA const & b, QuaternionSoA * pR)
+{
+    assert(a.Size() == b.Size());
+
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float const * const aw = a.GetW();
+    float const * const bx = b.GetX();
+    float const * const by = b.GetY();
+    float const * const bz = b.GetZ();
+    float const * const bw = b.GetW();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    float * const       rw = pR->GetW();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const x = aw[i] * bx[i] + ax[i] * bw[i] + ay[i] * bz[i] - az[i] * by[i];
+        float const y = aw[i] * by[i] - ax[i] * bz[i] + ay[i] * bw[i] + az[i] * bx[i];
+        float const z = aw[i] * bz[i] + ax[i] * by[i] - ay[i] * bx[i] + az[i] * bw[i];
+        float const w = aw[i] * bw[i] - ax[i] * bx[i] - ay[i] * by[i] - az[i] * bz[i];
+
+        rx[i] = x;
+        ry[i] = y;
+        rz[i] = z;
+        rw[i] = w;
+    }
+}
+
+//! Zero-length elements remain 0.
+
+void Normalize(QuaternionSoA const & a, QuaternionSoA * pR)
+{
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float const * const aw = a.GetW();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    float * const       rw = pR->GetW();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const l2 = ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i] + aw[i] * aw[i];
+        float const il = (l2 > 0.0f) ? 1.0f / std::sqrt(l2) : 0.0f;
+
+        rx[i] = ax[i] * il;
+        ry[i] = ay[i] * il;
+        rz[i] = az[i] * il;
+        rw[i] = aw[i] * il;
+    }
+}
+
+void Conjugate(QuaternionSoA const & a, QuaternionSoA * pR)
+{
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float const * const aw = a.GetW();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    float * const       rw = pR->GetW();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        rx[i] = -ax[i];
+        ry[i] = -ay[i];
+        rz[i] = -az[i];
+        rw[i] = aw[i];
+    }
+}
+
+void Rotate(Vector3SoA const & v, QuaternionSoA const & q, Vector3SoA * pR)
+{
+    assert(v.Size() == q.Size());
+
+    pR->Resize(v.Size());
+
+    float const * const vx = v.GetX();
+    float const * const vy = v.GetY();
+    float const * const vz = v.GetZ();
+    float const * const qx = q.GetX();
+    float const * const qy = q.GetY();
+    float const * const qz = q.GetZ();
+    float const * const qw = q.GetW();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = v.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const x = vx[i];
+        float const y = vy[i];
+        float const z = vz[i];
+
+        float const xx = qx[i] * qx[i];
+        float const xy = qx[i] * qy[i];
+        float const xz = qx[i] * qz[i];
+        float const xw = qx[i] * qw[i];
+
+        float const yy = qy[i] * qy[i];
+        float const yz = qy[i] * qz[i];
+        float const yw = qy[i] * qw[i];
+
+        float const zz = qz[i] * qz[i];
+        float const zw = qz[i] * qw[i];
+
+        rx[i] = x + 2.0f * (-x * (yy + zz) + y * (xy - zw) + z * (xz + yw));
+        ry[i] = y + 2.0f * (x * (xy + zw) - y * (xx + zz) + z * (yz - xw));
+        rz[i] = z + 2.0f * (x * (xz - yw) + y * (yz + xw) - z * (xx + yy));
+    }
+}
+} // namespace MyMath
@@ -0,0 +1,714 @@
+#include "Random.h"
+
+#include "Box.h"
+#include "Cone.h"
+#include "MyMath.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Vector3.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Philox4x32 constants
+uint32_t const PHILOX_M0 = 0xD2511F53;
+uint32_t const PHILOX_M1 = 0xCD9E8D57;
+uint32_t const PHILOX_W0 = 0x9E3779B9;
+uint32_t const PHILOX_W1 = 0xBB67AE85;
+int const PHILOX_ROUNDS  = 10;
+
+int const LANES      = 8;       // Number of blocks encrypted at a time by Philox::Fill()
+size_t const CHUNK   = 256;     // Number of 32-bit values generated at a time by the batch distributions
+
+float const  FLOAT_ULP  = 1.0f / 16777216.0f;           // 2^-24
+double const DOUBLE_ULP = 1.0 / 9007199254740992.0;     // 2^-53
+
+// Encrypts L counters with the Philox4x32-10 function. The counters are stored as a structure of arrays so that
+// the rounds can be vectorized.
+template <int L>
+void Encrypt(uint32_t const key[2], uint32_t c[4][L])
+{
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (int r = 0; r < PHILOX_ROUNDS; ++r)
+    {
+        for (int i = 0; i < L; ++i)
+        {
+            uint64_t const p0 = uint64_t(PHILOX_M0) * c[0][i];
+            uint64_t const p1 = uint64_t(PHILOX_M1) * c[2][i];
+            uint32_t const x0 = uint32_t(p1 >> 32) ^ c[1][i] ^ k0;
+            uint32_t const x2 = uint32_t(p0 >> 32) ^ c[3][i] ^ k1;
+
+            c[0][i] = x0;
+            c[1][i] = uint32_t(p1);
+            c[2][i] = x2;
+            c[3][i] = uint32_t(p0);
+        }
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+}
+
+// Converts a 32-bit random value to a float uniformly distributed in [0, 1)
+float ToFloat(uint32_t u)
+{
+    return float(u >> 8) * FLOAT_ULP;
+}
+
+// Converts a 32-bit random value to a float uniformly distributed in (0, 1]
+float ToFloatNonZero(uint32_t u)
+{
+    return float((u >> 8) + 1) * FLOAT_ULP;
+}
+
+// Converts two 32-bit random values to a double uniformly distributed in [0, 1)
+double ToDouble(uint32_t hi, uint32_t lo)
+{
+    return double(((uint64_t(hi) << 32) | lo) >> 11) * DOUBLE_ULP;
+}
+
+// Returns a pair of independent normally-distributed values computed from two uniform values using the Box-Muller
+// transform. u0 must be in (0, 1].
+template <typename T>
+void BoxMuller(T u0, T u1, T * pZ0, T * pZ1)
+{
+    T const r     = std::sqrt(T(-2) * std::log(u0));
+    T const theta = T(MyMath::TWO_PI) * u1;
+
+    *pZ0 = r * std::cos(theta);
+    *pZ1 = r * std::sin(theta);
+}
+
+// Returns a binomially-distributed value for small n * p using inversion
+int BinomialInversion(Philox & rng, int n, double p)
+{
+    double const q = 1.0 - p;
+    double const s = p / q;
+    double const a = (n + 1) * s;
+
+    for (;;)
+    {
+        double r = std::pow(q, n);
+        double u = rng.NextDouble();
+        int    x = 0;
+
+        while (u > r)
+        {
+            u -= r;
+            ++x;
+            if (x > n)
+                break;
+            r *= a / x - s;
+        }
+
+        if (x <= n)
+            return x;
+    }
+}
+
+// Returns a binomially-distributed value for large n * p using transformed rejection (BTRS, Hormann 1993)
+int BinomialRejection(Philox & rng, int n, double p)
+{
+    double const q     = 1.0 - p;
+    double const spq   = std::sqrt(n * p * q);
+    double const b     = 1.15 + 2.53 * spq;
+    double const a     = -0.0873 + 0.0248 * b + 0.01 * p;
+    double const c     = n * p + 0.5;
+    double const vr    = 0.92 - 4.2 / b;
+    double const alpha = (2.83 + 5.1 / b) * spq;
+    double const lpq   = std::log(p / q);
+    double const m     = std::floor((n + 1) * p);
+    double const h     = MyMath::LogGamma(m + 1.0) + MyMath::LogGamma(n - m + 1.0);
+
+    for (;;)
+    {
+        double const u  = rng.NextDouble() - 0.5;
+        double       v  = rng.NextDouble();
+        double const us = 0.5 - std::fabs(u);
+        double const k  = std::floor((2.0 * a / us + b) * u + c);
+
+        if (k < 0.0 || k > n)
+            continue;
+
+        if (us >= 0.07 && v <= vr)
+            return int(k);
+
+        v = std::log(v * alpha / (a / (us * us) + b));
+        if (v <= h - MyMath::LogGamma(k + 1.0) - MyMath::LogGamma(n - k + 1.0) + (k - m) * lpq)
+            return int(k);
+    }
+}
+
+// Returns an orthonormal basis whose third axis is d. d must be normalized.
+void MakeBasis(Vector3 const & d, Vector3 * pT1, Vector3 * pT2)
+{
+    Vector3 const a = std::fabs(d.m_X) < 0.9f ? Vector3::XAxis() : Vector3::YAxis();
+
+    *pT1 = Cross(d, a).Normalize();
+    *pT2 = Cross(d, *pT1);
+}
+} // anonymous namespace
+
+//! @param	seed	Seed (the key of the encryption)
+//! @param	stream	Stream number. Generators with the same seed and different streams produce independent sequences.
+
+Philox::Philox(uint64_t seed, uint64_t stream)
+    : m_Key{ uint32_t(seed), uint32_t(seed >> 32) }
+    , m_Counter{ 0, 0, uint32_t(stream), uint32_t(stream >> 32) }
+    , m_Index(4)
+{
+}
+
+uint32_t Philox::operator ()()
+{
+    if (m_Index >= 4)
+        Generate();
+
+    return m_Block[m_Index++];
+}
+
+uint64_t Philox::Next64()
+{
+    uint64_t const hi = (*this)();
+    return (hi << 32) | (*this)();
+}
+
+float Philox::NextFloat()
+{
+    return ToFloat((*this)());
+}
+
+double Philox::NextDouble()
+{
+    uint32_t const hi = (*this)();
+    return ToDouble(hi, (*this)());
+}
+
+//! @param	p		Where to store the values
+//! @param	count	Number of values
+//!
+//! The values are the same as those returned by calling operator () @a count times. Blocks are generated in
+//! groups of 8 so that the encryption can be vectorized.
+
+void Philox::Fill(uint32_t * p, size_t count)
+{
+    // Use the remainder of the current block first
+
+    while (count > 0 && m_Index < 4)
+    {
+        *p++ = m_Block[m_Index++];
+        --count;
+    }
+
+    for (; count >= 4 * LANES; count -= 4 * LANES, p += 4 * LANES)
+    {
+        uint64_t const block = (uint64_t(m_Counter[1]) << 32) | m_Counter[0];
+        uint32_t       c[4][LANES];
+
+        for (int i = 0; i < LANES; ++i)
+        {
+            c[0][i] = uint32_t(block + i);
+            c[1][i] = uint32_t((block + i) >> 32);
+            c[2][i] = m_Counter[2];
+            c[3][i] = m_Counter[3];
+        }
+
+        Encrypt<LANES>(m_Key, c);
+
+        for (int i = 0; i < LANES; ++i)
+        {
+            p[4 * i + 0] = c[0][i];
+            p[4 * i + 1] = c[1][i];
+            p[4 * i + 2] = c[2][i];
+            p[4 * i + 3] = c[3][i];
+        }
+
+        Seek(block + LANES);
+    }
+
+    for (; count > 0; --count)
+    {
+        *p++ = (*this)();
+    }
+}
+
+//! @param	block	Index of the 128-bit block in the stream. The next value returned is the first 32 bits of the block.
+
+void Philox::Seek(uint64_t block)
+{
+    m_Counter[0] = uint32_t(block);
+    m_Counter[1] = uint32_t(block >> 32);
+    m_Index      = 4;
+}
+
+void Philox::Generate()
+{
+    uint32_t c[4][1] = { { m_Counter[0] }, { m_Counter[1] }, { m_Counter[2] }, { m_Counter[3] } };
+
+    Encrypt<1>(m_Key, c);
+
+    m_Block[0] = c[0][0];
+    m_Block[1] = c[1][0];
+    m_Block[2] = c[2][0];
+    m_Block[3] = c[3][0];
+    m_Index    = 0;
+
+    if (++m_Counter[0] == 0)
+        ++m_Counter[1];
+}
+
+//! @param	weights		Relative probabilities of the values. The weights must not be negative and the sum must
+//!						be greater than 0.
+//! @param	n			Number of values
+
+AliasTable::AliasTable(double const * weights, int n)
+    : m_Threshold(n)
+    , m_Alias(n)
+{
+    assert(n > 0);
+
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        assert(weights[i] >= 0.0);
+        sum += weights[i];
+    }
+
+    assert(sum > 0.0);
+
+    // Vose's algorithm: Each value is assigned a column of height 1. Columns of values with less than the average
+    // probability are filled from columns of values with more than the average.
+
+    std::vector<double> p(n);
+    std::vector<int>    small;
+    std::vector<int>    large;
+
+    for (int i = 0; i < n; ++i)
+    {
+        p[i] = weights[i] * n / sum;
+        if (p[i] < 1.0)
+            small.push_back(i);
+        else
+            large.push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        int const s = small.back();
+        int const l = large.back();
+        small.pop_back();
+
+        m_Threshold[s] = uint32_t(std::min(p[s] * 4294967296.0, 4294967295.0));
+        m_Alias[s]     = l;
+
+        p[l] = (p[l] + p[s]) - 1.0;
+        if (p[l] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // The remaining columns are full (except for rounding errors).
+
+    for (int i : large)
+    {
+        m_Threshold[i] = 0xffffffff;
+        m_Alias[i]     = i;
+    }
+
+    for (int i : small)
+    {
+        m_Threshold[i] = 0xffffffff;
+        m_Alias[i]     = i;
+    }
+}
+
+//! @param	rng		Random number generator
+//!
+//! The upper 32 bits of a 64-bit random value select the column and the lower 32 bits select the value in the column.
+
+int AliasTable::Sample(Philox & rng) const
+{
+    uint64_t const u = rng.Next64();
+    int const      i = int(((u >> 32) * m_Alias.size()) >> 32);
+
+    return uint32_t(u) < m_Threshold[i] ? i : m_Alias[i];
+}
+
+namespace MyMath
+{
+//! @param	rng		Random number generator
+//! @param	n		Number of values (must be greater than 0)
+//!
+//! The result is unbiased (Lemire's method).
+
+uint32_t UniformInt(Philox & rng, uint32_t n)
+{
+    assert(n > 0);
+
+    uint64_t m = uint64_t(rng()) * n;
+    if (uint32_t(m) < n)
+    {
+        uint32_t const threshold = uint32_t(-n) % n;
+        while (uint32_t(m) < threshold)
+        {
+            m = uint64_t(rng()) * n;
+        }
+    }
+
+    return uint32_t(m >> 32);
+}
+
+//! @param	rng		Random number generator
+//! @param	min		Minimum value
+//! @param	max		Maximum value
+
+double Uniform(Philox & rng, double min, double max)
+{
+    return min + (max - min) * rng.NextDouble();
+}
+
+//! @param	rng		Random number generator
+//! @param	mean	Mean
+//! @param	sd		Standard deviation
+
+double Normal(Philox & rng, double mean, double sd)
+{
+    double const u0 = 1.0 - rng.NextDouble();
+    double const u1 = rng.NextDouble();
+    double       z0;
+    double       z1;
+
+    BoxMuller(u0, u1, &z0, &z1);
+
+    return mean + sd * z0;
+}
+
+//! @param	rng		Random number generator
+//! @param	n		Number of trials
+//! @param	p		Probability of success of each trial
+//!
+//! @return		Number of successes
+//!
+//! Inversion is used when n * p is small and transformed rejection (BTRS) otherwise.
+
+int Binomial(Philox & rng, int n, double p)
+{
+    assert(n >= 0);
+    assert(p >= 0.0 && p <= 1.0);
+
+    if (p > 0.5)
+        return n - Binomial(rng, n, 1.0 - p);
+
+    if (n == 0 || p == 0.0)
+        return 0;
+
+    if (n * p < 10.0)
+        return BinomialInversion(rng, n, p);
+    else
+        return BinomialRejection(rng, n, p);
+}
+
+//! @param	rng		Random number generator
+//! @param	mean	Mean (must not be negative)
+//!
+//! Inversion is used when the mean is small and transformed rejection (PTRS, Hormann 1993) otherwise.
+
+int Poisson(Philox & rng, double mean)
+{
+    assert(mean >= 0.0);
+
+    if (mean < 10.0)
+    {
+        double p = std::exp(-mean);
+        double f = p;
+        double u = rng.NextDouble();
+        int    k = 0;
+
+        while (u > f && p > 0.0)
+        {
+            ++k;
+            p *= mean / k;
+            f += p;
+        }
+
+        return k;
+    }
+
+    double const slam     = std::sqrt(mean);
+    double const loglam   = std::log(mean);
+    double const b        = 0.931 + 2.53 * slam;
+    double const a        = -0.059 + 0.02483 * b;
+    double const invalpha = 1.1239 + 1.1328 / (b - 3.4);
+    double const vr       = 0.9277 - 3.6224 / (b - 2.0);
+
+    for (;;)
+    {
+        double const u  = rng.NextDouble() - 0.5;
+        double const v  = rng.NextDouble();
+        double const us = 0.5 - std::fabs(u);
+        double const k  = std::floor((2.0 * a / us + b) * u + mean + 0.43);
+
+        if (us >= 0.07 && v <= vr)
+            return int(k);
+
+        if (k < 0.0 || (us < 0.013 && v > us))
+            continue;
+
+        if (std::log(v) + std::log(invalpha) - std::log(a / (us * us) + b) <= -mean + k * loglam - LogGamma(k + 1.0))
+            return int(k);
+    }
+}
+
+//! @param	rng		Random number generator
+//! @param	p		Where to store the values
+//! @param	count	Number of values
+
+void Uniform(Philox & rng, float * p, size_t count)
+{
+    uint32_t u[CHUNK];
+
+    while (count > 0)
+    {
+        size_t const n = std::min(count, CHUNK);
+
+        rng.Fill(u, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            p[i] = ToFloat(u[i]);
+        }
+
+        p     += n;
+        count -= n;
+    }
+}
+
+//! @param	rng		Random number generator
+//! @param	p		Where to store the values
+//! @param	count	Number of values
+
+void Uniform(Philox & rng, double * p, size_t count)
+{
+    uint32_t u[CHUNK];
+
+    while (count > 0)
+    {
+        size_t const n = std::min(count, CHUNK / 2);
+
+        rng.Fill(u, 2 * n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            p[i] = ToDouble(u[2 * i], u[2 * i + 1]);
+        }
+
+        p     += n;
+        count -= n;
+    }
+}
+
+//! @param	rng		Random number generator
+//! @param	p		Where to store the values
+//! @param	count	Number of values
+//! @param	mean	Mean
+//! @param	sd		Standard deviation
+//!
+//! The values are generated in pairs using the Box-Muller transform.
+
+void Normal(Philox & rng, float * p, size_t count, float mean, float sd)
+{
+    uint32_t u[CHUNK];
+
+    while (count > 0)
+    {
+        size_t const n = std::min(count, CHUNK);
+        size_t const m = (n + 1) & ~size_t(1);
+
+        rng.Fill(u, m);
+        for (size_t i = 0; i < m; i += 2)
+        {
+            float z0;
+            float z1;
+
+            BoxMuller(ToFloatNonZero(u[i]), ToFloat(u[i + 1]), &z0, &z1);
+
+            p[i] = mean + sd * z0;
+            if (i + 1 < n)
+                p[i + 1] = mean + sd * z1;
+        }
+
+        p     += n;
+        count -= n;
+    }
+}
+
+//! @param	rng		Random number generator
+//! @param	p		Where to store the values
+//! @param	count	Number of values
+//! @param	mean	Mean
+//! @param	sd		Standard deviation
+//!
+//! The values are generated in pairs using the Box-Muller transform.
+
+void Normal(Philox & rng, double * p, size_t count, double mean, double sd)
+{
+    uint32_t u[CHUNK];
+
+    while (count > 0)
+    {
+        size_t const n = std::min(count, CHUNK / 2);
+        size_t const m = (n + 1) & ~size_t(1);
+
+        rng.Fill(u, 2 * m);
+        for (size_t i = 0; i < m; i += 2)
+        {
+            double z0;
+            double z1;
+
+            BoxMuller(1.0 - ToDouble(u[2 * i], u[2 * i + 1]), ToDouble(u[2 * i + 2], u[2 * i + 3]), &z0, &z1);
+
+            p[i] = mean + sd * z0;
+            if (i + 1 < n)
+                p[i + 1] = mean + sd * z1;
+        }
+
+        p     += n;
+        count -= n;
+    }
+}
+
+//! @param	rng		Random number generator
+//! @param	sphere	Sphere
+
+Vector3 UniformOnSphere(Philox & rng, Sphere const & sphere)
+{
+    float const z   = 1.0f - 2.0f * rng.NextFloat();
+    float const phi = float(TWO_PI) * rng.NextFloat();
+    float const r   = std::sqrt(std::max(0.0f, 1.0f - z * z));
+
+    return sphere.m_C + Vector3(r * std::cos(phi), r * std::sin(phi), z) * sphere.m_R;
+}
+
+//! @param	rng		Random number generator
+//! @param	sphere	Sphere
+
+Vector3 UniformInSphere(Philox & rng, Sphere const & sphere)
+{
+    float const z   = 1.0f - 2.0f * rng.NextFloat();
+    float const phi = float(TWO_PI) * rng.NextFloat();
+    float const r   = std::sqrt(std::max(0.0f, 1.0f - z * z));
+    float const d   = std::cbrt(rng.NextFloat()) * sphere.m_R;
+
+    return sphere.m_C + Vector3(r * std::cos(phi), r * std::sin(phi), z) * d;
+}
+
+//! @param	rng		Random number generator
+//! @param	box		Box
+
+Vector3 UniformInBox(Philox & rng, AABox const & box)
+{
+    float const x = rng.NextFloat();
+    float const y = rng.NextFloat();
+    float const z = rng.NextFloat();
+
+    return box.m_Position + Vector3(x * box.m_Scale.m_X, y * box.m_Scale.m_Y, z * box.m_Scale.m_Z);
+}
+
+//! @param	rng		Random number generator
+//! @param	box		Box
+
+Vector3 UniformInBox(Philox & rng, Box const & box)
+{
+    float const x = rng.NextFloat();
+    float const y = rng.NextFloat();
+    float const z = rng.NextFloat();
+
+    // The inverse of the box's inverse orientation is its transpose.
+
+    return box.m_Position + Vector3(x * box.m_Scale.m_X, y * box.m_Scale.m_Y, z * box.m_Scale.m_Z) * box.GetOrientation();
+}
+
+//! @param	rng		Random number generator
+//! @param	cone	Cone. The direction must be normalized.
+//!
+//! @return		A unit vector
+
+Vector3 UniformDirectionInCone(Philox & rng, Cone const & cone)
+{
+    assert(cone.m_D.IsNormalized());
+
+    Vector3 t1;
+    Vector3 t2;
+    MakeBasis(cone.m_D, &t1, &t2);
+
+    // The cosine of the angle from the axis is uniformly distributed in [cos(a), 1].
+
+    float const z   = 1.0f - rng.NextFloat() * (1.0f - cone.m_A);
+    float const phi = float(TWO_PI) * rng.NextFloat();
+    float const r   = std::sqrt(std::max(0.0f, 1.0f - z * z));
+
+    return t1 * (r * std::cos(phi)) + t2 * (r * std::sin(phi)) + cone.m_D * z;
+}
+
+//! @param	rng		Random number generator
+//! @param	cone	Cone. The direction must be normalized.
+//! @param	height	Distance from the vertex along the direction at which the cone is truncated
+
+Vector3 UniformInCone(Philox & rng, Cone const & cone, float height)
+{
+    assert(cone.m_D.IsNormalized());
+    assert(height > 0.0f);
+
+    Vector3 t1;
+    Vector3 t2;
+    MakeBasis(cone.m_D, &t1, &t2);
+
+    // The area of a cross-section is proportional to the square of its distance from the vertex, so the distance is
+    // distributed as the cube root of a uniform value. The point is uniformly distributed in the cross-section.
+
+    float const tana = std::sqrt(1.0f - cone.m_A * cone.m_A) / cone.m_A;
+    float const t    = height * std::cbrt(rng.NextFloat());
+    float const r    = t * tana * std::sqrt(rng.NextFloat());
+    float const phi  = float(TWO_PI) * rng.NextFloat();
+
+    return cone.m_V + cone.m_D * t + t1 * (r * std::cos(phi)) + t2 * (r * std::sin(phi));
+}
+
+//! @param	rng		Random number generator
+//! @param	poly	Polygon. The polygon must be convex and have at least 3 vertices.
+//!
+//! The polygon is divided into a fan of triangles. A triangle is chosen with probability proportional to its area,
+//! and then a point is chosen uniformly in the triangle. The time is proportional to the number of vertices.
+
+Vector3 UniformOnPoly(Philox & rng, Poly const & poly)
+{
+    assert(poly.GetVertexCount() >= 3);
+
+    Vector3 const * const v = poly.GetVertices();
+
+    float total = 0.0f;
+    for (int i = 2; i < poly.GetVertexCount(); ++i)
+    {
+        total += Cross(v[i - 1] - v[0], v[i] - v[0]).Length();
+    }
+
+    float a = rng.NextFloat() * total;
+    int   i = 2;
+    for (; i < poly.GetVertexCount() - 1; ++i)
+    {
+        float const area = Cross(v[i - 1] - v[0], v[i] - v[0]).Length();
+        if (a < area)
+            break;
+        a -= area;
+    }
+
+    float const su = std::sqrt(rng.NextFloat());
+    float const u1 = rng.NextFloat();
+
+    return v[0] * (1.0f - su) + v[i - 1] * (su * (1.0f - u1)) + v[i] * (su * u1);
+}
+} // namespace MyMath
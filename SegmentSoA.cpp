@@ -0,0 +1,469 @@
+#include "SegmentSoA.h"
+
+#include "Plane.h"
+#include "PolyBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+// Returns true if x is between 0 and d (in either order)
+bool IsInRange(float x, float d)
+{
+    return x >= std::min(0.0f, d) && x <= std::max(0.0f, d);
+}
+
+// Segments whose directions are within about this angle (in radians) of a common plane are treated as coplanar
+float const COPLANAR_EPSILON = 1.0e-5f;
+
+// Returns true if the segments a.B + s * a.M and b.B + t * b.M are coplanar, given c x b.M (c = a.B - b.B). That is
+// the normal of the plane containing b and a.B, and the segments are coplanar if a.M is perpendicular to it.
+bool AreCoplanar(Vector3 const & aM, Vector3 const & n)
+{
+    float const v = Dot(aM, n);
+
+    return v * v <= COPLANAR_EPSILON * COPLANAR_EPSILON * Dot(aM, aM) * Dot(n, n);
+}
+
+// Tests if the segments a.B + s * a.M and b.B + t * b.M intersect by projecting them onto the xy, xz and yz planes
+// (see Intersectable::Intersects(Segment const &, Segment const &)). If so, s and t are returned for the first point
+// they have in common.
+bool IntersectProjected(Vector3 const & aB, Vector3 const & aM, Vector3 const & bB, Vector3 const & bM,
+                        float * pS, float * pT)
+{
+    Vector3 const c = aB - bB;
+
+    float const s[3] = { c.m_X * bM.m_Y - c.m_Y * bM.m_X,
+                         c.m_X * bM.m_Z - c.m_Z * bM.m_X,
+                         c.m_Y * bM.m_Z - c.m_Z * bM.m_Y };
+    float const t[3] = { c.m_X * aM.m_Y - c.m_Y * aM.m_X,
+                         c.m_X * aM.m_Z - c.m_Z * aM.m_X,
+                         c.m_Y * aM.m_Z - c.m_Z * aM.m_Y };
+    float const d[3] = { bM.m_X * aM.m_Y - bM.m_Y * aM.m_X,
+                         bM.m_X * aM.m_Z - bM.m_Z * aM.m_X,
+                         bM.m_Y * aM.m_Z - bM.m_Z * aM.m_Y };
+
+    int best = 0;
+
+    for (int i = 1; i < 3; ++i)
+    {
+        if (std::abs(d[i]) > std::abs(d[best]))
+            best = i;
+    }
+
+    // If the segments aren't parallel, the projection with the largest determinant gives s and t. The lines through
+    // the segments meet there only if they are also coplanar. Note that c x b.M is (s[2], -s[1], s[0]).
+
+    if (d[best] != 0.0f)
+    {
+        if (!IsInRange(s[best], d[best]) || !IsInRange(t[best], d[best]))
+            return false;
+        if (!AreCoplanar(aM, Vector3(s[2], -s[1], s[0])))
+            return false;
+
+        *pS = s[best] / d[best];
+        *pT = t[best] / d[best];
+        return true;
+    }
+
+    // The segments are parallel, so they intersect only if they are collinear (c x a.M and c x b.M are 0) and
+    // overlap. The overlap is measured along the longer one.
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (s[i] != 0.0f || t[i] != 0.0f)
+            return false;
+    }
+
+    Vector3 const & u  = (Dot(aM, aM) >= Dot(bM, bM)) ? aM : bM;
+    float const     a0 = Dot(aB, u);
+    float const     a1 = a0 + Dot(aM, u);
+    float const     b0 = Dot(bB, u);
+    float const     b1 = b0 + Dot(bM, u);
+    float const     lo = std::max(std::min(a0, a1), std::min(b0, b1));
+    float const     hi = std::min(std::max(a0, a1), std::max(b0, b1));
+
+    if (lo > hi || (a0 == a1 && b0 == b1 && Dot(c, c) != 0.0f))
+        return false;
+
+    // The first point of a in the overlap, and where it is on b
+
+    float const p = (a1 >= a0) ? lo : hi;
+
+    *pS = (a1 != a0) ? (p - a0) / (a1 - a0) : 0.0f;
+    *pT = (b1 != b0) ? (p - b0) / (b1 - b0) : 0.0f;
+    return true;
+}
+
+// Returns true if a point in the plane of a convex polygon is inside it or on its boundary. The vertices may wind
+// either way around the normal.
+bool Contains(Vector3 const & normal, Vector3 const * paVertices, int nVertices, Vector3 const & p)
+{
+    if (nVertices < 3)
+        return false;
+
+    bool positive = false;
+    bool negative = false;
+
+    for (int i = 0, j = nVertices - 1; i < nVertices; j = i++)
+    {
+        float const w = Dot(Cross(paVertices[i] - paVertices[j], p - paVertices[j]), normal);
+
+        positive = positive || (w > 0.0f);
+        negative = negative || (w < 0.0f);
+    }
+
+    return !(positive && negative);
+}
+} // anonymous namespace
+
+//! @param	segment		Segment to append
+
+void SegmentSoA::PushBack(Segment const & segment)
+{
+    size_t const i = Size();
+
+    m_Storage.Resize(i + 1);
+    Set(i, segment);
+}
+
+//! @param	i	Index of the element
+
+Segment SegmentSoA::operator [](size_t i) const
+{
+    Segment segment;
+
+    segment.m_B = Vector3(GetStream(B_X)[i], GetStream(B_Y)[i], GetStream(B_Z)[i]);
+    segment.m_M = Vector3(GetStream(M_X)[i], GetStream(M_Y)[i], GetStream(M_Z)[i]);
+
+    return segment;
+}
+
+//! @param	p	Segments
+//! @param	n	Number of segments
+
+void SegmentSoA::Load(Segment const * p, size_t n)
+{
+    m_Storage.Resize(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Set(i, p[i]);
+    }
+}
+
+void SegmentSoA::Set(size_t i, Segment const & segment)
+{
+    Vector3 const & b = segment.m_B;
+    Vector3 const   e = segment.m_B + segment.m_M;
+
+    m_Storage.GetStream(B_X)[i]   = b.m_X;
+    m_Storage.GetStream(B_Y)[i]   = b.m_Y;
+    m_Storage.GetStream(B_Z)[i]   = b.m_Z;
+    m_Storage.GetStream(M_X)[i]   = segment.m_M.m_X;
+    m_Storage.GetStream(M_Y)[i]   = segment.m_M.m_Y;
+    m_Storage.GetStream(M_Z)[i]   = segment.m_M.m_Z;
+    m_Storage.GetStream(MIN_X)[i] = std::min(b.m_X, e.m_X);
+    m_Storage.GetStream(MIN_Y)[i] = std::min(b.m_Y, e.m_Y);
+    m_Storage.GetStream(MIN_Z)[i] = std::min(b.m_Z, e.m_Z);
+    m_Storage.GetStream(MAX_X)[i] = std::max(b.m_X, e.m_X);
+    m_Storage.GetStream(MAX_Y)[i] = std::max(b.m_Y, e.m_Y);
+    m_Storage.GetStream(MAX_Z)[i] = std::max(b.m_Z, e.m_Z);
+}
+
+namespace MyMath
+{
+//! @param	segment		Segment to test
+//! @param	segments	Segments to test against
+//! @param	paIndices	Where to store the indexes of the segments that are hit
+//! @param	paS			Where to store the values of @a segment's t at the hits (or nullptr)
+//! @param	paT			Where to store the values of the hit segments' t at the hits (or nullptr)
+//!
+//! @return		Number of segments hit
+//!
+//! The result of each test is the same as Intersectable::Intersects(Segment const &, Segment const &), except that
+//! segments whose bounding boxes don't overlap are always rejected. With AVX2, 8 segments are tested at a time and
+//! groups whose bounding boxes all miss are skipped after the first comparisons.
+
+int Intersect(Segment const & segment, SegmentSoA const & segments, int * paIndices, float * paS, float * paT)
+{
+    Vector3 const & aB   = segment.m_B;
+    Vector3 const & aM   = segment.m_M;
+    Vector3 const   aE   = aB + aM;
+    Vector3 const   aMin(std::min(aB.m_X, aE.m_X), std::min(aB.m_Y, aE.m_Y), std::min(aB.m_Z, aE.m_Z));
+    Vector3 const   aMax(std::max(aB.m_X, aE.m_X), std::max(aB.m_Y, aE.m_Y), std::max(aB.m_Z, aE.m_Z));
+
+    float const * const bX   = segments.GetStream(SegmentSoA::B_X);
+    float const * const bY   = segments.GetStream(SegmentSoA::B_Y);
+    float const * const bZ   = segments.GetStream(SegmentSoA::B_Z);
+    float const * const mX   = segments.GetStream(SegmentSoA::M_X);
+    float const * const mY   = segments.GetStream(SegmentSoA::M_Y);
+    float const * const mZ   = segments.GetStream(SegmentSoA::M_Z);
+    float const * const minX = segments.GetStream(SegmentSoA::MIN_X);
+    float const * const minY = segments.GetStream(SegmentSoA::MIN_Y);
+    float const * const minZ = segments.GetStream(SegmentSoA::MIN_Z);
+    float const * const maxX = segments.GetStream(SegmentSoA::MAX_X);
+    float const * const maxY = segments.GetStream(SegmentSoA::MAX_Y);
+    float const * const maxZ = segments.GetStream(SegmentSoA::MAX_Z);
+    int const           n    = int(segments.Size());
+    int                 hits = 0;
+
+#if defined(__AVX2__)
+    __m256 const  vZero = _mm256_setzero_ps();
+    __m256 const  vSign = _mm256_set1_ps(-0.0f);
+    __m256i const vLane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 const  aMinX = _mm256_set1_ps(aMin.m_X);
+    __m256 const  aMinY = _mm256_set1_ps(aMin.m_Y);
+    __m256 const  aMinZ = _mm256_set1_ps(aMin.m_Z);
+    __m256 const  aMaxX = _mm256_set1_ps(aMax.m_X);
+    __m256 const  aMaxY = _mm256_set1_ps(aMax.m_Y);
+    __m256 const  aMaxZ = _mm256_set1_ps(aMax.m_Z);
+    __m256 const  aBX   = _mm256_set1_ps(aB.m_X);
+    __m256 const  aBY   = _mm256_set1_ps(aB.m_Y);
+    __m256 const  aBZ   = _mm256_set1_ps(aB.m_Z);
+    __m256 const  aMX   = _mm256_set1_ps(aM.m_X);
+    __m256 const  aMY   = _mm256_set1_ps(aM.m_Y);
+    __m256 const  aMZ   = _mm256_set1_ps(aM.m_Z);
+    __m256 const  vLim  = _mm256_set1_ps(COPLANAR_EPSILON * COPLANAR_EPSILON * Dot(aM, aM));
+
+    // Returns the lanes where s and t are between 0 and d
+    auto const inRange = [vZero](__m256 s, __m256 t, __m256 d)
+    {
+        __m256 const lo = _mm256_min_ps(vZero, d);
+        __m256 const hi = _mm256_max_ps(vZero, d);
+        return _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(s, lo, _CMP_GE_OQ), _mm256_cmp_ps(s, hi, _CMP_LE_OQ)),
+                             _mm256_and_ps(_mm256_cmp_ps(t, lo, _CMP_GE_OQ), _mm256_cmp_ps(t, hi, _CMP_LE_OQ)));
+    };
+
+    for (int i = 0; i < n; i += 8)
+    {
+        // Reject by the bounding boxes. The padding is masked off.
+
+        __m256 overlap = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(n - i), vLane));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(aMinX, _mm256_load_ps(maxX + i), _CMP_LE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(aMaxX, _mm256_load_ps(minX + i), _CMP_GE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(aMinY, _mm256_load_ps(maxY + i), _CMP_LE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(aMaxY, _mm256_load_ps(minY + i), _CMP_GE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(aMinZ, _mm256_load_ps(maxZ + i), _CMP_LE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(aMaxZ, _mm256_load_ps(minZ + i), _CMP_GE_OQ));
+
+        if (_mm256_movemask_ps(overlap) == 0)
+            continue;
+
+        __m256 const bMX = _mm256_load_ps(mX + i);
+        __m256 const bMY = _mm256_load_ps(mY + i);
+        __m256 const bMZ = _mm256_load_ps(mZ + i);
+        __m256 const cX  = _mm256_sub_ps(aBX, _mm256_load_ps(bX + i));
+        __m256 const cY  = _mm256_sub_ps(aBY, _mm256_load_ps(bY + i));
+        __m256 const cZ  = _mm256_sub_ps(aBZ, _mm256_load_ps(bZ + i));
+
+        __m256 const sXY = _mm256_sub_ps(_mm256_mul_ps(cX, bMY), _mm256_mul_ps(cY, bMX));
+        __m256 const tXY = _mm256_sub_ps(_mm256_mul_ps(cX, aMY), _mm256_mul_ps(cY, aMX));
+        __m256 const dXY = _mm256_sub_ps(_mm256_mul_ps(bMX, aMY), _mm256_mul_ps(bMY, aMX));
+        __m256 const sXZ = _mm256_sub_ps(_mm256_mul_ps(cX, bMZ), _mm256_mul_ps(cZ, bMX));
+        __m256 const tXZ = _mm256_sub_ps(_mm256_mul_ps(cX, aMZ), _mm256_mul_ps(cZ, aMX));
+        __m256 const dXZ = _mm256_sub_ps(_mm256_mul_ps(bMX, aMZ), _mm256_mul_ps(bMZ, aMX));
+        __m256 const sYZ = _mm256_sub_ps(_mm256_mul_ps(cY, bMZ), _mm256_mul_ps(cZ, bMY));
+        __m256 const tYZ = _mm256_sub_ps(_mm256_mul_ps(cY, aMZ), _mm256_mul_ps(cZ, aMY));
+        __m256 const dYZ = _mm256_sub_ps(_mm256_mul_ps(bMY, aMZ), _mm256_mul_ps(bMZ, aMY));
+
+        // The parameters come from the projection with the largest determinant.
+
+        __m256 s = sXY;
+        __m256 t = tXY;
+        __m256 d = dXY;
+
+        __m256 const useXZ = _mm256_cmp_ps(_mm256_andnot_ps(vSign, dXZ), _mm256_andnot_ps(vSign, d), _CMP_GT_OQ);
+        s = _mm256_blendv_ps(s, sXZ, useXZ);
+        t = _mm256_blendv_ps(t, tXZ, useXZ);
+        d = _mm256_blendv_ps(d, dXZ, useXZ);
+
+        __m256 const useYZ = _mm256_cmp_ps(_mm256_andnot_ps(vSign, dYZ), _mm256_andnot_ps(vSign, d), _CMP_GT_OQ);
+        s = _mm256_blendv_ps(s, sYZ, useYZ);
+        t = _mm256_blendv_ps(t, tYZ, useYZ);
+        d = _mm256_blendv_ps(d, dYZ, useYZ);
+
+        // That projection must pass and the segments must be coplanar (c x b.M is (sYZ, -sXZ, sXY)). Parallel
+        // segments (d = 0) are left to the scalar test.
+
+        __m256 const v        = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(aMX, sYZ), _mm256_mul_ps(aMY, sXZ)),
+                                              _mm256_mul_ps(aMZ, sXY));
+        __m256 const nn       = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sYZ, sYZ), _mm256_mul_ps(sXZ, sXZ)),
+                                              _mm256_mul_ps(sXY, sXY));
+        __m256 const coplanar = _mm256_cmp_ps(_mm256_mul_ps(v, v), _mm256_mul_ps(vLim, nn), _CMP_LE_OQ);
+        __m256 const nonZero  = _mm256_cmp_ps(d, vZero, _CMP_NEQ_OQ);
+        __m256 const pass     = _mm256_or_ps(_mm256_and_ps(_mm256_and_ps(nonZero, coplanar), inRange(s, t, d)),
+                                             _mm256_andnot_ps(nonZero, overlap));
+
+        int const mask     = _mm256_movemask_ps(_mm256_and_ps(overlap, pass));
+        int const parallel = _mm256_movemask_ps(_mm256_andnot_ps(nonZero, overlap));
+
+        if (mask == 0)
+            continue;
+
+        alignas(32) float laneS[8];
+        alignas(32) float laneT[8];
+        _mm256_store_ps(laneS, _mm256_and_ps(nonZero, _mm256_div_ps(s, d)));
+        _mm256_store_ps(laneT, _mm256_and_ps(nonZero, _mm256_div_ps(t, d)));
+
+        for (int lane = 0; lane < 8; ++lane)
+        {
+            if ((mask & (1 << lane)) == 0)
+                continue;
+
+            int const j = i + lane;
+
+            if ((parallel & (1 << lane))
+                && !IntersectProjected(aB, aM, Vector3(bX[j], bY[j], bZ[j]), Vector3(mX[j], mY[j], mZ[j]),
+                                       &laneS[lane], &laneT[lane]))
+            {
+                continue;
+            }
+
+            paIndices[hits] = j;
+            if (paS)
+                paS[hits] = laneS[lane];
+            if (paT)
+                paT[hits] = laneT[lane];
+            ++hits;
+        }
+    }
+#else // defined(__AVX2__)
+    for (int i = 0; i < n; ++i)
+    {
+        if (  aMin.m_X > maxX[i] || aMax.m_X < minX[i]
+           || aMin.m_Y > maxY[i] || aMax.m_Y < minY[i]
+           || aMin.m_Z > maxZ[i] || aMax.m_Z < minZ[i])
+        {
+            continue;
+        }
+
+        float s;
+        float t;
+
+        if (IntersectProjected(aB, aM, Vector3(bX[i], bY[i], bZ[i]), Vector3(mX[i], mY[i], mZ[i]), &s, &t))
+        {
+            paIndices[hits] = i;
+            if (paS)
+                paS[hits] = s;
+            if (paT)
+                paT[hits] = t;
+            ++hits;
+        }
+    }
+#endif // defined(__AVX2__)
+
+    return hits;
+}
+
+//! @param	a	Segment to test
+//! @param	b	Segment to test
+//! @param	pS	Where to store the value of @a a's t at the first point they have in common
+//! @param	pT	Where to store the value of @a b's t at that point
+//!
+//! @return		True if the segments intersect
+//!
+//! The segments are projected onto the xy, xz and yz planes, and s and t are found in the projection with the
+//! largest determinant, without dividing. The segments must also be coplanar. Parallel segments intersect if they
+//! are collinear and overlap. The bounding boxes aren't tested.
+
+bool Intersect(Segment const & a, Segment const & b, float * pS, float * pT)
+{
+    return IntersectProjected(a.m_B, a.m_M, b.m_B, b.m_M, pS, pT);
+}
+
+//! @param	segment		Segment to test
+//! @param	polys		Convex polygons to test against
+//! @param	paIndices	Where to store the indexes of the polygons that are hit
+//! @param	paT			Where to store the values of the segment's t at the hits (or nullptr)
+//!
+//! @return		Number of polygons hit
+//!
+//! The polygons are read directly from the buffer, so no Poly is constructed.
+
+int Intersect(Segment const & segment, PolyBuffer const & polys, int * paIndices, float * paT)
+{
+    int hits = 0;
+
+    for (int i = 0; i < polys.Size(); ++i)
+    {
+        float t;
+
+        if (Intersect(segment, polys.GetPlane(i), polys.GetVertices(i), polys.GetVertexCount(i), &t))
+        {
+            paIndices[hits] = i;
+            if (paT)
+                paT[hits] = t;
+            ++hits;
+        }
+    }
+
+    return hits;
+}
+
+//! @param	segment		Segment to test
+//! @param	plane		Plane of the polygon
+//! @param	paVertices	Vertices of the polygon, in order around it (either way)
+//! @param	nVertices	Number of vertices
+//! @param	pT			Where to store the value of the segment's t at the first point of contact
+//!
+//! @return		True if the segment intersects the polygon
+//!
+//! If the segment lies in the plane of the polygon, it is tested against the polygon's edges.
+
+bool Intersect(Segment const & segment, Plane const & plane, Vector3 const * paVertices, int nVertices, float * pT)
+{
+    float const da = Dot(plane.m_N, segment.m_B) + plane.m_D;
+    float const db = Dot(plane.m_N, segment.m_B + segment.m_M) + plane.m_D;
+
+    // Reject if both ends are on the same side of the plane
+
+    if ((da > 0.0f && db > 0.0f) || (da < 0.0f && db < 0.0f))
+        return false;
+
+    if (da != db)
+    {
+        float const t = da / (da - db);
+
+        if (!Contains(plane.m_N, paVertices, nVertices, segment.m_B + segment.m_M * t))
+            return false;
+
+        *pT = t;
+        return true;
+    }
+
+    // The segment is in the plane. It intersects if it starts inside or crosses an edge.
+
+    if (Contains(plane.m_N, paVertices, nVertices, segment.m_B))
+    {
+        *pT = 0.0f;
+        return true;
+    }
+
+    bool  hit  = false;
+    float best = 1.0f;
+
+    for (int i = 0, j = nVertices - 1; i < nVertices; j = i++)
+    {
+        float s;
+        float u;
+
+        if (IntersectProjected(segment.m_B, segment.m_M, paVertices[j], paVertices[i] - paVertices[j], &s, &u)
+            && s <= best)
+        {
+            best = s;
+            hit  = true;
+        }
+    }
+
+    if (hit)
+        *pT = best;
+
+    return hit;
+}
+} // namespace MyMath
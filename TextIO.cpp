@@ -0,0 +1,432 @@
+#include "TextIO.h"
+
+#include "Matrix43.h"
+#include "Matrix44.h"
+#include "Quaternion.h"
+#include "QuaternionSoA.h"
+#include "Vector2i.h"
+#include "Vector3.h"
+#include "Vector3i.h"
+#include "Vector3SoA.h"
+
+#include "Misc/Assertx.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <system_error>
+
+namespace
+{
+bool IsSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Longest text written for a number (a float with 9 significant digits and an exponent, or an int)
+size_t const MAX_NUMBER_SIZE = 32;
+} // anonymous namespace
+
+namespace MyMath
+{
+//! @param	in			Stream to read from
+//! @param	chunkSize	Number of characters read from the stream at once. A token longer than this is read anyway.
+
+TextReader::TextReader(std::istream & in, size_t chunkSize)
+    : m_In(in)
+    , m_Buffer(chunkSize)
+    , m_Begin(0)
+    , m_End(0)
+    , m_Fail(false)
+{
+    assert(chunkSize > 0);
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of floats to read
+//!
+//! @return		Number of floats read
+
+size_t TextReader::Read(float * p, size_t n)
+{
+    return ReadNumbers(p, n);
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of ints to read
+//!
+//! @return		Number of ints read
+
+size_t TextReader::Read(int * p, size_t n)
+{
+    return ReadNumbers(p, n);
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of vectors to read
+//!
+//! @return		Number of vectors read
+
+size_t TextReader::Read(Vector3 * p, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n && ReadNumbers(p[i].m_V, 3) == 3; ++i)
+    {
+    }
+    return i;
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of vectors to read
+//!
+//! @return		Number of vectors read
+
+size_t TextReader::Read(Vector2i * p, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n && ReadNumbers(p[i].m_V, 2) == 2; ++i)
+    {
+    }
+    return i;
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of vectors to read
+//!
+//! @return		Number of vectors read
+
+size_t TextReader::Read(Vector3i * p, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n && ReadNumbers(p[i].m_V, 3) == 3; ++i)
+    {
+    }
+    return i;
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of quaternions to read
+//!
+//! @return		Number of quaternions read
+
+size_t TextReader::Read(Quaternion * p, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n && ReadNumbers(p[i].m_Q, 4) == 4; ++i)
+    {
+    }
+    return i;
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of matrices to read
+//!
+//! @return		Number of matrices read
+
+size_t TextReader::Read(Matrix43 * p, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n && ReadNumbers(&p[i].m_M[0][0], 4 * 3) == 4 * 3; ++i)
+    {
+    }
+    return i;
+}
+
+//! @param	p	Destination
+//! @param	n	Maximum number of matrices to read
+//!
+//! @return		Number of matrices read
+
+size_t TextReader::Read(Matrix44 * p, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n && ReadNumbers(&p[i].m_M[0][0], 4 * 4) == 4 * 4; ++i)
+    {
+    }
+    return i;
+}
+
+//! @param	pV	Array to append to
+//! @param	n	Maximum number of vectors to read
+//!
+//! @return		Number of vectors read
+
+size_t TextReader::Read(Vector3SoA * pV, size_t n)
+{
+    size_t  i;
+    Vector3 v;
+    for (i = 0; i < n && ReadNumbers(v.m_V, 3) == 3; ++i)
+    {
+        pV->PushBack(v);
+    }
+    return i;
+}
+
+//! @param	pQ	Array to append to
+//! @param	n	Maximum number of quaternions to read
+//!
+//! @return		Number of quaternions read
+
+size_t TextReader::Read(QuaternionSoA * pQ, size_t n)
+{
+    size_t     i;
+    Quaternion q;
+    for (i = 0; i < n && ReadNumbers(q.m_Q, 4) == 4; ++i)
+    {
+        pQ->PushBack(q);
+    }
+    return i;
+}
+
+bool TextReader::NextToken(char const ** ppBegin, char const ** ppEnd)
+{
+    // Skip the whitespace
+
+    for (;;)
+    {
+        while (m_Begin < m_End && IsSpace(m_Buffer[m_Begin]))
+        {
+            ++m_Begin;
+        }
+        if (m_Begin < m_End)
+            break;
+        if (!Refill())
+            return false;
+    }
+
+    // Find the end of the token. If the token reaches the end of the buffer, it may continue in the stream.
+
+    size_t end = m_Begin;
+    for (;;)
+    {
+        while (end < m_End && !IsSpace(m_Buffer[end]))
+        {
+            ++end;
+        }
+        if (end < m_End)
+            break;
+
+        // Refill() moves the unparsed characters even if it reads nothing more
+
+        size_t const offset = end - m_Begin;
+        bool const   more   = Refill();
+        end = m_Begin + offset;
+        if (!more)
+            break;
+    }
+
+    *ppBegin = m_Buffer.data() + m_Begin;
+    *ppEnd   = m_Buffer.data() + end;
+    m_Begin  = end;
+    return true;
+}
+
+bool TextReader::Refill()
+{
+    if (!m_In)
+        return false;
+
+    // Move the unparsed characters to the start of the buffer, and make room if they fill it
+
+    size_t const remaining = m_End - m_Begin;
+    std::memmove(m_Buffer.data(), m_Buffer.data() + m_Begin, remaining);
+    m_Begin = 0;
+    m_End   = remaining;
+    if (m_End == m_Buffer.size())
+        m_Buffer.resize(m_Buffer.size() * 2);
+
+    m_In.read(m_Buffer.data() + m_End, std::streamsize(m_Buffer.size() - m_End));
+    size_t const count = size_t(m_In.gcount());
+    m_End += count;
+
+    return count > 0;
+}
+
+template <typename T>
+size_t TextReader::ReadNumbers(T * p, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && !m_Fail; ++i)
+    {
+        char const * begin;
+        char const * end;
+        if (!NextToken(&begin, &end))
+            break;
+
+        // operator >> allows a leading '+', but std::from_chars doesn't
+
+        if (*begin == '+' && end - begin > 1 && begin[1] != '-')
+            ++begin;
+
+        std::from_chars_result const result = std::from_chars(begin, end, p[i]);
+        if (result.ec != std::errc() || result.ptr != end)
+        {
+            m_Fail = true;
+            break;
+        }
+    }
+
+    return i;
+}
+
+//! @param	out			Stream to write to
+//! @param	bufferSize	Size of the buffer
+
+TextWriter::TextWriter(std::ostream & out, size_t bufferSize)
+    : m_Out(out)
+    , m_Buffer(std::max(bufferSize, 16 * MAX_NUMBER_SIZE))
+    , m_Size(0)
+{
+}
+
+//! @param	p	Floats to write
+//! @param	n	Number of floats
+
+void TextWriter::Write(float const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(p + i, 1);
+    }
+}
+
+//! @param	p	Ints to write
+//! @param	n	Number of ints
+
+void TextWriter::Write(int const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(p + i, 1);
+    }
+}
+
+//! @param	p	Vectors to write
+//! @param	n	Number of vectors
+
+void TextWriter::Write(Vector3 const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(p[i].m_V, 3);
+    }
+}
+
+//! @param	p	Vectors to write
+//! @param	n	Number of vectors
+
+void TextWriter::Write(Vector2i const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(p[i].m_V, 2);
+    }
+}
+
+//! @param	p	Vectors to write
+//! @param	n	Number of vectors
+
+void TextWriter::Write(Vector3i const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(p[i].m_V, 3);
+    }
+}
+
+//! @param	p	Quaternions to write
+//! @param	n	Number of quaternions
+
+void TextWriter::Write(Quaternion const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(p[i].m_Q, 4);
+    }
+}
+
+//! @param	p	Matrices to write
+//! @param	n	Number of matrices
+
+void TextWriter::Write(Matrix43 const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(&p[i].m_M[0][0], 4 * 3);
+    }
+}
+
+//! @param	p	Matrices to write
+//! @param	n	Number of matrices
+
+void TextWriter::Write(Matrix44 const * p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        WriteLine(&p[i].m_M[0][0], 4 * 4);
+    }
+}
+
+//! @param	v	Vectors to write
+
+void TextWriter::Write(Vector3SoA const & v)
+{
+    float const * const x = v.GetX();
+    float const * const y = v.GetY();
+    float const * const z = v.GetZ();
+
+    for (size_t i = 0; i < v.Size(); ++i)
+    {
+        float const element[3] = { x[i], y[i], z[i] };
+        WriteLine(element, 3);
+    }
+}
+
+//! @param	q	Quaternions to write
+
+void TextWriter::Write(QuaternionSoA const & q)
+{
+    float const * const x = q.GetX();
+    float const * const y = q.GetY();
+    float const * const z = q.GetZ();
+    float const * const w = q.GetW();
+
+    for (size_t i = 0; i < q.Size(); ++i)
+    {
+        float const element[4] = { x[i], y[i], z[i], w[i] };
+        WriteLine(element, 4);
+    }
+}
+
+void TextWriter::Flush()
+{
+    m_Out.write(m_Buffer.data(), std::streamsize(m_Size));
+    m_Size = 0;
+}
+
+template <typename T>
+void TextWriter::WriteLine(T const * p, size_t n)
+{
+    assert(n <= 16);
+
+    if (m_Buffer.size() - m_Size < n * MAX_NUMBER_SIZE)
+        Flush();
+
+    char * const begin = m_Buffer.data();
+    char * const end   = begin + m_Buffer.size();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i > 0)
+            begin[m_Size++] = ' ';
+
+        std::to_chars_result const result = std::to_chars(begin + m_Size, end, p[i]);
+        assert(result.ec == std::errc());
+        m_Size = size_t(result.ptr - begin);
+    }
+    begin[m_Size++] = '\n';
+}
+} // namespace MyMath
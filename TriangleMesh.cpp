@@ -0,0 +1,959 @@
+#include "TriangleMesh.h"
+
+#include "Box.h"
+#include "Frustum.h"
+#include "Line.h"
+#include "Plane.h"
+#include "Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+float const DET_EPSILON = 1.0e-12f;    // Determinants smaller than this are treated as a ray parallel to a triangle
+float const SIN_EPSILON = 1.0e-6f;     // Triangles whose edges' angle has a smaller sine are treated as degenerate
+int const   STACK_SIZE  = 64;          // Maximum depth of the hierarchy (it is balanced, so this is never reached)
+
+// Returns the distance along a ray at which it enters a box, or infinity if it misses the box or enters it beyond
+// maxT
+template <typename Node>
+float EnterBox(Node const & node, RayPrecomputed const & ray, float maxT)
+{
+    float enter;
+    float exit;
+
+    if (MyMath::IntersectSlabs(ray, node.m_Bounds, 0.0f, maxT, &enter, &exit))
+        return enter;
+    else
+        return std::numeric_limits<float>::infinity();
+}
+
+// Returns the squared distance from a point to a box
+template <typename Node>
+float DistanceSquared(Node const & node, Vector3 const & p)
+{
+    float d2 = 0.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float const d = std::max(std::max(node.m_Bounds[0].m_V[i] - p.m_V[i], p.m_V[i] - node.m_Bounds[1].m_V[i]), 0.0f);
+        d2 += d * d;
+    }
+    return d2;
+}
+
+// Computes the barycentric coordinates (weights of v1 and v2) of a point in the plane of a triangle
+void Barycentric(Vector3 const & p, Vector3 const & v0, Vector3 const & v1, Vector3 const & v2, float * pU, float * pV)
+{
+    Vector3 const e1  = v1 - v0;
+    Vector3 const e2  = v2 - v0;
+    Vector3 const w   = p - v0;
+    float const   d11 = Dot(e1, e1);
+    float const   d12 = Dot(e1, e2);
+    float const   d22 = Dot(e2, e2);
+    float const   dw1 = Dot(w, e1);
+    float const   dw2 = Dot(w, e2);
+    float const   den = d11 * d22 - d12 * d12;
+
+    if (!(den > SIN_EPSILON * SIN_EPSILON * d11 * d22))
+    {
+        *pU = 0.0f;
+        *pV = 0.0f;
+        return;
+    }
+
+    *pU = (d22 * dw1 - d12 * dw2) / den;
+    *pV = (d11 * dw2 - d12 * dw1) / den;
+}
+
+// Returns the point on the segment p0-p1 closest to a point
+Vector3 ClosestPointOnSegment(Vector3 const & point, Vector3 const & p0, Vector3 const & p1)
+{
+    Vector3 const e  = p1 - p0;
+    float const   ee = Dot(e, e);
+
+    if (ee == 0.0f)
+        return p0;
+
+    return p0 + e * std::min(std::max(Dot(point - p0, e) / ee, 0.0f), 1.0f);
+}
+
+// Returns the smallest t in [0, maxT] at which o + d * t is at distance r from c, or infinity
+float SweepPoint(Vector3 const & o, Vector3 const & d, Vector3 const & c, float r, float maxT)
+{
+    Vector3 const m = o - c;
+    float const   a = Dot(d, d);
+    float const   b = Dot(m, d);
+    float const   k = Dot(m, m) - r * r;
+
+    if (a == 0.0f || b >= 0.0f)
+        return std::numeric_limits<float>::infinity();
+
+    float const disc = b * b - a * k;
+    if (disc < 0.0f)
+        return std::numeric_limits<float>::infinity();
+
+    float const t = (-b - std::sqrt(disc)) / a;
+    return (t >= 0.0f && t <= maxT) ? t : std::numeric_limits<float>::infinity();
+}
+
+// Returns the smallest t in [0, maxT] at which o + d * t is at distance r from the interior of the segment p0-p1,
+// or infinity. The ends of the segment are handled by SweepPoint().
+float SweepEdge(Vector3 const & o, Vector3 const & d, Vector3 const & p0, Vector3 const & p1, float r, float maxT)
+{
+    Vector3 const e  = p1 - p0;
+    Vector3 const m  = o - p0;
+    float const   ee = Dot(e, e);
+
+    if (ee == 0.0f)
+        return std::numeric_limits<float>::infinity();
+
+    // Remove the components along the edge and solve for the distance from the edge's line.
+
+    float const   md = Dot(m, e);
+    float const   dd = Dot(d, e);
+    Vector3 const mp = m - e * (md / ee);
+    Vector3 const dp = d - e * (dd / ee);
+
+    float const t = SweepPoint(mp, dp, Vector3::Origin(), r, maxT);
+    if (!(t <= maxT))
+        return t;
+
+    // The contact must be within the segment.
+
+    float const s = md + dd * t;
+    return (s >= 0.0f && s <= ee) ? t : std::numeric_limits<float>::infinity();
+}
+
+// Returns the smallest t in [0, maxT] at which a sphere at o + d * t with radius r touches a triangle, or infinity.
+// The sphere must not touch the triangle at t = 0. The contact point is returned in pContact.
+float SweepTriangle(Vector3 const & o, Vector3 const & d, float r,
+                    Vector3 const & v0, Vector3 const & v1, Vector3 const & v2, float maxT, Vector3 * pContact)
+{
+    float best = std::numeric_limits<float>::infinity();
+
+    // Face. The normal of a degenerate triangle is not exactly 0 if the cross product is rounded (e.g. if it is
+    // contracted to fused multiply-adds), so it is compared to the lengths of the edges.
+
+    Vector3 const e1     = v1 - v0;
+    Vector3 const e2     = v2 - v0;
+    Vector3       n      = Cross(e1, e2);
+    float const   length = n.Length();
+    if (length > SIN_EPSILON * e1.Length() * e2.Length())
+    {
+        n *= 1.0f / length;
+
+        float const dist0 = Dot(n, o - v0);
+        float const dn    = Dot(n, d);
+
+        if (dist0 * dn < 0.0f)
+        {
+            float const side = (dist0 > 0.0f) ? 1.0f : -1.0f;
+            float const t    = (side * r - dist0) / dn;
+
+            if (t >= 0.0f && t <= maxT)
+            {
+                Vector3 const contact = o + d * t - n * (side * r);
+                float         u;
+                float         v;
+                Barycentric(contact, v0, v1, v2, &u, &v);
+                if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f)
+                {
+                    best      = t;
+                    *pContact = contact;
+                }
+            }
+        }
+    }
+
+    // Edges and vertices
+
+    Vector3 const * const vertices[3] = { &v0, &v1, &v2 };
+    for (int i = 0; i < 3; ++i)
+    {
+        Vector3 const & p0 = *vertices[i];
+        Vector3 const & p1 = *vertices[(i + 1) % 3];
+
+        float const te = SweepEdge(o, d, p0, p1, r, std::min(best, maxT));
+        if (te < best)
+        {
+            Vector3 const c = o + d * te;
+            Vector3 const e = p1 - p0;
+            best      = te;
+            *pContact = p0 + e * (Dot(c - p0, e) / Dot(e, e));
+        }
+
+        float const tv = SweepPoint(o, d, p0, r, std::min(best, maxT));
+        if (tv < best)
+        {
+            best      = tv;
+            *pContact = p0;
+        }
+    }
+
+    return best;
+}
+
+// Returns the vertices of a box that are nearest and farthest along a direction, given a mask of the signs of the
+// direction's elements (see Frustum::GetPositiveMask())
+template <typename Node>
+void GetExtremes(Node const & node, int positiveMask, Vector3 * pNear, Vector3 * pFar)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        bool const positive = (positiveMask & (1 << i)) != 0;
+        pNear->m_V[i] = positive ? node.m_Bounds[0].m_V[i] : node.m_Bounds[1].m_V[i];
+        pFar->m_V[i]  = positive ? node.m_Bounds[1].m_V[i] : node.m_Bounds[0].m_V[i];
+    }
+}
+} // anonymous namespace
+
+//! @param	paVertices	Vertices
+//! @param	nVertices	Number of vertices
+//! @param	paIndices	Indexes of the vertices of each triangle (3 per triangle)
+//! @param	nTriangles	Number of triangles
+
+TriangleMesh::TriangleMesh(Vector3 const * paVertices, int nVertices, int const * paIndices, int nTriangles)
+    : m_Vertices(paVertices, paVertices + nVertices)
+    , m_Indices(paIndices, paIndices + 3 * nTriangles)
+{
+    if (nTriangles == 0)
+        return;
+
+    std::vector<Vector3> centroids(nTriangles);
+    m_Order.resize(nTriangles);
+    for (int i = 0; i < nTriangles; ++i)
+    {
+        assert(m_Indices[3 * i + 0] >= 0 && m_Indices[3 * i + 0] < nVertices);
+        assert(m_Indices[3 * i + 1] >= 0 && m_Indices[3 * i + 1] < nVertices);
+        assert(m_Indices[3 * i + 2] >= 0 && m_Indices[3 * i + 2] < nVertices);
+
+        Vector3 v0;
+        Vector3 v1;
+        Vector3 v2;
+        GetTriangle(i, &v0, &v1, &v2);
+
+        centroids[i] = (v0 + v1 + v2) * (1.0f / 3.0f);
+        m_Order[i]   = i;
+    }
+
+    m_Nodes.reserve(2 * (nTriangles / TrianglePacket8::SIZE + 1));
+    m_Packets.reserve(nTriangles / TrianglePacket8::SIZE + 1);
+    Build(0, nTriangles, centroids);
+
+    m_Order.clear();
+    m_Order.shrink_to_fit();
+}
+
+AABox TriangleMesh::GetBounds() const
+{
+    if (m_Nodes.empty())
+        return AABox(Vector3::Origin(), Vector3::Origin());
+
+    Node const & root = m_Nodes[0];
+
+    return AABox(root.m_Bounds[0], root.m_Bounds[1] - root.m_Bounds[0]);
+}
+
+//! @param	ray		Ray
+//! @param	maxT	Maximum distance along the ray
+//! @param	pHit	Where to store the nearest hit
+//!
+//! @return		true if the ray hits a triangle within @a maxT
+//!
+//! Triangles are hit from either side. Children are visited nearest first so that farther subtrees are usually
+//! skipped.
+
+bool TriangleMesh::Raycast(Ray const & ray, float maxT, Hit * pHit) const
+{
+    if (m_Nodes.empty())
+        return false;
+
+    RayPrecomputed const precomputed(ray);
+    float                best = maxT;
+    bool                 hit  = false;
+
+    int stack[STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        Node const & node = m_Nodes[stack[--top]];
+
+        if (!(EnterBox(node, precomputed, best) <= best))
+            continue;
+
+        if (node.m_Count > 0)
+        {
+            float t;
+            float u;
+            float v;
+            int const lane = MyMath::Intersect(ray, m_Packets[node.m_Offset], best, &t, &u, &v);
+            if (lane >= 0)
+            {
+                best             = t;
+                hit              = true;
+                pHit->m_Triangle = m_Packets[node.m_Offset].m_Index[lane];
+                pHit->m_T        = t;
+                pHit->m_U        = u;
+                pHit->m_V        = v;
+            }
+        }
+        else
+        {
+            int const   left  = int(&node - m_Nodes.data()) + 1;
+            int const   right = node.m_Offset;
+            float const tl    = EnterBox(m_Nodes[left], precomputed, best);
+            float const tr    = EnterBox(m_Nodes[right], precomputed, best);
+
+            // Push the farther child first so the nearer one is visited first.
+
+            assert(top + 2 <= STACK_SIZE);
+            if (tl <= tr)
+            {
+                stack[top++] = right;
+                stack[top++] = left;
+            }
+            else
+            {
+                stack[top++] = left;
+                stack[top++] = right;
+            }
+        }
+    }
+
+    return hit;
+}
+
+//! @param	ray		Ray
+//! @param	maxT	Maximum distance along the ray
+//!
+//! The search stops at the first hit found, so this is faster than Raycast() for visibility tests.
+
+bool TriangleMesh::AnyHit(Ray const & ray, float maxT) const
+{
+    if (m_Nodes.empty())
+        return false;
+
+    RayPrecomputed const precomputed(ray);
+
+    int stack[STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        int const    i    = stack[--top];
+        Node const & node = m_Nodes[i];
+
+        if (!(EnterBox(node, precomputed, maxT) <= maxT))
+            continue;
+
+        if (node.m_Count > 0)
+        {
+            float t;
+            float u;
+            float v;
+            if (MyMath::Intersect(ray, m_Packets[node.m_Offset], maxT, &t, &u, &v) >= 0)
+                return true;
+        }
+        else
+        {
+            assert(top + 2 <= STACK_SIZE);
+            stack[top++] = node.m_Offset;
+            stack[top++] = i + 1;
+        }
+    }
+
+    return false;
+}
+
+//! @param	point		Point
+//! @param	pTriangle	If not null, the index of the triangle containing the closest point is stored here
+//!
+//! @return		The closest point, or @a point if the mesh is empty
+
+Vector3 TriangleMesh::ClosestPoint(Vector3 const & point, int * pTriangle /* = nullptr*/) const
+{
+    Vector3 closest  = point;
+    int     triangle = -1;
+    float   best     = std::numeric_limits<float>::infinity();
+
+    if (!m_Nodes.empty())
+    {
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            int const    i    = stack[--top];
+            Node const & node = m_Nodes[i];
+
+            if (!(DistanceSquared(node, point) < best))
+                continue;
+
+            if (node.m_Count > 0)
+            {
+                TrianglePacket8 const & packet = m_Packets[node.m_Offset];
+                for (int k = 0; k < node.m_Count; ++k)
+                {
+                    Vector3 v0;
+                    Vector3 v1;
+                    Vector3 v2;
+                    GetTriangle(packet.m_Index[k], &v0, &v1, &v2);
+
+                    Vector3 const c  = MyMath::ClosestPointOnTriangle(point, v0, v1, v2);
+                    float const   d2 = (c - point).Length2();
+                    if (d2 < best)
+                    {
+                        best     = d2;
+                        closest  = c;
+                        triangle = packet.m_Index[k];
+                    }
+                }
+            }
+            else
+            {
+                // Visit the nearer child first.
+
+                int const left  = i + 1;
+                int const right = node.m_Offset;
+
+                assert(top + 2 <= STACK_SIZE);
+                if (DistanceSquared(m_Nodes[left], point) <= DistanceSquared(m_Nodes[right], point))
+                {
+                    stack[top++] = right;
+                    stack[top++] = left;
+                }
+                else
+                {
+                    stack[top++] = left;
+                    stack[top++] = right;
+                }
+            }
+        }
+    }
+
+    if (pTriangle)
+        *pTriangle = triangle;
+
+    return closest;
+}
+
+//! @param	sphere		Sphere at its starting position
+//! @param	direction	Direction of motion. The sphere's center moves along sphere.m_C + direction * t.
+//! @param	maxT		Maximum value of t
+//! @param	pHit		Where to store the first contact. m_U and m_V are the barycentric coordinates of the contact
+//!						point.
+//!
+//! @return		true if the sphere touches a triangle for some t in [0, maxT]
+//!
+//! Each triangle is swept against its face, its edges and its vertices. A triangle that the sphere touches at its
+//! starting position is hit at t = 0.
+
+bool TriangleMesh::SphereSweep(Sphere const & sphere, Vector3 const & direction, float maxT, Hit * pHit) const
+{
+    if (m_Nodes.empty())
+        return false;
+
+    Vector3 const &      o    = sphere.m_C;
+    float const          r    = sphere.m_R;
+    RayPrecomputed const precomputed(o, direction);
+    float                best = maxT;
+    bool                 hit  = false;
+    Vector3              contact;
+
+    int stack[STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        int const i    = stack[--top];
+        Node      node = m_Nodes[i];
+
+        // The sphere's center touches the box expanded by the radius.
+
+        for (int k = 0; k < 3; ++k)
+        {
+            node.m_Bounds[0].m_V[k] -= r;
+            node.m_Bounds[1].m_V[k] += r;
+        }
+
+        if (!(EnterBox(node, precomputed, best) <= best))
+            continue;
+
+        if (node.m_Count > 0)
+        {
+            TrianglePacket8 const & packet = m_Packets[node.m_Offset];
+            for (int k = 0; k < node.m_Count; ++k)
+            {
+                Vector3 v0;
+                Vector3 v1;
+                Vector3 v2;
+                GetTriangle(packet.m_Index[k], &v0, &v1, &v2);
+
+                Vector3 c = MyMath::ClosestPointOnTriangle(o, v0, v1, v2);
+                float   t = 0.0f;
+                if ((c - o).Length2() > r * r)
+                    t = SweepTriangle(o, direction, r, v0, v1, v2, best, &c);
+
+                if (t <= best && (!hit || t < best))
+                {
+                    best             = t;
+                    hit              = true;
+                    contact          = c;
+                    pHit->m_Triangle = packet.m_Index[k];
+                    pHit->m_T        = t;
+                    Barycentric(contact, v0, v1, v2, &pHit->m_U, &pHit->m_V);
+                }
+            }
+        }
+        else
+        {
+            assert(top + 2 <= STACK_SIZE);
+            stack[top++] = node.m_Offset;
+            stack[top++] = i + 1;
+        }
+    }
+
+    return hit;
+}
+
+//! @param	frustum		Frustum
+//! @param	pTriangles	The indexes of the triangles that overlap the frustum are appended to this array
+//!
+//! Subtrees whose boxes are inside the frustum are accepted without testing their triangles. A triangle is rejected
+//! only if all its vertices are in front of one of the frustum's planes, so (like Intersects(AABox, Frustum)) some
+//! triangles near the frustum's edges are reported even though they do not overlap it.
+
+void TriangleMesh::Overlaps(Frustum const & frustum, std::vector<int> * pTriangles) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    int stack[STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        int const    i    = stack[--top];
+        Node const & node = m_Nodes[i];
+
+        bool outside = false;
+        bool inside  = true;
+        for (int s = 0; s < Frustum::NUM_SIDES; ++s)
+        {
+            Plane const & side = frustum.sides_[s];
+            Vector3       nearest;
+            Vector3       farthest;
+            GetExtremes(node, frustum.GetPositiveMask(s), &nearest, &farthest);
+
+            if (Dot(side.m_N, nearest) + side.m_D > 0.0f)
+            {
+                outside = true;
+                break;
+            }
+            if (Dot(side.m_N, farthest) + side.m_D > 0.0f)
+                inside = false;
+        }
+
+        if (outside)
+            continue;
+
+        // Find the range of nodes in this subtree. Its nodes are contiguous, and the subtree ends where the next
+        // subtree to visit begins (or at the end of the array).
+
+        if (inside || node.m_Count > 0)
+        {
+            int const end = (top > 0) ? stack[top - 1] : int(m_Nodes.size());
+
+            for (int k = i; k < end; ++k)
+            {
+                Node const & leaf = m_Nodes[k];
+                if (leaf.m_Count == 0)
+                    continue;
+
+                TrianglePacket8 const & packet = m_Packets[leaf.m_Offset];
+                for (int j = 0; j < leaf.m_Count; ++j)
+                {
+                    if (!inside)
+                    {
+                        Vector3 v[3];
+                        GetTriangle(packet.m_Index[j], &v[0], &v[1], &v[2]);
+
+                        bool rejected = false;
+                        for (auto const & side : frustum.sides_)
+                        {
+                            if (Dot(side.m_N, v[0]) + side.m_D > 0.0f &&
+                                Dot(side.m_N, v[1]) + side.m_D > 0.0f &&
+                                Dot(side.m_N, v[2]) + side.m_D > 0.0f)
+                            {
+                                rejected = true;
+                                break;
+                            }
+                        }
+
+                        if (rejected)
+                            continue;
+                    }
+
+                    pTriangles->push_back(packet.m_Index[j]);
+                }
+            }
+        }
+        else
+        {
+            assert(top + 2 <= STACK_SIZE);
+            stack[top++] = node.m_Offset;
+            stack[top++] = i + 1;
+        }
+    }
+}
+
+int TriangleMesh::Build(int first, int last, std::vector<Vector3> const & centroids)
+{
+    int const index = int(m_Nodes.size());
+    m_Nodes.push_back(Node());
+
+    Node node;
+    for (int k = 0; k < 3; ++k)
+    {
+        node.m_Bounds[0].m_V[k] = std::numeric_limits<float>::infinity();
+        node.m_Bounds[1].m_V[k] = -std::numeric_limits<float>::infinity();
+    }
+
+    for (int i = first; i < last; ++i)
+    {
+        Vector3 v[3];
+        GetTriangle(m_Order[i], &v[0], &v[1], &v[2]);
+        for (auto const & p : v)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                node.m_Bounds[0].m_V[k] = std::min(node.m_Bounds[0].m_V[k], p.m_V[k]);
+                node.m_Bounds[1].m_V[k] = std::max(node.m_Bounds[1].m_V[k], p.m_V[k]);
+            }
+        }
+    }
+
+    if (last - first <= TrianglePacket8::SIZE)
+    {
+        TrianglePacket8 packet = {};
+        for (int lane = 0; lane < TrianglePacket8::SIZE; ++lane)
+        {
+            packet.m_Index[lane] = -1;
+        }
+
+        for (int i = first; i < last; ++i)
+        {
+            int const lane = i - first;
+            Vector3   v0;
+            Vector3   v1;
+            Vector3   v2;
+            GetTriangle(m_Order[i], &v0, &v1, &v2);
+
+            for (int k = 0; k < 3; ++k)
+            {
+                packet.m_V0[k][lane] = v0.m_V[k];
+                packet.m_E1[k][lane] = v1.m_V[k] - v0.m_V[k];
+                packet.m_E2[k][lane] = v2.m_V[k] - v0.m_V[k];
+            }
+            packet.m_Index[lane] = m_Order[i];
+        }
+
+        node.m_Offset = int(m_Packets.size());
+        node.m_Count  = last - first;
+        m_Packets.push_back(packet);
+    }
+    else
+    {
+        // Split at the median of the centroids along the longest axis of their bounds.
+
+        Vector3 cmin = centroids[m_Order[first]];
+        Vector3 cmax = cmin;
+        for (int i = first + 1; i < last; ++i)
+        {
+            Vector3 const & c = centroids[m_Order[i]];
+            for (int k = 0; k < 3; ++k)
+            {
+                cmin.m_V[k] = std::min(cmin.m_V[k], c.m_V[k]);
+                cmax.m_V[k] = std::max(cmax.m_V[k], c.m_V[k]);
+            }
+        }
+
+        Vector3 const extent = cmax - cmin;
+        int           axis   = 0;
+        if (extent.m_Y > extent.m_V[axis])
+            axis = 1;
+        if (extent.m_Z > extent.m_V[axis])
+            axis = 2;
+
+        int const mid = (first + last) / 2;
+        std::nth_element(m_Order.begin() + first, m_Order.begin() + mid, m_Order.begin() + last,
+                         [&centroids, axis](int a, int b) {
+            return centroids[a].m_V[axis] < centroids[b].m_V[axis];
+        });
+
+        Build(first, mid, centroids);
+        node.m_Offset = Build(mid, last, centroids);
+        node.m_Count  = 0;
+    }
+
+    m_Nodes[index] = node;
+    return index;
+}
+
+void TriangleMesh::GetTriangle(int i, Vector3 * pV0, Vector3 * pV1, Vector3 * pV2) const
+{
+    *pV0 = m_Vertices[m_Indices[3 * i + 0]];
+    *pV1 = m_Vertices[m_Indices[3 * i + 1]];
+    *pV2 = m_Vertices[m_Indices[3 * i + 2]];
+}
+
+namespace MyMath
+{
+//! @param	ray		Ray
+//! @param	v0		First vertex
+//! @param	v1		Second vertex
+//! @param	v2		Third vertex
+//! @param	maxT	Maximum distance along the ray
+//! @param	pT		Where to store the distance along the ray
+//! @param	pU		Where to store the barycentric coordinate of the hit point (weight of v1)
+//! @param	pV		Where to store the barycentric coordinate of the hit point (weight of v2)
+//!
+//! @return		true if the ray hits the triangle (from either side) within @a maxT
+
+bool Intersect(Ray const & ray, Vector3 const & v0, Vector3 const & v1, Vector3 const & v2, float maxT,
+               float * pT, float * pU, float * pV)
+{
+    Vector3 const e1  = v1 - v0;
+    Vector3 const e2  = v2 - v0;
+    Vector3 const p   = Cross(ray.m_M, e2);
+    float const   det = Dot(e1, p);
+
+    if (std::fabs(det) < DET_EPSILON)
+        return false;
+
+    float const   inv = 1.0f / det;
+    Vector3 const s   = ray.m_B - v0;
+    float const   u   = Dot(s, p) * inv;
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    Vector3 const q = Cross(s, e1);
+    float const   v = Dot(ray.m_M, q) * inv;
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    float const t = Dot(e2, q) * inv;
+    if (t < 0.0f || t >= maxT)
+        return false;
+
+    *pT = t;
+    *pU = u;
+    *pV = v;
+    return true;
+}
+
+//! @param	ray		Ray
+//! @param	packet	Triangles
+//! @param	maxT	Maximum distance along the ray
+//! @param	pT		Where to store the distance along the ray to the nearest hit
+//! @param	pU		Where to store the barycentric coordinate of the nearest hit point (weight of vertex 1)
+//! @param	pV		Where to store the barycentric coordinate of the nearest hit point (weight of vertex 2)
+//!
+//! @return		The lane of the nearest triangle hit within @a maxT, or -1
+//!
+//! The 8 triangles are tested together with AVX2 if it is enabled. Otherwise, they are tested one lane at a time
+//! with the same operations.
+
+int Intersect(Ray const & ray, TrianglePacket8 const & packet, float maxT, float * pT, float * pU, float * pV)
+{
+    int const N = TrianglePacket8::SIZE;
+
+    float t[N];
+    float u[N];
+    float v[N];
+
+#if defined(__AVX2__)
+    __m256 const dx = _mm256_set1_ps(ray.m_M.m_X);
+    __m256 const dy = _mm256_set1_ps(ray.m_M.m_Y);
+    __m256 const dz = _mm256_set1_ps(ray.m_M.m_Z);
+
+    __m256 const e1x = _mm256_load_ps(packet.m_E1[0]);
+    __m256 const e1y = _mm256_load_ps(packet.m_E1[1]);
+    __m256 const e1z = _mm256_load_ps(packet.m_E1[2]);
+    __m256 const e2x = _mm256_load_ps(packet.m_E2[0]);
+    __m256 const e2y = _mm256_load_ps(packet.m_E2[1]);
+    __m256 const e2z = _mm256_load_ps(packet.m_E2[2]);
+
+    __m256 const px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+    __m256 const py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+    __m256 const pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+
+    __m256 const det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)),
+                                     _mm256_mul_ps(e1z, pz));
+    __m256 const inv = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+    __m256 const sx = _mm256_sub_ps(_mm256_set1_ps(ray.m_B.m_X), _mm256_load_ps(packet.m_V0[0]));
+    __m256 const sy = _mm256_sub_ps(_mm256_set1_ps(ray.m_B.m_Y), _mm256_load_ps(packet.m_V0[1]));
+    __m256 const sz = _mm256_sub_ps(_mm256_set1_ps(ray.m_B.m_Z), _mm256_load_ps(packet.m_V0[2]));
+
+    __m256 const vu = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)),
+                                                  _mm256_mul_ps(sz, pz)), inv);
+
+    __m256 const qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+    __m256 const qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+    __m256 const qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+
+    __m256 const vv = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)),
+                                                  _mm256_mul_ps(dz, qz)), inv);
+    __m256 const vt = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)),
+                                                  _mm256_mul_ps(e2z, qz)), inv);
+
+    __m256 const zero    = _mm256_setzero_ps();
+    __m256 const absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+
+    __m256 hit = _mm256_cmp_ps(_mm256_and_ps(det, absMask), _mm256_set1_ps(DET_EPSILON), _CMP_GE_OQ);
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(vu, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(vu, _mm256_set1_ps(1.0f), _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(vv, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(vu, vv), _mm256_set1_ps(1.0f), _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(vt, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(vt, _mm256_set1_ps(maxT), _CMP_LT_OQ));
+
+    if (_mm256_movemask_ps(hit) == 0)
+        return -1;
+
+    _mm256_storeu_ps(t, _mm256_blendv_ps(_mm256_set1_ps(std::numeric_limits<float>::infinity()), vt, hit));
+    _mm256_storeu_ps(u, vu);
+    _mm256_storeu_ps(v, vv);
+#else // defined(__AVX2__)
+    Vector3 const & d = ray.m_M;
+    Vector3 const & o = ray.m_B;
+
+    for (int i = 0; i < N; ++i)
+    {
+        Vector3 const e1(packet.m_E1[0][i], packet.m_E1[1][i], packet.m_E1[2][i]);
+        Vector3 const e2(packet.m_E2[0][i], packet.m_E2[1][i], packet.m_E2[2][i]);
+        Vector3 const s(o.m_X - packet.m_V0[0][i], o.m_Y - packet.m_V0[1][i], o.m_Z - packet.m_V0[2][i]);
+
+        Vector3 const p   = Cross(d, e2);
+        float const   det = Dot(e1, p);
+        float const   inv = 1.0f / det;
+        Vector3 const q   = Cross(s, e1);
+
+        u[i] = Dot(s, p) * inv;
+        v[i] = Dot(d, q) * inv;
+        t[i] = Dot(e2, q) * inv;
+
+        bool const hit = std::fabs(det) >= DET_EPSILON && u[i] >= 0.0f && u[i] <= 1.0f && v[i] >= 0.0f &&
+                         u[i] + v[i] <= 1.0f && t[i] >= 0.0f && t[i] < maxT;
+        if (!hit)
+            t[i] = std::numeric_limits<float>::infinity();
+    }
+#endif // defined(__AVX2__)
+
+    int nearest = -1;
+    for (int i = 0; i < N; ++i)
+    {
+        if (t[i] < maxT && (nearest < 0 || t[i] < t[nearest]))
+            nearest = i;
+    }
+
+    if (nearest >= 0)
+    {
+        *pT = t[nearest];
+        *pU = u[nearest];
+        *pV = v[nearest];
+    }
+
+    return nearest;
+}
+
+//! @param	point	Point
+//! @param	v0		First vertex
+//! @param	v1		Second vertex
+//! @param	v2		Third vertex
+//!
+//! from Ericson, Christer. Real-Time Collision Detection, pp. 141-142
+
+Vector3 ClosestPointOnTriangle(Vector3 const & point, Vector3 const & v0, Vector3 const & v1, Vector3 const & v2)
+{
+    Vector3 const ab = v1 - v0;
+    Vector3 const ac = v2 - v0;
+    Vector3 const ap = point - v0;
+
+    // The regions below divide by zero for a degenerate triangle. It has no face, so the closest point is on one of
+    // its edges.
+
+    if (!(Cross(ab, ac).Length2() > SIN_EPSILON * SIN_EPSILON * ab.Length2() * ac.Length2()))
+    {
+        Vector3 const c01 = ClosestPointOnSegment(point, v0, v1);
+        Vector3 const c12 = ClosestPointOnSegment(point, v1, v2);
+        Vector3 const c20 = ClosestPointOnSegment(point, v2, v0);
+        float const   d01 = (c01 - point).Length2();
+        float const   d12 = (c12 - point).Length2();
+        float const   d20 = (c20 - point).Length2();
+
+        if (d01 <= d12 && d01 <= d20)
+            return c01;
+        return (d12 <= d20) ? c12 : c20;
+    }
+
+    // Vertex region of v0
+
+    float const d1 = Dot(ab, ap);
+    float const d2 = Dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return v0;
+
+    // Vertex region of v1
+
+    Vector3 const bp = point - v1;
+    float const   d3 = Dot(ab, bp);
+    float const   d4 = Dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return v1;
+
+    // Edge region of v0-v1
+
+    float const vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return v0 + ab * (d1 / (d1 - d3));
+
+    // Vertex region of v2
+
+    Vector3 const cp = point - v2;
+    float const   d5 = Dot(ab, cp);
+    float const   d6 = Dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return v2;
+
+    // Edge region of v0-v2
+
+    float const vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return v0 + ac * (d2 / (d2 - d6));
+
+    // Edge region of v1-v2
+
+    float const va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return v1 + (v2 - v1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    // Face region
+
+    float const denom = 1.0f / (va + vb + vc);
+    return v0 + ab * (vb * denom) + ac * (vc * denom);
+}
+} // namespace MyMath
@@ -0,0 +1,315 @@
+#include "Vector3SoA.h"
+
+#include "Matrix43.h"
+#include "Quaternion.h"
+
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+//! @param	v	Vector to append
+
+void Vector3SoA::PushBack(Vector3 const & v)
+{
+    size_t const i = Size();
+
+    Resize(i + 1);
+    (*this)[i] = v;
+}
+
+//! @param	p	Vectors
+//! @param	n	Number of vectors
+//!
+//! With SSE, 4 vectors are converted at a time by loading them as 3 registers and shuffling them into the 3 streams.
+
+void Vector3SoA::Load(Vector3 const * p, size_t n)
+{
+    Resize(n);
+
+    float * const x = GetX();
+    float * const y = GetY();
+    float * const z = GetZ();
+    size_t        i = 0;
+
+#if defined(__SSE2__)
+    static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be 3 packed floats");
+
+    for (; i + 4 <= n; i += 4)
+    {
+        float const * const s = &p[i].m_X;
+
+        __m128 const a = _mm_loadu_ps(s + 0);  // x0 y0 z0 x1
+        __m128 const b = _mm_loadu_ps(s + 4);  // y1 z1 x2 y2
+        __m128 const c = _mm_loadu_ps(s + 8);  // z2 x3 y3 z3
+
+        __m128 const bc = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));   // x2 x2 x3 x3
+        __m128 const ab = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));   // y0 y0 y1 y1
+        __m128 const cb = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));   // y2 y2 y3 y3
+        __m128 const za = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));   // z0 z0 z1 z1
+
+        _mm_store_ps(x + i, _mm_shuffle_ps(a, bc, _MM_SHUFFLE(2, 0, 3, 0)));
+        _mm_store_ps(y + i, _mm_shuffle_ps(ab, cb, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_store_ps(z + i, _mm_shuffle_ps(za, c, _MM_SHUFFLE(3, 0, 2, 0)));
+    }
+#endif // defined(__SSE2__)
+
+    for (; i < n; ++i)
+    {
+        x[i] = p[i].m_X;
+        y[i] = p[i].m_Y;
+        z[i] = p[i].m_Z;
+    }
+}
+
+//! @param	p	Where to store the vectors. There must be room for Size() vectors.
+//!
+//! With SSE, 4 vectors are converted at a time by shuffling the 3 streams into 3 registers.
+
+void Vector3SoA::Store(Vector3 * p) const
+{
+    size_t const        n = Size();
+    float const * const x = GetX();
+    float const * const y = GetY();
+    float const * const z = GetZ();
+    size_t              i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= n; i += 4)
+    {
+        float * const d = &p[i].m_X;
+
+        __m128 const vx = _mm_load_ps(x + i);
+        __m128 const vy = _mm_load_ps(y + i);
+        __m128 const vz = _mm_load_ps(z + i);
+
+        __m128 const x0y0 = _mm_shuffle_ps(vx, vy, _MM_SHUFFLE(0, 0, 0, 0));  // x0 x0 y0 y0
+        __m128 const z0x1 = _mm_shuffle_ps(vz, vx, _MM_SHUFFLE(1, 1, 0, 0));  // z0 z0 x1 x1
+        __m128 const y1z1 = _mm_shuffle_ps(vy, vz, _MM_SHUFFLE(1, 1, 1, 1));  // y1 y1 z1 z1
+        __m128 const x2y2 = _mm_shuffle_ps(vx, vy, _MM_SHUFFLE(2, 2, 2, 2));  // x2 x2 y2 y2
+        __m128 const z2x3 = _mm_shuffle_ps(vz, vx, _MM_SHUFFLE(3, 3, 2, 2));  // z2 z2 x3 x3
+        __m128 const y3z3 = _mm_shuffle_ps(vy, vz, _MM_SHUFFLE(3, 3, 3, 3));  // y3 y3 z3 z3
+
+        _mm_storeu_ps(d + 0, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(d + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(d + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif // defined(__SSE2__)
+
+    for (; i < n; ++i)
+    {
+        p[i].m_X = x[i];
+        p[i].m_Y = y[i];
+        p[i].m_Z = z[i];
+    }
+}
+
+namespace MyMath
+{
+// The operations process the padding too, so that the loops have no remainder when vectorized.
+
+void Add(Vector3SoA const & a, Vector3SoA const & b, Vector3SoA * pR)
+{
+    assert(a.Size() == b.Size());
+
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float const * const bx = b.GetX();
+    float const * const by = b.GetY();
+    float const * const bz = b.GetZ();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        rx[i] = ax[i] + bx[i];
+        ry[i] = ay[i] + by[i];
+        rz[i] = az[i] + bz[i];
+    }
+}
+
+void Subtract(Vector3SoA const & a, Vector3SoA const & b, Vector3SoA * pR)
+{
+    assert(a.Size() == b.Size());
+
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float const * const bx = b.GetX();
+    float const * const by = b.GetY();
+    float const * const bz = b.GetZ();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        rx[i] = ax[i] - bx[i];
+        ry[i] = ay[i] - by[i];
+        rz[i] = az[i] - bz[i];
+    }
+}
+
+void Scale(Vector3SoA const & a, float s, Vector3SoA * pR)
+{
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        rx[i] = ax[i] * s;
+        ry[i] = ay[i] * s;
+        rz[i] = az[i] * s;
+    }
+}
+
+void Dot(Vector3SoA const & a, Vector3SoA const & b, float * pR)
+{
+    assert(a.Size() == b.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float const * const bx = b.GetX();
+    float const * const by = b.GetY();
+    float const * const bz = b.GetZ();
+    size_t const        n  = a.Size();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        pR[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+    }
+}
+
+void Cross(Vector3SoA const & a, Vector3SoA const & b, Vector3SoA * pR)
+{
+    assert(a.Size() == b.Size());
+
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float const * const bx = b.GetX();
+    float const * const by = b.GetY();
+    float const * const bz = b.GetZ();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const x = ay[i] * bz[i] - az[i] * by[i];
+        float const y = az[i] * bx[i] - ax[i] * bz[i];
+        float const z = ax[i] * by[i] - ay[i] * bx[i];
+
+        rx[i] = x;
+        ry[i] = y;
+        rz[i] = z;
+    }
+}
+
+//! Zero-length elements remain 0.
+
+void Normalize(Vector3SoA const & a, Vector3SoA * pR)
+{
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const l2 = ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i];
+        float const il = (l2 > 0.0f) ? 1.0f / std::sqrt(l2) : 0.0f;
+
+        rx[i] = ax[i] * il;
+        ry[i] = ay[i] * il;
+        rz[i] = az[i] * il;
+    }
+}
+
+void Transform(Vector3SoA const & a, Matrix43 const & m, Vector3SoA * pR)
+{
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const x = ax[i];
+        float const y = ay[i];
+        float const z = az[i];
+
+        rx[i] = x * m.m_Xx + y * m.m_Yx + z * m.m_Zx + m.m_Tx;
+        ry[i] = x * m.m_Xy + y * m.m_Yy + z * m.m_Zy + m.m_Ty;
+        rz[i] = x * m.m_Xz + y * m.m_Yz + z * m.m_Zz + m.m_Tz;
+    }
+}
+
+void Rotate(Vector3SoA const & a, Quaternion const & q, Vector3SoA * pR)
+{
+    assert(q.IsNormalized());
+
+    float const xx = q.m_X * q.m_X;
+    float const xy = q.m_X * q.m_Y;
+    float const xz = q.m_X * q.m_Z;
+    float const xw = q.m_X * q.m_W;
+
+    float const yy = q.m_Y * q.m_Y;
+    float const yz = q.m_Y * q.m_Z;
+    float const yw = q.m_Y * q.m_W;
+
+    float const zz = q.m_Z * q.m_Z;
+    float const zw = q.m_Z * q.m_W;
+
+    pR->Resize(a.Size());
+
+    float const * const ax = a.GetX();
+    float const * const ay = a.GetY();
+    float const * const az = a.GetZ();
+    float * const       rx = pR->GetX();
+    float * const       ry = pR->GetY();
+    float * const       rz = pR->GetZ();
+    size_t const        n  = a.PaddedSize();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        float const x = ax[i];
+        float const y = ay[i];
+        float const z = az[i];
+
+        rx[i] = x + 2.0f * (-x * (yy + zz) + y * (xy - zw) + z * (xz + yw));
+        ry[i] = y + 2.0f * (x * (xy + zw) - y * (xx + zz) + z * (yz - xw));
+        rz[i] = z + 2.0f * (x * (xz - yw) + y * (yz + xw) - z * (xx + yy));
+    }
+}
+} // namespace MyMath
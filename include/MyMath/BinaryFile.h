@@ -0,0 +1,282 @@
+#pragma once
+
+#if !defined(MYMATH_BINARYFILE_H)
+#define MYMATH_BINARYFILE_H
+
+#include "Matrix43.h"
+#include "Matrix44.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <type_traits>
+#include <vector>
+
+class AABox;
+class Box;
+class Sphere;
+
+namespace MyMath
+{
+//! @defgroup BinaryFile Binary Geometry Files
+//!
+//! A file holds a list of chunks. Each chunk is an array of records of one type, and the records are stored exactly
+//! as they are laid out in memory, so a mapped file can be read in place.
+//!
+//! The layout is:
+//!
+//!		- Header: magic "MYMB", version, number of chunks and size of the header (4 x uint32)
+//!		- Chunk table: type, record size, number of records and offset of the data (2 x uint32, 2 x uint64) per chunk
+//!		- Chunk data. Each chunk starts at a multiple of FILE_ALIGNMENT bytes.
+//!
+//! All values are little-endian IEEE-754 floats and unsigned integers.
+//!
+//! Later versions may only add fields to the end of the header and add new types of chunks. A reader accepts any
+//! version and skips the header fields and the chunks it doesn't know.
+//!
+//! Vector3, Quaternion, Matrix43 and Matrix44 are stored directly. The geometry classes are polymorphic, so they are
+//! stored as the plain records below, which convert to and from them.
+//!
+//! @ingroup Geometry
+//@{
+
+uint32_t const FILE_VERSION   = 1;     //!< Version written by BinaryFileWriter
+size_t const   FILE_ALIGNMENT = 32;    //!< Alignment of each chunk's data in the file (one AVX register)
+
+//! Types of chunks.
+enum class ChunkType : uint32_t
+{
+    VECTOR3    = 1,     //!< Vector3
+    QUATERNION = 2,     //!< Quaternion
+    MATRIX43   = 3,     //!< Matrix43
+    MATRIX44   = 4,     //!< Matrix44
+    AABOX      = 5,     //!< AABoxRecord
+    SPHERE     = 6,     //!< SphereRecord
+    BOX        = 7,     //!< BoxRecord
+};
+
+//! An AABox stored in a file.
+struct AABoxRecord
+{
+    float m_Position[3];    //!< AABox::m_Position
+    float m_Scale[3];       //!< AABox::m_Scale
+
+    //! Returns the record of a box.
+    static AABoxRecord From(AABox const & aabox);
+
+    //! Returns the box.
+    AABox ToAABox() const;
+};
+
+//! A Sphere stored in a file.
+struct SphereRecord
+{
+    float m_C[3];           //!< Sphere::m_C
+    float m_R;              //!< Sphere::m_R
+
+    //! Returns the record of a sphere.
+    static SphereRecord From(Sphere const & sphere);
+
+    //! Returns the sphere.
+    Sphere ToSphere() const;
+};
+
+//! A Box stored in a file.
+struct BoxRecord
+{
+    float m_InverseOrientation[3][3];   //!< Box::m_InverseOrientation
+    float m_Position[3];                //!< Box::m_Position
+    float m_Scale[3];                   //!< Box::m_Scale
+
+    //! Returns the record of a box.
+    static BoxRecord From(Box const & box);
+
+    //! Returns the box.
+    Box ToBox() const;
+};
+
+//! The chunk type of each record type.
+template <typename T> struct ChunkTypeOf;
+template <> struct ChunkTypeOf<Vector3>      { static ChunkType const VALUE = ChunkType::VECTOR3;    };
+template <> struct ChunkTypeOf<Quaternion>   { static ChunkType const VALUE = ChunkType::QUATERNION; };
+template <> struct ChunkTypeOf<Matrix43>     { static ChunkType const VALUE = ChunkType::MATRIX43;   };
+template <> struct ChunkTypeOf<Matrix44>     { static ChunkType const VALUE = ChunkType::MATRIX44;   };
+template <> struct ChunkTypeOf<AABoxRecord>  { static ChunkType const VALUE = ChunkType::AABOX;      };
+template <> struct ChunkTypeOf<SphereRecord> { static ChunkType const VALUE = ChunkType::SPHERE;     };
+template <> struct ChunkTypeOf<BoxRecord>    { static ChunkType const VALUE = ChunkType::BOX;        };
+
+//! A read-only view of an array.
+template <typename T>
+class Span
+{
+public:
+
+    //! Constructor.
+    Span() : m_pData(nullptr), m_Size(0) {}
+
+    //! Constructor.
+    Span(T const * pData, size_t size) : m_pData(pData), m_Size(size) {}
+
+    //! Returns the number of elements.
+    size_t Size() const { return m_Size; }
+
+    //! Returns the elements.
+    T const * Data() const { return m_pData; }
+
+    //! Returns element i.
+    T const & operator [](size_t i) const { return m_pData[i]; }
+
+    //! Returns the start of the elements.
+    T const * begin() const { return m_pData; }
+
+    //! Returns the end of the elements.
+    T const * end() const { return m_pData + m_Size; }
+
+private:
+
+    T const * m_pData;
+    size_t m_Size;
+};
+
+//! Builds a binary geometry file.
+//!
+//! Each call to Add() appends a chunk. The data is copied, so the arrays need not outlive the call.
+
+class BinaryFileWriter
+{
+public:
+
+    //! Appends a chunk of vectors.
+    void Add(Vector3 const * p, size_t n) { AddRecords(p, n); }
+
+    //! Appends a chunk of quaternions.
+    void Add(Quaternion const * p, size_t n) { AddRecords(p, n); }
+
+    //! Appends a chunk of matrices.
+    void Add(Matrix43 const * p, size_t n) { AddRecords(p, n); }
+
+    //! Appends a chunk of matrices.
+    void Add(Matrix44 const * p, size_t n) { AddRecords(p, n); }
+
+    //! Appends a chunk of axis-aligned boxes.
+    void Add(AABox const * p, size_t n);
+
+    //! Appends a chunk of spheres.
+    void Add(Sphere const * p, size_t n);
+
+    //! Appends a chunk of oriented boxes.
+    void Add(Box const * p, size_t n);
+
+    //! Writes the file to a binary stream. Returns false if the stream fails.
+    bool Write(std::ostream & out) const;
+
+    //! Writes the file. Returns false if it could not be written.
+    bool Write(char const * path) const;
+
+private:
+
+    struct Chunk
+    {
+        ChunkType m_Type;
+        uint32_t m_RecordSize;
+        uint64_t m_Count;
+        std::vector<char> m_Data;
+    };
+
+    // Appends a chunk of records that are stored as they are
+    template <typename T>
+    void AddRecords(T const * p, size_t n);
+
+    std::vector<Chunk> m_Chunks;
+};
+
+//! A binary geometry file mapped into memory.
+//!
+//! Opening the file only maps it and checks its header and chunk table, so it takes the same time regardless of the
+//! size of the file. The records are read in place through the spans returned by GetChunk(), which remain valid until
+//! the file is closed.
+
+class BinaryFileReader
+{
+public:
+
+    //! Constructor.
+    BinaryFileReader() = default;
+
+    //! Destructor. Closes the file.
+    ~BinaryFileReader() { Close(); }
+
+    BinaryFileReader(BinaryFileReader const &) = delete;
+    BinaryFileReader & operator =(BinaryFileReader const &) = delete;
+
+    //! Maps a file. Returns false if it can't be opened or is not a valid file.
+    bool Open(char const * path);
+
+    //! Unmaps the file.
+    void Close();
+
+    //! Returns the number of chunks.
+    int GetChunkCount() const { return int(m_Chunks.size()); }
+
+    //! Returns the type of chunk i.
+    ChunkType GetChunkType(int i) const { return m_Chunks[i].m_Type; }
+
+    //! Returns the index of the first chunk of a type at or after @a start, or -1.
+    int FindChunk(ChunkType type, int start = 0) const;
+
+    //! Returns the records of chunk i, which must be of type T.
+    template <typename T>
+    Span<T> GetChunk(int i) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Records must be trivially copyable");
+        assert(m_Chunks[i].m_Type == ChunkTypeOf<T>::VALUE);
+        assert(m_Chunks[i].m_RecordSize == sizeof(T));
+        return Span<T>(reinterpret_cast<T const *>(m_pData + m_Chunks[i].m_Offset), size_t(m_Chunks[i].m_Count));
+    }
+
+private:
+
+    struct Chunk
+    {
+        ChunkType m_Type;
+        uint32_t m_RecordSize;
+        uint64_t m_Count;
+        uint64_t m_Offset;
+    };
+
+    // Checks the header and chunk table and loads the table
+    bool Parse();
+
+    char const * m_pData = nullptr;     // Start of the mapped file
+    size_t m_Size        = 0;           // Size of the mapped file
+    void * m_hMapping    = nullptr;     // Windows file mapping handle
+    std::vector<Chunk> m_Chunks;        // Chunk table
+};
+
+//@}
+} // namespace MyMath
+
+// Inline functions
+
+#include "Misc/Assertx.h"
+
+namespace MyMath
+{
+template <typename T>
+void BinaryFileWriter::AddRecords(T const * p, size_t n)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Records must be trivially copyable");
+
+    Chunk chunk;
+    chunk.m_Type       = ChunkTypeOf<T>::VALUE;
+    chunk.m_RecordSize = uint32_t(sizeof(T));
+    chunk.m_Count      = n;
+    chunk.m_Data.assign(reinterpret_cast<char const *>(p), reinterpret_cast<char const *>(p + n));
+
+    m_Chunks.push_back(std::move(chunk));
+}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_BINARYFILE_H)
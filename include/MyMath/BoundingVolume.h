@@ -0,0 +1,127 @@
+#pragma once
+
+#if !defined(MYMATH_BOUNDINGVOLUME_H)
+#define MYMATH_BOUNDINGVOLUME_H
+
+#include <cstddef>
+#include <vector>
+
+class AABox;
+class Box;
+class Matrix33;
+class Matrix43;
+class Matrix43SoA;
+class Matrix44;
+class Sphere;
+class Vector3;
+class Vector3SoA;
+
+namespace MyMath
+{
+class TaskScheduler;
+
+//! @defgroup BoundingVolumes Bounding Volume Fitting
+//!
+//! These compute volumes that enclose sets of points. Each function that reads every point has an overload that
+//! divides the points among the threads of a TaskScheduler. The volumes computed in parallel enclose the same points
+//! but may differ slightly from the ones computed serially (see the individual functions).
+//!
+//! Extend() and ComputeBox() with a given orientation update a volume without refitting it from scratch, which is
+//! cheaper when the points move a little at a time (e.g. a deforming mesh).
+//!
+//! The sets of points must not be empty.
+//!
+//! @ingroup Geometry
+//@{
+
+//! Returns the smallest axis-aligned box enclosing a set of points.
+AABox ComputeAABox(Vector3 const * paPoints, size_t n);
+
+//! Returns the smallest axis-aligned box enclosing a set of points, in parallel.
+AABox ComputeAABox(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n);
+
+//! Returns the smallest axis-aligned box enclosing a set of points.
+AABox ComputeAABox(Vector3SoA const & points);
+
+//! Returns a sphere enclosing a set of points using Ritter's method. It is usually 5-20% larger than the minimal one.
+Sphere ComputeBoundingSphere(Vector3 const * paPoints, size_t n);
+
+//! Returns a sphere enclosing a set of points using Ritter's method, in parallel.
+Sphere ComputeBoundingSphere(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n);
+
+//! Returns the smallest sphere enclosing a set of points (Welzl's algorithm).
+Sphere ComputeMinimalSphere(Vector3 const * paPoints, size_t n);
+
+//! Returns the smallest sphere enclosing a set of points, in parallel.
+Sphere ComputeMinimalSphere(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n);
+
+//! Returns a tight oriented box enclosing a set of points (DiTO-14 with the principal axes as an extra candidate).
+Box ComputeBox(Vector3 const * paPoints, size_t n);
+
+//! Returns a tight oriented box enclosing a set of points, in parallel.
+Box ComputeBox(TaskScheduler & scheduler, Vector3 const * paPoints, size_t n);
+
+//! Returns the smallest box with the given orientation enclosing a set of points.
+Box ComputeBox(Matrix33 const & orientation, Vector3 const * paPoints, size_t n);
+
+//! Returns the smallest box with the given orientation enclosing a set of points, in parallel.
+Box ComputeBox(TaskScheduler & scheduler, Matrix33 const & orientation, Vector3 const * paPoints, size_t n);
+
+//! Grows an axis-aligned box to enclose a set of points.
+void Extend(AABox * pAABox, Vector3 const * paPoints, size_t n);
+
+//! Grows a sphere to enclose a set of points.
+void Extend(Sphere * pSphere, Vector3 const * paPoints, size_t n);
+
+//! Returns the smallest axis-aligned box enclosing two axis-aligned boxes.
+AABox Merge(AABox const & a, AABox const & b);
+
+//! Returns the smallest sphere enclosing two spheres.
+Sphere Merge(Sphere const & a, Sphere const & b);
+
+//@}
+
+//! @defgroup BoundingVolumeTransformation Bounding Volume Transformation
+//!
+//! These transform bounding volumes without transforming their corners or points (e.g. to update the world bounds of
+//! instances from their local bounds). The matrices are affine. A Matrix44 must have (0, 0, 0, 1) as its last column.
+//!
+//! The batched versions transform each element by the corresponding matrix. Axis-aligned boxes are given as centers
+//! and half-extents, which is the form that the transformation uses. The results may be the operands, and they are
+//! resized to the number of matrices.
+//!
+//! @ingroup Geometry
+//@{
+
+//! Returns the smallest axis-aligned box enclosing a transformed axis-aligned box (Arvo's method).
+AABox Transform(AABox const & aabox, Matrix43 const & m);
+
+//! Returns the smallest axis-aligned box enclosing a transformed axis-aligned box (Arvo's method).
+AABox Transform(AABox const & aabox, Matrix44 const & m);
+
+//! Returns a sphere enclosing a transformed sphere. The radius is scaled by a bound on the largest stretch of the
+//! matrix, which is exact if the matrix does not shear.
+Sphere Transform(Sphere const & sphere, Matrix43 const & m);
+
+//! Returns a sphere enclosing a transformed sphere. The radius is scaled by a bound on the largest stretch of the
+//! matrix, which is exact if the matrix does not shear.
+Sphere Transform(Sphere const & sphere, Matrix44 const & m);
+
+//! Returns the oriented box that is a transformed axis-aligned box. The matrix must not shear.
+Box TransformToBox(AABox const & aabox, Matrix43 const & m);
+
+//! Transforms axis-aligned boxes given as centers and half-extents (Arvo's method).
+void Transform(Vector3SoA const & centers, Vector3SoA const & halfExtents, Matrix43SoA const & m,
+               Vector3SoA * pCenters, Vector3SoA * pHalfExtents);
+
+//! Transforms spheres given as centers and radii. @a paRadii and @a paTransformedRadii have m.Size() values.
+void Transform(Vector3SoA const & centers, float const * paRadii, Matrix43SoA const & m,
+               Vector3SoA * pCenters, float * paTransformedRadii);
+
+//! Transforms an axis-aligned box by each matrix. The boxes replace the contents of @a pBoxes.
+void TransformToBox(AABox const & aabox, Matrix43SoA const & m, std::vector<Box> * pBoxes);
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_BOUNDINGVOLUME_H)
@@ -84,9 +84,50 @@ public:
     //! Returns the orientation of the box
     Matrix33 GetOrientation() const { return Matrix33(m_InverseOrientation).Transpose();  }
 
+    //! Recomputes the cached values. This must be called after m_InverseOrientation, m_Position or m_Scale is changed.
+    void Update();
+
+    //! Returns the center of the box.
+    Vector3 const & GetCenter() const { return m_Center; }
+
+    //! Returns half the size of the box along each of its axes. The elements are not negative.
+    Vector3 const & GetHalfExtents() const { return m_HalfExtents; }
+
+    //! Returns one of the axes of the box in world space (a row of the orientation).
+    Vector3 const & GetAxis(int i) const { return m_Axes[i]; }
+
+    //! Returns the smallest axis-aligned box that encloses the box.
+    AABox GetAABox() const;
+
     Matrix33 m_InverseOrientation;      //!< Inverse of the orientation of the box
     Vector3 m_Position;                 //!< Location of the origin of the box
     Vector3 m_Scale;                    //!< Size of the box
+
+private:
+
+    Vector3 m_Center;                   // Center of the box
+    Vector3 m_HalfExtents;              // Half the absolute value of the scale
+    Vector3 m_Axes[3];                  // Axes of the box in world space
 };
 
+namespace MyMath
+{
+//! @name Box Classification
+//!
+//! These classify many oriented boxes against one object using the boxes' cached centers, half-extents and axes.
+//! Result i is the value of Intersectable::Intersects() for box i.
+//@{
+
+//! Classifies oriented boxes against a point.
+void Classify(Point const & point, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults);
+
+//! Classifies oriented boxes against a sphere.
+void Classify(Sphere const & sphere, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults);
+
+//! Classifies oriented boxes against a ray.
+void Classify(Ray const & ray, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults);
+
+//@}
+} // namespace MyMath
+
 #endif // !defined(MYMATH_BOX_H)
@@ -0,0 +1,51 @@
+#pragma once
+
+#if !defined(MYMATH_CLIP_H)
+#define MYMATH_CLIP_H
+
+class Frustum;
+class HalfSpace;
+class Plane;
+class Poly;
+class PolyBuffer;
+class Vector3;
+
+namespace MyMath
+{
+//! @name Polygon Clipping
+//!
+//! Convex polygons are clipped with the Sutherland-Hodgman algorithm. As with HalfSpace and Frustum, the part of a
+//! polygon behind a plane (where DirectedDistance() <= 0) is kept. A result with fewer than 3 vertices is returned
+//! as 0 vertices.
+//!
+//! The array forms write into buffers provided by the caller and never allocate. Each plane adds at most one vertex
+//! to a convex polygon, so the buffers need room for the number of input vertices plus the number of planes. If
+//! rounding makes a nearly degenerate polygon slightly non-convex, vertices that don't fit are dropped (and assert).
+//@{
+
+//! Clips a polygon against a half-space and returns the number of vertices in the result.
+int Clip(Vector3 const * paVertices, int nVertices, HalfSpace const & halfspace, Vector3 * paResult);
+
+//! Splits a polygon by a plane into the parts in front of and behind it.
+void Split(Vector3 const * paVertices, int nVertices, Plane const & plane,
+           Vector3 * paFront, int * pnFront, Vector3 * paBack, int * pnBack);
+
+//! Clips a polygon against the sides of a frustum and returns the number of vertices in the result.
+int Clip(Vector3 const * paVertices, int nVertices, Frustum const & frustum, Vector3 * paResult, Vector3 * paScratch);
+
+//! Clips a polygon against a half-space. Returns false if nothing is left.
+bool Clip(Poly const & poly, HalfSpace const & halfspace, Poly * pResult);
+
+//! Splits a polygon by a plane into the parts in front of and behind it.
+void Split(Poly const & poly, Plane const & plane, Poly * pFront, Poly * pBack);
+
+//! Clips a polygon against the sides of a frustum. Returns false if nothing is left.
+bool Clip(Poly const & poly, Frustum const & frustum, Poly * pResult);
+
+//! Clips polygons against the sides of a frustum and appends the non-empty results to another buffer.
+void Clip(PolyBuffer const & polys, Frustum const & frustum, PolyBuffer * pResult);
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_CLIP_H)
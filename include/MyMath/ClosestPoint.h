@@ -0,0 +1,68 @@
+#pragma once
+
+#if !defined(MYMATH_CLOSESTPOINT_H)
+#define MYMATH_CLOSESTPOINT_H
+
+#include "Vector3.h"
+
+class AABox;
+class Box;
+class Segment;
+class SegmentSoA;
+class Sphere;
+class Vector3SoA;
+
+namespace MyMath
+{
+//! @name Closest Points
+//!
+//! These find the closest points between two objects and return the distance between them. If the objects overlap,
+//! the distance is 0 and both points are set to the same point in the overlap. The points on solids may be in their
+//! interiors.
+//@{
+
+//! Finds the closest points of two segments.
+float ClosestPoints(Segment const & a, Segment const & b, Vector3 * pA, Vector3 * pB);
+
+//! Finds the point in an axis-aligned box closest to a point.
+float ClosestPoints(Vector3 const & point, AABox const & aabox, Vector3 * pPoint);
+
+//! Finds the point in an oriented box closest to a point.
+float ClosestPoints(Vector3 const & point, Box const & box, Vector3 * pPoint);
+
+//! Finds the point on a triangle closest to a point.
+float ClosestPoints(Vector3 const & point, Vector3 const & v0, Vector3 const & v1, Vector3 const & v2,
+                    Vector3 * pPoint);
+
+//! Finds the closest points of a segment and an axis-aligned box.
+float ClosestPoints(Segment const & segment, AABox const & aabox, Vector3 * pSegment, Vector3 * pAABox);
+
+//! Finds the closest points of a sphere and an oriented box.
+float ClosestPoints(Sphere const & sphere, Box const & box, Vector3 * pSphere, Vector3 * pBox);
+
+//! Finds the closest points of two axis-aligned boxes.
+float ClosestPoints(AABox const & a, AABox const & b, Vector3 * pA, Vector3 * pB);
+
+//@}
+
+//! @name Batched Closest Points
+//!
+//! These test one object against N targets stored as streams. @a paDistances must have room for N values. The point
+//! arrays may be nullptr; otherwise, they must have room for N points.
+//@{
+
+//! Finds the points in N axis-aligned boxes closest to a point. Box i spans [minimums[i], maximums[i]].
+void ClosestPoints(Vector3 const & point, Vector3SoA const & minimums, Vector3SoA const & maximums,
+                   float * paDistances, Vector3 * paPoints);
+
+//! Finds the points on N segments closest to a point.
+void ClosestPoints(Vector3 const & point, SegmentSoA const & segments, float * paDistances, Vector3 * paPoints);
+
+//! Finds the closest points of a segment and N segments.
+void ClosestPoints(Segment const & segment, SegmentSoA const & segments, float * paDistances, Vector3 * paA,
+                   Vector3 * paB);
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_CLOSESTPOINT_H)
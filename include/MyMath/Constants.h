@@ -36,6 +36,8 @@ double constexpr SQRT_OF_2_OVER_2 = 7.07106781186547524400844e-1;
 double constexpr SQRT_OF_3        = 1.73205080756887729352745;
 double constexpr SQRT_OF_3_OVER_3 = 5.77350269189625764509149e-1;
 
+double constexpr LOGE_OF_SQRT_OF_TWO_PI = 9.18938533204672741780330e-1;
+
 //@}
 } // namespace MyMath
 
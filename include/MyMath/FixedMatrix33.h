@@ -0,0 +1,355 @@
+#pragma once
+
+#if !defined(MYMATH_FIXEDMATRIX33_H)
+#define MYMATH_FIXEDMATRIX33_H
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+#include <utility>
+
+template <typename T, int N>
+class FixedVector3;
+
+#pragma warning( push )
+#pragma warning( disable : 4201 )   // nonstandard extension used : nameless struct/union
+
+//! A 3x3 matrix of fixed-point values.
+//!
+//! @ingroup Matrices
+//!
+//! @param	T	Underlying integer type of the elements
+//! @param	N	Number of bits in the fraction part of the elements
+//!
+//! The interface mirrors Matrix33.
+
+template <typename T, int N>
+class FixedMatrix33
+{
+public:
+
+    //! Type of the elements
+    using Element = FixedPoint<T, N>;
+
+    //! Constructor.
+    FixedMatrix33() = default;
+
+    //! Constructor.
+    constexpr FixedMatrix33(Element xx, Element xy, Element xz,
+                            Element yx, Element yy, Element yz,
+                            Element zx, Element zy, Element zz);
+
+    //! Constructor.
+    constexpr FixedMatrix33(FixedVector3<T, N> const & x, FixedVector3<T, N> const & y, FixedVector3<T, N> const & z);
+
+    //! Returns the X vector.
+    FixedVector3<T, N> const & GetX() const;
+
+    //! Returns the Y vector.
+    FixedVector3<T, N> const & GetY() const;
+
+    //! returns the Z vector.
+    FixedVector3<T, N> const & GetZ() const;
+
+    //! Returns the determinant.
+    constexpr Element Determinant() const;
+
+    //! Returns true if the matrix is orthonormal (within a tolerance)
+    bool IsOrthonormal() const;
+
+    //! Tranposes the matrix. Returns the result.
+    constexpr FixedMatrix33 & Transpose();
+
+    //! Inverts the matrix. Returns the result.
+    constexpr FixedMatrix33 & Invert();
+
+    //! Pre-concatenates a matrix. Returns the result.
+    constexpr FixedMatrix33 & PreConcatenate(FixedMatrix33 const & b);
+
+    //! Post-concatenates a matrix. Returns the result.
+    constexpr FixedMatrix33 & PostConcatenate(FixedMatrix33 const & b);
+
+    //! Post-concatenates a matrix. Returns the result.
+    constexpr FixedMatrix33 & operator *=(FixedMatrix33 const & b);
+
+    //! Returns the inverse.
+    constexpr FixedMatrix33 operator ~() const;
+
+    union
+    {
+        Element m_M[3][3];                  //!< Elements as a 3x3 array.
+        struct
+        {
+            //! @name	Matrix elements
+            //@{
+            Element /** */ m_Xx, /** */ m_Xy, /** */ m_Xz;
+            Element /** */ m_Yx, /** */ m_Yy, /** */ m_Yz;
+            Element /** */ m_Zx, /** */ m_Zy, /** */ m_Zz;
+            //@}
+        };
+    };
+
+    //! Returns the identity matrix
+    static constexpr FixedMatrix33 Identity();
+};
+
+#pragma warning( pop )
+
+// Inline functions
+
+#include "FixedVector3.h"
+#include "MyMath.h"
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N>::FixedMatrix33(Element xx, Element xy, Element xz,
+                                             Element yx, Element yy, Element yz,
+                                             Element zx, Element zy, Element zz)
+    : m_Xx(xx)
+    , m_Xy(xy)
+    , m_Xz(xz)
+    , m_Yx(yx)
+    , m_Yy(yy)
+    , m_Yz(yz)
+    , m_Zx(zx)
+    , m_Zy(zy)
+    , m_Zz(zz)
+{
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N>::FixedMatrix33(FixedVector3<T, N> const & x,
+                                             FixedVector3<T, N> const & y,
+                                             FixedVector3<T, N> const & z)
+    : m_Xx(x.m_X)
+    , m_Xy(x.m_Y)
+    , m_Xz(x.m_Z)
+    , m_Yx(y.m_X)
+    , m_Yy(y.m_Y)
+    , m_Yz(y.m_Z)
+    , m_Zx(z.m_X)
+    , m_Zy(z.m_Y)
+    , m_Zz(z.m_Z)
+{
+}
+
+template <typename T, int N>
+FixedVector3<T, N> const & FixedMatrix33<T, N>::GetX() const
+{
+    return *reinterpret_cast<FixedVector3<T, N> const *>(&m_Xx);
+}
+
+template <typename T, int N>
+FixedVector3<T, N> const & FixedMatrix33<T, N>::GetY() const
+{
+    return *reinterpret_cast<FixedVector3<T, N> const *>(&m_Yx);
+}
+
+template <typename T, int N>
+FixedVector3<T, N> const & FixedMatrix33<T, N>::GetZ() const
+{
+    return *reinterpret_cast<FixedVector3<T, N> const *>(&m_Zx);
+}
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> FixedMatrix33<T, N>::Determinant() const
+{
+    return m_Xx * (m_Yy * m_Zz - m_Yz * m_Zy)
+         - m_Xy * (m_Yx * m_Zz - m_Yz * m_Zx)
+         + m_Xz * (m_Yx * m_Zy - m_Yy * m_Zx);
+}
+
+template <typename T, int N>
+bool FixedMatrix33<T, N>::IsOrthonormal() const
+{
+    double const r0 = 1.0 - double(GetX().Length());
+    double const r1 = 1.0 - double(GetY().Length());
+    double const r2 = 1.0 - double(GetZ().Length());
+    double const c0 = 1.0 - double(FixedVector3<T, N>(m_Xx, m_Yx, m_Zx).Length());
+    double const c1 = 1.0 - double(FixedVector3<T, N>(m_Xy, m_Yy, m_Zy).Length());
+    double const c2 = 1.0 - double(FixedVector3<T, N>(m_Xz, m_Yz, m_Zz).Length());
+
+    return (r0 * r0 + r1 * r1 + r2 * r2 + c0 * c0 + c1 * c1 + c2 * c2) < MyMath::DEFAULT_FLOAT_ORTHONORMAL_TOLERANCE;
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> & FixedMatrix33<T, N>::Transpose()
+{
+    std::swap(m_Xy, m_Yx);
+    std::swap(m_Xz, m_Zx);
+    std::swap(m_Yz, m_Zy);
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> & FixedMatrix33<T, N>::Invert()
+{
+    FixedMatrix33 const a(*this);
+    Element const       det = a.Determinant();
+
+    assert(det.Raw() != 0);
+
+    if (det.Raw() != 0)
+    {
+        m_Xx =  (a.m_Yy * a.m_Zz - a.m_Yz * a.m_Zy) / det;
+        m_Xy = -(a.m_Xy * a.m_Zz - a.m_Xz * a.m_Zy) / det;
+        m_Xz =  (a.m_Xy * a.m_Yz - a.m_Xz * a.m_Yy) / det;
+
+        m_Yx = -(a.m_Yx * a.m_Zz - a.m_Yz * a.m_Zx) / det;
+        m_Yy =  (a.m_Xx * a.m_Zz - a.m_Xz * a.m_Zx) / det;
+        m_Yz = -(a.m_Xx * a.m_Yz - a.m_Xz * a.m_Yx) / det;
+
+        m_Zx =  (a.m_Yx * a.m_Zy - a.m_Yy * a.m_Zx) / det;
+        m_Zy = -(a.m_Xx * a.m_Zy - a.m_Xy * a.m_Zx) / det;
+        m_Zz =  (a.m_Xx * a.m_Yy - a.m_Xy * a.m_Yx) / det;
+    }
+    else
+    {
+        *this = Identity();
+    }
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> & FixedMatrix33<T, N>::PostConcatenate(FixedMatrix33 const & b)
+{
+    FixedMatrix33 c = *this;
+
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            c.m_M[i][j] =   m_M[i][0] * b.m_M[0][j]
+                          + m_M[i][1] * b.m_M[1][j]
+                          + m_M[i][2] * b.m_M[2][j];
+        }
+    }
+
+    *this = c;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> & FixedMatrix33<T, N>::PreConcatenate(FixedMatrix33 const & b)
+{
+    FixedMatrix33 c = *this;
+
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            c.m_M[i][j] =   b.m_M[i][0] * m_M[0][j]
+                          + b.m_M[i][1] * m_M[1][j]
+                          + b.m_M[i][2] * m_M[2][j];
+        }
+    }
+
+    *this = c;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> & FixedMatrix33<T, N>::operator *=(FixedMatrix33 const & b)
+{
+    return PostConcatenate(b);
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> FixedMatrix33<T, N>::operator ~() const
+{
+    return FixedMatrix33(*this).Invert();
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> FixedMatrix33<T, N>::Identity()
+{
+    return FixedMatrix33(Element(1), Element(0), Element(0),
+                         Element(0), Element(1), Element(0),
+                         Element(0), Element(0), Element(1));
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::Transform(FixedMatrix33<T, N> const & m)
+{
+    Element const x = m_X;
+    Element const y = m_Y;
+    Element const z = m_Z;
+
+    m_X = x * m.m_Xx + y * m.m_Yx + z * m.m_Zx;
+    m_Y = x * m.m_Xy + y * m.m_Yy + z * m.m_Zy;
+    m_Z = x * m.m_Xz + y * m.m_Yz + z * m.m_Zz;
+
+    return *this;
+}
+
+//! Returns the product of @a a and @a b.
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> operator *(FixedMatrix33<T, N> a, FixedMatrix33<T, N> const & b)
+{
+    return a.PostConcatenate(b);
+}
+
+//! Returns the result of transforming @a v by @a m.
+template <typename T, int N>
+constexpr FixedVector3<T, N> operator *(FixedVector3<T, N> v, FixedMatrix33<T, N> const & m)
+{
+    return v.Transform(m);
+}
+
+namespace MyMath
+{
+//! Transforms an array of vectors (vM).
+//!
+//! @param	v		Vectors to transform
+//! @param	m		Transformation
+//! @param	pR		Where to store the transformed vectors. May be the same as @a v.
+//! @param	count	Number of vectors
+//!
+//! @ingroup Matrices
+//!
+//! The vectors are processed in blocks. Each column of the matrix is applied to a block with the array form of
+//! FixedPoint::MultiplyAdd(), so the results are identical to transforming each vector individually.
+
+template <typename T, int N>
+void Transform(FixedVector3<T, N> const * v, FixedMatrix33<T, N> const & m, FixedVector3<T, N> * pR, size_t count)
+{
+    using Element = FixedPoint<T, N>;
+
+    size_t constexpr BLOCK_SIZE = 64;
+
+    Element x[BLOCK_SIZE];
+    Element y[BLOCK_SIZE];
+    Element z[BLOCK_SIZE];
+    Element r[3][BLOCK_SIZE];
+    Element const zero[BLOCK_SIZE] = {};
+
+    for (size_t i = 0; i < count; i += BLOCK_SIZE)
+    {
+        size_t const n = std::min(count - i, BLOCK_SIZE);
+
+        for (size_t k = 0; k < n; ++k)
+        {
+            x[k] = v[i + k].m_X;
+            y[k] = v[i + k].m_Y;
+            z[k] = v[i + k].m_Z;
+        }
+
+        for (int j = 0; j < 3; ++j)
+        {
+            Element::MultiplyAdd(zero, x, m.m_M[0][j], r[j], n);
+            Element::MultiplyAdd(r[j], y, m.m_M[1][j], r[j], n);
+            Element::MultiplyAdd(r[j], z, m.m_M[2][j], r[j], n);
+        }
+
+        for (size_t k = 0; k < n; ++k)
+        {
+            pR[i + k] = FixedVector3<T, N>(r[0][k], r[1][k], r[2][k]);
+        }
+    }
+}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_FIXEDMATRIX33_H)
@@ -3,156 +3,530 @@
 #if !defined(MYMATH_FIXEDPOINT_H)
 #define MYMATH_FIXEDPOINT_H
 
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
 //! Fixed point representation
 //!
-//! @param	T	Underlying integer type. The type must be signed.
+//! @param	T	Underlying integer type. The type must be signed, and 8, 16, 32, or 64 bits.
 //! @param	N	Number of bits in the fraction part
+//!
+//! The width of the intermediate values used by multiplication and division is selected at compile time. 64-bit
+//! values use @c __int128 where the compiler supports it, and a portable 128-bit implementation otherwise. All
+//! implementations produce identical results, so computations are bit-exact across platforms.
+//!
+//! The array forms of Multiply() and MultiplyAdd() use SSE4.1 or AVX2 for 32-bit values when the compiler targets
+//! them. The results are identical to the scalar forms.
 
 template <typename T, int N>
 class FixedPoint
 {
+    static_assert(std::is_integral<T>::value && std::is_signed<T>::value, "T must be a signed integer type");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "T must be 8, 16, 32, or 64 bits");
+    static_assert(N >= 0 && N < int(sizeof(T) * 8), "N must be less than the number of bits in T");
+
 public:
 
+    //! Rounding of the result of multiplication and division
+    enum Rounding
+    {
+        TRUNCATE,           //!< Round toward zero
+        ROUND_TO_NEAREST    //!< Round to the nearest value, with halfway cases rounded away from zero
+    };
+
+    //! Handling of results of multiplication and division that cannot be represented
+    enum Overflow
+    {
+        WRAP,               //!< Keep the low-order bits of the result
+        SATURATE            //!< Clamp the result to the minimum or maximum value
+    };
+
     //! Default constructor (leaves the value uninitialized)
     FixedPoint() = default;
 
     //! Constructor.
-    FixedPoint(double x)
+    constexpr FixedPoint(double x)
+        : value(T(x * SCALE + (x < 0.0 ? -0.5 : 0.5)))
     {
-        value = T(ldexp(x, N) + 0.5);
     }
 
     //! Constructor.
-    FixedPoint(int x)
+    constexpr FixedPoint(int x)
+        : value(T(int64_t(x) * int64_t(uint64_t(1) << N)))
     {
-        value = x << N;
     }
 
+    //! Conversion
     template <typename U, int M>
-    FixedPoint(FixedPoint<U, M> x)
+    constexpr FixedPoint(FixedPoint<U, M> x)
+        : value(0)
     {
-        if (M < N)
-            value = T(x.value) << (N - M);
+        if constexpr (M < N)
+            value = T(T(x.value) * (T(1) << (N - M)));
         else
-            value = T(x.value / (1 << (M - N)));
+            value = T(x.value >> (M - N));
     }
 
     //! Destructor.
     ~FixedPoint() = default;
 
     //! Conversion to double
-    operator double() const
+    constexpr operator double() const
     {
-        return ldexp(value, -N);
+        return double(value) / SCALE;
     }
 
-    //! Conversion to long
-    operator long() const
+    //! Conversion to long (rounded toward negative infinity)
+    constexpr operator long() const
     {
-        return (long)((value >> N) & unsigned long(-1));
+        return long(value >> N);
     }
 
     //! += operator
-    FixedPoint & operator +=(FixedPoint const & y)
+    constexpr FixedPoint & operator +=(FixedPoint const & y)
     {
         value += y.value;
         return *this;
     }
 
     //! -= operator
-    FixedPoint & operator -=(FixedPoint const & y)
+    constexpr FixedPoint & operator -=(FixedPoint const & y)
     {
         value -= y.value;
         return *this;
     }
 
     //! *= operator
-    FixedPoint & operator *=(FixedPoint const & y)
+    constexpr FixedPoint & operator *=(FixedPoint const & y)
     {
-        if (sizeof(T) == sizeof(int8_t))
-        {
-            int16_t temp;
+        *this = Multiply(*this, y);
+        return *this;
+    }
 
-            temp  = int16_t(value) * int16_t(y.value);
-            value = (T)(temp / (int16_t(1) << N) & uint8(-1));
-        }
-        else if (sizeof(T) == sizeof(int16_t))
+    //! /= operator
+    constexpr FixedPoint & operator /=(FixedPoint const & y)
+    {
+        *this = Divide(*this, y);
+        return *this;
+    }
+
+    //! negation operator
+    constexpr FixedPoint operator -() const
+    {
+        return FromRaw(T(-value));
+    }
+
+    //! Returns the underlying integer representation.
+    constexpr T Raw() const { return value; }
+
+    //! Returns a fixed-point value with the given underlying integer representation.
+    static constexpr FixedPoint FromRaw(T raw)
+    {
+        FixedPoint x(0);
+        x.value = raw;
+        return x;
+    }
+
+    //! Returns the product of two values using the specified rounding and overflow handling.
+    template <Rounding R = ROUND_TO_NEAREST, Overflow O = WRAP>
+    static constexpr FixedPoint Multiply(FixedPoint x, FixedPoint y);
+
+    //! Returns the quotient of two values using the specified rounding and overflow handling.
+    template <Rounding R = ROUND_TO_NEAREST, Overflow O = WRAP>
+    static constexpr FixedPoint Divide(FixedPoint x, FixedPoint y);
+
+    //! Computes the products of two arrays of values using the specified rounding and overflow handling.
+    template <Rounding R = ROUND_TO_NEAREST, Overflow O = WRAP>
+    static void Multiply(FixedPoint const * x, FixedPoint const * y, FixedPoint * pR, size_t count);
+
+    //! Computes a + x * s for arrays of values using the specified rounding and overflow handling.
+    template <Rounding R = ROUND_TO_NEAREST, Overflow O = WRAP>
+    static void MultiplyAdd(FixedPoint const * a, FixedPoint const * x, FixedPoint s, FixedPoint * pR, size_t count);
+
+private:
+
+    template <typename U, int M>
+    friend class FixedPoint;
+
+    template <typename U, int M>
+    friend class FixedPointMath;
+
+    // Intermediate type for multiplication and division of 8, 16, and 32-bit values
+    using Wide = std::conditional_t<sizeof(T) == 1, int16_t, std::conditional_t<sizeof(T) == 2, int32_t, int64_t>>;
+
+    static constexpr double SCALE = double(uint64_t(1) << N);   // 2**N (exact)
+
+    // Converts a wide intermediate result to T
+    template <Overflow O, typename W>
+    static constexpr T Narrow(W x)
+    {
+        if constexpr (O == SATURATE)
         {
-            int32_t temp;
+            if (x > W(std::numeric_limits<T>::max()))
+                return std::numeric_limits<T>::max();
+            if (x < W(std::numeric_limits<T>::min()))
+                return std::numeric_limits<T>::min();
+        }
+        return T(x);
+    }
 
-            temp  = int32_t(value) * int32_t(y.value);
-            value = (T)(temp / (int32_t(1) << N) & uint16(-1));
+    // Converts a sign and a 128-bit magnitude to T
+    template <Overflow O>
+    static constexpr T Narrow128(bool negative, uint64_t hi, uint64_t lo)
+    {
+        if constexpr (O == SATURATE)
+        {
+            uint64_t const limit = negative ? uint64_t(1) << 63 : (uint64_t(1) << 63) - 1;
+            if (hi != 0 || lo > limit)
+                return negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
         }
-        else         // if ( sizeof( T ) == sizeof( int32_t ) )
+        return T(negative ? ~lo + 1 : lo);
+    }
+
+    // Returns the full 128-bit product of two 64-bit values
+    static constexpr void Multiply128(uint64_t a, uint64_t b, uint64_t * pHi, uint64_t * pLo)
+    {
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+        *pLo = _umul128(a, b, pHi);
+#else
+        uint64_t const a0 = a & 0xffffffff;
+        uint64_t const a1 = a >> 32;
+        uint64_t const b0 = b & 0xffffffff;
+        uint64_t const b1 = b >> 32;
+
+        uint64_t const p00 = a0 * b0;
+        uint64_t const p01 = a0 * b1;
+        uint64_t const p10 = a1 * b0;
+        uint64_t const p11 = a1 * b1;
+
+        uint64_t const middle = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+
+        *pLo = (middle << 32) | (p00 & 0xffffffff);
+        *pHi = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+#endif
+    }
+
+    // Divides a 128-bit value by a 64-bit value. Returns the 128-bit quotient and the remainder.
+    static constexpr uint64_t Divide128(uint64_t * pHi, uint64_t * pLo, uint64_t d)
+    {
+        uint64_t hi        = *pHi;
+        uint64_t lo        = *pLo;
+        uint64_t remainder = 0;
+
+        for (int i = 0; i < 128; ++i)
         {
-            int64_t temp;
+            bool const carry = (remainder >> 63) != 0;
+            remainder = (remainder << 1) | (hi >> 63);
+            hi        = (hi << 1) | (lo >> 63);
+            lo      <<= 1;
 
-            temp  = int64_t(value) * int64_t(y.value);
-            value = (T)(temp / (int64_t(1) << N) & uint32(-1));
+            if (carry || remainder >= d)
+            {
+                remainder -= d;
+                lo        |= 1;
+            }
         }
-//      else // if ( sizeof( T ) == sizeof( int64_t ) )
-//      {
-//          int128_t	temp;
-//
-//          temp = int128_t( value ) * int128_t( y.value );
-//          value = (T)( temp / ( int128_t(1) << N ) & uint64(-1) );
-//      }
-//		else
-//		{
-//			T	temp[2];
-//		}
-        return *this;
+
+        *pHi = hi;
+        *pLo = lo;
+        return remainder;
     }
 
-    //! /= operator
-    FixedPoint & operator /=(FixedPoint const & y)
+    // True if the array forms of Multiply() and MultiplyAdd() have a vectorized implementation
+    template <Overflow O>
+    static constexpr bool VECTORIZED = sizeof(T) == 4 && O == WRAP;
+
+#if defined(__AVX2__)
+    // Returns the low 32 bits of the rounded products of 8 pairs of 32-bit values
+    template <Rounding R>
+    static __m256i Multiply8(__m256i x, __m256i y)
+    {
+        __m256i const even = Round8<R>(_mm256_mul_epi32(x, y));
+        __m256i const odd  = Round8<R>(_mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32)));
+        return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+    }
+
+    // Rounds 4 64-bit products and shifts out the fraction. The low 32 bits of the logical shift are the same as
+    // those of the arithmetic shift done by the scalar implementation.
+    template <Rounding R>
+    static __m256i Round8(__m256i p)
+    {
+        __m256i const sign = _mm256_shuffle_epi32(_mm256_srai_epi32(p, 31), _MM_SHUFFLE(3, 3, 1, 1));
+        __m256i       bias;
+        if constexpr (R == TRUNCATE)
+            bias = _mm256_and_si256(sign, _mm256_set1_epi64x((int64_t(1) << N) - 1));
+        else if constexpr (N > 0)
+            bias = _mm256_add_epi64(_mm256_set1_epi64x(int64_t(1) << (N - 1)), sign);
+        else
+            bias = _mm256_setzero_si256();
+        return _mm256_srli_epi64(_mm256_add_epi64(p, bias), N);
+    }
+#endif // defined(__AVX2__)
+
+#if defined(__SSE4_1__)
+    // Returns the low 32 bits of the rounded products of 4 pairs of 32-bit values
+    template <Rounding R>
+    static __m128i Multiply4(__m128i x, __m128i y)
+    {
+        __m128i const even = Round4<R>(_mm_mul_epi32(x, y));
+        __m128i const odd  = Round4<R>(_mm_mul_epi32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32)));
+        return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xcc);
+    }
+
+    // Rounds 2 64-bit products and shifts out the fraction
+    template <Rounding R>
+    static __m128i Round4(__m128i p)
+    {
+        __m128i const sign = _mm_shuffle_epi32(_mm_srai_epi32(p, 31), _MM_SHUFFLE(3, 3, 1, 1));
+        __m128i       bias;
+        if constexpr (R == TRUNCATE)
+            bias = _mm_and_si128(sign, _mm_set1_epi64x((int64_t(1) << N) - 1));
+        else if constexpr (N > 0)
+            bias = _mm_add_epi64(_mm_set1_epi64x(int64_t(1) << (N - 1)), sign);
+        else
+            bias = _mm_setzero_si128();
+        return _mm_srli_epi64(_mm_add_epi64(p, bias), N);
+    }
+#endif // defined(__SSE4_1__)
+
+    T value;
+};
+
+//! @tparam	R	Rounding mode
+//! @tparam	O	Overflow handling
+//! @param	x	Fixed-point operand
+//! @param	y	Fixed-point operand
+//!
+//! @return		x * y
+
+template <typename T, int N>
+template <typename FixedPoint<T, N>::Rounding R, typename FixedPoint<T, N>::Overflow O>
+constexpr FixedPoint<T, N> FixedPoint<T, N>::Multiply(FixedPoint x, FixedPoint y)
+{
+    if constexpr (sizeof(T) < sizeof(int64_t))
+    {
+        // The product of the bias and the shift rounds as specified for both signs.
+        //	TRUNCATE:			p < 0 ? p + 2**N - 1 : p
+        //	ROUND_TO_NEAREST:	p < 0 ? p + 2**(N-1) - 1 : p + 2**(N-1)
+
+        Wide const p = Wide(Wide(x.value) * Wide(y.value));
+        Wide       bias = 0;
+
+        if constexpr (R == TRUNCATE)
+            bias = p < 0 ? Wide((Wide(1) << N) - 1) : Wide(0);
+        else if constexpr (N > 0)
+            bias = Wide((Wide(1) << (N - 1)) - (p < 0 ? 1 : 0));
+
+        return FromRaw(Narrow<O>(Wide((p + bias) >> N)));
+    }
+#if defined(__SIZEOF_INT128__)
+    else
+    {
+        __int128 const p    = __int128(x.value) * __int128(y.value);
+        __int128       bias = 0;
+
+        if constexpr (R == TRUNCATE)
+            bias = p < 0 ? (__int128(1) << N) - 1 : __int128(0);
+        else if constexpr (N > 0)
+            bias = (__int128(1) << (N - 1)) - (p < 0 ? 1 : 0);
+
+        return FromRaw(Narrow<O>((p + bias) >> N));
+    }
+#else
+    else
     {
-        if (sizeof(T) == sizeof(int8_t))
+        // Compute the magnitude of the product and then apply the sign.
+
+        bool const     negative = (x.value < 0) != (y.value < 0);
+        uint64_t const ax       = x.value < 0 ? ~uint64_t(x.value) + 1 : uint64_t(x.value);
+        uint64_t const ay       = y.value < 0 ? ~uint64_t(y.value) + 1 : uint64_t(y.value);
+        uint64_t       hi       = 0;
+        uint64_t       lo       = 0;
+
+        Multiply128(ax, ay, &hi, &lo);
+
+        if constexpr (R == ROUND_TO_NEAREST && N > 0)
         {
-            int16_t temp;
+            uint64_t const half = uint64_t(1) << (N - 1);
+            lo += half;
+            hi += lo < half ? 1 : 0;
+        }
 
-            temp  = int16_t(value) * (int16_t(1) << N) / int16_t(y.value);
-            value = (T)(temp & uint8(-1));
+        if constexpr (N > 0)
+        {
+            lo = (lo >> N) | (hi << (64 - N));
+            hi >>= N;
         }
-        else if (sizeof(T) == sizeof(int16_t))
+
+        return FromRaw(Narrow128<O>(negative, hi, lo));
+    }
+#endif
+}
+
+//! @tparam	R	Rounding mode
+//! @tparam	O	Overflow handling
+//! @param	x	Fixed-point operand
+//! @param	y	Fixed-point operand. Must not be 0.
+//!
+//! @return		x / y. If @a y is 0 and @a O is SATURATE, the result is the maximum or minimum value depending on the
+//!				sign of @a x.
+
+template <typename T, int N>
+template <typename FixedPoint<T, N>::Rounding R, typename FixedPoint<T, N>::Overflow O>
+constexpr FixedPoint<T, N> FixedPoint<T, N>::Divide(FixedPoint x, FixedPoint y)
+{
+    assert(y.value != 0);
+
+    if constexpr (O == SATURATE)
+    {
+        if (y.value == 0)
+            return FromRaw(x.value < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max());
+    }
+
+    // Rounding to nearest is done by adding half of the divisor to the magnitude of the dividend. The quotient is
+    // truncated toward zero.
+
+    if constexpr (sizeof(T) < sizeof(int64_t))
+    {
+        Wide const n = Wide(Wide(x.value) * (Wide(1) << N));
+        Wide const d = Wide(y.value);
+        Wide       h = 0;
+
+        if constexpr (R == ROUND_TO_NEAREST)
+            h = Wide((d < 0 ? -d : d) / 2);
+
+        return FromRaw(Narrow<O>(Wide((n < 0 ? n - h : n + h) / d)));
+    }
+#if defined(__SIZEOF_INT128__)
+    else
+    {
+        __int128 const n = __int128(x.value) * (__int128(1) << N);
+        __int128 const d = __int128(y.value);
+        __int128       h = 0;
+
+        if constexpr (R == ROUND_TO_NEAREST)
+            h = (d < 0 ? -d : d) / 2;
+
+        return FromRaw(Narrow<O>((n < 0 ? n - h : n + h) / d));
+    }
+#else
+    else
+    {
+        bool const     negative = (x.value < 0) != (y.value < 0);
+        uint64_t const ax       = x.value < 0 ? ~uint64_t(x.value) + 1 : uint64_t(x.value);
+        uint64_t const ay       = y.value < 0 ? ~uint64_t(y.value) + 1 : uint64_t(y.value);
+        uint64_t       hi       = N > 0 ? ax >> (64 - N) : 0;
+        uint64_t       lo       = ax << N;
+
+        if constexpr (R == ROUND_TO_NEAREST)
         {
-            int32_t temp;
+            uint64_t const h = ay / 2;
+            lo += h;
+            hi += lo < h ? 1 : 0;
+        }
+
+        Divide128(&hi, &lo, ay);
+
+        return FromRaw(Narrow128<O>(negative, hi, lo));
+    }
+#endif
+}
 
-            temp  = int32_t(value) * (int32_t(1) << N) / int32_t(y.value);
-            value = (T)(temp & uint16(-1));
+//! @tparam	R		Rounding mode
+//! @tparam	O		Overflow handling
+//! @param	x		Fixed-point operands
+//! @param	y		Fixed-point operands
+//! @param	pR		Where to store the products. May be the same as @a x or @a y.
+//! @param	count	Number of values
+
+template <typename T, int N>
+template <typename FixedPoint<T, N>::Rounding R, typename FixedPoint<T, N>::Overflow O>
+void FixedPoint<T, N>::Multiply(FixedPoint const * x, FixedPoint const * y, FixedPoint * pR, size_t count)
+{
+    size_t i = 0;
+
+    if constexpr (VECTORIZED<O>)
+    {
+#if defined(__AVX2__)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i const vx = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(x + i));
+            __m256i const vy = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(y + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(pR + i), Multiply8<R>(vx, vy));
         }
-        else         // if ( sizeof( T ) == sizeof( int32_t ) )
+#endif
+#if defined(__SSE4_1__)
+        for (; i + 4 <= count; i += 4)
         {
-            int64_t temp;
-
-            temp  = int64_t(value) * (int64_t(1) << N) / int64_t(y.value);
-            value = (T)(temp & uint32(-1));
+            __m128i const vx = _mm_loadu_si128(reinterpret_cast<__m128i const *>(x + i));
+            __m128i const vy = _mm_loadu_si128(reinterpret_cast<__m128i const *>(y + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pR + i), Multiply4<R>(vx, vy));
         }
-//		else if ( sizeof( T ) == sizeof( int64_t ) )
-//		{
-//			int128_t	temp;
-//
-//			temp = ( int128_t( value ) * ( int16_t(1) << N ) / int128_t( y.value );
-//			value = (T)( temp ) & uint64(-1) );
-//		}
-//		else
-//		{
-//			T	temp[2];
-//		}
-        return *this;
+#endif
     }
 
-    //! negation operator
-    FixedPoint & operator -()
+    for (; i < count; ++i)
     {
-        value = -value;
-        return *this;
+        pR[i] = Multiply<R, O>(x[i], y[i]);
     }
+}
 
-private:
+//! @tparam	R		Rounding mode
+//! @tparam	O		Overflow handling
+//! @param	a		Fixed-point addends
+//! @param	x		Fixed-point values to be scaled
+//! @param	s		Scale
+//! @param	pR		Where to store the results. May be the same as @a a or @a x.
+//! @param	count	Number of values
+//!
+//! @note	Only the product is rounded. The addition wraps regardless of @a O.
 
-    T value;
-};
+template <typename T, int N>
+template <typename FixedPoint<T, N>::Rounding R, typename FixedPoint<T, N>::Overflow O>
+void FixedPoint<T, N>::MultiplyAdd(FixedPoint const * a, FixedPoint const * x, FixedPoint s, FixedPoint * pR, size_t count)
+{
+    size_t i = 0;
+
+    if constexpr (VECTORIZED<O>)
+    {
+#if defined(__AVX2__)
+        __m256i const vs8 = _mm256_set1_epi32(int32_t(s.value));
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i const va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + i));
+            __m256i const vx = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(x + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(pR + i), _mm256_add_epi32(va, Multiply8<R>(vx, vs8)));
+        }
+#endif
+#if defined(__SSE4_1__)
+        __m128i const vs4 = _mm_set1_epi32(int32_t(s.value));
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i const va = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a + i));
+            __m128i const vx = _mm_loadu_si128(reinterpret_cast<__m128i const *>(x + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(pR + i), _mm_add_epi32(va, Multiply4<R>(vx, vs4)));
+        }
+#endif
+    }
+
+    for (; i < count; ++i)
+    {
+        pR[i] = FromRaw(T(a[i].value + Multiply<R, O>(x[i], s).value));
+    }
+}
 
 //! Returns the sum of two fixed-point values.
 //
@@ -161,7 +535,7 @@ private:
 //! @return		x + y
 
 template <typename T, int N>
-FixedPoint<T, N> operator +(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
+constexpr FixedPoint<T, N> operator +(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
 {
     return x += y;
 }
@@ -173,7 +547,7 @@ FixedPoint<T, N> operator +(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
 //! @return		x - y
 
 template <typename T, int N>
-FixedPoint<T, N> operator -(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
+constexpr FixedPoint<T, N> operator -(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
 {
     return x -= y;
 }
@@ -185,7 +559,7 @@ FixedPoint<T, N> operator -(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
 //! @return		x * y
 
 template <typename T, int N>
-FixedPoint<T, N> operator *(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
+constexpr FixedPoint<T, N> operator *(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
 {
     return x *= y;
 }
@@ -197,20 +571,594 @@ FixedPoint<T, N> operator *(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
 //! @return		x / y
 
 template <typename T, int N>
-FixedPoint<T, N> operator /(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
+constexpr FixedPoint<T, N> operator /(FixedPoint<T, N> x, FixedPoint<T, N> const & y)
 {
     return x /= y;
 }
 
+
+//! Integer-only implementations of the fixed-point elementary functions.
+//!
+//! @param	T	Underlying integer type of the fixed-point values
+//! @param	N	Number of bits in the fraction part of the fixed-point values
+//!
+//! The computations are done in 64-bit integers with WORKING_BITS fraction bits (3 guard bits, limited to 56). The
+//! tables are generated at compile time using only IEEE-754 basic operations on doubles, so they -- and the results
+//! -- are identical on every platform. The precision of the tables is limited to that of a double.
+//!
+//! @note	These functions are used to implement sqrt(), sin(), cos(), tan(), atan2(), exp(), and log() for
+//!			FixedPoint values and are not generally called directly.
+
+template <typename T, int N>
+class FixedPointMath
+{
+public:
+
+    using Fixed = FixedPoint<T, N>;
+
+    //! Number of bits in the fraction part of the intermediate values
+    static int constexpr WORKING_BITS = N + 3 < 56 ? N + 3 : 56;
+
+    //! Returns the square root of @a x (rounded to nearest).
+    static constexpr T Sqrt(T x);
+
+    //! Computes the sine and cosine of @a x.
+    static constexpr void SinCos(T x, T * pSin, T * pCos);
+
+    //! Returns the tangent of @a x.
+    static constexpr T Tan(T x);
+
+    //! Returns the angle of the vector [x, y] in the range [-pi, pi].
+    static constexpr T Atan2(T y, T x);
+
+    //! Returns e raised to the power of @a x.
+    static constexpr T Exp(T x);
+
+    //! Returns the natural logarithm of @a x.
+    static constexpr T Log(T x);
+
+private:
+
+    static int constexpr W          = WORKING_BITS;
+    static int constexpr G          = W - N;                 // Number of guard bits (negative if N > 56)
+    static int constexpr ITERATIONS = W;
+
+    // Returns round(x * 2**W) of a double computed at compile time
+    static constexpr int64_t ToWorking(double x)
+    {
+        double const scaled = x * double(uint64_t(1) << W);
+        return int64_t(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    // Returns atan(x) for |x| <= 1/2 using its Taylor series
+    static constexpr double AtanSeries(double x)
+    {
+        double sum  = 0.0;
+        double term = x;
+        for (int k = 1; k < 200; k += 2)
+        {
+            sum  += ((k / 2) % 2 == 0) ? term / k : -term / k;
+            term *= x * x;
+        }
+        return sum;
+    }
+
+    // Returns ln(1 + x) for 0 < x <= 1/2 using its Taylor series
+    static constexpr double Log1pSeries(double x)
+    {
+        double sum  = 0.0;
+        double term = x;
+        for (int k = 1; k < 200; ++k)
+        {
+            sum  += (k % 2 == 1) ? term / k : -term / k;
+            term *= x;
+        }
+        return sum;
+    }
+
+    // Returns sqrt(x) using Newton's method
+    static constexpr double SqrtNewton(double x)
+    {
+        double y = x > 1.0 ? x : 1.0;
+        for (int i = 0; i < 100; ++i)
+            y = 0.5 * (y + x / y);
+        return y;
+    }
+
+    // CORDIC angles: atan(2**-i) for i = 0 .. ITERATIONS-1
+    static constexpr std::array<int64_t, ITERATIONS> MakeAtanTable()
+    {
+        std::array<int64_t, ITERATIONS> table{};
+        table[0] = ToWorking(0.78539816339744830962);
+        double x = 0.5;
+        for (int i = 1; i < ITERATIONS; ++i)
+        {
+            table[i] = ToWorking(AtanSeries(x));
+            x       *= 0.5;
+        }
+        return table;
+    }
+
+    // Shift-and-add logarithms: ln(1 + 2**-i) for i = 1 .. ITERATIONS-1 (element 0 is ln 2)
+    static constexpr std::array<int64_t, ITERATIONS> MakeLogTable()
+    {
+        std::array<int64_t, ITERATIONS> table{};
+        table[0] = ToWorking(0.69314718055994530942);
+        double x = 0.5;
+        for (int i = 1; i < ITERATIONS; ++i)
+        {
+            table[i] = ToWorking(Log1pSeries(x));
+            x       *= 0.5;
+        }
+        return table;
+    }
+
+    // Reciprocal of the CORDIC gain: prod( 1 / sqrt( 1 + 2**-2i ) )
+    static constexpr int64_t MakeCordicGain()
+    {
+        double p = 1.0;
+        double x = 1.0;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            p *= 1.0 + x;
+            x *= 0.25;
+        }
+        return ToWorking(1.0 / SqrtNewton(p));
+    }
+
+    static constexpr std::array<int64_t, ITERATIONS> ATAN = MakeAtanTable();
+    static constexpr std::array<int64_t, ITERATIONS> LOG  = MakeLogTable();
+
+    // 2pi * 2**125 (128 bits). The multiples of pi are derived from these bits rather than from a double so that
+    // large angles can be reduced accurately.
+    static constexpr uint64_t TWO_PI_BITS_HI = 0xc90fdaa22168c234;
+    static constexpr uint64_t TWO_PI_BITS_LO = 0xc4c6628b80dc1cd1;
+
+    // Returns the low 64 bits of floor( 2pi * 2**s ), s <= 125
+    static constexpr uint64_t TwoPiBits(int s)
+    {
+        int const r = 125 - s;
+        if (r == 0)
+            return TWO_PI_BITS_LO;
+        else if (r >= 64)
+            return TWO_PI_BITS_HI >> (r - 64);
+        else
+            return (TWO_PI_BITS_LO >> r) | (TWO_PI_BITS_HI << (64 - r));
+    }
+
+    // Number of additional bits of 2pi used to reduce large angles. It is limited so that the correction cannot
+    // overflow.
+    static int constexpr EXTRA_BITS = 64 - int(sizeof(T) * 8) + N < 32 ? 64 - int(sizeof(T) * 8) + N : 32;
+
+    static constexpr int64_t ONE       = int64_t(1) << W;
+    static constexpr int64_t TWO_PI    = int64_t((TwoPiBits(W + 1) + 1) >> 1);
+    static constexpr int64_t PI        = int64_t((TwoPiBits(W) + 1) >> 1);
+    static constexpr int64_t PI_OVER_2 = int64_t((TwoPiBits(W - 1) + 1) >> 1);
+    static constexpr int64_t TWO_PI_LO = int64_t(TwoPiBits(W + EXTRA_BITS) - (uint64_t(TWO_PI) << EXTRA_BITS));
+    static constexpr int64_t LN2       = ToWorking(0.69314718055994530942);
+    static constexpr int64_t GAIN      = MakeCordicGain();
+
+    // Returns the number of significant bits in x
+    static constexpr int BitLength(uint64_t x)
+    {
+        int n = 0;
+        while (x != 0)
+        {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+    }
+
+    // Returns x / d rounded to the nearest integer (halfway cases away from zero)
+    static constexpr int64_t RoundedQuotient(int64_t x, int64_t d)
+    {
+        return (x < 0 ? x - d / 2 : x + d / 2) / d;
+    }
+
+    // Converts a value of T to working precision (rounding if N > 56)
+    static constexpr int64_t ToWorking(T x)
+    {
+        if constexpr (G >= 0)
+            return int64_t(x) * (int64_t(1) << G);
+        else
+            return (int64_t(x) + (int64_t(1) << (-G - 1))) >> -G;
+    }
+
+    // Converts a working value to T, rounding and saturating
+    static constexpr T FromWorking(int64_t x)
+    {
+        if constexpr (G > 0)
+            x = (x + (int64_t(1) << (G - 1))) >> G;
+        else if constexpr (G < 0)
+            x = x * (int64_t(1) << -G);
+        return Fixed::template Narrow<Fixed::SATURATE>(x);
+    }
+
+    // Reduces an angle to the range [-pi, pi] in working precision
+    static constexpr int64_t ReduceAngle(T x);
+
+    // Rotates [GAIN, 0] by the angle z (|z| <= pi/2) to get cos z and sin z
+    static constexpr void Rotate(int64_t z, int64_t * pSin, int64_t * pCos)
+    {
+        int64_t c = GAIN;
+        int64_t s = 0;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            int64_t const dc = s >> i;
+            int64_t const ds = c >> i;
+            if (z >= 0)
+            {
+                c -= dc;
+                s += ds;
+                z -= ATAN[i];
+            }
+            else
+            {
+                c += dc;
+                s -= ds;
+                z += ATAN[i];
+            }
+        }
+        *pSin = s;
+        *pCos = c;
+    }
+};
+
+//! @param	x	Value. Must not be negative.
+//!
+//! @return		sqrt(x) rounded to the nearest representable value. If x is negative, 0 is returned.
+
+template <typename T, int N>
+constexpr T FixedPointMath<T, N>::Sqrt(T x)
+{
+    // sqrt( x * 2**-N ) * 2**N = sqrt( x * 2**N ), so the result is the integer square root of x * 2**N. The
+    // digit-by-digit method is used.
+
+    assert(x >= 0);
+    if (x <= 0)
+        return 0;
+
+    if constexpr (sizeof(T) < sizeof(int64_t))
+    {
+        uint64_t v    = uint64_t(x) << N;
+        uint64_t root = 0;
+        uint64_t bit  = uint64_t(1) << 62;
+        while (bit > v)
+            bit >>= 2;
+        while (bit != 0)
+        {
+            if (v >= root + bit)
+            {
+                v   -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+            {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        if (v > root)
+            ++root;     // The remainder is more than half way to the next square
+        return root > uint64_t(std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() : T(root);
+    }
+#if defined(__SIZEOF_INT128__)
+    else
+    {
+        using U = unsigned __int128;
+
+        U v    = U(x) << N;
+        U root = 0;
+        U bit  = U(1) << 126;
+        while (bit > v)
+            bit >>= 2;
+        while (bit != 0)
+        {
+            if (v >= root + bit)
+            {
+                v   -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+            {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        if (v > root)
+            ++root;
+        return root > U(std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() : T(root);
+    }
+#else
+    else
+    {
+        // Without a 128-bit type, Newton's method is used. It produces the same (exact) integer square root.
+
+        uint64_t const vhi = N > 0 ? uint64_t(x) >> (64 - N) : 0;
+        uint64_t const vlo = uint64_t(x) << N;
+
+        int const bits = vhi != 0 ? 64 + BitLength(vhi) : BitLength(vlo);
+        uint64_t  root = uint64_t(1) << ((bits + 1) / 2);   // Initial estimate is >= sqrt(v)
+
+        while (true)
+        {
+            uint64_t qhi = vhi;
+            uint64_t qlo = vlo;
+            Fixed::Divide128(&qhi, &qlo, root);
+            uint64_t const next = root / 2 + qlo / 2 + (root & qlo & 1);
+            if (next >= root)
+                break;
+            root = next;
+        }
+
+        // Round to nearest: round up if v - root**2 > root
+
+        uint64_t shi = 0;
+        uint64_t slo = 0;
+        Fixed::Multiply128(root, root, &shi, &slo);
+        uint64_t const rlo = vlo - slo;
+        uint64_t const rhi = vhi - shi - (vlo < slo ? 1 : 0);
+        if (rhi != 0 || rlo > root)
+            ++root;
+        return root > uint64_t(std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() : T(root);
+    }
+#endif
+}
+
+//! The angle is first reduced using a multiple of 2pi rounded down to the precision of @a T. Then the error in that
+//! multiple is removed in working precision, using EXTRA_BITS more bits of 2pi.
+
+template <typename T, int N>
+constexpr int64_t FixedPointMath<T, N>::ReduceAngle(T x)
+{
+    int64_t z = 0;
+
+    if constexpr (G >= 0)
+    {
+        int64_t const hi = TWO_PI >> G;                 // 2pi in Q(N), rounded down
+        int64_t const lo = TWO_PI - (hi << G);          // the remainder in Q(W)
+        int64_t const k  = RoundedQuotient(x, hi);
+
+        z = (int64_t(x) - k * hi) * (int64_t(1) << G) - k * lo;
+
+        if constexpr (EXTRA_BITS > 0)
+            z -= (k * TWO_PI_LO + (int64_t(1) << (EXTRA_BITS - 1))) >> EXTRA_BITS;
+    }
+    else
+    {
+        z = ToWorking(x);
+    }
+
+    return z - RoundedQuotient(z, TWO_PI) * TWO_PI;
+}
+
+//! @param	x		Angle in radians
+//! @param	pSin	Where to store sin x
+//! @param	pCos	Where to store cos x
+
+template <typename T, int N>
+constexpr void FixedPointMath<T, N>::SinCos(T x, T * pSin, T * pCos)
+{
+    // Reduce the angle to [-pi/2, pi/2] where the CORDIC rotation converges. sin( pi - z ) = sin z and
+    // cos( pi - z ) = -cos z.
+
+    int64_t z         = ReduceAngle(x);
+    bool    negateCos = false;
+
+    if (z > PI_OVER_2)
+    {
+        z         = PI - z;
+        negateCos = true;
+    }
+    else if (z < -PI_OVER_2)
+    {
+        z         = -PI - z;
+        negateCos = true;
+    }
+
+    int64_t s = 0;
+    int64_t c = 0;
+    Rotate(z, &s, &c);
+
+    *pSin = FromWorking(s);
+    *pCos = FromWorking(negateCos ? -c : c);
+}
+
+//! @param	x	Angle in radians
+//!
+//! @return		tan x, saturated near odd multiples of pi/2
+
+template <typename T, int N>
+constexpr T FixedPointMath<T, N>::Tan(T x)
+{
+    int64_t z = ReduceAngle(x);
+    if (z > PI_OVER_2)
+        z -= PI;
+    else if (z < -PI_OVER_2)
+        z += PI;
+
+    int64_t s = 0;
+    int64_t c = 0;
+    Rotate(z, &s, &c);
+
+    using Working = FixedPoint<int64_t, W>;
+    Working const t = Working::template Divide<Working::ROUND_TO_NEAREST, Working::SATURATE>(Working::FromRaw(s),
+                                                                                            Working::FromRaw(c));
+    return FromWorking(t.Raw());
+}
+
+//! @param	y	Y component of the vector
+//! @param	x	X component of the vector
+//!
+//! @return		The angle in radians between the X axis and the vector, or 0 if the vector is 0
+
+template <typename T, int N>
+constexpr T FixedPointMath<T, N>::Atan2(T y, T x)
+{
+    if (x == 0 && y == 0)
+        return 0;
+
+    // Scale the vector so that the larger component has 60 significant bits. This maximizes the precision and
+    // leaves room for the CORDIC gain.
+
+    int64_t vx = x;
+    int64_t vy = y;
+
+    uint64_t const ax = x < 0 ? ~uint64_t(vx) + 1 : uint64_t(vx);
+    uint64_t const ay = y < 0 ? ~uint64_t(vy) + 1 : uint64_t(vy);
+    int const      b  = BitLength(ax | ay);
+
+    if (b > 60)
+    {
+        vx >>= b - 60;
+        vy >>= b - 60;
+    }
+    else
+    {
+        vx *= int64_t(1) << (60 - b);
+        vy *= int64_t(1) << (60 - b);
+    }
+
+    // Rotate the vector into the right half-plane where the CORDIC vectoring converges.
+
+    int64_t z = 0;
+    if (vx < 0)
+    {
+        z  = y >= 0 ? PI : -PI;
+        vx = -vx;
+        vy = -vy;
+    }
+
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        int64_t const dx = vy >> i;
+        int64_t const dy = vx >> i;
+        if (vy < 0)
+        {
+            vx -= dx;
+            vy += dy;
+            z  -= ATAN[i];
+        }
+        else
+        {
+            vx += dx;
+            vy -= dy;
+            z  += ATAN[i];
+        }
+    }
+
+    return FromWorking(z);
+}
+
+//! @param	x	Exponent
+//!
+//! @return		e**x, saturated if it is too large to be represented
+
+template <typename T, int N>
+constexpr T FixedPointMath<T, N>::Exp(T x)
+{
+    // Limits beyond which the result saturates or underflows to 0. The values are approximate, and the final shift
+    // handles the values near them.
+
+    int constexpr BITS      = int(sizeof(T) * 8);
+    double constexpr SCALE  = double(uint64_t(1) << N);
+    T constexpr      X_MAX  = T(0.69314718055994530942 * (BITS - N) * SCALE < double(std::numeric_limits<T>::max())
+                                ? 0.69314718055994530942 * (BITS - N) * SCALE
+                                : double(std::numeric_limits<T>::max()));
+    T constexpr      X_MIN  = T(-0.69314718055994530942 * (N + 2) * SCALE > double(std::numeric_limits<T>::min())
+                                ? -0.69314718055994530942 * (N + 2) * SCALE
+                                : double(std::numeric_limits<T>::min()));
+
+    if (x > X_MAX)
+        return std::numeric_limits<T>::max();
+    if (x < X_MIN)
+        return 0;
+
+    int64_t const xw = ToWorking(x);
+
+    // e**x = 2**k * e**r, where r = x - k ln 2, 0 <= r < ln 2
+
+    int64_t k = xw / LN2;
+    if (xw - k * LN2 < 0)
+        --k;
+    int64_t r = xw - k * LN2;
+
+    // e**r = product of ( 1 + 2**-i ) for each i where ln( 1 + 2**-i ) is subtracted from r
+
+    int64_t y = ONE;
+    for (int i = 1; i < ITERATIONS; ++i)
+    {
+        if (r >= LOG[i])
+        {
+            r -= LOG[i];
+            y += y >> i;
+        }
+    }
+    y += r;     // e**r ~ 1 + r for the remainder
+
+    // Scale by 2**k and convert to Q(N)
+
+    int const shift = int(k) - G;
+    if (shift >= 0)
+    {
+        if (shift >= 62 || y > (int64_t(std::numeric_limits<T>::max()) >> shift))
+            return std::numeric_limits<T>::max();
+        return T(y << shift);
+    }
+    else
+    {
+        if (-shift >= 63)
+            return 0;
+        return Fixed::template Narrow<Fixed::SATURATE>((y + (int64_t(1) << (-shift - 1))) >> -shift);
+    }
+}
+
+//! @param	x	Value. Must be greater than 0.
+//!
+//! @return		ln x. If @a x is not greater than 0, the minimum value is returned.
+
+template <typename T, int N>
+constexpr T FixedPointMath<T, N>::Log(T x)
+{
+    assert(x > 0);
+    if (x <= 0)
+        return std::numeric_limits<T>::min();
+
+    // x = m * 2**e, where 1 <= m < 2. ln x = e ln 2 + ln m
+
+    int const b = BitLength(uint64_t(x));
+    int const e = b - 1 - N;
+
+    int64_t const m = (b - 1 > W) ? int64_t(x) >> (b - 1 - W) : int64_t(x) * (int64_t(1) << (W - (b - 1)));
+
+    // ln m = sum of ln( 1 + 2**-i ) for each factor ( 1 + 2**-i ) that can be multiplied into p without exceeding m
+
+    int64_t p = ONE;
+    int64_t z = 0;
+    for (int i = 1; i < ITERATIONS; ++i)
+    {
+        int64_t const t = p + (p >> i);
+        if (t <= m)
+        {
+            p  = t;
+            z += LOG[i];
+        }
+    }
+    z += ((m - p) * ONE) / p;   // ln( m / p ) ~ m / p - 1 for the remainder
+
+    return FromWorking(z + e * LN2);
+}
+
 //! Returns the square root of a fixed-point value.
 //
-//! @param	x	Fixed-point operand
+//! @param	x	Fixed-point operand. Must not be negative.
 //! @return		sqrt( x )
 
 template <typename T, int N>
-FixedPoint<T, N> sqrt(FixedPoint<T, N> const & x)
+constexpr FixedPoint<T, N> sqrt(FixedPoint<T, N> const & x)
 {
-    return FixedPoint<T, N>(sqrt(double(x)));             //! @todo implement sqrt
+    return FixedPoint<T, N>::FromRaw(FixedPointMath<T, N>::Sqrt(x.Raw()));
 }
 
 //! Returns the sine of a fixed-point value.
@@ -219,9 +1167,12 @@ FixedPoint<T, N> sqrt(FixedPoint<T, N> const & x)
 //! @return		sin x
 
 template <typename T, int N>
-FixedPoint<T, N> sin(FixedPoint<T, N> const & x)
+constexpr FixedPoint<T, N> sin(FixedPoint<T, N> const & x)
 {
-    return FixedPoint<T, N>(sin(double(x)));             //! @todo implement sin
+    T s = 0;
+    T c = 0;
+    FixedPointMath<T, N>::SinCos(x.Raw(), &s, &c);
+    return FixedPoint<T, N>::FromRaw(s);
 }
 
 //! Returns the cosine of a fixed-point value.
@@ -230,9 +1181,12 @@ FixedPoint<T, N> sin(FixedPoint<T, N> const & x)
 //! @return		cos x
 
 template <typename T, int N>
-FixedPoint<T, N> cos(FixedPoint<T, N> const & x)
+constexpr FixedPoint<T, N> cos(FixedPoint<T, N> const & x)
 {
-    return FixedPoint<T, N>(cos(double(x)));             //! @todo implement cos
+    T s = 0;
+    T c = 0;
+    FixedPointMath<T, N>::SinCos(x.Raw(), &s, &c);
+    return FixedPoint<T, N>::FromRaw(c);
 }
 
 //! Returns the tangent of a fixed-point value.
@@ -241,9 +1195,43 @@ FixedPoint<T, N> cos(FixedPoint<T, N> const & x)
 //! @return		tan( x )
 
 template <typename T, int N>
-FixedPoint<T, N> tan(FixedPoint<T, N> const & x)
+constexpr FixedPoint<T, N> tan(FixedPoint<T, N> const & x)
+{
+    return FixedPoint<T, N>::FromRaw(FixedPointMath<T, N>::Tan(x.Raw()));
+}
+
+//! Returns the arc tangent of y/x using the signs of the values to determine the quadrant.
+//
+//! @param	y	Fixed-point operand
+//! @param	x	Fixed-point operand
+//! @return		atan2( y, x ) in the range [-pi, pi]
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> atan2(FixedPoint<T, N> const & y, FixedPoint<T, N> const & x)
+{
+    return FixedPoint<T, N>::FromRaw(FixedPointMath<T, N>::Atan2(y.Raw(), x.Raw()));
+}
+
+//! Returns e raised to the power of a fixed-point value.
+//
+//! @param	x	Fixed-point operand
+//! @return		e**x
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> exp(FixedPoint<T, N> const & x)
+{
+    return FixedPoint<T, N>::FromRaw(FixedPointMath<T, N>::Exp(x.Raw()));
+}
+
+//! Returns the natural logarithm of a fixed-point value.
+//
+//! @param	x	Fixed-point operand. Must be greater than 0.
+//! @return		ln x
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> log(FixedPoint<T, N> const & x)
 {
-    return FixedPoint<T, N>(tan(double(x)));             //! @todo implement tan
+    return FixedPoint<T, N>::FromRaw(FixedPointMath<T, N>::Log(x.Raw()));
 }
 
 #endif // !defined(MYMATH_FIXEDPOINT_H)
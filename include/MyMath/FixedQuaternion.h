@@ -0,0 +1,538 @@
+#pragma once
+
+#if !defined(MYMATH_FIXEDQUATERNION_H)
+#define MYMATH_FIXEDQUATERNION_H
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+
+template <typename T, int N>
+class FixedMatrix33;
+template <typename T, int N>
+class FixedVector3;
+
+//! @addtogroup	Quaternions
+//!
+//@{
+
+#pragma warning( push )
+#pragma warning( disable : 4201 )   // nonstandard extension used : nameless struct/union
+
+//! A quaternion of fixed-point values.
+//!
+//! @param	T	Underlying integer type of the elements
+//! @param	N	Number of bits in the fraction part of the elements
+//!
+//! The interface mirrors Quaternion. N must be large enough to represent unit quaternions with the required
+//! precision.
+
+template <typename T, int N>
+class FixedQuaternion
+{
+public:
+
+    //! Type of the elements
+    using Element = FixedPoint<T, N>;
+
+    //! Constructor.
+    FixedQuaternion() = default;
+
+    //! Constructor.
+    constexpr FixedQuaternion(Element x, Element y, Element z, Element w);
+
+    //! Constructor.
+    constexpr FixedQuaternion(Element const q[4]);
+
+    //! Constructor.
+    constexpr FixedQuaternion(FixedVector3<T, N> const & axis, Element angle);
+
+    //! Constructor.
+    constexpr FixedQuaternion(Element yaw, Element pitch, Element roll);
+
+    //! Conversion
+    constexpr explicit FixedQuaternion(FixedMatrix33<T, N> const & m33);
+
+    //! Returns an equivalent rotation matrix.
+    constexpr FixedMatrix33<T, N> GetRotationMatrix33() const;
+
+    //! Returns an equivalent rotation axis and angle.
+    constexpr void GetRotationAxisAndAngle(FixedVector3<T, N> * pAxis, Element * pAngle) const;
+
+    //! Returns the length of the quaternion squared.
+    constexpr Element Length2() const;
+
+    //! Returns the length of the quaternion.
+    constexpr Element Length() const;
+
+    //! Returns true if the quaternion is normalized (within a tolerance).
+    bool IsNormalized() const;
+
+    //! Returns the result of raising the quaternion to a power.
+    constexpr FixedQuaternion Pow(Element t) const;
+
+    //! Normalizes the quaternion. Returns the result.
+    constexpr FixedQuaternion const & Normalize();
+
+    //! Replaces the quaternion with its conjugate. Returns the result.
+    constexpr FixedQuaternion const & Conjugate();
+
+    //! Adds a quaternion. Returns the result.
+    constexpr FixedQuaternion const & Add(FixedQuaternion const & b);
+
+    //! Subtracts a quaternion. Returns the result.
+    constexpr FixedQuaternion const & Subtract(FixedQuaternion const & b);
+
+    //! Scales the quaternion. Returns the result.
+    constexpr FixedQuaternion const & Scale(Element scale);
+
+    //! Multiplies the quaternion. Returns the result.
+    constexpr FixedQuaternion const & Multiply(FixedQuaternion const & b);
+
+    //! Adds a quaternion. Returns the result.
+    constexpr FixedQuaternion const & operator +=(FixedQuaternion const & b);
+
+    //! Subtracts a quaternion. Returns the result.
+    constexpr FixedQuaternion const & operator -=(FixedQuaternion const & b);
+
+    //! Scales the quaternion. Returns the result.
+    constexpr FixedQuaternion const & operator *=(Element scale);
+
+    //! Multiplies the quaternion by another. Returns the result.
+    constexpr FixedQuaternion const & operator *=(FixedQuaternion const & b);
+
+    //! Returns the conjugate.
+    constexpr FixedQuaternion operator -() const;
+
+    union
+    {
+        Element m_Q[4];     //!< Elements as an array {x, y, z, w}
+        struct
+        {
+            Element /** */ m_X, m_Y, m_Z, m_W;
+        };
+    };
+
+    //! Returns the multiplicative identity [0, 0, 0, 1].
+    static constexpr FixedQuaternion Identity();
+};
+
+#pragma warning( pop )
+
+//@}
+
+// Inline functions
+
+#include "FixedMatrix33.h"
+#include "FixedVector3.h"
+#include "MyMath.h"
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N>::FixedQuaternion(Element x, Element y, Element z, Element w)
+    : m_X(x)
+    , m_Y(y)
+    , m_Z(z)
+    , m_W(w)
+{
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N>::FixedQuaternion(Element const q[4])
+    : m_X(q[0])
+    , m_Y(q[1])
+    , m_Z(q[2])
+    , m_W(q[3])
+{
+}
+
+//! @param	axis	Axis of rotation
+//! @param	angle	Angle of rotation
+//!
+//! @note	Do not confuse this with q( s, v ) notation.
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N>::FixedQuaternion(FixedVector3<T, N> const & axis, Element angle)
+    : m_X(0)
+    , m_Y(0)
+    , m_Z(0)
+    , m_W(0)
+{
+    Element const half = Element::FromRaw(T(angle.Raw() / 2));
+    Element const s    = sin(half);
+    Element const c    = cos(half);
+
+    m_X = axis.m_X * s;
+    m_Y = axis.m_Y * s;
+    m_Z = axis.m_Z * s;
+    m_W = c;
+}
+
+//! @param	yaw		Rotation angle (in radians) around the Y axis
+//! @param	pitch	Rotation angle (in radians) around the X axis
+//! @param	roll	Rotation angle (in radians) around the Z axis
+//!
+//! @note	The angles are applied in this order: @a yaw, @a pitch, then @a roll.
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N>::FixedQuaternion(Element yaw, Element pitch, Element roll)
+    : m_X(0)
+    , m_Y(0)
+    , m_Z(0)
+    , m_W(0)
+{
+    Element const sr   = sin(Element::FromRaw(T(roll.Raw() / 2)));
+    Element const cr   = cos(Element::FromRaw(T(roll.Raw() / 2)));
+    Element const sp   = sin(Element::FromRaw(T(pitch.Raw() / 2)));
+    Element const cp   = cos(Element::FromRaw(T(pitch.Raw() / 2)));
+    Element const sy   = sin(Element::FromRaw(T(yaw.Raw() / 2)));
+    Element const cy   = cos(Element::FromRaw(T(yaw.Raw() / 2)));
+    Element const crsp = cr * sp;
+    Element const srsp = sr * sp;
+    Element const srcp = sr * cp;
+    Element const crcp = cr * cp;
+
+    m_X = crsp * cy - srcp * sy;
+    m_Y = srsp * cy + crcp * sy;
+    m_Z = srcp * cy + crsp * sy;
+    m_W = crcp * cy - srsp * sy;
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N>::FixedQuaternion(FixedMatrix33<T, N> const & m)
+    : m_X(0)
+    , m_Y(0)
+    , m_Z(0)
+    , m_W(0)
+{
+    Element const one   = Element(1);
+    Element const trace = m.m_Xx + m.m_Yy + m.m_Zz;
+
+    if (trace.Raw() > 0)
+    {
+        Element const sq = sqrt(trace + one);
+        Element const s  = Element(0.5) / sq;
+
+        m_X = (m.m_Yz - m.m_Zy) * s;
+        m_Y = (m.m_Zx - m.m_Xz) * s;
+        m_Z = (m.m_Xy - m.m_Yx) * s;
+        m_W = Element(0.5) * sq;
+    }
+    else
+    {
+        if (m.m_Xx.Raw() >= m.m_Yy.Raw() && m.m_Xx.Raw() >= m.m_Zz.Raw())
+        {
+            Element const sq = sqrt(m.m_Xx - m.m_Yy - m.m_Zz + one);
+            Element const s  = Element(0.5) / sq;
+
+            m_X = Element(0.5) * sq;
+            m_Y = (m.m_Xy + m.m_Yx) * s;
+            m_Z = (m.m_Zx + m.m_Xz) * s;
+            m_W = (m.m_Yz - m.m_Zy) * s;
+        }
+        else if (m.m_Yy.Raw() >= m.m_Xx.Raw() && m.m_Yy.Raw() >= m.m_Zz.Raw())
+        {
+            Element const sq = sqrt(-m.m_Xx + m.m_Yy - m.m_Zz + one);
+            Element const s  = Element(0.5) / sq;
+
+            m_X = (m.m_Xy + m.m_Yx) * s;
+            m_Y = Element(0.5) * sq;
+            m_Z = (m.m_Yz + m.m_Zy) * s;
+            m_W = (m.m_Zx - m.m_Xz) * s;
+        }
+        else // if ( m.m_Zz >= m.m_Xx && m.m_Zz >= m.m_Yy )
+        {
+            Element const sq = sqrt(-m.m_Xx - m.m_Yy + m.m_Zz + one);
+            Element const s  = Element(0.5) / sq;
+
+            m_X = (m.m_Zx + m.m_Xz) * s;
+            m_Y = (m.m_Yz + m.m_Zy) * s;
+            m_Z = Element(0.5) * sq;
+            m_W = (m.m_Xy - m.m_Yx) * s;
+        }
+    }
+}
+
+template <typename T, int N>
+constexpr FixedMatrix33<T, N> FixedQuaternion<T, N>::GetRotationMatrix33() const
+{
+    Element const one = Element(1);
+    Element const two = Element(2);
+
+    Element const xx = m_X * m_X;
+    Element const xy = m_X * m_Y;
+    Element const xz = m_X * m_Z;
+    Element const xw = m_X * m_W;
+
+    Element const yy = m_Y * m_Y;
+    Element const yz = m_Y * m_Z;
+    Element const yw = m_Y * m_W;
+
+    Element const zz = m_Z * m_Z;
+    Element const zw = m_Z * m_W;
+
+    return FixedMatrix33<T, N>(one - two * (yy + zz),       two * (xy + zw),       two * (xz - yw),
+                                     two * (xy - zw), one - two * (xx + zz),       two * (yz + xw),
+                                     two * (xz + yw),       two * (yz - xw), one - two * (xx + yy));
+}
+
+//! @param	pAxis	Where to store the axis of rotation
+//! @param	pAngle	Where to store the angle of rotation
+
+template <typename T, int N>
+constexpr void FixedQuaternion<T, N>::GetRotationAxisAndAngle(FixedVector3<T, N> * pAxis, Element * pAngle) const
+{
+    Element const s = sqrt(m_X * m_X + m_Y * m_Y + m_Z * m_Z);     // = sin( acos( m_W ) )
+
+    if (s.Raw() != 0)
+    {
+        pAxis->m_X = m_X / s;
+        pAxis->m_Y = m_Y / s;
+        pAxis->m_Z = m_Z / s;
+    }
+    else
+    {
+        *pAxis = FixedVector3<T, N>::ZAxis();
+    }
+
+    *pAngle = Element(2) * atan2(s, m_W);
+}
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> FixedQuaternion<T, N>::Length2() const
+{
+    return m_X * m_X + m_Y * m_Y + m_Z * m_Z + m_W * m_W;
+}
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> FixedQuaternion<T, N>::Length() const
+{
+    return sqrt(Length2());
+}
+
+template <typename T, int N>
+bool FixedQuaternion<T, N>::IsNormalized() const
+{
+    return MyMath::IsCloseTo(double(Length2()), 1.0, 2.0 * MyMath::DEFAULT_FLOAT_NORMALIZED_TOLERANCE);
+}
+
+//! The operation is (*this) ** t.
+//!
+//! @warning	This function only works for unit quaternions.
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> FixedQuaternion<T, N>::Pow(Element t) const
+{
+    // See Quaternion::Pow(). The angle is computed with atan2 so that w does not need to be limited.
+
+    Element const sa = sqrt(m_X * m_X + m_Y * m_Y + m_Z * m_Z);    // = sin( a )
+
+    if (sa.Raw() != 0)
+    {
+        Element const at    = atan2(sa, m_W) * t;
+        Element const satsa = sin(at) / sa;
+
+        return FixedQuaternion(m_X * satsa, m_Y * satsa, m_Z * satsa, cos(at));
+    }
+    else
+    {
+        return *this;
+    }
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::Normalize()
+{
+    Element const len = Length();
+
+    assert(len.Raw() != 0);
+
+    if (len.Raw() != 0)
+    {
+        m_X /= len;
+        m_Y /= len;
+        m_Z /= len;
+        m_W /= len;
+    }
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::Conjugate()
+{
+    m_X = -m_X;
+    m_Y = -m_Y;
+    m_Z = -m_Z;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::Add(FixedQuaternion const & b)
+{
+    m_X += b.m_X;
+    m_Y += b.m_Y;
+    m_Z += b.m_Z;
+    m_W += b.m_W;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::Subtract(FixedQuaternion const & b)
+{
+    m_X -= b.m_X;
+    m_Y -= b.m_Y;
+    m_Z -= b.m_Z;
+    m_W -= b.m_W;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::Scale(Element scale)
+{
+    m_X *= scale;
+    m_Y *= scale;
+    m_Z *= scale;
+    m_W *= scale;
+
+    return *this;
+}
+
+//!
+//! The operation is *this = *this * b
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::Multiply(FixedQuaternion const & b)
+{
+    FixedQuaternion c = *this;
+
+    c.m_X = m_W * b.m_X + m_X * b.m_W + m_Y * b.m_Z - m_Z * b.m_Y;
+    c.m_Y = m_W * b.m_Y - m_X * b.m_Z + m_Y * b.m_W + m_Z * b.m_X;
+    c.m_Z = m_W * b.m_Z + m_X * b.m_Y - m_Y * b.m_X + m_Z * b.m_W;
+    c.m_W = m_W * b.m_W - m_X * b.m_X - m_Y * b.m_Y - m_Z * b.m_Z;
+
+    *this = c;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::operator +=(FixedQuaternion const & b)
+{
+    return Add(b);
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::operator -=(FixedQuaternion const & b)
+{
+    return Subtract(b);
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::operator *=(Element scale)
+{
+    return Scale(scale);
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> const & FixedQuaternion<T, N>::operator *=(FixedQuaternion const & b)
+{
+    return Multiply(b);
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> FixedQuaternion<T, N>::operator -() const
+{
+    return FixedQuaternion(*this).Conjugate();
+}
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> FixedQuaternion<T, N>::Identity()
+{
+    return FixedQuaternion(Element(0), Element(0), Element(0), Element(1));
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::Rotate(FixedQuaternion<T, N> const & q)
+{
+    return Transform(q.GetRotationMatrix33());
+}
+
+//! Returns the sum of @a a and @a b.
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> operator +(FixedQuaternion<T, N> a, FixedQuaternion<T, N> const & b)
+{
+    return a.Add(b);
+}
+
+//! Returns the difference between @a a and @a b.
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> operator -(FixedQuaternion<T, N> a, FixedQuaternion<T, N> const & b)
+{
+    return a.Subtract(b);
+}
+
+//!
+//! @warning	The operation is not commutative.
+
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> operator *(FixedQuaternion<T, N> a, FixedQuaternion<T, N> const & b)
+{
+    return a.Multiply(b);
+}
+
+//! Returns the result of scaling @a q by @a s.
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> operator *(FixedQuaternion<T, N> q, FixedPoint<T, N> s)
+{
+    return q.Scale(s);
+}
+
+//! Returns the result of scaling @a q by @a s.
+template <typename T, int N>
+constexpr FixedQuaternion<T, N> operator *(FixedPoint<T, N> s, FixedQuaternion<T, N> q)
+{
+    return q.Scale(s);
+}
+
+namespace MyMath
+{
+//! Rotates an array of vectors.
+//!
+//! @param	v		Vectors to rotate
+//! @param	q		Rotation
+//! @param	pR		Where to store the rotated vectors. May be the same as @a v.
+//! @param	count	Number of vectors
+//!
+//! @ingroup Quaternions
+//!
+//! The results are identical to FixedVector3::Rotate().
+
+template <typename T, int N>
+void Rotate(FixedVector3<T, N> const * v, FixedQuaternion<T, N> const & q, FixedVector3<T, N> * pR, size_t count)
+{
+    Transform(v, q.GetRotationMatrix33(), pR, count);
+}
+
+//! Computes the products of pairs of quaternions.
+//!
+//! @param	a		Operands
+//! @param	b		Operands
+//! @param	pR		Where to store the products a[i] * b[i]. May be the same as @a a or @a b.
+//! @param	count	Number of quaternions
+//!
+//! @ingroup Quaternions
+
+template <typename T, int N>
+void Multiply(FixedQuaternion<T, N> const * a, FixedQuaternion<T, N> const * b, FixedQuaternion<T, N> * pR, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pR[i] = a[i] * b[i];
+    }
+}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_FIXEDQUATERNION_H)
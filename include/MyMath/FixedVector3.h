@@ -0,0 +1,346 @@
+#pragma once
+
+#if !defined(MYMATH_FIXEDVECTOR3_H)
+#define MYMATH_FIXEDVECTOR3_H
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+
+template <typename T, int N>
+class FixedMatrix33;
+template <typename T, int N>
+class FixedQuaternion;
+
+#pragma warning( push )
+#pragma warning( disable : 4201 )   // nonstandard extension used : nameless struct/union
+
+//! A 3D vector of fixed-point values.
+//!
+//! @ingroup Vectors
+//!
+//! @param	T	Underlying integer type of the elements
+//! @param	N	Number of bits in the fraction part of the elements
+//!
+//! The interface mirrors Vector3. All operations are done in integer arithmetic, so the results are identical on all
+//! platforms.
+
+template <typename T, int N>
+class FixedVector3
+{
+public:
+
+    //! Type of the elements
+    using Element = FixedPoint<T, N>;
+
+    //! Constructor.
+    FixedVector3() = default;
+
+    //! Constructor.
+    constexpr FixedVector3(Element x, Element y, Element z);
+
+    //! Constructor.
+    constexpr FixedVector3(Element const v[3]);
+
+    //! Returns the length of the vector squared.
+    constexpr Element Length2() const;
+
+    //! Returns the length of the vector.
+    constexpr Element Length() const;
+
+    //! Returns true if the vector is normalized (within a tolerance).
+    bool IsNormalized() const;
+
+    //! Negates the vector. Returns the result.
+    constexpr FixedVector3 const & Negate();
+
+    //! Normalizes the vector. Returns the result.
+    constexpr FixedVector3 const & Normalize();
+
+    //! Adds a vector. Returns the result.
+    constexpr FixedVector3 const & Add(FixedVector3 const & b);
+
+    //! Subtracts a vector. Returns the result.
+    constexpr FixedVector3 const & Subtract(FixedVector3 const & b);
+
+    //! Multiplies the vector by a scalar. Returns the result.
+    constexpr FixedVector3 const & Scale(Element scale);
+
+    //! Transforms the vector (vM). Returns the result.
+    constexpr FixedVector3 const & Transform(FixedMatrix33<T, N> const & m);
+
+    //! Rotates the vector.
+    constexpr FixedVector3 const & Rotate(FixedQuaternion<T, N> const & q);
+
+    //! Adds a vector. Returns the result.
+    constexpr FixedVector3 const & operator +=(FixedVector3 const & b);
+
+    //! Subtracts a vector. Returns the result.
+    constexpr FixedVector3 const & operator -=(FixedVector3 const & b);
+
+    //! Scales the vector. Returns the result.
+    constexpr FixedVector3 const & operator *=(Element scale);
+
+    //! Transforms the vector (vM). Returns the result.
+    constexpr FixedVector3 const & operator *=(FixedMatrix33<T, N> const & m);
+
+    //! Returns the negative.
+    constexpr FixedVector3 operator -() const;
+
+    union
+    {
+        Element m_V[3];     //!< Elements as an array {x, y, z}
+        struct
+        {
+            Element /** */ m_X, m_Y, m_Z;
+        };
+    };
+
+    // Useful constants
+
+    //! Returns [0, 0, 0].
+    static constexpr FixedVector3 Origin() { return FixedVector3(Element(0), Element(0), Element(0)); }
+
+    //! Returns [1, 0, 0].
+    static constexpr FixedVector3 XAxis() { return FixedVector3(Element(1), Element(0), Element(0)); }
+
+    //! Returns [0, 1, 0].
+    static constexpr FixedVector3 YAxis() { return FixedVector3(Element(0), Element(1), Element(0)); }
+
+    //! Returns [0, 0, 1].
+    static constexpr FixedVector3 ZAxis() { return FixedVector3(Element(0), Element(0), Element(1)); }
+};
+
+#pragma warning( pop )
+
+// Inline functions
+
+#include "MyMath.h"
+
+template <typename T, int N>
+constexpr FixedVector3<T, N>::FixedVector3(Element x, Element y, Element z)
+    : m_X(x)
+    , m_Y(y)
+    , m_Z(z)
+{
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N>::FixedVector3(Element const v[3])
+    : m_X(v[0])
+    , m_Y(v[1])
+    , m_Z(v[2])
+{
+}
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> FixedVector3<T, N>::Length2() const
+{
+    return m_X * m_X + m_Y * m_Y + m_Z * m_Z;
+}
+
+template <typename T, int N>
+constexpr FixedPoint<T, N> FixedVector3<T, N>::Length() const
+{
+    return sqrt(Length2());
+}
+
+template <typename T, int N>
+bool FixedVector3<T, N>::IsNormalized() const
+{
+    return MyMath::IsCloseTo(double(Length2()), 1.0, 2.0 * MyMath::DEFAULT_FLOAT_NORMALIZED_TOLERANCE);
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::Negate()
+{
+    m_X = -m_X;
+    m_Y = -m_Y;
+    m_Z = -m_Z;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::Normalize()
+{
+    Element const len = Length();
+
+    assert(len.Raw() != 0);
+
+    if (len.Raw() != 0)
+    {
+        m_X /= len;
+        m_Y /= len;
+        m_Z /= len;
+    }
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::Add(FixedVector3 const & b)
+{
+    m_X += b.m_X;
+    m_Y += b.m_Y;
+    m_Z += b.m_Z;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::Subtract(FixedVector3 const & b)
+{
+    m_X -= b.m_X;
+    m_Y -= b.m_Y;
+    m_Z -= b.m_Z;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::Scale(Element scale)
+{
+    m_X *= scale;
+    m_Y *= scale;
+    m_Z *= scale;
+
+    return *this;
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::operator +=(FixedVector3 const & b)
+{
+    return Add(b);
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::operator -=(FixedVector3 const & b)
+{
+    return Subtract(b);
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::operator *=(Element scale)
+{
+    return Scale(scale);
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> const & FixedVector3<T, N>::operator *=(FixedMatrix33<T, N> const & m)
+{
+    return Transform(m);
+}
+
+template <typename T, int N>
+constexpr FixedVector3<T, N> FixedVector3<T, N>::operator -() const
+{
+    return FixedVector3(*this).Negate();
+}
+
+//! @name FixedVector3 Binary Operators
+//! @ingroup Vectors
+//@{
+
+//! Returns the sum of @a a and @a b.
+template <typename T, int N>
+constexpr FixedVector3<T, N> operator +(FixedVector3<T, N> a, FixedVector3<T, N> const & b)
+{
+    return a.Add(b);
+}
+
+//! Returns the difference between @a a and @a b.
+template <typename T, int N>
+constexpr FixedVector3<T, N> operator -(FixedVector3<T, N> a, FixedVector3<T, N> const & b)
+{
+    return a.Subtract(b);
+}
+
+//! Returns the result of scaling @a v by @a s.
+template <typename T, int N>
+constexpr FixedVector3<T, N> operator *(FixedVector3<T, N> v, FixedPoint<T, N> s)
+{
+    return v.Scale(s);
+}
+
+//! Returns the result of scaling @a v by @a s.
+template <typename T, int N>
+constexpr FixedVector3<T, N> operator *(FixedPoint<T, N> s, FixedVector3<T, N> v)
+{
+    return v.Scale(s);
+}
+
+//! Returns the dot product of @a a and @a b.
+template <typename T, int N>
+constexpr FixedPoint<T, N> Dot(FixedVector3<T, N> const & a, FixedVector3<T, N> const & b)
+{
+    return a.m_X * b.m_X + a.m_Y * b.m_Y + a.m_Z * b.m_Z;
+}
+
+//! Returns the cross product of @a a and @a b.
+template <typename T, int N>
+constexpr FixedVector3<T, N> Cross(FixedVector3<T, N> const & a, FixedVector3<T, N> const & b)
+{
+    return FixedVector3<T, N>(a.m_Y * b.m_Z - a.m_Z * b.m_Y,
+                              a.m_Z * b.m_X - a.m_X * b.m_Z,
+                              a.m_X * b.m_Y - a.m_Y * b.m_X);
+}
+
+//@}
+
+namespace MyMath
+{
+//! @name FixedVector3 Batch Operations
+//! @ingroup Vectors
+//@{
+
+//! Computes a[i] + v[i] * s for arrays of vectors.
+//!
+//! @param	a		Addends
+//! @param	v		Vectors to be scaled
+//! @param	s		Scale
+//! @param	pR		Where to store the results. May be the same as @a a or @a v.
+//! @param	count	Number of vectors
+//!
+//! @note	The results are identical to computing a[i] + v[i] * s individually.
+
+template <typename T, int N>
+void MultiplyAdd(FixedVector3<T, N> const * a,
+                 FixedVector3<T, N> const * v,
+                 FixedPoint<T, N>           s,
+                 FixedVector3<T, N> *       pR,
+                 size_t                     count)
+{
+    static_assert(sizeof(FixedVector3<T, N>) == 3 * sizeof(FixedPoint<T, N>), "FixedVector3 must be packed");
+
+    using Element = FixedPoint<T, N>;
+    Element::MultiplyAdd(reinterpret_cast<Element const *>(a),
+                         reinterpret_cast<Element const *>(v),
+                         s,
+                         reinterpret_cast<Element *>(pR),
+                         count * 3);
+}
+
+//! Computes the dot products of pairs of vectors.
+//!
+//! @param	a		Operands
+//! @param	b		Operands
+//! @param	pR		Where to store the dot products
+//! @param	count	Number of vectors
+
+template <typename T, int N>
+void Dot(FixedVector3<T, N> const * a, FixedVector3<T, N> const * b, FixedPoint<T, N> * pR, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pR[i] = Dot(a[i], b[i]);
+    }
+}
+
+//@}
+} // namespace MyMath
+
+#include "FixedMatrix33.h"
+#include "FixedQuaternion.h"
+
+#endif // !defined(MYMATH_FIXEDVECTOR3_H)
@@ -5,9 +5,19 @@
 
 #include "Intersectable.h"
 #include "Plane.h"
+#include "Vector3.h"
+
+class AABox;
+class Matrix44;
+class Sphere;
 
 //! A frustum that can detect and compute intersections with other intersectables.
 //!
+//! The normals of the sides point out of the frustum. The frustum caches its corners and, for each side, the
+//! absolute value of the normal and a mask selecting the vertex of an axis-aligned box farthest along the normal.
+//! These are used by the culling tests so that they are not recomputed for each test. If sides_ is changed
+//! directly, Update() must be called.
+//!
 //! @ingroup Geometry
 //!
 
@@ -27,6 +37,23 @@ public:
     };
     static int constexpr NUM_SIDES = BACK_SIDE - LEFT_SIDE + 1;
 
+    //! Bits of a corner index. A corner is on the right, top and back sides if the bits are set, or on the left,
+    //! bottom and front sides if they are not.
+    enum CornerBit
+    {
+        RIGHT_CORNER = 1,
+        TOP_CORNER   = 2,
+        BACK_CORNER  = 4
+    };
+    static int constexpr NUM_CORNERS = 8;
+
+    //! Accuracy of a classification (see MyMath::Classify())
+    enum Accuracy
+    {
+        CONSERVATIVE,   //!< Only the sides are tested, as by Intersects()
+        EXACT           //!< Objects that cross a side are also tested against the edges and corners
+    };
+
     //! Constructor.
     Frustum() = default;
 
@@ -35,6 +62,15 @@ public:
             Plane const & bottom, Plane const & top,
             Plane const & n, Plane const & f);
 
+    //! Returns the frustum of a view-projection matrix.
+    static Frustum FromViewProjection(Matrix44 const & viewProjection);
+
+    //! Returns a perspective frustum in view space.
+    static Frustum Perspective(float fovY, float aspect, float nearZ, float farZ);
+
+    //! Returns an orthographic frustum in view space.
+    static Frustum Orthographic(float width, float height, float nearZ, float farZ);
+
     //! Destructor.
     virtual ~Frustum() override = default;
 
@@ -55,7 +91,50 @@ public:
     virtual Result Intersects(Frustum const & frustum) const override     { return Intersectable::Intersects(*this, frustum);   }
     //@}
 
+    //! Recomputes the cached values. This must be called after sides_ is changed.
+    void Update();
+
+    //! Returns a corner (see CornerBit).
+    Vector3 const & GetCorner(int i) const { return m_Corners[i]; }
+
+    //! Returns the absolute value of the normal of a side.
+    Vector3 const & GetAbsNormal(int side) const { return m_AbsNormals[side]; }
+
+    //! Returns a mask with bit k set if element k of the normal of a side is not negative. Of the vertexes of an
+    //! axis-aligned box, the one farthest along the normal takes element k from the maximum if bit k is set, and
+    //! the one nearest takes it from the minimum.
+    int GetPositiveMask(int side) const { return m_PositiveMasks[side]; }
+
     Plane sides_[NUM_SIDES]; //!< Sides
+
+private:
+
+    Vector3 m_Corners[NUM_CORNERS];     // Corners
+    Vector3 m_AbsNormals[NUM_SIDES];    // Absolute values of the normals of the sides
+    int m_PositiveMasks[NUM_SIDES];     // Signs of the elements of the normals of the sides
 };
 
+namespace MyMath
+{
+//! @name Frustum Classification
+//!
+//! The results are the same as Intersects(object, frustum): ENCLOSED_BY means that the object is inside the
+//! frustum and ENCLOSES means that the frustum is inside the object.
+//@{
+
+//! Classifies spheres against a frustum.
+void Classify(Frustum const & frustum, Sphere const * paSpheres, int nSpheres, Intersectable::Result * paResults,
+              Frustum::Accuracy accuracy);
+
+//! Classifies axis-aligned boxes against a frustum.
+void Classify(Frustum const & frustum, AABox const * paBoxes, int nBoxes, Intersectable::Result * paResults,
+              Frustum::Accuracy accuracy);
+
+//! Classifies oriented boxes against a frustum.
+void Classify(Frustum const & frustum, Box const * paBoxes, int nBoxes, Intersectable::Result * paResults,
+              Frustum::Accuracy accuracy);
+
+//@}
+} // namespace MyMath
+
 #endif // !defined(MYMATH_FRUSTUM_H)
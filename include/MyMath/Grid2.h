@@ -0,0 +1,137 @@
+#pragma once
+
+#if !defined(MYMATH_GRID2_H)
+#define MYMATH_GRID2_H
+
+#include "MyMath.h"
+#include "Vector2.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+//! A 2D grid of values.
+//!
+//! The values are stored in 4x4 tiles so that the 4 values surrounding a point are usually close together in
+//! memory (a tile of floats is one 64-byte cache line). Within a tile, the values are stored in x, y order. The tiles
+//! are stored in x, y order.
+//!
+//! @param	T	Value type
+//!
+//! @ingroup	Miscellaneous
+
+template <typename T>
+class Grid2
+{
+public:
+
+    static int const TILE_SHIFT = 2;                        //!< log2 of the size of a tile
+    static int const TILE_SIZE  = 1 << TILE_SHIFT;          //!< Size of a tile in each dimension
+    static int const TILE_MASK  = TILE_SIZE - 1;            //!< Mask for the position in a tile
+    static int const TILE_COUNT = TILE_SIZE * TILE_SIZE;    //!< Number of values in a tile
+
+    //! Constructor.
+    //! @param	sizeX	Number of values in the X direction
+    //! @param	sizeY	Number of values in the Y direction
+    //! @param	value	Initial value
+    Grid2(int sizeX, int sizeY, T const & value = T())
+        : m_SizeX(sizeX)
+        , m_SizeY(sizeY)
+        , m_TilesX((sizeX + TILE_MASK) >> TILE_SHIFT)
+    {
+        assert(sizeX > 0 && sizeY > 0);
+
+        int const tilesY = (sizeY + TILE_MASK) >> TILE_SHIFT;
+        assert(double(m_TilesX) * tilesY * TILE_COUNT <= INT_MAX);
+
+        m_Data.resize(size_t(m_TilesX) * tilesY * TILE_COUNT, value);
+    }
+
+    //! Returns the number of values in the X direction.
+    int GetSizeX() const { return m_SizeX; }
+
+    //! Returns the number of values in the Y direction.
+    int GetSizeY() const { return m_SizeY; }
+
+    //! Returns the value at (x, y).
+    T const & operator ()(int x, int y) const { return m_Data[Index(x, y)]; }
+
+    //! Returns the value at (x, y).
+    T & operator ()(int x, int y) { return m_Data[Index(x, y)]; }
+
+    //! Returns the index of the value at (x, y) in the data.
+    int Index(int x, int y) const
+    {
+        assert(x >= 0 && x < m_SizeX);
+        assert(y >= 0 && y < m_SizeY);
+
+        int const tile  = (y >> TILE_SHIFT) * m_TilesX + (x >> TILE_SHIFT);
+        int const local = ((y & TILE_MASK) << TILE_SHIFT) | (x & TILE_MASK);
+
+        return tile * TILE_COUNT + local;
+    }
+
+    //! Returns the data (in tile order).
+    T const * GetData() const { return m_Data.data(); }
+
+    //! Returns the number of tiles in the X direction.
+    int GetTilesX() const { return m_TilesX; }
+
+private:
+
+    int m_SizeX;
+    int m_SizeY;
+    int m_TilesX;
+    std::vector<T> m_Data;
+};
+
+namespace MyMath
+{
+//! Returns the value of a grid at a point using bilinear interpolation.
+//!
+//! @param	grid	Grid
+//! @param	p		Point in grid coordinates (the value at (x, y) is at the point (x, y)). Points outside the grid are
+//!					clamped to its edges. NaN coordinates are clamped to 0.
+template <typename T>
+T SampleBilinear(Grid2<T> const & grid, Vector2 const & p)
+{
+    float const x = limitNaNToMin(0.0f, p.m_X, float(grid.GetSizeX() - 1));
+    float const y = limitNaNToMin(0.0f, p.m_Y, float(grid.GetSizeY() - 1));
+
+    int const x0 = int(x);
+    int const y0 = int(y);
+    int const x1 = std::min(x0 + 1, grid.GetSizeX() - 1);
+    int const y1 = std::min(y0 + 1, grid.GetSizeY() - 1);
+
+    float const fx = x - float(x0);
+    float const fy = y - float(y0);
+
+    T const z0 = grid(x0, y0) + (grid(x1, y0) - grid(x0, y0)) * fx;
+    T const z1 = grid(x0, y1) + (grid(x1, y1) - grid(x0, y1)) * fx;
+
+    return z0 + (z1 - z0) * fy;
+}
+
+//! Computes the values of a grid at an array of points using bilinear interpolation.
+//!
+//! @param	grid	Grid
+//! @param	p		Points in grid coordinates (see SampleBilinear(Grid2<T> const &, Vector2 const &))
+//! @param	pR		Where to store the values
+//! @param	count	Number of points
+template <typename T>
+void SampleBilinear(Grid2<T> const & grid, Vector2 const * p, T * pR, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pR[i] = SampleBilinear(grid, p[i]);
+    }
+}
+
+//! Computes the values of a grid of floats at an array of points using bilinear interpolation. This overload is
+//! vectorized when AVX2 is enabled.
+void SampleBilinear(Grid2<float> const & grid, Vector2 const * p, float * pR, size_t count);
+} // namespace MyMath
+
+#endif // !defined(MYMATH_GRID2_H)
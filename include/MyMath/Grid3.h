@@ -0,0 +1,157 @@
+#pragma once
+
+#if !defined(MYMATH_GRID3_H)
+#define MYMATH_GRID3_H
+
+#include "MyMath.h"
+#include "Vector3.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+//! A 3D grid of values.
+//!
+//! The values are stored in 4x4x4 bricks so that the 8 values surrounding a point are usually close together in
+//! memory. Within a brick, the values are stored in x, y, z order. The bricks are stored in x, y, z order.
+//!
+//! @param	T	Value type
+//!
+//! @ingroup	Miscellaneous
+
+template <typename T>
+class Grid3
+{
+public:
+
+    static int const BRICK_SHIFT = 2;                                   //!< log2 of the size of a brick
+    static int const BRICK_SIZE  = 1 << BRICK_SHIFT;                    //!< Size of a brick in each dimension
+    static int const BRICK_MASK  = BRICK_SIZE - 1;                      //!< Mask for the position in a brick
+    static int const BRICK_COUNT = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE; //!< Number of values in a brick
+
+    //! Constructor.
+    //! @param	sizeX	Number of values in the X direction
+    //! @param	sizeY	Number of values in the Y direction
+    //! @param	sizeZ	Number of values in the Z direction
+    //! @param	value	Initial value
+    Grid3(int sizeX, int sizeY, int sizeZ, T const & value = T())
+        : m_SizeX(sizeX)
+        , m_SizeY(sizeY)
+        , m_SizeZ(sizeZ)
+        , m_BricksX((sizeX + BRICK_MASK) >> BRICK_SHIFT)
+        , m_BricksY((sizeY + BRICK_MASK) >> BRICK_SHIFT)
+    {
+        assert(sizeX > 0 && sizeY > 0 && sizeZ > 0);
+
+        int const bricksZ = (sizeZ + BRICK_MASK) >> BRICK_SHIFT;
+        assert(double(m_BricksX) * m_BricksY * bricksZ * BRICK_COUNT <= INT_MAX);
+
+        m_Data.resize(size_t(m_BricksX) * m_BricksY * bricksZ * BRICK_COUNT, value);
+    }
+
+    //! Returns the number of values in the X direction.
+    int GetSizeX() const { return m_SizeX; }
+
+    //! Returns the number of values in the Y direction.
+    int GetSizeY() const { return m_SizeY; }
+
+    //! Returns the number of values in the Z direction.
+    int GetSizeZ() const { return m_SizeZ; }
+
+    //! Returns the value at (x, y, z).
+    T const & operator ()(int x, int y, int z) const { return m_Data[Index(x, y, z)]; }
+
+    //! Returns the value at (x, y, z).
+    T & operator ()(int x, int y, int z) { return m_Data[Index(x, y, z)]; }
+
+    //! Returns the index of the value at (x, y, z) in the data.
+    int Index(int x, int y, int z) const
+    {
+        assert(x >= 0 && x < m_SizeX);
+        assert(y >= 0 && y < m_SizeY);
+        assert(z >= 0 && z < m_SizeZ);
+
+        int const brick = (((z >> BRICK_SHIFT) * m_BricksY + (y >> BRICK_SHIFT)) * m_BricksX + (x >> BRICK_SHIFT));
+        int const local = (((z & BRICK_MASK) << BRICK_SHIFT | (y & BRICK_MASK)) << BRICK_SHIFT) | (x & BRICK_MASK);
+
+        return brick * BRICK_COUNT + local;
+    }
+
+    //! Returns the data (in brick order).
+    T const * GetData() const { return m_Data.data(); }
+
+    //! Returns the number of bricks in the X direction.
+    int GetBricksX() const { return m_BricksX; }
+
+    //! Returns the number of bricks in the Y direction.
+    int GetBricksY() const { return m_BricksY; }
+
+private:
+
+    int m_SizeX;
+    int m_SizeY;
+    int m_SizeZ;
+    int m_BricksX;
+    int m_BricksY;
+    std::vector<T> m_Data;
+};
+
+namespace MyMath
+{
+//! Returns the value of a grid at a point using trilinear interpolation.
+//!
+//! @param	grid	Grid
+//! @param	p		Point in grid coordinates (the value at (x, y, z) is at the point (x, y, z)). Points outside the
+//!					grid are clamped to its edges. NaN coordinates are clamped to 0.
+template <typename T>
+T SampleTrilinear(Grid3<T> const & grid, Vector3 const & p)
+{
+    float const x = limitNaNToMin(0.0f, p.m_X, float(grid.GetSizeX() - 1));
+    float const y = limitNaNToMin(0.0f, p.m_Y, float(grid.GetSizeY() - 1));
+    float const z = limitNaNToMin(0.0f, p.m_Z, float(grid.GetSizeZ() - 1));
+
+    int const x0 = int(x);
+    int const y0 = int(y);
+    int const z0 = int(z);
+    int const x1 = std::min(x0 + 1, grid.GetSizeX() - 1);
+    int const y1 = std::min(y0 + 1, grid.GetSizeY() - 1);
+    int const z1 = std::min(z0 + 1, grid.GetSizeZ() - 1);
+
+    float const fx = x - float(x0);
+    float const fy = y - float(y0);
+    float const fz = z - float(z0);
+
+    T const w00 = grid(x0, y0, z0) + (grid(x1, y0, z0) - grid(x0, y0, z0)) * fx;
+    T const w01 = grid(x0, y1, z0) + (grid(x1, y1, z0) - grid(x0, y1, z0)) * fx;
+    T const w10 = grid(x0, y0, z1) + (grid(x1, y0, z1) - grid(x0, y0, z1)) * fx;
+    T const w11 = grid(x0, y1, z1) + (grid(x1, y1, z1) - grid(x0, y1, z1)) * fx;
+
+    T const w0 = w00 + (w01 - w00) * fy;
+    T const w1 = w10 + (w11 - w10) * fy;
+
+    return w0 + (w1 - w0) * fz;
+}
+
+//! Computes the values of a grid at an array of points using trilinear interpolation.
+//!
+//! @param	grid	Grid
+//! @param	p		Points in grid coordinates (see SampleTrilinear(Grid3<T> const &, Vector3 const &))
+//! @param	pR		Where to store the values
+//! @param	count	Number of points
+template <typename T>
+void SampleTrilinear(Grid3<T> const & grid, Vector3 const * p, T * pR, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pR[i] = SampleTrilinear(grid, p[i]);
+    }
+}
+
+//! Computes the values of a grid of floats at an array of points using trilinear interpolation. This overload is
+//! vectorized when AVX2 is enabled.
+void SampleTrilinear(Grid3<float> const & grid, Vector3 const * p, float * pR, size_t count);
+} // namespace MyMath
+
+#endif // !defined(MYMATH_GRID3_H)
@@ -0,0 +1,123 @@
+#pragma once
+
+#if !defined(MYMATH_INSTRUMENTATION_H)
+#define MYMATH_INSTRUMENTATION_H
+
+//! @file
+//!
+//! Optional counters for finding hot spots.
+//!
+//! If MYMATH_INSTRUMENTATION is defined to a non-zero value, MYMATH_INSTRUMENT_CALL(name) counts the calls of the
+//! enclosing function and records how many cycles each one takes, and MYMATH_INSTRUMENT_EVENT(name) counts an event
+//! such as an early out. Otherwise, the macros expand to nothing.
+//!
+//! Each thread has its own counters, so counting needs no locks or atomic read-modify-writes. The counters of all the
+//! threads are combined by MyMath::Instrumentation::Snapshot::Take().
+
+#if !defined(MYMATH_INSTRUMENTATION)
+#define MYMATH_INSTRUMENTATION 0
+#endif
+
+#if MYMATH_INSTRUMENTATION
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace MyMath
+{
+namespace Instrumentation
+{
+int const MAX_COUNTERS = 512;   //!< Maximum number of distinct counters
+int const NUM_BUCKETS  = 32;    //!< Number of buckets in a cycle histogram (bucket i counts [2^i, 2^(i+1)))
+
+//! Returns the id of a counter, registering it if necessary. @a name must be a string literal.
+int Register(char const * name);
+
+//! Adds 1 to a counter in the calling thread.
+void Count(int id);
+
+//! Adds 1 to a counter in the calling thread and records a duration in its histogram.
+void Count(int id, uint64_t cycles);
+
+//! Returns the current value of the time stamp counter.
+uint64_t ReadCycles();
+
+//! Counts a call and the number of cycles until it is destroyed.
+class ScopedCall
+{
+public:
+
+    //! Constructor.
+    explicit ScopedCall(int id) : m_Id(id), m_Start(ReadCycles()) {}
+
+    //! Destructor.
+    ~ScopedCall() { Count(m_Id, ReadCycles() - m_Start); }
+
+    ScopedCall(ScopedCall const &) = delete;
+    ScopedCall & operator =(ScopedCall const &) = delete;
+
+private:
+
+    int m_Id;
+    uint64_t m_Start;
+};
+
+//! The combined values of the counters at some point.
+class Snapshot
+{
+public:
+
+    //! The value of a counter.
+    struct Entry
+    {
+        std::string m_Name;                     //!< Name of the counter
+        uint64_t m_Count;                       //!< Number of calls or events
+        uint64_t m_Cycles;                      //!< Total number of cycles of the calls (0 for events)
+        uint64_t m_Histogram[NUM_BUCKETS];      //!< Number of calls by log2 of their cycles
+    };
+
+    //! Returns the sum of the counters of all threads, including threads that have ended.
+    static Snapshot Take();
+
+    //! Adds the values of another snapshot (e.g. from another process) to this one. Entries are matched by name.
+    void Merge(Snapshot const & other);
+
+    //! Writes the entries as a JSON array of objects.
+    void WriteJson(std::ostream & out) const;
+
+    //! Writes the entries as CSV with a header row.
+    void WriteCsv(std::ostream & out) const;
+
+    std::vector<Entry> m_Entries;   //!< Counters with a non-zero count, in order of registration
+};
+} // namespace Instrumentation
+} // namespace MyMath
+
+#define MYMATH_INSTRUMENT_CONCATENATE_(a, b) a ## b
+#define MYMATH_INSTRUMENT_CONCATENATE(a, b)  MYMATH_INSTRUMENT_CONCATENATE_(a, b)
+
+//! Counts the calls of the enclosing scope and the cycles they take.
+#define MYMATH_INSTRUMENT_CALL(name)                                                                                \
+    static int const MYMATH_INSTRUMENT_CONCATENATE(instrumentId_, __LINE__) =                                       \
+        MyMath::Instrumentation::Register(name);                                                                    \
+    MyMath::Instrumentation::ScopedCall MYMATH_INSTRUMENT_CONCATENATE(instrumentCall_, __LINE__)(                   \
+        MYMATH_INSTRUMENT_CONCATENATE(instrumentId_, __LINE__))
+
+//! Counts an event.
+#define MYMATH_INSTRUMENT_EVENT(name)                                                                               \
+    do                                                                                                              \
+    {                                                                                                               \
+        static int const instrumentId = MyMath::Instrumentation::Register(name);                                    \
+        MyMath::Instrumentation::Count(instrumentId);                                                               \
+    } while (false)
+
+#else // MYMATH_INSTRUMENTATION
+
+#define MYMATH_INSTRUMENT_CALL(name)    ((void)0)
+#define MYMATH_INSTRUMENT_EVENT(name)   ((void)0)
+
+#endif // MYMATH_INSTRUMENTATION
+
+#endif // !defined(MYMATH_INSTRUMENTATION_H)
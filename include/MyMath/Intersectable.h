@@ -862,6 +862,36 @@ inline float Distance(Segment const & segment, Point const & point) { return Dis
 //! Returns the distance between a point and a plane.
 inline float Distance(Plane const & plane, Point const & point) { return Distance(point, plane); }
 
+//! Returns the distance between two line segments.
+float Distance(Segment const & a, Segment const & b);
+
+//! Returns the distance between a point and an axis-aligned box.
+float Distance(Point const & point, AABox const & aabox);
+
+//! Returns the distance between a point and an oriented box.
+float Distance(Point const & point, Box const & box);
+
+//! Returns the distance between a line segment and an axis-aligned box.
+float Distance(Segment const & segment, AABox const & aabox);
+
+//! Returns the distance between a sphere and an oriented box.
+float Distance(Sphere const & sphere, Box const & box);
+
+//! Returns the distance between two axis-aligned boxes.
+float Distance(AABox const & a, AABox const & b);
+
+//! Returns the distance between a point and an axis-aligned box.
+inline float Distance(AABox const & aabox, Point const & point) { return Distance(point, aabox); }
+
+//! Returns the distance between a point and an oriented box.
+inline float Distance(Box const & box, Point const & point) { return Distance(point, box); }
+
+//! Returns the distance between a line segment and an axis-aligned box.
+inline float Distance(AABox const & aabox, Segment const & segment) { return Distance(segment, aabox); }
+
+//! Returns the distance between a sphere and an oriented box.
+inline float Distance(Box const & box, Sphere const & sphere) { return Distance(sphere, box); }
+
 //@}
 
 #endif // !defined(MYMATH_INTERSECTABLE_H)
@@ -0,0 +1,356 @@
+#pragma once
+
+#if !defined(MYMATH_INTERVALSET_H)
+#define MYMATH_INTERVALSET_H
+
+#include "Range.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace MyMath
+{
+//! @addtogroup	Range
+//@{
+
+//! Returns true if a range whose lower end is @a lower can include @a v.
+template <typename T, bool lower_closed>
+bool IsAboveLower(T const & lower, T const & v)
+{
+    return lower_closed ? !(v < lower) : (lower < v);
+}
+
+//! Returns true if a range whose upper end is @a upper can include @a v.
+template <typename T, bool upper_closed>
+bool IsBelowUpper(T const & upper, T const & v)
+{
+    return upper_closed ? !(upper < v) : (v < upper);
+}
+
+//! Returns the number of lower ends in a sorted array that are below @a v (i.e. the number of ranges that could
+//! include @a v).
+//!
+//! The search is branchless (the loop count depends only on @a n) so that it can be pipelined when it is done for
+//! many values.
+//!
+//! @param	lower	Lower ends of ranges, sorted in increasing order
+//! @param	n		Number of lower ends
+//! @param	v		Value
+template <typename T, bool lower_closed>
+int CountLowerEnds(T const * lower, int n, T const & v)
+{
+    if (n <= 0)
+        return 0;
+
+    T const * base = lower;
+    int       len  = n;
+
+    while (len > 1)
+    {
+        int const half = len / 2;
+        base = IsAboveLower<T, lower_closed>(base[half], v) ? base + half : base;
+        len -= half;
+    }
+
+    return int(base - lower) + (IsAboveLower<T, lower_closed>(*base, v) ? 1 : 0);
+}
+
+//! A set of values represented as a sorted array of disjoint ranges.
+//!
+//! Ranges that overlap or touch are coalesced, so each value is in at most one range and the ranges are sorted by
+//! both of their ends. Lookups take O(log n) time. Adding or removing a range takes O(n) time.
+//!
+//! @param	T				Value type. @a T can be any type that implements operator== and operator<
+//! @param	lower_closed	If true, the lower ends of the ranges are included in the set
+//! @param	upper_closed	If true, the upper ends of the ranges are included in the set
+//!
+//! @note	Difference() and Remove() require half-open ranges (@a lower_closed != @a upper_closed) because otherwise
+//!			the result cannot be represented.
+
+template <typename T, bool lower_closed = true, bool upper_closed = true>
+class IntervalSet
+{
+public:
+
+    //! The type of the ranges in the set
+    using RangeType = Range<T, lower_closed, upper_closed>;
+
+    //! Constructor. The set is empty.
+    IntervalSet() = default;
+
+    //! Constructor.
+    //! @param	ranges	Ranges (in any order, and possibly overlapping)
+    //! @param	n		Number of ranges
+    IntervalSet(RangeType const * ranges, int n);
+
+    //! Returns true if the set is empty.
+    bool IsEmpty() const { return m_Lower.empty(); }
+
+    //! Returns the number of disjoint ranges.
+    int Size() const { return int(m_Lower.size()); }
+
+    //! Returns the range at the given index.
+    RangeType GetRange(int i) const { return RangeType(m_Lower[i], m_Upper[i]); }
+
+    //! Returns the index of the range including a value, or -1 if the set does not include it.
+    int Find(T const & v) const;
+
+    //! Returns true if the set includes a value.
+    bool Contains(T const & v) const { return Find(v) >= 0; }
+
+    //! Determines which values of an array the set includes.
+    void Contains(T const * values, bool * pR, size_t count) const;
+
+    //! Adds a range to the set.
+    void Insert(RangeType const & r);
+
+    //! Removes a range from the set.
+    void Remove(RangeType const & r);
+
+    //! Removes all the ranges.
+    void Clear();
+
+    //! Returns the union of two sets.
+    friend IntervalSet Union(IntervalSet const & a, IntervalSet const & b)
+    {
+        IntervalSet u;
+        u.Reserve(a.Size() + b.Size());
+
+        int i = 0;
+        int j = 0;
+        while (i < a.Size() || j < b.Size())
+        {
+            if (j >= b.Size() || (i < a.Size() && a.m_Lower[i] < b.m_Lower[j]))
+            {
+                u.Append(a.m_Lower[i], a.m_Upper[i]);
+                ++i;
+            }
+            else
+            {
+                u.Append(b.m_Lower[j], b.m_Upper[j]);
+                ++j;
+            }
+        }
+
+        return u;
+    }
+
+    //! Returns the intersection of two sets.
+    friend IntervalSet Intersection(IntervalSet const & a, IntervalSet const & b)
+    {
+        IntervalSet r;
+
+        int i = 0;
+        int j = 0;
+        while (i < a.Size() && j < b.Size())
+        {
+            T const & lower = (a.m_Lower[i] < b.m_Lower[j]) ? b.m_Lower[j] : a.m_Lower[i];
+            T const & upper = (b.m_Upper[j] < a.m_Upper[i]) ? b.m_Upper[j] : a.m_Upper[i];
+
+            if (!IsEmptyRange(lower, upper))
+                r.Append(lower, upper);
+
+            // Advance past the range that ends first
+
+            if (b.m_Upper[j] < a.m_Upper[i])
+                ++j;
+            else
+                ++i;
+        }
+
+        return r;
+    }
+
+    //! Returns the values in @a a that are not in @a b.
+    friend IntervalSet Difference(IntervalSet const & a, IntervalSet const & b)
+    {
+        static_assert(lower_closed != upper_closed, "Difference() requires half-open ranges");
+
+        IntervalSet d;
+
+        int j = 0;
+        for (int i = 0; i < a.Size(); ++i)
+        {
+            T const & upper = a.m_Upper[i];
+            T         cur   = a.m_Lower[i];
+
+            // Skip the ranges in b that end before this range starts. They cannot affect the following ranges in a
+            // either.
+
+            while (j < b.Size() && !(cur < b.m_Upper[j]))
+            {
+                ++j;
+            }
+
+            for (int k = j; k < b.Size() && b.m_Lower[k] < upper; ++k)
+            {
+                if (cur < b.m_Lower[k])
+                    d.Append(cur, b.m_Lower[k]);
+                if (cur < b.m_Upper[k])
+                    cur = b.m_Upper[k];
+                if (!(cur < upper))
+                    break;
+            }
+
+            if (cur < upper)
+                d.Append(cur, upper);
+        }
+
+        return d;
+    }
+
+private:
+
+    // Returns true if a range with the given ends contains no values
+    static bool IsEmptyRange(T const & lower, T const & upper)
+    {
+        return upper < lower || (!(lower < upper) && !(lower_closed && upper_closed));
+    }
+
+    // Reserves space for n ranges
+    void Reserve(int n)
+    {
+        m_Lower.reserve(n);
+        m_Upper.reserve(n);
+    }
+
+    // Appends a range whose lower end is not less than the lower end of the last range, coalescing it with the last
+    // range if they overlap or touch
+    void Append(T const & lower, T const & upper);
+
+    std::vector<T> m_Lower;     // Lower ends of the ranges (sorted)
+    std::vector<T> m_Upper;     // Upper ends of the ranges (sorted)
+};
+
+//@}
+
+template <typename T, bool lower_closed, bool upper_closed>
+IntervalSet<T, lower_closed, upper_closed>::IntervalSet(RangeType const * ranges, int n)
+{
+    // The ranges are appended in order of their lower ends so that they can be coalesced in one pass.
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [ranges](int a, int b) {
+        return ranges[a].Lower() < ranges[b].Lower();
+    });
+
+    Reserve(n);
+    for (int i : order)
+    {
+        if (!IsEmptyRange(ranges[i].Lower(), ranges[i].Upper()))
+            Append(ranges[i].Lower(), ranges[i].Upper());
+    }
+}
+
+//! @param	v	Value
+//!
+//! @return		Index of the range including @a v, or -1 if no range includes it
+
+template <typename T, bool lower_closed, bool upper_closed>
+int IntervalSet<T, lower_closed, upper_closed>::Find(T const & v) const
+{
+    // The only range that can include v is the last one whose lower end is below v.
+
+    int const i = CountLowerEnds<T, lower_closed>(m_Lower.data(), Size(), v) - 1;
+
+    return (i >= 0 && IsBelowUpper<T, upper_closed>(m_Upper[i], v)) ? i : -1;
+}
+
+//! @param	values	Values
+//! @param	pR		Where to store the results. pR[i] is true if the set includes values[i].
+//! @param	count	Number of values
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalSet<T, lower_closed, upper_closed>::Contains(T const * values, bool * pR, size_t count) const
+{
+    int const n = Size();
+
+    if (n == 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pR[i] = false;
+        }
+        return;
+    }
+
+    T const * const lower = m_Lower.data();
+    T const * const upper = m_Upper.data();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        int const k = CountLowerEnds<T, lower_closed>(lower, n, values[i]);
+
+        // If k is 0, range 0 is tested instead and the result is masked.
+
+        pR[i] = (k > 0) & IsBelowUpper<T, upper_closed>(upper[k - (k > 0)], values[i]);
+    }
+}
+
+//! @param	r	Range to add
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalSet<T, lower_closed, upper_closed>::Insert(RangeType const & r)
+{
+    if (IsEmptyRange(r.Lower(), r.Upper()))
+        return;
+
+    if (IsEmpty() || m_Lower.back() < r.Lower())
+    {
+        Append(r.Lower(), r.Upper());
+    }
+    else
+    {
+        IntervalSet single;
+        single.Append(r.Lower(), r.Upper());
+        *this = Union(*this, single);
+    }
+}
+
+//! @param	r	Range to remove
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalSet<T, lower_closed, upper_closed>::Remove(RangeType const & r)
+{
+    if (IsEmptyRange(r.Lower(), r.Upper()))
+        return;
+
+    IntervalSet single;
+    single.Append(r.Lower(), r.Upper());
+    *this = Difference(*this, single);
+}
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalSet<T, lower_closed, upper_closed>::Clear()
+{
+    m_Lower.clear();
+    m_Upper.clear();
+}
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalSet<T, lower_closed, upper_closed>::Append(T const & lower, T const & upper)
+{
+    if (!m_Lower.empty())
+    {
+        T & last = m_Upper.back();
+
+        // The ranges overlap if the new range starts before the last one ends. If they touch, they are coalesced
+        // unless the shared end is excluded from both.
+
+        if (lower < last || (!(last < lower) && (lower_closed || upper_closed)))
+        {
+            if (last < upper)
+                last = upper;
+            return;
+        }
+    }
+
+    m_Lower.push_back(lower);
+    m_Upper.push_back(upper);
+}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_INTERVALSET_H)
@@ -0,0 +1,209 @@
+#pragma once
+
+#if !defined(MYMATH_INTERVALTREE_H)
+#define MYMATH_INTERVALTREE_H
+
+#include "IntervalSet.h"
+#include "Range.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace MyMath
+{
+//! @addtogroup	Range
+//@{
+
+//! A static index of possibly overlapping ranges.
+//!
+//! The ranges are sorted by their lower ends. The ranges that could include a value are a prefix of the sorted
+//! ranges, which is found with a branchless binary search. Whether any of them includes the value is determined
+//! from the maximum upper end of the prefix, so Contains() takes O(log n) time. The ranges that include a value are
+//! found with an implicit binary tree over the sorted ranges, in which each node holds the range with the maximum
+//! upper end in its subtree, so Query() takes O(log n + k log n) time for k results.
+//!
+//! @param	T				Value type. @a T can be any type that implements operator== and operator<
+//! @param	lower_closed	If true, the lower ends of the ranges are included in the ranges
+//! @param	upper_closed	If true, the upper ends of the ranges are included in the ranges
+
+template <typename T, bool lower_closed = true, bool upper_closed = true>
+class IntervalTree
+{
+public:
+
+    //! The type of the ranges in the tree
+    using RangeType = Range<T, lower_closed, upper_closed>;
+
+    //! Constructor.
+    //! @param	ranges	Ranges (in any order)
+    //! @param	n		Number of ranges
+    IntervalTree(RangeType const * ranges, int n);
+
+    //! Returns the number of ranges.
+    int Size() const { return int(m_Lower.size()); }
+
+    //! Returns true if any range includes a value.
+    bool Contains(T const & v) const;
+
+    //! Determines which values of an array are included in any range.
+    void Contains(T const * values, bool * pR, size_t count) const;
+
+    //! Returns the indexes of the ranges that include a value.
+    void Query(T const & v, std::vector<int> * pResult) const;
+
+private:
+
+    // Returns the index of the range with the greater upper end, where -1 is no range
+    int Max(int a, int b) const
+    {
+        if (a < 0)
+            return b;
+        if (b < 0)
+            return a;
+        return (m_Upper[a] < m_Upper[b]) ? b : a;
+    }
+
+    // Adds the ranges in the subtree at node x (at level k) that include v to the result. Only the first n ranges
+    // (the ones whose lower ends are below v) are considered.
+    void Collect(int x, int k, int n, T const & v, std::vector<int> * pResult) const;
+
+    std::vector<T> m_Lower;         // Lower ends of the ranges, sorted
+    std::vector<T> m_Upper;         // Upper ends of the ranges, in the same order as m_Lower
+    std::vector<int> m_Index;       // Original index of each range
+    std::vector<T> m_PrefixMax;     // Maximum upper end of the first i+1 ranges
+    std::vector<int> m_Tree;        // Index of the range with the maximum upper end in the subtree of each node
+    int m_RootLevel;                // Level of the root of the tree
+};
+
+//@}
+
+//! @param	ranges	Ranges (in any order)
+//! @param	n		Number of ranges
+//!
+//! The tree is implicit: node x is at level k if the lowest k bits of x are 1. Its children are x - 2^(k-1) and
+//! x + 2^(k-1), and the root is 2^K - 1 where K is the level of the root. Node x corresponds to sorted range x.
+//! Nodes at or beyond n have no range but may have children that do.
+
+template <typename T, bool lower_closed, bool upper_closed>
+IntervalTree<T, lower_closed, upper_closed>::IntervalTree(RangeType const * ranges, int n)
+    : m_Index(n)
+    , m_RootLevel(0)
+{
+    std::iota(m_Index.begin(), m_Index.end(), 0);
+    std::stable_sort(m_Index.begin(), m_Index.end(), [ranges](int a, int b) {
+        return ranges[a].Lower() < ranges[b].Lower();
+    });
+
+    m_Lower.reserve(n);
+    m_Upper.reserve(n);
+    m_PrefixMax.reserve(n);
+    for (int i : m_Index)
+    {
+        m_Lower.push_back(ranges[i].Lower());
+        m_Upper.push_back(ranges[i].Upper());
+        m_PrefixMax.push_back((m_PrefixMax.empty() || m_PrefixMax.back() < ranges[i].Upper()) ? ranges[i].Upper()
+                                                                                              : m_PrefixMax.back());
+    }
+
+    while ((2 << m_RootLevel) - 1 < n)
+    {
+        ++m_RootLevel;
+    }
+
+    int const size = (2 << m_RootLevel) - 1;
+    m_Tree.resize(size);
+
+    for (int x = 0; x < size; x += 2)
+    {
+        m_Tree[x] = (x < n) ? x : -1;
+    }
+
+    for (int k = 1; k <= m_RootLevel; ++k)
+    {
+        int const half = 1 << (k - 1);
+        for (int x = (1 << k) - 1; x < size; x += 2 << k)
+        {
+            m_Tree[x] = Max(Max((x < n) ? x : -1, m_Tree[x - half]), m_Tree[x + half]);
+        }
+    }
+}
+
+//! @param	v	Value
+
+template <typename T, bool lower_closed, bool upper_closed>
+bool IntervalTree<T, lower_closed, upper_closed>::Contains(T const & v) const
+{
+    int const n = CountLowerEnds<T, lower_closed>(m_Lower.data(), Size(), v);
+
+    return n > 0 && IsBelowUpper<T, upper_closed>(m_PrefixMax[n - 1], v);
+}
+
+//! @param	values	Values
+//! @param	pR		Where to store the results. pR[i] is true if any range includes values[i].
+//! @param	count	Number of values
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalTree<T, lower_closed, upper_closed>::Contains(T const * values, bool * pR, size_t count) const
+{
+    int const size = Size();
+
+    if (size == 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pR[i] = false;
+        }
+        return;
+    }
+
+    T const * const lower     = m_Lower.data();
+    T const * const prefixMax = m_PrefixMax.data();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        int const n = CountLowerEnds<T, lower_closed>(lower, size, values[i]);
+
+        // If n is 0, the first prefix is tested instead and the result is masked.
+
+        pR[i] = (n > 0) & IsBelowUpper<T, upper_closed>(prefixMax[n - (n > 0)], values[i]);
+    }
+}
+
+//! @param	v			Value
+//! @param	pResult		Where to store the indexes (in the array given to the constructor) of the ranges that include
+//!						@a v. The indexes are appended in the order of the ranges' lower ends.
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalTree<T, lower_closed, upper_closed>::Query(T const & v, std::vector<int> * pResult) const
+{
+    int const n = CountLowerEnds<T, lower_closed>(m_Lower.data(), Size(), v);
+
+    if (n > 0)
+        Collect((1 << m_RootLevel) - 1, m_RootLevel, n, v, pResult);
+}
+
+template <typename T, bool lower_closed, bool upper_closed>
+void IntervalTree<T, lower_closed, upper_closed>::Collect(int x, int k, int n, T const & v,
+                                                          std::vector<int> * pResult) const
+{
+    // Nothing in the subtree includes v if it has no ranges, if its first range is not one of the first n, or if
+    // the greatest upper end in it is below v.
+
+    int const m = m_Tree[x];
+    if (m < 0 || x - ((1 << k) - 1) >= n || !IsBelowUpper<T, upper_closed>(m_Upper[m], v))
+        return;
+
+    if (k > 0)
+        Collect(x - (1 << (k - 1)), k - 1, n, v, pResult);
+
+    if (x < n && IsBelowUpper<T, upper_closed>(m_Upper[x], v))
+        pResult->push_back(m_Index[x]);
+
+    if (k > 0)
+        Collect(x + (1 << (k - 1)), k - 1, n, v, pResult);
+}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_INTERVALTREE_H)
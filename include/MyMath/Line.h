@@ -8,6 +8,8 @@
 #include "MyMath.h"
 #include "Vector3.h"
 
+#include <cmath>
+
 class Segment;
 class Ray;
 
@@ -152,6 +154,46 @@ public:
     Vector3 m_B;    //!< Location of endpoint at t = 0
 };
 
+//! A ray with values precomputed for slab tests against boxes.
+//!
+//! The reciprocal of the direction and the signs of its elements are computed once, so testing the ray against many
+//! boxes (e.g. when traversing a hierarchy) needs no divides or branches. It can represent a line, ray or segment;
+//! the range of t is given to the test.
+//!
+//! @ingroup Geometry
+
+class RayPrecomputed
+{
+public:
+
+    //! Constructor.
+    RayPrecomputed() = default;
+
+    //! Constructor.
+    RayPrecomputed(Vector3 const & origin, Vector3 const & direction);
+
+    //! Constructor. t is in [-infinity, infinity].
+    explicit RayPrecomputed(Line const & line) : RayPrecomputed(line.m_B, line.m_M) {}
+
+    //! Constructor. t is in [0, infinity].
+    explicit RayPrecomputed(Ray const & ray) : RayPrecomputed(ray.m_B, ray.m_M) {}
+
+    //! Constructor. t is in [0, 1].
+    explicit RayPrecomputed(Segment const & segment) : RayPrecomputed(segment.m_B, segment.m_M) {}
+
+    Vector3 m_Origin;           //!< Point at t = 0
+    Vector3 m_Direction;        //!< Direction (not necessarily normalized)
+    Vector3 m_InvDirection;     //!< Reciprocal of each element of the direction (infinite if the element is 0)
+    int m_Signs[3];             //!< 1 if the corresponding element of m_InvDirection is negative, otherwise 0
+};
+
+namespace MyMath
+{
+//! Intersects a ray with an axis-aligned box and returns the range of t inside it.
+bool IntersectSlabs(RayPrecomputed const & ray, Vector3 const bounds[2], float tMin, float tMax,
+                    float * pEnter, float * pExit);
+} // namespace MyMath
+
 // Inline functions
 
 #include "Misc/Assertx.h"
@@ -221,4 +263,54 @@ inline Segment::Segment(Vector3 const & m, Vector3 const & b, float length)
     m_B = b;
 }
 
+//! @param	origin		Point at t = 0
+//! @param	direction	Direction. It does not need to be normalized, and its elements may be 0 (or -0).
+
+inline RayPrecomputed::RayPrecomputed(Vector3 const & origin, Vector3 const & direction)
+    : m_Origin(origin)
+    , m_Direction(direction)
+    , m_InvDirection(1.0f / direction.m_X, 1.0f / direction.m_Y, 1.0f / direction.m_Z)
+{
+    m_Signs[0] = std::signbit(m_InvDirection.m_X) ? 1 : 0;
+    m_Signs[1] = std::signbit(m_InvDirection.m_Y) ? 1 : 0;
+    m_Signs[2] = std::signbit(m_InvDirection.m_Z) ? 1 : 0;
+}
+
+namespace MyMath
+{
+//! @param	ray		Ray
+//! @param	bounds	Minimum and maximum corners of the box
+//! @param	tMin	Start of the range of t to test
+//! @param	tMax	End of the range of t to test
+//! @param	pEnter	Where to store the value of t where the ray enters the box (or @a tMin if it starts inside)
+//! @param	pExit	Where to store the value of t where the ray leaves the box (or @a tMax if it ends inside)
+//!
+//! @return		true if the ray is inside the box for some t in [@a tMin, @a tMax]
+//!
+//! from Williams, Amy, et al. An Efficient and Robust Ray-Box Intersection Algorithm
+//!
+//! The near and far planes of each slab are selected with the precomputed signs. If the ray is parallel to a slab,
+//! the distances are infinite (so the range is empty if the ray is outside the slab) or NaN if the ray starts in
+//! one of the slab's planes. The comparisons are written so that NaNs leave the range unchanged, and the boxes are
+//! closed.
+
+inline bool IntersectSlabs(RayPrecomputed const & ray, Vector3 const bounds[2], float tMin, float tMax,
+                           float * pEnter, float * pExit)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        float const tNear = (bounds[ray.m_Signs[i]].m_V[i] - ray.m_Origin.m_V[i]) * ray.m_InvDirection.m_V[i];
+        float const tFar  = (bounds[1 - ray.m_Signs[i]].m_V[i] - ray.m_Origin.m_V[i]) * ray.m_InvDirection.m_V[i];
+
+        tMin = (tNear > tMin) ? tNear : tMin;
+        tMax = (tFar < tMax) ? tFar : tMax;
+    }
+
+    *pEnter = tMin;
+    *pExit  = tMax;
+
+    return tMin <= tMax;
+}
+} // namespace MyMath
+
 #endif // !defined(MYMATH_LINE_H)
@@ -0,0 +1,117 @@
+#pragma once
+
+#if !defined(MYMATH_MATRIX43SOA_H)
+#define MYMATH_MATRIX43SOA_H
+
+#include "Matrix43.h"
+#include "SoAStorage.h"
+
+#include <cstddef>
+
+class Vector3SoA;
+
+//! An array of 4x3 matrices of floats stored as 12 separate streams, one for each element.
+//!
+//! Elements are accessed through a proxy that has the same element members as Matrix43. The streams are aligned and
+//! padded (see MyMath::SoAStorage) so they can be given directly to SIMD kernels.
+//!
+//! @ingroup Matrices
+
+class Matrix43SoA
+{
+public:
+
+    //! A reference to an element.
+    class Reference
+    {
+    public:
+
+        //! Constructor.
+        Reference(Matrix43SoA & a, size_t i);
+
+        //! Assigns a matrix to the element.
+        Reference & operator =(Matrix43 const & m);
+
+        //! Assigns the value of another element to the element.
+        Reference & operator =(Reference const & r) { return operator =(Matrix43(r)); }
+
+        //! Returns the value of the element.
+        operator Matrix43() const;
+
+        //! @name	Matrix elements
+        //@{
+        float & m_Xx; float & m_Xy; float & m_Xz;
+        float & m_Yx; float & m_Yy; float & m_Yz;
+        float & m_Zx; float & m_Zy; float & m_Zz;
+        float & m_Tx; float & m_Ty; float & m_Tz;
+        //@}
+    };
+
+    //! Constructor.
+    Matrix43SoA() = default;
+
+    //! Constructor. The elements are 0.
+    explicit Matrix43SoA(size_t n) { Resize(n); }
+
+    //! Constructor.
+    Matrix43SoA(Matrix43 const * p, size_t n) { Load(p, n); }
+
+    //! Returns the number of elements.
+    size_t Size() const { return m_Storage.Size(); }
+
+    //! Returns the number of elements, including the padding.
+    size_t PaddedSize() const { return m_Storage.PaddedSize(); }
+
+    //! Sets the number of elements. New elements are 0.
+    void Resize(size_t n) { m_Storage.Resize(n); }
+
+    //! Makes room for at least n elements.
+    void Reserve(size_t n) { m_Storage.Reserve(n); }
+
+    //! Removes all the elements.
+    void Clear() { m_Storage.Resize(0); }
+
+    //! Appends an element.
+    void PushBack(Matrix43 const & m);
+
+    //! Returns a reference to element i.
+    Reference operator [](size_t i) { return Reference(*this, i); }
+
+    //! Returns the value of element i.
+    Matrix43 operator [](size_t i) const;
+
+    //! Returns the stream of the matrix element at the given row and column.
+    float * GetStream(int row, int column) { return m_Storage.GetStream(row * 3 + column); }
+
+    //! Returns the stream of the matrix element at the given row and column.
+    float const * GetStream(int row, int column) const { return m_Storage.GetStream(row * 3 + column); }
+
+    //! Replaces the elements with an array of matrices.
+    void Load(Matrix43 const * p, size_t n);
+
+    //! Stores the elements in an array of matrices.
+    void Store(Matrix43 * p) const;
+
+private:
+
+    MyMath::SoAStorage<12> m_Storage;
+};
+
+namespace MyMath
+{
+//! @name Matrix43SoA Operations
+//!
+//! These operate on every element. The result may be one of the operands. The result is resized to the size of the
+//! operands, which must be the same.
+//@{
+
+//! Computes a * b (see Matrix43::PostConcatenate()).
+void Multiply(Matrix43SoA const & a, Matrix43SoA const & b, Matrix43SoA * pR);
+
+//! Transforms each vector by the corresponding matrix (see Vector3::Transform(Matrix43 const &)).
+void Transform(Vector3SoA const & v, Matrix43SoA const & m, Vector3SoA * pR);
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_MATRIX43SOA_H)
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 
 // Group definitions for doxygen
 
@@ -123,9 +124,21 @@ inline bool IsRelativelyCloseTo(double x, double y, double tolerance = DEFAULT_F
 //! @ingroup	Miscellaneous
 //@{
 
-//! Returns <i>n</i>! computed using Stirling's formula
+//! Returns <i>n</i>! computed using Stirling's series
 double Stirling(double n);
 
+//! Returns the natural logarithm of the absolute value of the gamma function
+double LogGamma(double x);
+
+//! Computes the natural logarithms of the absolute values of the gamma function for an array of values
+void LogGamma(double const * x, double * pR, size_t count);
+
+//! Returns the gamma function
+double Gamma(double x);
+
+//! Returns <i>n</i>! for real values (the gamma function of <i>n</i> + 1)
+double Factorial(double n);
+
 //! Returns the linear interpolation between two values
 //!
 //! @param	y0	Value when x = 0
@@ -154,6 +167,13 @@ T limit(T const & min, T const & v, T const & max)
     return std::min(std::max(v, min), max);
 }
 
+//! Returns a value limited to min and max values. Unlike limit(), NaN is limited to @a min, so the result is always
+//! in range (as with the SSE/AVX max and min instructions).
+inline float limitNaNToMin(float min, float v, float max)
+{
+    return (v > min) ? std::min(v, max) : min;
+}
+
 //@}
 } // namespace MyMath
 
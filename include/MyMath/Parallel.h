@@ -0,0 +1,271 @@
+#pragma once
+
+#if !defined(MYMATH_PARALLEL_H)
+#define MYMATH_PARALLEL_H
+
+#include "Intersectable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MyMath
+{
+//! A fixed pool of worker threads that run tasks.
+//!
+//! Each worker has its own deque of tasks. A worker takes tasks from the back of its own deque and, when it is
+//! empty, steals them from the front of the others, so the load is balanced without a central queue. Tasks submitted
+//! by a worker go to its own deque; tasks submitted by other threads are dealt to the workers in turn.
+//!
+//! Threads that wait for tasks (see TaskGroup::Wait()) run queued tasks while they wait, so parallel loops may be
+//! nested.
+
+class TaskScheduler
+{
+public:
+
+    //! A unit of work.
+    using Task = std::function<void()>;
+
+    //! Constructor. If @a nThreads is 0, there is one worker per hardware thread.
+    explicit TaskScheduler(int nThreads = 0);
+
+    //! Destructor. Queued tasks are run before the workers stop.
+    ~TaskScheduler();
+
+    TaskScheduler(TaskScheduler const &) = delete;
+    TaskScheduler & operator =(TaskScheduler const &) = delete;
+
+    //! Returns the number of worker threads.
+    int GetThreadCount() const { return int(m_Threads.size()); }
+
+    //! Queues a task. The task must not throw (see TaskGroup).
+    void Submit(Task task);
+
+    //! Runs one queued task in the calling thread. Returns false if there were none.
+    bool RunOne();
+
+    //! Returns a scheduler shared by the whole program, with one worker per hardware thread.
+    static TaskScheduler & GetDefault();
+
+private:
+
+    // A worker's deque
+    struct Queue
+    {
+        std::mutex m_Mutex;
+        std::deque<Task> m_Tasks;
+    };
+
+    // Worker thread function
+    void Work(int index);
+
+    // Takes a task, preferring the back of queue 'first' and then stealing from the front of the others
+    bool Take(int first, Task * pTask);
+
+    std::vector<std::unique_ptr<Queue> > m_Queues;  // One per worker
+    std::vector<std::thread> m_Threads;             // Workers
+    std::mutex m_WakeMutex;                         // Guards m_nPending changes that workers wait on
+    std::condition_variable m_Wake;                 // Signaled when a task is queued or the workers must stop
+    std::atomic<int> m_nPending;                    // Number of queued tasks
+    std::atomic<unsigned> m_NextQueue;              // Queue for the next task submitted by a non-worker
+    bool m_Stop;                                    // True when the workers must stop
+};
+
+//! A set of tasks that a thread can wait for.
+//!
+//! If a task throws, the tasks of the group that have not started are skipped and Wait() rethrows the exception once
+//! the others are done. Since Wait() doesn't return before every task is done, the tasks may refer to the waiting
+//! thread's locals.
+
+class TaskGroup
+{
+public:
+
+    //! Constructor.
+    TaskGroup() : m_nRemaining(0), m_Cancelled(false) {}
+
+    TaskGroup(TaskGroup const &) = delete;
+    TaskGroup & operator =(TaskGroup const &) = delete;
+
+    //! Queues a task of the group.
+    template <typename F>
+    void Submit(TaskScheduler & scheduler, F const & f);
+
+    //! Runs a task of the group in the calling thread.
+    template <typename F>
+    void Run(F const & f);
+
+    //! Returns when all the tasks are done, and rethrows the first exception thrown by any of them.
+    void Wait(TaskScheduler & scheduler);
+
+private:
+
+    // Records an exception and skips the tasks that haven't started
+    void Cancel(std::exception_ptr pException);
+
+    // Marks a queued task as done
+    void Finish();
+
+    std::mutex m_Mutex;                 // Guards m_nRemaining and m_pException
+    std::condition_variable m_Done;     // Signaled when m_nRemaining reaches 0
+    size_t m_nRemaining;                // Number of queued tasks that are not done
+    std::exception_ptr m_pException;    // First exception thrown by a task
+    std::atomic<bool> m_Cancelled;      // True if a task has thrown
+};
+
+//! @param	scheduler	Scheduler to run the task
+//! @param	f			Task. It is called with no arguments.
+//!
+//! If the task can't be queued, the exception is rethrown by Wait().
+
+template <typename F>
+void TaskGroup::Submit(TaskScheduler & scheduler, F const & f)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_nRemaining;
+    }
+
+    try
+    {
+        scheduler.Submit([this, f]
+        {
+            Run(f);
+            Finish();   // The group may be destroyed as soon as this returns.
+        });
+    }
+    catch (...)
+    {
+        Finish();
+        Cancel(std::current_exception());
+    }
+}
+
+//! @param	f	Task. It is called with no arguments.
+//!
+//! The task is skipped if another task of the group has thrown. If it throws, the exception is rethrown by Wait().
+
+template <typename F>
+void TaskGroup::Run(F const & f)
+{
+    if (m_Cancelled.load(std::memory_order_relaxed))
+        return;
+
+    try
+    {
+        f();
+    }
+    catch (...)
+    {
+        Cancel(std::current_exception());
+    }
+}
+
+//! @name Parallel Loops
+//!
+//! The range is divided into chunks whose boundaries are multiples of @a grain, and each chunk is a task. Since each
+//! index is handled by exactly one call, results written by index are the same as a serial loop, regardless of the
+//! number of threads. The calling thread helps run the chunks and returns when all of them are done.
+//@{
+
+//! Size of a cache line in bytes
+size_t const CACHE_LINE_SIZE = 64;
+
+//! Calls body(begin, end) for chunks covering [0, n). If a call throws, the chunks that haven't started are skipped
+//! and the exception is rethrown.
+template <typename Body>
+void ParallelFor(TaskScheduler & scheduler, size_t n, size_t grain, Body const & body)
+{
+    if (n == 0)
+        return;
+
+    // Make about 4 chunks per thread so that stealing can even out the load, but not smaller than the grain.
+
+    grain = std::max<size_t>(grain, 1);
+
+    size_t const nThreads = size_t(scheduler.GetThreadCount()) + 1;
+    size_t       chunk    = std::max(grain, (n + nThreads * 4 - 1) / (nThreads * 4));
+    chunk = (chunk + grain - 1) / grain * grain;
+
+    if (chunk >= n)
+    {
+        body(size_t(0), n);
+        return;
+    }
+
+    TaskGroup group;
+
+    for (size_t begin = chunk; begin < n; begin += chunk)
+    {
+        size_t const end = std::min(begin + chunk, n);
+        group.Submit(scheduler, [&body, begin, end] { body(begin, end); });
+    }
+
+    // The calling thread does the first chunk and then helps with the others. If a chunk throws, the exception is
+    // rethrown only after the queued chunks, which refer to body, are done or skipped.
+
+    group.Run([&body, chunk] { body(size_t(0), chunk); });
+    group.Wait(scheduler);
+}
+
+//! Calls body(begin, end) for chunks covering [0, n), using the default scheduler.
+template <typename Body>
+void ParallelFor(size_t n, size_t grain, Body const & body)
+{
+    ParallelFor(TaskScheduler::GetDefault(), n, grain, body);
+}
+
+//! Tests a query against each shape and stores the results in order.
+//!
+//! @param	scheduler	Scheduler that runs the tests
+//! @param	query		Object to test
+//! @param	paShapes	Shapes to test against
+//! @param	n			Number of shapes
+//! @param	paResults	Where to store query.Intersects(paShapes[i]). There must be room for n results.
+//!
+//! The chunks start on cache lines of the results, so threads don't write to the same line.
+
+template <typename Shape>
+void ParallelClassify(TaskScheduler & scheduler, Intersectable const & query, Shape const * paShapes, size_t n,
+                      Intersectable::Result * paResults)
+{
+    // The results before the first cache line boundary are done first, so the chunks after them start on a line.
+
+    size_t const offset = size_t(reinterpret_cast<uintptr_t>(paResults) % CACHE_LINE_SIZE);
+    size_t const head   = std::min(n, (CACHE_LINE_SIZE - offset) % CACHE_LINE_SIZE / sizeof(Intersectable::Result));
+
+    for (size_t i = 0; i < head; ++i)
+    {
+        paResults[i] = query.Intersects(paShapes[i]);
+    }
+
+    ParallelFor(scheduler, n - head, CACHE_LINE_SIZE / sizeof(Intersectable::Result), [&](size_t begin, size_t end)
+    {
+        for (size_t i = head + begin; i < head + end; ++i)
+        {
+            paResults[i] = query.Intersects(paShapes[i]);
+        }
+    });
+}
+
+//! Tests a query against each shape and stores the results in order, using the default scheduler.
+template <typename Shape>
+void ParallelClassify(Intersectable const & query, Shape const * paShapes, size_t n, Intersectable::Result * paResults)
+{
+    ParallelClassify(TaskScheduler::GetDefault(), query, paShapes, n, paResults);
+}
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_PARALLEL_H)
@@ -6,9 +6,12 @@
 #include "Intersectable.h"
 #include "Vector3.h"
 
+#include <cstddef>
+
 class Matrix43;
 class Poly;
 class HalfSpace;
+class Vector3SoA;
 
 //! A plane that can detect and compute intersections with other intersectable objects.
 //!
@@ -87,6 +90,28 @@ public:
     //! Returns true if the point is behind the plane.
     bool IsBehind(Point const & v) const;
 
+    //! @name Batch Operations
+    //@{
+
+    //! Computes the directed distances of n points.
+    void DirectedDistances(Vector3 const * paPoints, float * paDistances, size_t n) const;
+
+    //! Computes the directed distances of the elements. @a paDistances must have room for points.Size() values.
+    void DirectedDistances(Vector3SoA const & points, float * paDistances) const;
+
+    //! Reflects n points about the plane. The results may be the points.
+    void Reflect(Vector3 const * paPoints, Vector3 * paResults, size_t n) const;
+
+    //! Reflects the elements about the plane. The result may be the points.
+    void Reflect(Vector3SoA const & points, Vector3SoA * pResults) const;
+
+    //! Projects n points along the plane's normal onto the plane. The results may be the points.
+    void Project(Vector3 const * paPoints, Vector3 * paResults, size_t n) const;
+
+    //! Projects the elements along the plane's normal onto the plane. The result may be the points.
+    void Project(Vector3SoA const & points, Vector3SoA * pResults) const;
+    //@}
+
     // Plane equation: m_N.m_X * x + m_N.m_Y * y + m_N.m_Z * z + m_D = 0
 
     Vector3 m_N;            //!< Normal ([A, B, C])
@@ -95,6 +120,12 @@ public:
 
 //! A planar polygon that can detect and compute intersections with other intersectable objects
 //!
+//! A polygon owns its vertices. Up to INLINE_CAPACITY vertices are stored in the polygon itself, so most polygons
+//! never allocate. Larger polygons get their vertices from a per-thread pool of blocks that are reused rather than
+//! freed, so polygons that are created and destroyed constantly (e.g. by clipping) rarely reach the heap. Copying a
+//! polygon copies its vertices; moving a polygon with pooled vertices just transfers the block. Polygons that outlive
+//! their thread's pool (e.g. static polygons) free their blocks directly.
+//!
 //! @ingroup Geometry
 //!
 
@@ -102,17 +133,31 @@ class Poly : public Plane
 {
 public:
 
-    //! Constructor.
-    Poly() = default;
+    static int constexpr INLINE_CAPACITY = 8;   //!< Number of vertices stored in the polygon itself
 
     //! Constructor.
+    Poly();
+
+    //! Constructor. The plane is computed from the vertices.
     Poly(Vector3 const * paVertices, int nVertices);
 
     //! Constructor.
     Poly(Plane const & plane, Vector3 const * paVertices, int nVertices);
 
+    //! Copy constructor.
+    Poly(Poly const & poly);
+
+    //! Move constructor.
+    Poly(Poly && poly) noexcept;
+
     //! Destructor.
-    virtual ~Poly() override = default;
+    virtual ~Poly() override;
+
+    //! Copy assignment.
+    Poly & operator =(Poly const & poly);
+
+    //! Move assignment.
+    Poly & operator =(Poly && poly) noexcept;
 
     //! @name Overrides Intersectable
     //@{
@@ -146,8 +191,45 @@ public:
     //	bool IsBehind( Vector3 const & v ) const;
     //@}
 
-    Vector3 * m_paVertices;         //!< Vertex list
-    int m_nVertices;                //!< Number of vertices in the vertex list
+    //! Returns the vertices.
+    Vector3 const * GetVertices() const { return m_paVertices; }
+
+    //! Returns the vertices. Use Resize(), PushBack() or Assign() to change their number.
+    Vector3 * GetVertices() { return m_paVertices; }
+
+    //! Returns the number of vertices.
+    int GetVertexCount() const { return m_nVertices; }
+
+    //! Returns the number of vertices that can be stored without reallocating.
+    int GetCapacity() const { return m_Capacity; }
+
+    //! Makes room for at least n vertices.
+    void Reserve(int n);
+
+    //! Sets the number of vertices. The values of new vertices are undefined.
+    void Resize(int n);
+
+    //! Appends a vertex.
+    void PushBack(Vector3 const & v);
+
+    //! Removes all the vertices.
+    void Clear() { m_nVertices = 0; }
+
+    //! Replaces the vertices.
+    void Assign(Vector3 const * paVertices, int nVertices);
+
+    //! Returns the plane containing a list of vertices (Newell's method).
+    static Plane ComputePlane(Vector3 const * paVertices, int nVertices);
+
+private:
+
+    // Frees pooled storage and reverts to the inline storage
+    void Release();
+
+    Vector3 * m_paVertices;                     // Vertex list, either m_aInline or a pooled block
+    int m_nVertices;                            // Number of vertices in the vertex list
+    int m_Capacity;                             // Number of vertices that m_paVertices can hold
+    Vector3 m_aInline[INLINE_CAPACITY];         // Storage for small polygons
 };
 
 //! A half-space that can detect and compute intersections with other intersectable objects
@@ -0,0 +1,240 @@
+#pragma once
+
+#if !defined(MYMATH_PLANESET_H)
+#define MYMATH_PLANESET_H
+
+#include "Plane.h"
+#include "Vector3.h"
+#include "Vector3SoA.h"
+
+#include "Misc/Assertx.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+//! A fixed set of planes that points can be classified against all at once.
+//!
+//! The planes are stored as separate a, b, c and d streams padded to a multiple of 8 with planes that no point is in
+//! front of. A point is classified against 8 planes at a time, and the elements of a Vector3SoA are classified 8
+//! points at a time.
+//!
+//! @param	N	Number of planes (1 - 32)
+//!
+//! @ingroup Geometry
+
+template <int N>
+class PlaneSet
+{
+public:
+
+    static_assert(N > 0 && N <= 32, "A plane set has 1 to 32 planes");
+
+    static uint32_t const ALL = ~uint32_t(0) >> (32 - N);     //!< Mask of all the planes
+
+    //! Constructor. No point is in front of any of the planes.
+    PlaneSet();
+
+    //! Constructor.
+    explicit PlaneSet(Plane const * paPlanes);
+
+    //! Replaces plane i.
+    void Set(int i, Plane const & plane);
+
+    //! Returns plane i.
+    Plane Get(int i) const;
+
+    //! Computes the directed distances from a point to each plane. @a paDistances must have room for N values.
+    void DirectedDistances(Vector3 const & point, float * paDistances) const;
+
+    //! Returns a mask of the planes that a point is in front of (bit i is set if the point is in front of plane i).
+    uint32_t Classify(Vector3 const & point) const;
+
+    //! Classifies n points (see Classify(Vector3 const &)).
+    void Classify(Vector3 const * paPoints, uint32_t * paMasks, size_t n) const;
+
+    //! Classifies the elements (see Classify(Vector3 const &)). @a paMasks must have room for points.Size() values.
+    void Classify(Vector3SoA const & points, uint32_t * paMasks) const;
+
+private:
+
+    static int const PADDED_SIZE = (N + 7) & ~7;
+
+    alignas(32) float m_A[PADDED_SIZE];     // Normals (x)
+    alignas(32) float m_B[PADDED_SIZE];     // Normals (y)
+    alignas(32) float m_C[PADDED_SIZE];     // Normals (z)
+    alignas(32) float m_D[PADDED_SIZE];     // Distances
+};
+
+// Inline functions
+
+template <int N>
+PlaneSet<N>::PlaneSet()
+{
+    for (int i = 0; i < PADDED_SIZE; ++i)
+    {
+        m_A[i] = 0.0f;
+        m_B[i] = 0.0f;
+        m_C[i] = 0.0f;
+        m_D[i] = -1.0f;
+    }
+}
+
+//! @param	paPlanes	The N planes
+
+template <int N>
+PlaneSet<N>::PlaneSet(Plane const * paPlanes)
+    : PlaneSet()
+{
+    for (int i = 0; i < N; ++i)
+    {
+        Set(i, paPlanes[i]);
+    }
+}
+
+//! @param	i		Index of the plane
+//! @param	plane	Plane
+
+template <int N>
+void PlaneSet<N>::Set(int i, Plane const & plane)
+{
+    assert(i >= 0 && i < N);
+
+    m_A[i] = plane.m_N.m_X;
+    m_B[i] = plane.m_N.m_Y;
+    m_C[i] = plane.m_N.m_Z;
+    m_D[i] = plane.m_D;
+}
+
+//! @param	i	Index of the plane
+
+template <int N>
+Plane PlaneSet<N>::Get(int i) const
+{
+    assert(i >= 0 && i < N);
+
+    Plane plane;
+    plane.m_N = Vector3(m_A[i], m_B[i], m_C[i]);
+    plane.m_D = m_D[i];
+    return plane;
+}
+
+//! @param	point			Point
+//! @param	paDistances		Where to store the distances
+
+template <int N>
+void PlaneSet<N>::DirectedDistances(Vector3 const & point, float * paDistances) const
+{
+    for (int i = 0; i < N; ++i)
+    {
+        paDistances[i] = point.m_X * m_A[i] + point.m_Y * m_B[i] + point.m_Z * m_C[i] + m_D[i];
+    }
+}
+
+//! @param	point	Point
+//!
+//! @return		Bit i is set if the point is in front of plane i (see Plane::IsInFrontOf())
+
+template <int N>
+uint32_t PlaneSet<N>::Classify(Vector3 const & point) const
+{
+    uint32_t mask = 0;
+
+#if defined(__AVX2__)
+    __m256 const x    = _mm256_set1_ps(point.m_X);
+    __m256 const y    = _mm256_set1_ps(point.m_Y);
+    __m256 const z    = _mm256_set1_ps(point.m_Z);
+    __m256 const zero = _mm256_setzero_ps();
+
+    for (int i = 0; i < PADDED_SIZE; i += 8)
+    {
+        __m256 const d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_load_ps(m_A + i)),
+                                                                   _mm256_mul_ps(y, _mm256_load_ps(m_B + i))),
+                                                     _mm256_mul_ps(z, _mm256_load_ps(m_C + i))),
+                                       _mm256_load_ps(m_D + i));
+        mask |= uint32_t(_mm256_movemask_ps(_mm256_cmp_ps(d, zero, _CMP_GT_OQ))) << i;
+    }
+#else // defined(__AVX2__)
+    for (int i = 0; i < N; ++i)
+    {
+        if (point.m_X * m_A[i] + point.m_Y * m_B[i] + point.m_Z * m_C[i] + m_D[i] > 0.0f)
+            mask |= uint32_t(1) << i;
+    }
+#endif // defined(__AVX2__)
+
+    return mask;
+}
+
+//! @param	paPoints	Points
+//! @param	paMasks		Where to store the masks
+//! @param	n			Number of points
+
+template <int N>
+void PlaneSet<N>::Classify(Vector3 const * paPoints, uint32_t * paMasks, size_t n) const
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        paMasks[i] = Classify(paPoints[i]);
+    }
+}
+
+//! @param	points		Points
+//! @param	paMasks		Where to store the masks
+
+template <int N>
+void PlaneSet<N>::Classify(Vector3SoA const & points, uint32_t * paMasks) const
+{
+    float const * const px = points.GetX();
+    float const * const py = points.GetY();
+    float const * const pz = points.GetZ();
+    size_t const        n  = points.Size();
+
+#if defined(__AVX2__)
+    // The streams are padded to a multiple of 8, so whole blocks can be loaded. Only the masks of the elements are
+    // stored.
+
+    __m256 const zero = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < n; i += 8)
+    {
+        __m256 const x     = _mm256_load_ps(px + i);
+        __m256 const y     = _mm256_load_ps(py + i);
+        __m256 const z     = _mm256_load_ps(pz + i);
+        __m256i      masks = _mm256_setzero_si256();
+
+        for (int p = 0; p < N; ++p)
+        {
+            __m256 const  d     = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(m_A[p])),
+                                                                            _mm256_mul_ps(y, _mm256_set1_ps(m_B[p]))),
+                                                              _mm256_mul_ps(z, _mm256_set1_ps(m_C[p]))),
+                                                _mm256_set1_ps(m_D[p]));
+            __m256i const front = _mm256_castps_si256(_mm256_cmp_ps(d, zero, _CMP_GT_OQ));
+            masks = _mm256_or_si256(masks, _mm256_and_si256(front, _mm256_set1_epi32(int(uint32_t(1) << p))));
+        }
+
+        if (i + 8 <= n)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(paMasks + i), masks);
+        }
+        else
+        {
+            alignas(32) uint32_t last[8];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(last), masks);
+            for (size_t j = 0; i + j < n; ++j)
+            {
+                paMasks[i + j] = last[j];
+            }
+        }
+    }
+#else // defined(__AVX2__)
+    for (size_t i = 0; i < n; ++i)
+    {
+        paMasks[i] = Classify(Vector3(px[i], py[i], pz[i]));
+    }
+#endif // defined(__AVX2__)
+}
+
+#endif // !defined(MYMATH_PLANESET_H)
@@ -0,0 +1,68 @@
+#pragma once
+
+#if !defined(MYMATH_POLYBUFFER_H)
+#define MYMATH_POLYBUFFER_H
+
+#include "Plane.h"
+#include "Vector3.h"
+
+#include <vector>
+
+//! A list of polygons whose vertices are stored contiguously in one array.
+//!
+//! Adding a polygon appends its vertices to the shared array, so thousands of polygons need only a few allocations,
+//! and the vertices of consecutive polygons are adjacent in memory.
+//!
+//! @ingroup Geometry
+
+class PolyBuffer
+{
+public:
+
+    //! Constructor.
+    PolyBuffer() : m_Offsets(1, 0) {}
+
+    //! Returns the number of polygons.
+    int Size() const { return int(m_Planes.size()); }
+
+    //! Returns the total number of vertices.
+    int GetTotalVertexCount() const { return int(m_Vertices.size()); }
+
+    //! Returns the number of vertices of polygon i.
+    int GetVertexCount(int i) const { return m_Offsets[i + 1] - m_Offsets[i]; }
+
+    //! Returns the vertices of polygon i.
+    Vector3 const * GetVertices(int i) const { return m_Vertices.data() + m_Offsets[i]; }
+
+    //! Returns the vertices of polygon i.
+    Vector3 * GetVertices(int i) { return m_Vertices.data() + m_Offsets[i]; }
+
+    //! Returns the plane of polygon i.
+    Plane const & GetPlane(int i) const { return m_Planes[i]; }
+
+    //! Returns a copy of polygon i.
+    Poly operator [](int i) const { return Poly(m_Planes[i], GetVertices(i), GetVertexCount(i)); }
+
+    //! Appends a polygon and returns its index.
+    int PushBack(Poly const & poly);
+
+    //! Appends a polygon and returns its index. The plane is computed from the vertices.
+    int PushBack(Vector3 const * paVertices, int nVertices);
+
+    //! Appends a polygon and returns its index.
+    int PushBack(Plane const & plane, Vector3 const * paVertices, int nVertices);
+
+    //! Makes room for at least the given numbers of polygons and vertices.
+    void Reserve(int nPolys, int nVertices);
+
+    //! Removes all the polygons.
+    void Clear();
+
+private:
+
+    std::vector<Vector3> m_Vertices;    // Vertices of all the polygons
+    std::vector<int> m_Offsets;         // Index of each polygon's first vertex, plus the total number of vertices
+    std::vector<Plane> m_Planes;        // Plane of each polygon
+};
+
+#endif // !defined(MYMATH_POLYBUFFER_H)
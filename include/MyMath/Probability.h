@@ -3,11 +3,42 @@
 #if !defined(MYMATH_PROBABILITY_H)
 #define MYMATH_PROBABILITY_H
 
+#include <cstddef>
+#include <cstdint>
+
+//! @name Combinatorics
+//!
+//! The integer functions return 0 if the arguments are invalid or if the result cannot be represented. The 128-bit
+//! functions return false instead and the result is returned as two 64-bit halves.
+//!
+//! The log-space functions return the natural logarithm of the result, and -infinity if the arguments are invalid.
+//@{
+
 int     Factorial(int n);
-__int64 Factorial64(int n);
+int64_t Factorial64(int n);
+bool    Factorial128(int n, uint64_t * pHi, uint64_t * pLo);
+double  LogFactorial(int n);
+
+int     Combinations(int n, int r);
+int64_t Combinations64(int n, int r);
+bool    Combinations128(int n, int r, uint64_t * pHi, uint64_t * pLo);
+double  LogCombinations(int n, int r);
+
+int     Permutations(int n, int r);
+int64_t Permutations64(int n, int r);
+bool    Permutations128(int n, int r, uint64_t * pHi, uint64_t * pLo);
+double  LogPermutations(int n, int r);
+
+//@}
+
+//! @name Batch Combinatorics
+//!
+//! These compute the values for arrays of (n, r) pairs, in the same way as the functions above.
+//@{
 
-int Combinations(int n, int r);
+void Combinations64(int const * n, int const * r, int64_t * pC, size_t count);
+void LogCombinations(int const * n, int const * r, double * pC, size_t count);
 
-int Permutations(int n, int r);
+//@}
 
 #endif // !defined(MYMATH_PROBABILITY_H)
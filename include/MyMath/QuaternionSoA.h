@@ -0,0 +1,143 @@
+#pragma once
+
+#if !defined(MYMATH_QUATERNIONSOA_H)
+#define MYMATH_QUATERNIONSOA_H
+
+#include "Quaternion.h"
+#include "SoAStorage.h"
+
+#include <cstddef>
+
+class Vector3SoA;
+
+//! An array of quaternions stored as separate x, y, z and w streams.
+//!
+//! Elements are accessed through a proxy that has the same members as Quaternion. The streams are aligned and
+//! padded (see MyMath::SoAStorage) so they can be given directly to SIMD kernels.
+
+class QuaternionSoA
+{
+public:
+
+    //! A reference to an element.
+    class Reference
+    {
+    public:
+
+        //! Constructor.
+        Reference(float & x, float & y, float & z, float & w) : m_X(x), m_Y(y), m_Z(z), m_W(w) {}
+
+        //! Assigns a quaternion to the element.
+        Reference & operator =(Quaternion const & q)
+        {
+            m_X = q.m_X;
+            m_Y = q.m_Y;
+            m_Z = q.m_Z;
+            m_W = q.m_W;
+            return *this;
+        }
+
+        //! Assigns the value of another element to the element.
+        Reference & operator =(Reference const & r) { return operator =(Quaternion(r)); }
+
+        //! Returns the value of the element.
+        operator Quaternion() const { return Quaternion(m_X, m_Y, m_Z, m_W); }
+
+        float & m_X;    //!< X
+        float & m_Y;    //!< Y
+        float & m_Z;    //!< Z
+        float & m_W;    //!< W
+    };
+
+    //! Constructor.
+    QuaternionSoA() = default;
+
+    //! Constructor. The elements are 0.
+    explicit QuaternionSoA(size_t n) { Resize(n); }
+
+    //! Constructor.
+    QuaternionSoA(Quaternion const * p, size_t n) { Load(p, n); }
+
+    //! Returns the number of elements.
+    size_t Size() const { return m_Storage.Size(); }
+
+    //! Returns the number of elements, including the padding.
+    size_t PaddedSize() const { return m_Storage.PaddedSize(); }
+
+    //! Sets the number of elements. New elements are 0.
+    void Resize(size_t n) { m_Storage.Resize(n); }
+
+    //! Makes room for at least n elements.
+    void Reserve(size_t n) { m_Storage.Reserve(n); }
+
+    //! Removes all the elements.
+    void Clear() { m_Storage.Resize(0); }
+
+    //! Appends an element.
+    void PushBack(Quaternion const & q);
+
+    //! Returns a reference to element i.
+    Reference operator [](size_t i) { return Reference(GetX()[i], GetY()[i], GetZ()[i], GetW()[i]); }
+
+    //! Returns the value of element i.
+    Quaternion operator [](size_t i) const { return Quaternion(GetX()[i], GetY()[i], GetZ()[i], GetW()[i]); }
+
+    //! Returns the X stream.
+    float * GetX() { return m_Storage.GetStream(0); }
+
+    //! Returns the Y stream.
+    float * GetY() { return m_Storage.GetStream(1); }
+
+    //! Returns the Z stream.
+    float * GetZ() { return m_Storage.GetStream(2); }
+
+    //! Returns the W stream.
+    float * GetW() { return m_Storage.GetStream(3); }
+
+    //! Returns the X stream.
+    float const * GetX() const { return m_Storage.GetStream(0); }
+
+    //! Returns the Y stream.
+    float const * GetY() const { return m_Storage.GetStream(1); }
+
+    //! Returns the Z stream.
+    float const * GetZ() const { return m_Storage.GetStream(2); }
+
+    //! Returns the W stream.
+    float const * GetW() const { return m_Storage.GetStream(3); }
+
+    //! Replaces the elements with an array of quaternions.
+    void Load(Quaternion const * p, size_t n);
+
+    //! Stores the elements in an array of quaternions.
+    void Store(Quaternion * p) const;
+
+private:
+
+    MyMath::SoAStorage<4> m_Storage;
+};
+
+namespace MyMath
+{
+//! @name QuaternionSoA Operations
+//!
+//! These operate on every element. The result may be one of the operands. The result is resized to the size of the
+//! operands, which must be the same.
+//@{
+
+//! Computes a * b (see Quaternion::Multiply()).
+void Multiply(QuaternionSoA const & a, QuaternionSoA const & b, QuaternionSoA * pR);
+
+//! Normalizes the elements.
+void Normalize(QuaternionSoA const & a, QuaternionSoA * pR);
+
+//! Conjugates the elements.
+void Conjugate(QuaternionSoA const & a, QuaternionSoA * pR);
+
+//! Rotates each vector by the corresponding quaternion (see Vector3::Rotate(Quaternion const &)).
+void Rotate(Vector3SoA const & v, QuaternionSoA const & q, Vector3SoA * pR);
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_QUATERNIONSOA_H)
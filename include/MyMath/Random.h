@@ -0,0 +1,166 @@
+#pragma once
+
+#if !defined(MYMATH_RANDOM_H)
+#define MYMATH_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AABox;
+class Box;
+class Cone;
+class Poly;
+class Sphere;
+class Vector3;
+
+//! @defgroup	Random		Random Numbers
+//! @ingroup	Miscellaneous
+//!
+//! Random number generation and sampling of distributions and geometric objects.
+//@{
+
+//! Philox4x32-10 counter-based random number generator.
+//!
+//! The generator encrypts a 128-bit counter with the seed as the key. The upper half of the counter is the stream
+//! number and the lower half is the position in the stream, so generators with the same seed and different streams
+//! produce independent sequences. This allows each thread (or each task) to have its own generator without any
+//! coordination.
+//!
+//! The class satisfies the requirements of UniformRandomBitGenerator.
+
+class Philox
+{
+public:
+
+    //! Type of the values returned by operator ()
+    using result_type = uint32_t;
+
+    //! Constructor.
+    explicit Philox(uint64_t seed, uint64_t stream = 0);
+
+    //! Returns the next 32-bit value.
+    uint32_t operator ()();
+
+    //! Returns the next 64-bit value.
+    uint64_t Next64();
+
+    //! Returns the next value as a float uniformly distributed in [0, 1).
+    float NextFloat();
+
+    //! Returns the next value as a double uniformly distributed in [0, 1).
+    double NextDouble();
+
+    //! Fills an array with the next values.
+    void Fill(uint32_t * p, size_t count);
+
+    //! Skips ahead to the specified 128-bit block in the stream.
+    void Seek(uint64_t block);
+
+    //! Returns the minimum value returned by operator ()
+    static constexpr uint32_t min() { return 0; }
+
+    //! Returns the maximum value returned by operator ()
+    static constexpr uint32_t max() { return 0xffffffff; }
+
+private:
+
+    // Encrypts the current counter into m_Block and advances the counter
+    void Generate();
+
+    uint32_t m_Key[2];      // Seed
+    uint32_t m_Counter[4];  // Position in the stream (low half) and stream (high half)
+    uint32_t m_Block[4];    // Most recently generated values
+    int m_Index;            // Index of the next unused value in m_Block
+};
+
+//! A table for sampling a discrete distribution in constant time (Vose's alias method).
+
+class AliasTable
+{
+public:
+
+    //! Constructor.
+    AliasTable(double const * weights, int n);
+
+    //! Returns a value in [0, n) with the probability proportional to its weight.
+    int Sample(Philox & rng) const;
+
+    //! Returns the number of values.
+    int Size() const { return int(m_Alias.size()); }
+
+private:
+
+    std::vector<uint32_t> m_Threshold;  // Probability of keeping each value (scaled to 2^32)
+    std::vector<int> m_Alias;           // Value returned if a value is not kept
+};
+
+namespace MyMath
+{
+//! @name Distributions
+//@{
+
+//! Returns a value uniformly distributed in [0, n).
+uint32_t UniformInt(Philox & rng, uint32_t n);
+
+//! Returns a value uniformly distributed in [min, max).
+double Uniform(Philox & rng, double min, double max);
+
+//! Returns a normally-distributed value.
+double Normal(Philox & rng, double mean = 0.0, double sd = 1.0);
+
+//! Returns a binomially-distributed value.
+int Binomial(Philox & rng, int n, double p);
+
+//! Returns a Poisson-distributed value.
+int Poisson(Philox & rng, double mean);
+
+//@}
+
+//! @name Batch Distributions
+//@{
+
+//! Fills an array with values uniformly distributed in [0, 1).
+void Uniform(Philox & rng, float * p, size_t count);
+
+//! Fills an array with values uniformly distributed in [0, 1).
+void Uniform(Philox & rng, double * p, size_t count);
+
+//! Fills an array with normally-distributed values.
+void Normal(Philox & rng, float * p, size_t count, float mean = 0.0f, float sd = 1.0f);
+
+//! Fills an array with normally-distributed values.
+void Normal(Philox & rng, double * p, size_t count, double mean = 0.0, double sd = 1.0);
+
+//@}
+
+//! @name Geometric Sampling
+//@{
+
+//! Returns a point uniformly distributed on the surface of a sphere.
+Vector3 UniformOnSphere(Philox & rng, Sphere const & sphere);
+
+//! Returns a point uniformly distributed inside a sphere.
+Vector3 UniformInSphere(Philox & rng, Sphere const & sphere);
+
+//! Returns a point uniformly distributed inside an axis-aligned box.
+Vector3 UniformInBox(Philox & rng, AABox const & box);
+
+//! Returns a point uniformly distributed inside an oriented box.
+Vector3 UniformInBox(Philox & rng, Box const & box);
+
+//! Returns a direction uniformly distributed in the solid angle of a cone.
+Vector3 UniformDirectionInCone(Philox & rng, Cone const & cone);
+
+//! Returns a point uniformly distributed inside a cone truncated at a given height.
+Vector3 UniformInCone(Philox & rng, Cone const & cone, float height);
+
+//! Returns a point uniformly distributed on the surface of a convex polygon.
+Vector3 UniformOnPoly(Philox & rng, Poly const & poly);
+
+//@}
+} // namespace MyMath
+
+//@}
+
+#endif // !defined(MYMATH_RANDOM_H)
@@ -0,0 +1,100 @@
+#pragma once
+
+#if !defined(MYMATH_SEGMENTSOA_H)
+#define MYMATH_SEGMENTSOA_H
+
+#include "Line.h"
+#include "SoAStorage.h"
+
+#include <cstddef>
+
+class Plane;
+class PolyBuffer;
+
+//! An array of line segments stored as separate streams, with their bounding boxes.
+//!
+//! Each segment is stored as its endpoint at t = 0 and its direction (see Segment), and the corners of its
+//! axis-aligned bounding box are stored with it so batch tests can reject segments without computing them. The
+//! streams are aligned and padded (see MyMath::SoAStorage) so they can be given directly to SIMD kernels.
+//!
+//! Elements are read-only; use PushBack() or Load() to change them, so that the bounds stay consistent.
+//!
+//! @ingroup Geometry
+
+class SegmentSoA
+{
+public:
+
+    //! Indexes of the streams.
+    enum Stream
+    {
+        B_X, B_Y, B_Z,          //!< Endpoint at t = 0
+        M_X, M_Y, M_Z,          //!< Direction
+        MIN_X, MIN_Y, MIN_Z,    //!< Minimum corner of the bounding box
+        MAX_X, MAX_Y, MAX_Z,    //!< Maximum corner of the bounding box
+        NUM_STREAMS
+    };
+
+    //! Constructor.
+    SegmentSoA() = default;
+
+    //! Constructor.
+    SegmentSoA(Segment const * p, size_t n) { Load(p, n); }
+
+    //! Returns the number of elements.
+    size_t Size() const { return m_Storage.Size(); }
+
+    //! Returns the number of elements, including the padding.
+    size_t PaddedSize() const { return m_Storage.PaddedSize(); }
+
+    //! Makes room for at least n elements.
+    void Reserve(size_t n) { m_Storage.Reserve(n); }
+
+    //! Removes all the elements.
+    void Clear() { m_Storage.Resize(0); }
+
+    //! Appends an element.
+    void PushBack(Segment const & segment);
+
+    //! Returns the value of element i.
+    Segment operator [](size_t i) const;
+
+    //! Returns a stream.
+    float const * GetStream(Stream s) const { return m_Storage.GetStream(s); }
+
+    //! Replaces the elements with an array of segments.
+    void Load(Segment const * p, size_t n);
+
+private:
+
+    // Stores a segment in element i
+    void Set(size_t i, Segment const & segment);
+
+    MyMath::SoAStorage<NUM_STREAMS> m_Storage;
+};
+
+namespace MyMath
+{
+//! @name Segment Batch Tests
+//!
+//! These test one segment against many and return the indexes of the ones that are hit, in increasing order, along
+//! with the parameters of the hits. The arrays must have room for one entry per tested element. The parameter
+//! arrays may be nullptr.
+//@{
+
+//! Finds the segments in a set that intersect a segment.
+int Intersect(Segment const & segment, SegmentSoA const & segments, int * paIndices, float * paS, float * paT);
+
+//! Finds the polygons in a buffer that intersect a segment.
+int Intersect(Segment const & segment, PolyBuffer const & polys, int * paIndices, float * paT);
+
+//@}
+
+//! Returns true if two segments intersect.
+bool Intersect(Segment const & a, Segment const & b, float * pS, float * pT);
+
+//! Returns true if a segment intersects a convex polygon.
+bool Intersect(Segment const & segment, Plane const & plane, Vector3 const * paVertices, int nVertices, float * pT);
+} // namespace MyMath
+
+#endif // !defined(MYMATH_SEGMENTSOA_H)
@@ -0,0 +1,145 @@
+#pragma once
+
+#if !defined(MYMATH_SOASTORAGE_H)
+#define MYMATH_SOASTORAGE_H
+
+#include "Misc/Assertx.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace MyMath
+{
+//! An allocator that returns memory with the specified alignment.
+//!
+//! @param	T			Value type
+//! @param	ALIGNMENT	Alignment in bytes
+
+template <typename T, size_t ALIGNMENT>
+class AlignedAllocator
+{
+public:
+
+    using value_type = T;
+
+    //! Rebinds the allocator to another value type.
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, ALIGNMENT>;   //!< Allocator for U
+    };
+
+    AlignedAllocator() = default;
+
+    //! Conversion.
+    template <typename U>
+    AlignedAllocator(AlignedAllocator<U, ALIGNMENT> const &) {}
+
+    //! Allocates memory for n values.
+    T * allocate(size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(ALIGNMENT)));
+    }
+
+    //! Frees memory.
+    void deallocate(T * p, size_t)
+    {
+        ::operator delete(p, std::align_val_t(ALIGNMENT));
+    }
+};
+
+//! Returns true (all aligned allocators with the same alignment are interchangeable).
+template <typename T, typename U, size_t ALIGNMENT>
+bool operator ==(AlignedAllocator<T, ALIGNMENT> const &, AlignedAllocator<U, ALIGNMENT> const &)
+{
+    return true;
+}
+
+//! Returns false (all aligned allocators with the same alignment are interchangeable).
+template <typename T, typename U, size_t ALIGNMENT>
+bool operator !=(AlignedAllocator<T, ALIGNMENT> const &, AlignedAllocator<U, ALIGNMENT> const &)
+{
+    return false;
+}
+
+//! Storage for N streams of floats (structure of arrays).
+//!
+//! The streams are stored in one block. Each stream is aligned to ALIGNMENT bytes and padded to a multiple of
+//! PADDING values, so SIMD kernels can process the streams in whole registers without handling a remainder. The
+//! padding may be read and written freely; its values are unspecified.
+//!
+//! @param	N	Number of streams
+
+template <int N>
+class SoAStorage
+{
+public:
+
+    static size_t const ALIGNMENT = 32;    //!< Alignment of each stream in bytes (one AVX register)
+    static size_t const PADDING   = 8;     //!< Each stream is padded to a multiple of this number of values
+
+    //! Constructor.
+    SoAStorage() : m_Size(0), m_Capacity(0) {}
+
+    //! Returns the number of values in each stream.
+    size_t Size() const { return m_Size; }
+
+    //! Returns the number of values in each stream, including the padding.
+    size_t PaddedSize() const { return Pad(m_Size); }
+
+    //! Returns the number of values that can be stored in each stream without reallocating.
+    size_t Capacity() const { return m_Capacity; }
+
+    //! Returns stream i.
+    float * GetStream(int i) { assert(i >= 0 && i < N); return m_Data.data() + i * m_Capacity; }
+
+    //! Returns stream i.
+    float const * GetStream(int i) const { assert(i >= 0 && i < N); return m_Data.data() + i * m_Capacity; }
+
+    //! Sets the number of values in each stream. New values are 0.
+    void Resize(size_t n)
+    {
+        if (n > m_Capacity)
+            Reserve(std::max(n, 2 * m_Capacity));
+
+        for (int i = 0; i < N; ++i)
+        {
+            if (n > m_Size)
+                std::fill(GetStream(i) + m_Size, GetStream(i) + n, 0.0f);
+        }
+
+        m_Size = n;
+    }
+
+    //! Makes room for at least n values in each stream.
+    void Reserve(size_t n)
+    {
+        if (n <= m_Capacity)
+            return;
+
+        size_t const capacity = Pad(n);
+        std::vector<float, AlignedAllocator<float, ALIGNMENT> > data(N * capacity, 0.0f);
+
+        for (int i = 0; i < N; ++i)
+        {
+            std::copy(GetStream(i), GetStream(i) + m_Size, data.data() + i * capacity);
+        }
+
+        m_Data.swap(data);
+        m_Capacity = capacity;
+    }
+
+private:
+
+    // Returns n rounded up to a multiple of PADDING
+    static size_t Pad(size_t n) { return (n + PADDING - 1) & ~(PADDING - 1); }
+
+    std::vector<float, AlignedAllocator<float, ALIGNMENT> > m_Data;
+    size_t m_Size;      // Number of values in each stream
+    size_t m_Capacity;  // Number of values allocated for each stream (a multiple of PADDING)
+};
+} // namespace MyMath
+
+#endif // !defined(MYMATH_SOASTORAGE_H)
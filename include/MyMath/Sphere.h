@@ -33,6 +33,7 @@ public:
     virtual Result Intersects(Ray const & ray) const override             { return Intersectable::Intersects(*this, ray);       }
     virtual Result Intersects(Segment const & segment) const override     { return Intersectable::Intersects(*this, segment);   }
     virtual Result Intersects(Plane const & plane) const override         { return Intersectable::Intersects(*this, plane);     }
+    virtual Result Intersects(HalfSpace const & halfspace) const override { return Intersectable::Intersects(*this, halfspace); }
     virtual Result Intersects(Poly const & poly) const override           { return Intersectable::Intersects(*this, poly);      }
     virtual Result Intersects(Sphere const & sphere) const override       { return Intersectable::Intersects(*this, sphere);    }
     virtual Result Intersects(Cone const & cone) const override           { return Intersectable::Intersects(*this, cone);      }
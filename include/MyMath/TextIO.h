@@ -0,0 +1,168 @@
+#pragma once
+
+#if !defined(MYMATH_TEXTIO_H)
+#define MYMATH_TEXTIO_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+class Matrix43;
+class Matrix44;
+class Quaternion;
+class QuaternionSoA;
+class Vector2i;
+class Vector3;
+class Vector3i;
+class Vector3SoA;
+
+namespace MyMath
+{
+//! @defgroup TextIO Bulk Text I/O
+//!
+//! These read and write large amounts of text in the layout of the stream operators (e.g. operator >>(std::istream
+//! &, Vector3 &)): numbers separated by whitespace, with the components of each element in order. Matrices are
+//! written row by row.
+//!
+//! The numbers are converted with std::from_chars and std::to_chars, so they are not affected by the locale, and
+//! floats are written with the fewest digits that read back to the same value.
+//!
+//! @ingroup Vectors
+//@{
+
+//! Reads numbers from a text stream in chunks.
+//!
+//! Reading stops at the end of the stream or at the first token that is not a number. After that, Fail() tells
+//! which one it was.
+
+class TextReader
+{
+public:
+
+    //! Constructor.
+    explicit TextReader(std::istream & in, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    TextReader(TextReader const &) = delete;
+    TextReader & operator =(TextReader const &) = delete;
+
+    //! Reads up to n floats. Returns the number read.
+    size_t Read(float * p, size_t n);
+
+    //! Reads up to n ints. Returns the number read.
+    size_t Read(int * p, size_t n);
+
+    //! Reads up to n vectors. Returns the number of complete vectors read.
+    size_t Read(Vector3 * p, size_t n);
+
+    //! Reads up to n vectors. Returns the number of complete vectors read.
+    size_t Read(Vector2i * p, size_t n);
+
+    //! Reads up to n vectors. Returns the number of complete vectors read.
+    size_t Read(Vector3i * p, size_t n);
+
+    //! Reads up to n quaternions. Returns the number of complete quaternions read.
+    size_t Read(Quaternion * p, size_t n);
+
+    //! Reads up to n matrices. Returns the number of complete matrices read.
+    size_t Read(Matrix43 * p, size_t n);
+
+    //! Reads up to n matrices. Returns the number of complete matrices read.
+    size_t Read(Matrix44 * p, size_t n);
+
+    //! Appends up to n vectors to an array. Returns the number of complete vectors read.
+    size_t Read(Vector3SoA * pV, size_t n);
+
+    //! Appends up to n quaternions to an array. Returns the number of complete quaternions read.
+    size_t Read(QuaternionSoA * pQ, size_t n);
+
+    //! Returns true if reading stopped at a token that is not a number (rather than at the end of the stream).
+    bool Fail() const { return m_Fail; }
+
+    static size_t const DEFAULT_CHUNK_SIZE = 64 * 1024;   //!< Default number of characters read from the stream at once
+
+private:
+
+    // Finds the next token and returns its start and end, or false if there are none
+    bool NextToken(char const ** ppBegin, char const ** ppEnd);
+
+    // Reads more of the stream, keeping the unparsed characters. Returns false if nothing more was read.
+    bool Refill();
+
+    template <typename T>
+    size_t ReadNumbers(T * p, size_t n);
+
+    std::istream & m_In;
+    std::vector<char> m_Buffer;
+    size_t m_Begin;             // Start of the unparsed characters
+    size_t m_End;               // End of the characters in the buffer
+    bool m_Fail;
+};
+
+//! Writes numbers to a text stream through a buffer.
+//!
+//! Each element is written on a line of its own. The buffer is flushed when it is full, by Flush() and by the
+//! destructor.
+
+class TextWriter
+{
+public:
+
+    //! Constructor.
+    explicit TextWriter(std::ostream & out, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    //! Destructor. Flushes the buffer.
+    ~TextWriter() { Flush(); }
+
+    TextWriter(TextWriter const &) = delete;
+    TextWriter & operator =(TextWriter const &) = delete;
+
+    //! Writes n floats, one per line.
+    void Write(float const * p, size_t n);
+
+    //! Writes n ints, one per line.
+    void Write(int const * p, size_t n);
+
+    //! Writes n vectors.
+    void Write(Vector3 const * p, size_t n);
+
+    //! Writes n vectors.
+    void Write(Vector2i const * p, size_t n);
+
+    //! Writes n vectors.
+    void Write(Vector3i const * p, size_t n);
+
+    //! Writes n quaternions.
+    void Write(Quaternion const * p, size_t n);
+
+    //! Writes n matrices.
+    void Write(Matrix43 const * p, size_t n);
+
+    //! Writes n matrices.
+    void Write(Matrix44 const * p, size_t n);
+
+    //! Writes the elements of an array.
+    void Write(Vector3SoA const & v);
+
+    //! Writes the elements of an array.
+    void Write(QuaternionSoA const & q);
+
+    //! Writes the buffer to the stream.
+    void Flush();
+
+    static size_t const DEFAULT_BUFFER_SIZE = 64 * 1024;  //!< Default size of the buffer
+
+private:
+
+    // Writes an element of n numbers separated by spaces and ending with a newline
+    template <typename T>
+    void WriteLine(T const * p, size_t n);
+
+    std::ostream & m_Out;
+    std::vector<char> m_Buffer;
+    size_t m_Size;              // Number of characters in the buffer
+};
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_TEXTIO_H)
@@ -0,0 +1,128 @@
+#pragma once
+
+#if !defined(MYMATH_TRIANGLEMESH_H)
+#define MYMATH_TRIANGLEMESH_H
+
+#include "Vector3.h"
+
+#include <vector>
+
+class AABox;
+class Frustum;
+class Ray;
+class Sphere;
+
+//! Eight triangles stored as a structure of arrays for testing them together.
+//!
+//! Each triangle is stored as a vertex and two edges (V1 - V0 and V2 - V0). Unused lanes have zero-length edges
+//! and an index of -1, and never intersect anything.
+//!
+//! @ingroup Geometry
+
+struct alignas(32) TrianglePacket8
+{
+    static int const SIZE = 8;  //!< Number of triangles in a packet
+
+    float m_V0[3][SIZE];        //!< First vertices (x, y and z streams)
+    float m_E1[3][SIZE];        //!< First edges
+    float m_E2[3][SIZE];        //!< Second edges
+    int m_Index[SIZE];          //!< Indexes of the triangles (or -1)
+};
+
+//! An indexed triangle mesh with a bounding volume hierarchy for ray, closest-point, sphere-sweep and frustum
+//! queries.
+//!
+//! The mesh owns copies of its vertex and index buffers. The hierarchy is built by the constructor. Each leaf holds
+//! up to 8 triangles in a TrianglePacket8, so a leaf is tested with one 8-wide test.
+//!
+//! @ingroup Geometry
+
+class TriangleMesh
+{
+public:
+
+    //! The result of a ray or sweep query.
+    struct Hit
+    {
+        int m_Triangle;     //!< Index of the triangle that was hit
+        float m_T;          //!< Distance along the ray or sweep direction
+        float m_U;          //!< Barycentric coordinate of the hit point (weight of vertex 1)
+        float m_V;          //!< Barycentric coordinate of the hit point (weight of vertex 2)
+    };
+
+    //! Constructor.
+    TriangleMesh(Vector3 const * paVertices, int nVertices, int const * paIndices, int nTriangles);
+
+    //! Returns the number of vertices.
+    int GetVertexCount() const { return int(m_Vertices.size()); }
+
+    //! Returns the number of triangles.
+    int GetTriangleCount() const { return int(m_Indices.size() / 3); }
+
+    //! Returns a vertex.
+    Vector3 const & GetVertex(int i) const { return m_Vertices[i]; }
+
+    //! Returns the index buffer (3 indexes per triangle).
+    int const * GetIndices() const { return m_Indices.data(); }
+
+    //! Returns a bounding box of the mesh.
+    AABox GetBounds() const;
+
+    //! Finds the nearest triangle hit by a ray.
+    bool Raycast(Ray const & ray, float maxT, Hit * pHit) const;
+
+    //! Returns true if a ray hits any triangle.
+    bool AnyHit(Ray const & ray, float maxT) const;
+
+    //! Returns the point on the mesh closest to a point.
+    Vector3 ClosestPoint(Vector3 const & point, int * pTriangle = nullptr) const;
+
+    //! Finds the first triangle touched by a moving sphere.
+    bool SphereSweep(Sphere const & sphere, Vector3 const & direction, float maxT, Hit * pHit) const;
+
+    //! Finds the triangles that overlap a frustum.
+    void Overlaps(Frustum const & frustum, std::vector<int> * pTriangles) const;
+
+private:
+
+    // A node of the hierarchy. If m_Count is 0, the node is interior, its first child follows it and m_Offset is the
+    // index of its second child. Otherwise, the node is a leaf with m_Count triangles in packet m_Offset.
+    struct Node
+    {
+        Vector3 m_Bounds[2];
+        int m_Offset;
+        int m_Count;
+    };
+
+    // Builds the subtree for triangles [first, last) of m_Order and returns the index of its root
+    int Build(int first, int last, std::vector<Vector3> const & centroids);
+
+    // Returns the vertices of a triangle
+    void GetTriangle(int i, Vector3 * pV0, Vector3 * pV1, Vector3 * pV2) const;
+
+    std::vector<Vector3> m_Vertices;            // Vertex buffer
+    std::vector<int> m_Indices;                 // Index buffer
+    std::vector<Node> m_Nodes;                  // Hierarchy (the root is node 0)
+    std::vector<TrianglePacket8> m_Packets;     // Triangles of the leaves
+    std::vector<int> m_Order;                   // Triangle indexes, in leaf order (used while building)
+};
+
+namespace MyMath
+{
+//! @name Ray-Triangle Intersection
+//@{
+
+//! Intersects a ray with a triangle (Moller-Trumbore).
+bool Intersect(Ray const & ray, Vector3 const & v0, Vector3 const & v1, Vector3 const & v2, float maxT,
+               float * pT, float * pU, float * pV);
+
+//! Intersects a ray with 8 triangles and returns the lane of the nearest hit, or -1.
+int Intersect(Ray const & ray, TrianglePacket8 const & packet, float maxT, float * pT, float * pU, float * pV);
+
+//! Returns the point on a triangle closest to a point.
+Vector3 ClosestPointOnTriangle(Vector3 const & point, Vector3 const & v0, Vector3 const & v1, Vector3 const & v2);
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_TRIANGLEMESH_H)
@@ -0,0 +1,150 @@
+#pragma once
+
+#if !defined(MYMATH_VECTOR3SOA_H)
+#define MYMATH_VECTOR3SOA_H
+
+#include "SoAStorage.h"
+#include "Vector3.h"
+
+#include <cstddef>
+
+class Matrix43;
+class Quaternion;
+
+//! An array of 3D vectors of floats stored as separate x, y and z streams.
+//!
+//! Elements are accessed through a proxy that has the same members as Vector3. The streams are aligned and padded
+//! (see MyMath::SoAStorage) so they can be given directly to SIMD kernels.
+//!
+//! @ingroup Vectors
+
+class Vector3SoA
+{
+public:
+
+    //! A reference to an element.
+    class Reference
+    {
+    public:
+
+        //! Constructor.
+        Reference(float & x, float & y, float & z) : m_X(x), m_Y(y), m_Z(z) {}
+
+        //! Assigns a vector to the element.
+        Reference & operator =(Vector3 const & v)
+        {
+            m_X = v.m_X;
+            m_Y = v.m_Y;
+            m_Z = v.m_Z;
+            return *this;
+        }
+
+        //! Assigns the value of another element to the element.
+        Reference & operator =(Reference const & r) { return operator =(Vector3(r)); }
+
+        //! Returns the value of the element.
+        operator Vector3() const { return Vector3(m_X, m_Y, m_Z); }
+
+        float & m_X;    //!< X
+        float & m_Y;    //!< Y
+        float & m_Z;    //!< Z
+    };
+
+    //! Constructor.
+    Vector3SoA() = default;
+
+    //! Constructor. The elements are 0.
+    explicit Vector3SoA(size_t n) { Resize(n); }
+
+    //! Constructor.
+    Vector3SoA(Vector3 const * p, size_t n) { Load(p, n); }
+
+    //! Returns the number of elements.
+    size_t Size() const { return m_Storage.Size(); }
+
+    //! Returns the number of elements, including the padding.
+    size_t PaddedSize() const { return m_Storage.PaddedSize(); }
+
+    //! Sets the number of elements. New elements are 0.
+    void Resize(size_t n) { m_Storage.Resize(n); }
+
+    //! Makes room for at least n elements.
+    void Reserve(size_t n) { m_Storage.Reserve(n); }
+
+    //! Removes all the elements.
+    void Clear() { m_Storage.Resize(0); }
+
+    //! Appends an element.
+    void PushBack(Vector3 const & v);
+
+    //! Returns a reference to element i.
+    Reference operator [](size_t i) { return Reference(GetX()[i], GetY()[i], GetZ()[i]); }
+
+    //! Returns the value of element i.
+    Vector3 operator [](size_t i) const { return Vector3(GetX()[i], GetY()[i], GetZ()[i]); }
+
+    //! Returns the X stream.
+    float * GetX() { return m_Storage.GetStream(0); }
+
+    //! Returns the Y stream.
+    float * GetY() { return m_Storage.GetStream(1); }
+
+    //! Returns the Z stream.
+    float * GetZ() { return m_Storage.GetStream(2); }
+
+    //! Returns the X stream.
+    float const * GetX() const { return m_Storage.GetStream(0); }
+
+    //! Returns the Y stream.
+    float const * GetY() const { return m_Storage.GetStream(1); }
+
+    //! Returns the Z stream.
+    float const * GetZ() const { return m_Storage.GetStream(2); }
+
+    //! Replaces the elements with an array of vectors.
+    void Load(Vector3 const * p, size_t n);
+
+    //! Stores the elements in an array of vectors.
+    void Store(Vector3 * p) const;
+
+private:
+
+    MyMath::SoAStorage<3> m_Storage;
+};
+
+namespace MyMath
+{
+//! @name Vector3SoA Operations
+//!
+//! These operate on every element. The result may be one of the operands. The result is resized to the size of the
+//! operands, which must be the same.
+//@{
+
+//! Computes a + b.
+void Add(Vector3SoA const & a, Vector3SoA const & b, Vector3SoA * pR);
+
+//! Computes a - b.
+void Subtract(Vector3SoA const & a, Vector3SoA const & b, Vector3SoA * pR);
+
+//! Computes a * s.
+void Scale(Vector3SoA const & a, float s, Vector3SoA * pR);
+
+//! Computes the dot products of the elements. @a pR must have room for a.Size() values.
+void Dot(Vector3SoA const & a, Vector3SoA const & b, float * pR);
+
+//! Computes the cross products of the elements.
+void Cross(Vector3SoA const & a, Vector3SoA const & b, Vector3SoA * pR);
+
+//! Normalizes the elements.
+void Normalize(Vector3SoA const & a, Vector3SoA * pR);
+
+//! Transforms the elements by a matrix (see Vector3::Transform(Matrix43 const &)).
+void Transform(Vector3SoA const & a, Matrix43 const & m, Vector3SoA * pR);
+
+//! Rotates the elements by a quaternion (see Vector3::Rotate(Quaternion const &)).
+void Rotate(Vector3SoA const & a, Quaternion const & q, Vector3SoA * pR);
+
+//@}
+} // namespace MyMath
+
+#endif // !defined(MYMATH_VECTOR3SOA_H)
@@ -0,0 +1,390 @@
+/********************************************************************************************************************
+
+                                                  BinaryFileTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	Files are written with BinaryFileWriter and mapped with BinaryFileReader, and every record must come back with
+	the same bits, including infinities, NaNs and negative zeros. Files from a later version (with a longer header
+	and chunks of an unknown type) must be readable, and truncated or corrupt files must be rejected without reading
+	outside the file. The files are written to a temporary file in the current directory.
+
+ ********************************************************************************************************************/
+
+#include "BinaryFileTest.h"
+
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/Quaternion.h"
+#include "../include/MyMath/Sphere.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( BinaryFileTest );
+
+using namespace MyMath;
+
+static char const	PATH[]	= "BinaryFileTest.tmp";
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 97531;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+static Vector3 RandomVector( float scale )
+{
+	return Vector3( Random() * scale, Random() * scale, Random() * scale );
+}
+
+// Returns true if two objects have the same bits
+template< typename T >
+static bool IsSame( T const & a, T const & b )
+{
+	return std::memcmp( &a, &b, sizeof( T ) ) == 0;
+}
+
+// Returns the contents of a file as written by a writer
+static std::string ToBytes( BinaryFileWriter const & writer )
+{
+	std::ostringstream	out( std::ios::binary );
+	CPPUNIT_ASSERT( writer.Write( out ) );
+	return out.str();
+}
+
+// Writes bytes to the temporary file
+static void WriteBytes( std::string const & bytes )
+{
+	std::ofstream	out( PATH, std::ios::binary | std::ios::trunc );
+	out.write( bytes.data(), std::streamsize( bytes.size() ) );
+	CPPUNIT_ASSERT( out.good() );
+}
+
+// Appends a little-endian value
+template< typename T >
+static void Append( std::string * pBytes, T value )
+{
+	for ( size_t i = 0; i < sizeof( T ); ++i )
+	{
+		pBytes->push_back( char( ( value >> ( 8 * i ) ) & 0xff ) );
+	}
+}
+
+// Overwrites a little-endian value
+template< typename T >
+static void Poke( std::string * pBytes, size_t offset, T value )
+{
+	for ( size_t i = 0; i < sizeof( T ); ++i )
+	{
+		( *pBytes )[ offset + i ] = char( ( value >> ( 8 * i ) ) & 0xff );
+	}
+}
+
+// Returns true if the records of a chunk are the same as an array
+template< typename T >
+static bool HasRecords( BinaryFileReader const & reader, int chunk, T const * p, size_t n )
+{
+	if ( reader.GetChunkType( chunk ) != ChunkTypeOf< T >::VALUE )
+	{
+		return false;
+	}
+
+	Span< T > const	records	= reader.GetChunk< T >( chunk );
+	if ( records.Size() != n || reinterpret_cast< uintptr_t >( records.Data() ) % FILE_ALIGNMENT != 0 )
+	{
+		return false;
+	}
+	for ( size_t i = 0; i < n; ++i )
+	{
+		if ( !IsSame( records[ i ], p[ i ] ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void BinaryFileTest::tearDown()
+{
+	std::remove( PATH );
+}
+
+void BinaryFileTest::TestRoundTrip()
+{
+	std::vector< Vector3 >		vectors;
+	std::vector< Quaternion >	quaternions;
+	std::vector< Matrix43 >		matrices43;
+	std::vector< Matrix44 >		matrices44;
+	std::vector< AABox >		aaboxes;
+	std::vector< Sphere >		spheres;
+	std::vector< Box >			boxes;
+
+	// Odd numbers of records, so the chunks need padding
+	for ( int i = 0; i < 37; ++i )
+	{
+		Quaternion	q( Random(), Random(), Random(), Random() );
+		q.Normalize();
+
+		vectors.push_back( RandomVector( 100.0f ) );
+		quaternions.push_back( q );
+		matrices43.push_back( Matrix43( q.GetRotationMatrix33(), RandomVector( 10.0f ) ) );
+		matrices44.push_back( Matrix44( matrices43.back() ) );
+		aaboxes.push_back( AABox( RandomVector( 10.0f ), RandomVector( 5.0f ) ) );
+		spheres.push_back( Sphere( RandomVector( 10.0f ), std::fabs( Random() ) * 5.0f ) );
+		boxes.push_back( Box( q.GetRotationMatrix33(), RandomVector( 10.0f ), Vector3( 1.0f, -2.0f, 3.0f ) ) );
+	}
+
+	BinaryFileWriter	writer;
+	writer.Add( vectors.data(), 37 );
+	writer.Add( quaternions.data(), 5 );
+	writer.Add( matrices43.data(), 3 );
+	writer.Add( matrices44.data(), 7 );
+	writer.Add( aaboxes.data(), 37 );
+	writer.Add( spheres.data(), 11 );
+	writer.Add( boxes.data(), 13 );
+	writer.Add( vectors.data() + 1, 2 );
+	CPPUNIT_ASSERT( writer.Write( PATH ) );
+
+	BinaryFileReader	reader;
+	CPPUNIT_ASSERT( reader.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( 8, reader.GetChunkCount() );
+
+	CPPUNIT_ASSERT( HasRecords( reader, 0, vectors.data(), 37 ) );
+	CPPUNIT_ASSERT( HasRecords( reader, 1, quaternions.data(), 5 ) );
+	CPPUNIT_ASSERT( HasRecords( reader, 2, matrices43.data(), 3 ) );
+	CPPUNIT_ASSERT( HasRecords( reader, 3, matrices44.data(), 7 ) );
+	CPPUNIT_ASSERT( HasRecords( reader, 7, vectors.data() + 1, 2 ) );
+
+	// The geometry classes are stored as records
+	Span< AABoxRecord > const	aaboxRecords	= reader.GetChunk< AABoxRecord >( 4 );
+	Span< SphereRecord > const	sphereRecords	= reader.GetChunk< SphereRecord >( 5 );
+	Span< BoxRecord > const		boxRecords		= reader.GetChunk< BoxRecord >( 6 );
+	CPPUNIT_ASSERT_EQUAL( size_t( 37 ), aaboxRecords.Size() );
+	CPPUNIT_ASSERT_EQUAL( size_t( 11 ), sphereRecords.Size() );
+	CPPUNIT_ASSERT_EQUAL( size_t( 13 ), boxRecords.Size() );
+
+	for ( size_t i = 0; i < aaboxRecords.Size(); ++i )
+	{
+		AABox const	aabox	= aaboxRecords[ i ].ToAABox();
+		CPPUNIT_ASSERT( IsSame( aaboxes[ i ].m_Position, aabox.m_Position ) );
+		CPPUNIT_ASSERT( IsSame( aaboxes[ i ].m_Scale, aabox.m_Scale ) );
+	}
+	for ( size_t i = 0; i < sphereRecords.Size(); ++i )
+	{
+		Sphere const	sphere	= sphereRecords[ i ].ToSphere();
+		CPPUNIT_ASSERT( IsSame( spheres[ i ].m_C, sphere.m_C ) );
+		CPPUNIT_ASSERT( IsSame( spheres[ i ].m_R, sphere.m_R ) );
+	}
+	for ( size_t i = 0; i < boxRecords.Size(); ++i )
+	{
+		Box const	box	= boxRecords[ i ].ToBox();
+		CPPUNIT_ASSERT( IsSame( boxes[ i ].m_InverseOrientation, box.m_InverseOrientation ) );
+		CPPUNIT_ASSERT( IsSame( boxes[ i ].m_Position, box.m_Position ) );
+		CPPUNIT_ASSERT( IsSame( boxes[ i ].m_Scale, box.m_Scale ) );
+	}
+
+	// Finding chunks by type
+	CPPUNIT_ASSERT_EQUAL( 0, reader.FindChunk( ChunkType::VECTOR3 ) );
+	CPPUNIT_ASSERT_EQUAL( 7, reader.FindChunk( ChunkType::VECTOR3, 1 ) );
+	CPPUNIT_ASSERT_EQUAL( -1, reader.FindChunk( ChunkType::VECTOR3, 8 ) );
+	CPPUNIT_ASSERT_EQUAL( 6, reader.FindChunk( ChunkType::BOX ) );
+
+	// Writing to a stream gives the same file
+	std::ifstream		in( PATH, std::ios::binary );
+	std::string const	file( ( std::istreambuf_iterator< char >( in ) ), std::istreambuf_iterator< char >() );
+	CPPUNIT_ASSERT( file == ToBytes( writer ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), file.size() % FILE_ALIGNMENT );
+
+	reader.Close();
+	CPPUNIT_ASSERT_EQUAL( 0, reader.GetChunkCount() );
+}
+
+void BinaryFileTest::TestEmpty()
+{
+	BinaryFileReader	reader;
+
+	// A file with no chunks
+	BinaryFileWriter	writer;
+	CPPUNIT_ASSERT( writer.Write( PATH ) );
+	CPPUNIT_ASSERT( reader.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( 0, reader.GetChunkCount() );
+	CPPUNIT_ASSERT_EQUAL( -1, reader.FindChunk( ChunkType::VECTOR3 ) );
+
+	// Empty chunks, including the last one
+	Vector3 const	v( 1.0f, 2.0f, 3.0f );
+	writer.Add( &v, 0 );
+	writer.Add( &v, 1 );
+	writer.Add( static_cast< Sphere const * >( nullptr ), 0 );
+	CPPUNIT_ASSERT( writer.Write( PATH ) );
+	CPPUNIT_ASSERT( reader.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( 3, reader.GetChunkCount() );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.GetChunk< Vector3 >( 0 ).Size() );
+	CPPUNIT_ASSERT( HasRecords( reader, 1, &v, 1 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.GetChunk< SphereRecord >( 2 ).Size() );
+	CPPUNIT_ASSERT( reader.GetChunk< SphereRecord >( 2 ).begin() == reader.GetChunk< SphereRecord >( 2 ).end() );
+
+	// An empty file, and one that doesn't exist
+	WriteBytes( std::string() );
+	CPPUNIT_ASSERT( !reader.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( 0, reader.GetChunkCount() );
+	std::remove( PATH );
+	CPPUNIT_ASSERT( !reader.Open( PATH ) );
+}
+
+void BinaryFileTest::TestSpecialValues()
+{
+	float const		inf		= std::numeric_limits< float >::infinity();
+	float const		nan		= std::numeric_limits< float >::quiet_NaN();
+	float const		denorm	= std::numeric_limits< float >::denorm_min();
+	float const		max		= std::numeric_limits< float >::max();
+	Vector3 const	vectors[]	= { Vector3( inf, -inf, nan ), Vector3( -0.0f, 0.0f, -nan ),
+									Vector3( denorm, -denorm, max ), Vector3( -max, 1.0e-38f, -1.0f ) };
+
+	BinaryFileWriter	writer;
+	writer.Add( vectors, 4 );
+	CPPUNIT_ASSERT( writer.Write( PATH ) );
+
+	BinaryFileReader	reader;
+	CPPUNIT_ASSERT( reader.Open( PATH ) );
+	CPPUNIT_ASSERT( HasRecords( reader, 0, vectors, 4 ) );
+	CPPUNIT_ASSERT( std::signbit( reader.GetChunk< Vector3 >( 0 )[ 1 ].m_X ) );
+	CPPUNIT_ASSERT( std::isnan( reader.GetChunk< Vector3 >( 0 )[ 0 ].m_Z ) );
+}
+
+void BinaryFileTest::TestLaterVersion()
+{
+	// A version 7 file with 8 extra bytes of header, a chunk of an unknown type with 20-byte records, and a chunk of
+	// vectors
+	Vector3 const	v[ 2 ]	= { Vector3( 1.0f, 2.0f, 3.0f ), Vector3( -4.0f, -5.0f, -6.0f ) };
+	uint32_t const	headerSize	= 24;
+
+	std::string	bytes( "MYMB" );
+	Append< uint32_t >( &bytes, 7 );
+	Append< uint32_t >( &bytes, 2 );
+	Append< uint32_t >( &bytes, headerSize );
+	Append< uint64_t >( &bytes, 0x0123456789abcdefull );
+
+	Append< uint32_t >( &bytes, 1000 );
+	Append< uint32_t >( &bytes, 20 );
+	Append< uint64_t >( &bytes, 3 );
+	Append< uint64_t >( &bytes, 96 );
+
+	Append< uint32_t >( &bytes, uint32_t( ChunkType::VECTOR3 ) );
+	Append< uint32_t >( &bytes, uint32_t( sizeof( Vector3 ) ) );
+	Append< uint64_t >( &bytes, 2 );
+	Append< uint64_t >( &bytes, 160 );
+
+	bytes.resize( 96, '\0' );
+	bytes.append( 60, '\x55' );
+	bytes.resize( 160, '\0' );
+	bytes.append( reinterpret_cast< char const * >( v ), sizeof( v ) );
+
+	WriteBytes( bytes );
+
+	BinaryFileReader	reader;
+	CPPUNIT_ASSERT( reader.Open( PATH ) );
+	CPPUNIT_ASSERT_EQUAL( 2, reader.GetChunkCount() );
+	CPPUNIT_ASSERT( reader.GetChunkType( 0 ) == ChunkType( 1000 ) );
+	CPPUNIT_ASSERT_EQUAL( 1, reader.FindChunk( ChunkType::VECTOR3 ) );
+	CPPUNIT_ASSERT( HasRecords( reader, 1, v, 2 ) );
+
+	// The unknown chunk must still fit in the file
+	Poke< uint64_t >( &bytes, headerSize + 8, 5 );
+	WriteBytes( bytes );
+	CPPUNIT_ASSERT( !reader.Open( PATH ) );
+}
+
+void BinaryFileTest::TestTruncated()
+{
+	Vector3 const	v[ 3 ]	= { Vector3( 1.0f, 2.0f, 3.0f ), Vector3( 4.0f, 5.0f, 6.0f ), Vector3( 7.0f, 8.0f, 9.0f ) };
+	Sphere const	s( Vector3( 1.0f, 1.0f, 1.0f ), 2.0f );
+
+	BinaryFileWriter	writer;
+	writer.Add( v, 3 );
+	writer.Add( &s, 1 );
+	std::string const	bytes	= ToBytes( writer );
+
+	// The file is valid only if every chunk's data is in it. The padding after the last chunk may be missing.
+	BinaryFileReader	reader;
+	CPPUNIT_ASSERT( reader.Open( PATH ) == false );
+	WriteBytes( bytes );
+	CPPUNIT_ASSERT( reader.Open( PATH ) );
+	// The header and table take 64 bytes, the vectors start at 64 and the sphere starts at 128
+	size_t const	end	= 128 + sizeof( SphereRecord );
+
+	for ( size_t size = 0; size < bytes.size(); ++size )
+	{
+		WriteBytes( bytes.substr( 0, size ) );
+		bool const	valid	= reader.Open( PATH );
+		CPPUNIT_ASSERT_EQUAL( size >= end, valid );
+		if ( valid )
+		{
+			CPPUNIT_ASSERT( HasRecords( reader, 0, v, 3 ) );
+			CPPUNIT_ASSERT( IsSame( s.m_C, reader.GetChunk< SphereRecord >( 1 )[ 0 ].ToSphere().m_C ) );
+		}
+	}
+}
+
+void BinaryFileTest::TestCorrupt()
+{
+	Vector3 const		v[ 2 ]	= { Vector3( 1.0f, 2.0f, 3.0f ), Vector3( 4.0f, 5.0f, 6.0f ) };
+	BinaryFileWriter	writer;
+	writer.Add( v, 2 );
+	std::string const	bytes	= ToBytes( writer );
+	BinaryFileReader	reader;
+
+	struct Corruption
+	{
+		size_t		m_Offset;
+		uint64_t	m_Value;
+		size_t		m_Size;
+	};
+
+	// Offsets of the fields of the header (16 bytes) and the table entry (24 bytes). The data is at 64 and the file
+	// is 96 bytes long.
+	Corruption const	corruptions[]	=
+	{
+		{ 0,	0x424d594e,					4 },	// Magic ("NYMB")
+		{ 4,	0,							4 },	// Version 0
+		{ 8,	2,							4 },	// More chunks than the table holds
+		{ 8,	0xffffffff,					4 },
+		{ 12,	8,							4 },	// Header smaller than version 1's
+		{ 12,	0xfffffff0,					4 },	// Header beyond the file
+		{ 20,	16,							4 },	// Wrong record size for the type
+		{ 20,	0,							4 },
+		{ 24,	3,							8 },	// More records than the file holds
+		{ 24,	0xffffffffffffffffull,		8 },
+		{ 32,	48,							8 },	// Misaligned data
+		{ 32,	96,							8 },	// Data past the end of the file
+		{ 32,	0xffffffffffffffe0ull,		8 },
+	};
+
+	WriteBytes( bytes );
+	CPPUNIT_ASSERT( reader.Open( PATH ) );
+
+	for ( Corruption const & corruption : corruptions )
+	{
+		std::string	corrupt	= bytes;
+		if ( corruption.m_Size == 4 )
+		{
+			Poke< uint32_t >( &corrupt, corruption.m_Offset, uint32_t( corruption.m_Value ) );
+		}
+		else
+		{
+			Poke< uint64_t >( &corrupt, corruption.m_Offset, corruption.m_Value );
+		}
+		WriteBytes( corrupt );
+		CPPUNIT_ASSERT( !reader.Open( PATH ) );
+		CPPUNIT_ASSERT_EQUAL( 0, reader.GetChunkCount() );
+	}
+}
@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                   BinaryFileTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/BinaryFile.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class BinaryFileTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( BinaryFileTest );
+	CPPUNIT_TEST( TestRoundTrip );
+	CPPUNIT_TEST( TestEmpty );
+	CPPUNIT_TEST( TestSpecialValues );
+	CPPUNIT_TEST( TestLaterVersion );
+	CPPUNIT_TEST( TestTruncated );
+	CPPUNIT_TEST( TestCorrupt );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void tearDown() override;
+
+	void TestRoundTrip();
+	void TestEmpty();
+	void TestSpecialValues();
+	void TestLaterVersion();
+	void TestTruncated();
+	void TestCorrupt();
+};
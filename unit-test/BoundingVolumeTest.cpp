@@ -0,0 +1,338 @@
+/********************************************************************************************************************
+
+                                                BoundingVolumeTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	Every volume must contain all of its points according to the library's own intersection tests, both near the
+	origin and far from it. The minimal sphere is compared against a brute-force search over the spheres through 2,
+	3 and 4 of the points. Transformed volumes must contain the transformed points of the original volumes, including
+	for matrices that shear.
+
+ ********************************************************************************************************************/
+
+#include "BoundingVolumeTest.h"
+
+#include "../include/MyMath/BoundingVolume.h"
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/Matrix43.h"
+#include "../include/MyMath/Matrix43SoA.h"
+#include "../include/MyMath/Parallel.h"
+#include "../include/MyMath/Point.h"
+#include "../include/MyMath/Quaternion.h"
+#include "../include/MyMath/Sphere.h"
+#include "../include/MyMath/Vector3d.h"
+#include "../include/MyMath/Vector3SoA.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( BoundingVolumeTest );
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 54321;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+// Returns a set of points in a randomly oriented slab around a point. Every 5th set is flat.
+static std::vector< Vector3 > RandomPoints( size_t n, Vector3 const & offset, int set )
+{
+	Quaternion	q( Random(), Random(), Random(), Random() );
+	q.Normalize();
+	Matrix33 const	rotation	= q.GetRotationMatrix33();
+	float const		thickness	= ( set % 5 == 0 ) ? 0.0f : 0.3f;
+
+	std::vector< Vector3 >	points( n );
+	for ( Vector3 & p : points )
+	{
+		p = Vector3( Random() * 3.0f, Random(), Random() * thickness ) * rotation + offset;
+	}
+	return points;
+}
+
+static bool Contains( Sphere const & sphere, Vector3 const & point )
+{
+	return ( point - sphere.m_C ).Length() <= sphere.m_R;
+}
+
+static bool Contains( Intersectable const & volume, Vector3 const & point )
+{
+	Point const	p( point );
+	return volume.IntersectedBy( &p ) != Intersectable::NO_INTERSECTION;
+}
+
+// Returns the radius of the smallest sphere through 2, 3 or 4 of the points that encloses all of them
+static double BruteForceMinimalRadius( std::vector< Vector3 > const & points )
+{
+	size_t const	n		= points.size();
+	double			best	= std::numeric_limits<double>::infinity();
+
+	auto const	consider	= [ & ]( Vector3d const & c, double r )
+	{
+		for ( Vector3 const & p : points )
+		{
+			if ( ( Vector3d( p.m_X, p.m_Y, p.m_Z ) - c ).Length() > r * ( 1.0 + 1.0e-9 ) )
+				return;
+		}
+		best = std::min( best, r );
+	};
+
+	std::vector< Vector3d >	p;
+	for ( Vector3 const & v : points )
+	{
+		p.push_back( Vector3d( v.m_X, v.m_Y, v.m_Z ) );
+	}
+
+	for ( size_t i = 0; i < n; ++i )
+	{
+		for ( size_t j = i + 1; j < n; ++j )
+		{
+			consider( ( p[ i ] + p[ j ] ) * 0.5, ( p[ j ] - p[ i ] ).Length() * 0.5 );
+
+			for ( size_t k = j + 1; k < n; ++k )
+			{
+				Vector3d const	u	= p[ i ] - p[ k ];
+				Vector3d const	v	= p[ j ] - p[ k ];
+				Vector3d const	w	= Cross( u, v );
+				if ( w.Length2() < 1.0e-12 )
+					continue;
+
+				Vector3d const	c3	= p[ k ] + Cross( v * u.Length2() - u * v.Length2(), w ) * ( 0.5 / w.Length2() );
+				consider( c3, ( c3 - p[ k ] ).Length() );
+
+				for ( size_t l = k + 1; l < n; ++l )
+				{
+					Vector3d const	a	= p[ i ] - p[ l ];
+					Vector3d const	b	= p[ j ] - p[ l ];
+					Vector3d const	c	= p[ k ] - p[ l ];
+					double const	det	= Dot( a, Cross( b, c ) );
+					if ( std::fabs( det ) < 1.0e-9 )
+						continue;
+
+					Vector3d const	c4	= p[ l ] + ( Cross( b, c ) * a.Length2() + Cross( c, a ) * b.Length2()
+													 + Cross( a, b ) * c.Length2() ) * ( 0.5 / det );
+					consider( c4, ( c4 - p[ l ] ).Length() );
+				}
+			}
+		}
+	}
+
+	return best;
+}
+
+void BoundingVolumeTest::TestContainment()
+{
+	MyMath::TaskScheduler	scheduler( 4 );
+	Vector3 const			offsets[ 2 ]	= { Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 1000.0f, -1000.0f, 1000.0f ) };
+
+	for ( Vector3 const & offset : offsets )
+	{
+		for ( int set = 0; set < 40; ++set )
+		{
+			size_t const			n		= ( set < 20 ) ? 1000 : 20000;
+			std::vector< Vector3 >	points	= RandomPoints( n, offset, set );
+			Vector3SoA const		soa( points.data(), n );
+
+			AABox const		aaboxes[]	=
+			{
+				MyMath::ComputeAABox( points.data(), n ),
+				MyMath::ComputeAABox( scheduler, points.data(), n ),
+				MyMath::ComputeAABox( soa )
+			};
+			Sphere const	spheres[]	=
+			{
+				MyMath::ComputeBoundingSphere( points.data(), n ),
+				MyMath::ComputeBoundingSphere( scheduler, points.data(), n ),
+				MyMath::ComputeMinimalSphere( points.data(), n ),
+				MyMath::ComputeMinimalSphere( scheduler, points.data(), n )
+			};
+			Box const		boxes[]		=
+			{
+				MyMath::ComputeBox( points.data(), n ),
+				MyMath::ComputeBox( scheduler, points.data(), n ),
+				MyMath::ComputeBox( Matrix33::Identity(), points.data(), n ),
+				MyMath::ComputeBox( scheduler, Matrix33::Identity(), points.data(), n )
+			};
+
+			for ( Vector3 const & p : points )
+			{
+				for ( AABox const & aabox : aaboxes )
+				{
+					CPPUNIT_ASSERT( Contains( aabox, p ) );
+				}
+				for ( Sphere const & sphere : spheres )
+				{
+					CPPUNIT_ASSERT( Contains( sphere, p ) );
+				}
+				for ( Box const & box : boxes )
+				{
+					CPPUNIT_ASSERT( Contains( box, p ) );
+				}
+			}
+
+			// The minimal sphere is no larger than Ritter's, and the serial and parallel ones agree.
+
+			CPPUNIT_ASSERT( spheres[ 2 ].m_R <= spheres[ 0 ].m_R * 1.0001f );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( spheres[ 2 ].m_R, spheres[ 3 ].m_R, spheres[ 2 ].m_R * 1.0e-4 );
+		}
+	}
+}
+
+void BoundingVolumeTest::TestMinimalSphere()
+{
+	for ( int set = 0; set < 200; ++set )
+	{
+		size_t const					n		= 2 + set % 9;
+		std::vector< Vector3 > const	points	= RandomPoints( n, Vector3( 0.0f, 0.0f, 0.0f ), set );
+		Sphere const					sphere	= MyMath::ComputeMinimalSphere( points.data(), n );
+
+		for ( Vector3 const & p : points )
+		{
+			CPPUNIT_ASSERT( Contains( sphere, p ) );
+		}
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( BruteForceMinimalRadius( points ), sphere.m_R, 1.0e-4 );
+	}
+}
+
+void BoundingVolumeTest::TestExtendMerge()
+{
+	for ( int set = 0; set < 100; ++set )
+	{
+		std::vector< Vector3 > const	a	= RandomPoints( 100, Vector3( Random(), Random(), Random() ) * 5.0f, set );
+		std::vector< Vector3 > const	b	= RandomPoints( 100, Vector3( Random(), Random(), Random() ) * 5.0f, set + 1 );
+
+		AABox	aabox	= MyMath::ComputeAABox( a.data(), a.size() );
+		Sphere	sphere	= MyMath::ComputeMinimalSphere( a.data(), a.size() );
+
+		AABox const		mergedAABox		= MyMath::Merge( aabox, MyMath::ComputeAABox( b.data(), b.size() ) );
+		Sphere const	mergedSphere	= MyMath::Merge( sphere, MyMath::ComputeMinimalSphere( b.data(), b.size() ) );
+
+		MyMath::Extend( &aabox, b.data(), b.size() );
+		MyMath::Extend( &sphere, b.data(), b.size() );
+
+		for ( std::vector< Vector3 > const * pPoints : { &a, &b } )
+		{
+			for ( Vector3 const & p : *pPoints )
+			{
+				CPPUNIT_ASSERT( Contains( aabox, p ) );
+				CPPUNIT_ASSERT( Contains( mergedAABox, p ) );
+				CPPUNIT_ASSERT( Contains( sphere, p ) );
+				CPPUNIT_ASSERT( Contains( mergedSphere, p ) );
+			}
+		}
+	}
+}
+
+void BoundingVolumeTest::TestTransform()
+{
+	// A shear stretches a unit sphere by more than the length of any row of the matrix.
+
+	Matrix43 const	shear( Vector3( 1.0f, 1.0f, 0.0f ), Vector3( 0.0f, 1.0f, 0.0f ), Vector3( 0.0f, 0.0f, 1.0f ),
+						   Vector3( 0.0f, 0.0f, 0.0f ) );
+	CPPUNIT_ASSERT( MyMath::Transform( Sphere( Vector3( 0.0f, 0.0f, 0.0f ), 1.0f ), shear ).m_R >= 1.618034f );
+
+	int const				N	= 100;
+	std::vector< Matrix43 >	matrices;
+	std::vector< Sphere >	spheres;
+	std::vector< AABox >	aaboxes;
+	Vector3SoA				centers;
+	Vector3SoA				halfExtents;
+	Vector3SoA				sphereCenters;
+	std::vector< float >	radii;
+
+	for ( int i = 0; i < N; ++i )
+	{
+		// Every other matrix has random (sheared) rows.
+
+		Quaternion	q( Random(), Random(), Random(), Random() );
+		q.Normalize();
+		Matrix33	rotation	= q.GetRotationMatrix33();
+		Vector3		x( rotation.m_Xx, rotation.m_Xy, rotation.m_Xz );
+		Vector3		y( rotation.m_Yx, rotation.m_Yy, rotation.m_Yz );
+		Vector3		z( rotation.m_Zx, rotation.m_Zy, rotation.m_Zz );
+		if ( i % 2 == 0 )
+		{
+			x *= 0.5f + std::fabs( Random() ) * 2.0f;
+			y *= 0.5f + std::fabs( Random() ) * 2.0f;
+			z *= 0.5f + std::fabs( Random() ) * 2.0f;
+		}
+		else
+		{
+			x = Vector3( Random(), Random(), Random() ) * 2.0f;
+			y = Vector3( Random(), Random(), Random() ) * 2.0f;
+			z = Vector3( Random(), Random(), Random() ) * 2.0f;
+		}
+
+		matrices.push_back( Matrix43( x, y, z, Vector3( Random(), Random(), Random() ) * 10.0f ) );
+		spheres.push_back( Sphere( Vector3( Random(), Random(), Random() ), 0.1f + std::fabs( Random() ) ) );
+		aaboxes.push_back( AABox( Vector3( Random(), Random(), Random() ), Vector3( Random(), Random(), Random() ) ) );
+
+		centers.PushBack( aaboxes.back().m_Position + aaboxes.back().m_Scale * 0.5f );
+		halfExtents.PushBack( aaboxes.back().m_Scale * 0.5f );
+		sphereCenters.PushBack( spheres.back().m_C );
+		radii.push_back( spheres.back().m_R );
+	}
+
+	Matrix43SoA const	m( matrices.data(), N );
+	Vector3SoA			transformedCenters;
+	Vector3SoA			transformedHalfExtents;
+	Vector3SoA			transformedSphereCenters;
+	std::vector< float >	transformedRadii( N );
+
+	MyMath::Transform( centers, halfExtents, m, &transformedCenters, &transformedHalfExtents );
+	MyMath::Transform( sphereCenters, radii.data(), m, &transformedSphereCenters, transformedRadii.data() );
+
+	for ( int i = 0; i < N; ++i )
+	{
+		Matrix43 const &	matrix	= matrices[ i ];
+
+		// The transformed points on the surface of the sphere are in the transformed sphere.
+
+		Sphere const	sphere	= MyMath::Transform( spheres[ i ], matrix );
+		for ( int j = 0; j < 200; ++j )
+		{
+			Vector3	u( Random(), Random(), Random() );
+			u.Normalize();
+			Vector3 const	p	= ( spheres[ i ].m_C + u * spheres[ i ].m_R ) * matrix;
+			CPPUNIT_ASSERT( ( p - sphere.m_C ).Length() <= sphere.m_R * 1.00001f );
+		}
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( sphere.m_R, transformedRadii[ i ], 1.0e-5 );
+		CPPUNIT_ASSERT( ( Vector3( transformedSphereCenters[ i ] ) - sphere.m_C ).Length() <= 1.0e-5f );
+
+		// The transformed corners of the box touch each side of the transformed box.
+
+		AABox const &	aabox		= aaboxes[ i ];
+		AABox const		transformed	= MyMath::Transform( aabox, matrix );
+		Vector3			lo( std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+							std::numeric_limits<float>::infinity() );
+		Vector3			hi	= -lo;
+		for ( int c = 0; c < 8; ++c )
+		{
+			Vector3 const	corner( ( c & 1 ) ? aabox.m_Scale.m_X : 0.0f,
+									( c & 2 ) ? aabox.m_Scale.m_Y : 0.0f,
+									( c & 4 ) ? aabox.m_Scale.m_Z : 0.0f );
+			Vector3 const	p	= ( aabox.m_Position + corner ) * matrix;
+			for ( int k = 0; k < 3; ++k )
+			{
+				lo.m_V[ k ] = std::min( lo.m_V[ k ], p.m_V[ k ] );
+				hi.m_V[ k ] = std::max( hi.m_V[ k ], p.m_V[ k ] );
+			}
+		}
+		for ( int k = 0; k < 3; ++k )
+		{
+			Vector3 const	c	= transformedCenters[ i ];
+			Vector3 const	h	= transformedHalfExtents[ i ];
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( lo.m_V[ k ], transformed.m_Position.m_V[ k ], 1.0e-4 );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( hi.m_V[ k ], transformed.m_Position.m_V[ k ] + transformed.m_Scale.m_V[ k ], 1.0e-4 );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( lo.m_V[ k ], c.m_V[ k ] - h.m_V[ k ], 1.0e-4 );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( hi.m_V[ k ], c.m_V[ k ] + h.m_V[ k ], 1.0e-4 );
+		}
+	}
+}
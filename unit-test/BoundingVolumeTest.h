@@ -0,0 +1,31 @@
+/********************************************************************************************************************
+
+                                                 BoundingVolumeTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/BoundingVolume.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class BoundingVolumeTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( BoundingVolumeTest );
+	CPPUNIT_TEST( TestContainment );
+	CPPUNIT_TEST( TestMinimalSphere );
+	CPPUNIT_TEST( TestExtendMerge );
+	CPPUNIT_TEST( TestTransform );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestContainment();
+	void TestMinimalSphere();
+	void TestExtendMerge();
+	void TestTransform();
+};
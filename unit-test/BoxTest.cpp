@@ -0,0 +1,617 @@
+/********************************************************************************************************************
+
+                                                     BoxTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	The cached center, half-extents and axes of a box are compared against its corners, which are computed from
+	the position, scale and orientation, for scales with negative elements and after Update(). The batched
+	classifications are compared against references that work in the box's own frame (the position plus the scale
+	along each axis) and against the single-object Intersects(). The exact frustum classification is compared
+	against a separating axis test that projects all the corners onto every candidate axis. Objects whose reference
+	results are within a small tolerance of a boundary are skipped.
+
+ ********************************************************************************************************************/
+
+#include "BoxTest.h"
+
+#include "../include/MyMath/Frustum.h"
+#include "../include/MyMath/Line.h"
+#include "../include/MyMath/Matrix44.h"
+#include "../include/MyMath/Point.h"
+#include "../include/MyMath/Quaternion.h"
+#include "../include/MyMath/Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( BoxTest );
+
+using namespace MyMath;
+
+static float const	TOLERANCE	= 1.0e-3f;
+static float const	INF			= std::numeric_limits< float >::infinity();
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 31415;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+static Vector3 RandomVector( float scale )
+{
+	return Vector3( Random() * scale, Random() * scale, Random() * scale );
+}
+
+static Vector3 RandomDirection()
+{
+	Vector3	d	= RandomVector( 1.0f );
+	while ( d.Length() < 0.1f )
+	{
+		d = RandomVector( 1.0f );
+	}
+	return d * ( 1.0f / d.Length() );
+}
+
+static Matrix33 RandomOrientation()
+{
+	Quaternion	q( Random(), Random(), Random(), Random() );
+	q.Normalize();
+	return q.GetRotationMatrix33();
+}
+
+// Returns a box with a random orientation and a scale whose elements have random signs
+static Box RandomBox( Vector3 const & center, float size )
+{
+	Vector3	scale;
+	for ( int k = 0; k < 3; ++k )
+	{
+		float const	s	= size * ( 0.1f + std::fabs( Random() ) );
+		scale.m_V[ k ] = ( Random() < 0.0f ) ? -s : s;
+	}
+	return Box( RandomOrientation(), center + RandomVector( size ), scale );
+}
+
+static bool IsClose( Vector3 const & a, Vector3 const & b )
+{
+	return ( a - b ).Length() <= TOLERANCE * ( 1.0f + b.Length() );
+}
+
+// Returns the corners of a box, using the box's own definition: the position plus the scale along each axis
+static void GetCorners( Box const & box, Vector3 corners[ 8 ] )
+{
+	Matrix33 const	orientation	= box.GetOrientation();
+	for ( int i = 0; i < 8; ++i )
+	{
+		Vector3 const	local( ( i & 1 ) ? box.m_Scale.m_X : 0.0f,
+							   ( i & 2 ) ? box.m_Scale.m_Y : 0.0f,
+							   ( i & 4 ) ? box.m_Scale.m_Z : 0.0f );
+		corners[ i ] = box.m_Position + orientation * local;
+	}
+}
+
+// Returns the signed distance from a point to the surface of a box: negative inside and positive outside
+static float SignedDistance( Box const & box, Vector3 const & point )
+{
+	Vector3 const	local	= box.m_InverseOrientation * ( point - box.m_Position );
+
+	float	outside2	= 0.0f;
+	float	depth		= INF;
+	for ( int k = 0; k < 3; ++k )
+	{
+		float const	lo		= std::min( 0.0f, box.m_Scale.m_V[ k ] );
+		float const	hi		= std::max( 0.0f, box.m_Scale.m_V[ k ] );
+		float const	excess	= std::max( lo - local.m_V[ k ], local.m_V[ k ] - hi );
+		if ( excess > 0.0f )
+		{
+			outside2 += excess * excess;
+		}
+		depth = std::min( depth, -excess );
+	}
+	return ( outside2 > 0.0f ) ? std::sqrt( outside2 ) : -depth;
+}
+
+// Checks that the cached values of a box match its corners
+static void CheckCache( Box const & box )
+{
+	Vector3	corners[ 8 ];
+	GetCorners( box, corners );
+
+	Vector3	center( 0.0f, 0.0f, 0.0f );
+	for ( Vector3 const & c : corners )
+	{
+		center += c * 0.125f;
+	}
+	CPPUNIT_ASSERT( IsClose( box.GetCenter(), center ) );
+
+	Matrix33 const	orientation	= box.GetOrientation();
+	for ( int k = 0; k < 3; ++k )
+	{
+		Vector3 const	axis	= box.GetAxis( k );
+		Vector3 const	row( orientation.m_M[ k ][ 0 ], orientation.m_M[ k ][ 1 ], orientation.m_M[ k ][ 2 ] );
+		CPPUNIT_ASSERT( IsClose( axis, row ) );
+		CPPUNIT_ASSERT( std::fabs( axis.Length() - 1.0f ) <= TOLERANCE );
+
+		// The half-extent is half the distance between the faces
+		Vector3 const	edge	= corners[ 1 << k ] - corners[ 0 ];
+		CPPUNIT_ASSERT( box.GetHalfExtents().m_V[ k ] >= 0.0f );
+		CPPUNIT_ASSERT( std::fabs( box.GetHalfExtents().m_V[ k ] - edge.Length() * 0.5f ) <= TOLERANCE );
+		CPPUNIT_ASSERT( std::fabs( std::fabs( Dot( edge, axis ) ) - edge.Length() ) <= TOLERANCE );
+	}
+}
+
+// Returns the reference classification of a box against a sphere, or -1 if it is within the tolerance of a boundary
+static int Reference( Sphere const & sphere, Box const & box )
+{
+	Vector3	corners[ 8 ];
+	GetCorners( box, corners );
+
+	float	farthest	= 0.0f;
+	for ( Vector3 const & c : corners )
+	{
+		farthest = std::max( farthest, ( c - sphere.m_C ).Length() );
+	}
+
+	float const	distance	= SignedDistance( box, sphere.m_C );
+	float const	r			= sphere.m_R;
+
+	if ( std::fabs( distance - r ) <= TOLERANCE || std::fabs( distance + r ) <= TOLERANCE ||
+		 std::fabs( farthest - r ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	if ( distance > r )
+	{
+		return Intersectable::NO_INTERSECTION;
+	}
+	if ( distance + r < 0.0f )
+	{
+		return Intersectable::ENCLOSED_BY;
+	}
+	if ( farthest < r )
+	{
+		return Intersectable::ENCLOSES;
+	}
+	return Intersectable::INTERSECTS;
+}
+
+// Returns the reference classification of a box against a ray, or -1 if the ray grazes the box. The ray is clipped
+// to each slab in the box's frame, with an explicit branch for a ray parallel to a slab.
+static int Reference( Ray const & ray, Box const & box )
+{
+	Vector3 const	origin		= box.m_InverseOrientation * ( ray.m_B - box.m_Position );
+	Vector3 const	direction	= box.m_InverseOrientation * ray.m_M;
+
+	float	enter	= 0.0f;
+	float	exit	= INF;
+	for ( int k = 0; k < 3; ++k )
+	{
+		float const	lo	= std::min( 0.0f, box.m_Scale.m_V[ k ] );
+		float const	hi	= std::max( 0.0f, box.m_Scale.m_V[ k ] );
+		float const	o	= origin.m_V[ k ];
+		float const	d	= direction.m_V[ k ];
+
+		if ( std::fabs( d ) < 1.0e-6f )
+		{
+			if ( std::fabs( o - lo ) <= TOLERANCE || std::fabs( o - hi ) <= TOLERANCE )
+			{
+				return -1;
+			}
+			if ( o < lo || o > hi )
+			{
+				return Intersectable::NO_INTERSECTION;
+			}
+		}
+		else
+		{
+			float const	t0	= ( lo - o ) / d;
+			float const	t1	= ( hi - o ) / d;
+			enter = std::max( enter, std::min( t0, t1 ) );
+			exit = std::min( exit, std::max( t0, t1 ) );
+		}
+	}
+
+	if ( std::fabs( exit - enter ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	return ( enter <= exit ) ? Intersectable::INTERSECTS : Intersectable::NO_INTERSECTION;
+}
+
+// Returns the reference classification of a box against a frustum, or -1 if it is within the tolerance of a
+// boundary
+static int Reference( Frustum const & frustum, Box const & box )
+{
+	Vector3	boxCorners[ 8 ];
+	GetCorners( box, boxCorners );
+
+	Vector3	frustumCorners[ Frustum::NUM_CORNERS ];
+	for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+	{
+		frustumCorners[ i ] = frustum.GetCorner( i );
+	}
+
+	// Candidate axes: the box's edges, the frustum's normals and the cross products of the box's edges with the
+	// frustum's edges
+	std::vector< Vector3 >	axes;
+	for ( int k = 0; k < 3; ++k )
+	{
+		axes.push_back( boxCorners[ 1 << k ] - boxCorners[ 0 ] );
+	}
+	for ( Plane const & side : frustum.sides_ )
+	{
+		axes.push_back( side.m_N );
+	}
+	for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+	{
+		for ( int bit = 1; bit < Frustum::NUM_CORNERS; bit <<= 1 )
+		{
+			if ( ( i & bit ) == 0 )
+			{
+				Vector3 const	edge	= frustumCorners[ i | bit ] - frustumCorners[ i ];
+				for ( int k = 0; k < 3; ++k )
+				{
+					axes.push_back( Cross( axes[ k ], edge ) );
+				}
+			}
+		}
+	}
+
+	// The greatest gap between the projections. If it is negative, its magnitude is the penetration depth.
+	float	gap	= -INF;
+	for ( Vector3 axis : axes )
+	{
+		if ( axis.Length() < 1.0e-4f )
+		{
+			continue;
+		}
+		axis *= 1.0f / axis.Length();
+
+		float	boxMin		= INF;
+		float	boxMax		= -INF;
+		float	frustumMin	= INF;
+		float	frustumMax	= -INF;
+		for ( int i = 0; i < 8; ++i )
+		{
+			boxMin = std::min( boxMin, Dot( boxCorners[ i ], axis ) );
+			boxMax = std::max( boxMax, Dot( boxCorners[ i ], axis ) );
+			frustumMin = std::min( frustumMin, Dot( frustumCorners[ i ], axis ) );
+			frustumMax = std::max( frustumMax, Dot( frustumCorners[ i ], axis ) );
+		}
+		gap = std::max( gap, std::max( boxMin - frustumMax, frustumMin - boxMax ) );
+	}
+
+	float	maxSide	= -INF;
+	for ( Plane const & side : frustum.sides_ )
+	{
+		for ( Vector3 const & c : boxCorners )
+		{
+			maxSide = std::max( maxSide, side.DirectedDistance( c ) );
+		}
+	}
+
+	float	outside	= -INF;
+	for ( Vector3 const & c : frustumCorners )
+	{
+		outside = std::max( outside, SignedDistance( box, c ) );
+	}
+
+	if ( std::fabs( gap ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	if ( gap > 0.0f )
+	{
+		return Intersectable::NO_INTERSECTION;
+	}
+	if ( std::fabs( maxSide ) <= TOLERANCE || std::fabs( outside ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	if ( maxSide < 0.0f )
+	{
+		return Intersectable::ENCLOSED_BY;
+	}
+	if ( outside < 0.0f )
+	{
+		return Intersectable::ENCLOSES;
+	}
+	return Intersectable::INTERSECTS;
+}
+
+void BoxTest::TestCache()
+{
+	// An axis-aligned box
+	Box const	aligned( Matrix33::Identity(), Vector3( 1.0f, 2.0f, 3.0f ), Vector3( 2.0f, -4.0f, 6.0f ) );
+	CPPUNIT_ASSERT( IsClose( aligned.GetCenter(), Vector3( 2.0f, 0.0f, 6.0f ) ) );
+	CPPUNIT_ASSERT( IsClose( aligned.GetHalfExtents(), Vector3( 1.0f, 2.0f, 3.0f ) ) );
+	CPPUNIT_ASSERT( IsClose( aligned.GetAxis( 0 ), Vector3( 1.0f, 0.0f, 0.0f ) ) );
+	CPPUNIT_ASSERT( IsClose( aligned.GetAxis( 1 ), Vector3( 0.0f, 1.0f, 0.0f ) ) );
+	CPPUNIT_ASSERT( IsClose( aligned.GetAxis( 2 ), Vector3( 0.0f, 0.0f, 1.0f ) ) );
+	CheckCache( aligned );
+
+	for ( int i = 0; i < 200; ++i )
+	{
+		Box const	box	= RandomBox( Vector3( 0.0f, 0.0f, 0.0f ), 3.0f );
+		CheckCache( box );
+
+		// A box built from the equivalent transform has the same cache
+		Matrix33 const	o	= box.GetOrientation();
+		Vector3 const	s	= box.m_Scale;
+		Box const		converted( Matrix44( o.m_Xx * s.m_X, o.m_Xy * s.m_X, o.m_Xz * s.m_X, 0.0f,
+											 o.m_Yx * s.m_Y, o.m_Yy * s.m_Y, o.m_Yz * s.m_Y, 0.0f,
+											 o.m_Zx * s.m_Z, o.m_Zy * s.m_Z, o.m_Zz * s.m_Z, 0.0f,
+											 0.0f, 0.0f, 0.0f, 1.0f ) );
+		CheckCache( converted );
+		CPPUNIT_ASSERT( IsClose( converted.GetCenter(), box.GetCenter() - box.m_Position ) );
+		CPPUNIT_ASSERT( IsClose( converted.GetHalfExtents(), box.GetHalfExtents() ) );
+	}
+}
+
+void BoxTest::TestUpdate()
+{
+	Box	box( Matrix33::Identity(), Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 1.0f, 1.0f, 1.0f ) );
+
+	for ( int i = 0; i < 100; ++i )
+	{
+		Box const	other	= RandomBox( Vector3( 0.0f, 0.0f, 0.0f ), 5.0f );
+
+		box.m_InverseOrientation = other.m_InverseOrientation;
+		box.m_Position = other.m_Position;
+		box.m_Scale = other.m_Scale;
+		box.Update();
+
+		CheckCache( box );
+		CPPUNIT_ASSERT( IsClose( box.GetCenter(), other.GetCenter() ) );
+		CPPUNIT_ASSERT( IsClose( box.GetHalfExtents(), other.GetHalfExtents() ) );
+		for ( int k = 0; k < 3; ++k )
+		{
+			CPPUNIT_ASSERT( IsClose( box.GetAxis( k ), other.GetAxis( k ) ) );
+		}
+	}
+}
+
+void BoxTest::TestAABox()
+{
+	for ( int i = 0; i < 200; ++i )
+	{
+		Box const	box		= RandomBox( Vector3( 0.0f, 0.0f, 0.0f ), 3.0f );
+		AABox const	aabox	= box.GetAABox();
+
+		Vector3	corners[ 8 ];
+		GetCorners( box, corners );
+
+		// Every corner is inside the box, and each face of the box touches a corner
+		Vector3 const	lo	= aabox.m_Position;
+		Vector3 const	hi	= aabox.m_Position + aabox.m_Scale;
+		for ( int k = 0; k < 3; ++k )
+		{
+			float	cornerMin	= INF;
+			float	cornerMax	= -INF;
+			for ( Vector3 const & c : corners )
+			{
+				cornerMin = std::min( cornerMin, c.m_V[ k ] );
+				cornerMax = std::max( cornerMax, c.m_V[ k ] );
+			}
+			CPPUNIT_ASSERT( aabox.m_Scale.m_V[ k ] >= 0.0f );
+			CPPUNIT_ASSERT( std::fabs( cornerMin - lo.m_V[ k ] ) <= TOLERANCE );
+			CPPUNIT_ASSERT( std::fabs( cornerMax - hi.m_V[ k ] ) <= TOLERANCE );
+		}
+	}
+
+	// An axis-aligned box encloses itself
+	Box const	aligned( Matrix33::Identity(), Vector3( 1.0f, 2.0f, 3.0f ), Vector3( -2.0f, 4.0f, 6.0f ) );
+	AABox const	aabox	= aligned.GetAABox();
+	CPPUNIT_ASSERT( IsClose( aabox.m_Position, Vector3( -1.0f, 2.0f, 3.0f ) ) );
+	CPPUNIT_ASSERT( IsClose( aabox.m_Scale, Vector3( 2.0f, 4.0f, 6.0f ) ) );
+}
+
+void BoxTest::TestClassifyEmpty()
+{
+	Intersectable::Result	result	= Intersectable::ENCLOSES;
+
+	Classify( Point( Vector3( 0.0f, 0.0f, 0.0f ) ), nullptr, 0, &result );
+	Classify( Sphere( Vector3( 0.0f, 0.0f, 0.0f ), 1.0f ), nullptr, 0, &result );
+	Classify( Ray( Vector3( 1.0f, 0.0f, 0.0f ), Vector3( 0.0f, 0.0f, 0.0f ) ), nullptr, 0, &result );
+	Classify( Frustum::Perspective( 1.0f, 1.0f, 1.0f, 10.0f ), static_cast< Box const * >( nullptr ), 0, &result,
+			  Frustum::EXACT );
+	CPPUNIT_ASSERT_EQUAL( Intersectable::ENCLOSES, result );
+}
+
+void BoxTest::TestClassifyPoints()
+{
+	std::vector< Box >	boxes;
+	for ( int i = 0; i < 50; ++i )
+	{
+		boxes.push_back( RandomBox( Vector3( 0.0f, 0.0f, 0.0f ), 2.0f ) );
+	}
+
+	int const								n	= int( boxes.size() );
+	std::vector< Intersectable::Result >	results( n + 1, Intersectable::ENCLOSES );
+	for ( int i = 0; i < 500; ++i )
+	{
+		Point const	point( RandomVector( 5.0f ) );
+		Classify( point, boxes.data(), n, results.data() );
+		CPPUNIT_ASSERT_EQUAL( Intersectable::ENCLOSES, results[ n ] );
+
+		for ( int b = 0; b < n; ++b )
+		{
+			CPPUNIT_ASSERT_EQUAL( point.Intersects( boxes[ b ] ), results[ b ] );
+
+			float const	distance	= SignedDistance( boxes[ b ], point.value_ );
+			if ( std::fabs( distance ) > TOLERANCE )
+			{
+				Intersectable::Result const	expected	= ( distance < 0.0f ) ? Intersectable::INTERSECTS
+																			  : Intersectable::NO_INTERSECTION;
+				CPPUNIT_ASSERT_EQUAL( expected, results[ b ] );
+			}
+		}
+	}
+
+	// The corners and center of a box are in it
+	for ( Box const & box : boxes )
+	{
+		Vector3	corners[ 8 ];
+		GetCorners( box, corners );
+		CPPUNIT_ASSERT_EQUAL( Intersectable::INTERSECTS, Point( box.GetCenter() ).Intersects( box ) );
+		CPPUNIT_ASSERT_EQUAL( Intersectable::NO_INTERSECTION,
+							  Point( corners[ 7 ] + ( corners[ 7 ] - box.GetCenter() ) * 0.01f ).Intersects( box ) );
+	}
+}
+
+void BoxTest::TestClassifySpheres()
+{
+	std::vector< Box >	boxes;
+	for ( int i = 0; i < 50; ++i )
+	{
+		boxes.push_back( RandomBox( Vector3( 0.0f, 0.0f, 0.0f ), 2.0f ) );
+	}
+
+	int const								n	= int( boxes.size() );
+	std::vector< Intersectable::Result >	results( n );
+	for ( int i = 0; i < 500; ++i )
+	{
+		// Zero, small and large radii
+		float const		r	= ( i % 25 == 0 ) ? 0.0f : ( i % 7 == 0 ) ? 10.0f : 2.0f * std::fabs( Random() );
+		Sphere const	sphere( RandomVector( 4.0f ), r );
+		Classify( sphere, boxes.data(), n, results.data() );
+
+		for ( int b = 0; b < n; ++b )
+		{
+			CPPUNIT_ASSERT_EQUAL( sphere.Intersects( boxes[ b ] ), results[ b ] );
+
+			int const	expected	= Reference( sphere, boxes[ b ] );
+			if ( expected >= 0 )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, int( results[ b ] ) );
+			}
+		}
+	}
+}
+
+void BoxTest::TestClassifyRays()
+{
+	std::vector< Box >	boxes;
+	for ( int i = 0; i < 50; ++i )
+	{
+		boxes.push_back( RandomBox( Vector3( 0.0f, 0.0f, 0.0f ), 2.0f ) );
+	}
+
+	int const								n	= int( boxes.size() );
+	std::vector< Intersectable::Result >	results( n );
+	for ( int i = 0; i < 500; ++i )
+	{
+		Vector3 const	origin	= RandomVector( 5.0f );
+		Ray const		ray( RandomDirection(), origin );
+		Classify( ray, boxes.data(), n, results.data() );
+
+		for ( int b = 0; b < n; ++b )
+		{
+			CPPUNIT_ASSERT_EQUAL( ray.Intersects( boxes[ b ] ), results[ b ] );
+
+			int const	expected	= Reference( ray, boxes[ b ] );
+			if ( expected >= 0 )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, int( results[ b ] ) );
+			}
+		}
+	}
+
+	// Rays parallel to the box's axes, starting inside, outside, and beside the box
+	for ( Box const & box : boxes )
+	{
+		for ( int k = 0; k < 3; ++k )
+		{
+			Vector3 const	axis		= box.GetAxis( k );
+			Vector3 const	side		= box.GetAxis( ( k + 1 ) % 3 );
+			float const		h			= box.GetHalfExtents().m_V[ k ];
+			float const		w			= box.GetHalfExtents().m_V[ ( k + 1 ) % 3 ];
+			Vector3 const	behind		= box.GetCenter() - axis * ( h + 1.0f );
+			Vector3 const	beyond		= box.GetCenter() + axis * ( h + 1.0f );
+			Vector3 const	beside		= behind + side * ( w + 0.5f );
+
+			Ray const	rays[]	=
+			{
+				Ray( axis, box.GetCenter() ), Ray( -axis, box.GetCenter() ),
+				Ray( axis, behind ), Ray( -axis, behind ),
+				Ray( -axis, beyond ), Ray( axis, beyond ),
+				Ray( axis, beside ), Ray( -axis, beside ),
+			};
+			Intersectable::Result const	expected[]	=
+			{
+				Intersectable::INTERSECTS, Intersectable::INTERSECTS,
+				Intersectable::INTERSECTS, Intersectable::NO_INTERSECTION,
+				Intersectable::INTERSECTS, Intersectable::NO_INTERSECTION,
+				Intersectable::NO_INTERSECTION, Intersectable::NO_INTERSECTION,
+			};
+			for ( size_t r = 0; r < sizeof( rays ) / sizeof( rays[ 0 ] ); ++r )
+			{
+				Intersectable::Result	result;
+				Classify( rays[ r ], &box, 1, &result );
+				CPPUNIT_ASSERT_EQUAL( expected[ r ], result );
+			}
+		}
+	}
+}
+
+void BoxTest::TestClassifyFrustum()
+{
+	Frustum const	frustums[]	=
+	{
+		Frustum::Perspective( 1.0f, 1.3f, 1.0f, 10.0f ),
+		Frustum::Perspective( 0.3f, 0.5f, 0.1f, 20.0f ),
+		Frustum::Orthographic( 6.0f, 3.0f, -2.0f, 8.0f ),
+	};
+
+	for ( Frustum const & frustum : frustums )
+	{
+		std::vector< Box >	boxes;
+		for ( int i = 0; i < 3000; ++i )
+		{
+			float const	size	= ( i % 17 == 0 ) ? 40.0f : 2.5f;
+			Vector3 const	center( Random() * 12.0f, Random() * 10.0f, 5.0f + Random() * 12.0f );
+			boxes.push_back( RandomBox( center, size ) );
+		}
+
+		// Large boxes around the frustum, many of which enclose it
+		Vector3	center( 0.0f, 0.0f, 0.0f );
+		for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+		{
+			center += frustum.GetCorner( i ) * ( 1.0f / Frustum::NUM_CORNERS );
+		}
+		for ( int i = 0; i < 500; ++i )
+		{
+			Box	box	= RandomBox( Vector3( 0.0f, 0.0f, 0.0f ), 30.0f );
+			box.m_Position += center + RandomVector( 2.0f ) - box.GetCenter();
+			box.Update();
+			boxes.push_back( box );
+		}
+
+		int const								n	= int( boxes.size() );
+		std::vector< Intersectable::Result >	conservative( n );
+		std::vector< Intersectable::Result >	exact( n );
+		Classify( frustum, boxes.data(), n, conservative.data(), Frustum::CONSERVATIVE );
+		Classify( frustum, boxes.data(), n, exact.data(), Frustum::EXACT );
+
+		for ( int i = 0; i < n; ++i )
+		{
+			CPPUNIT_ASSERT_EQUAL( boxes[ i ].Intersects( frustum ), conservative[ i ] );
+			if ( conservative[ i ] != Intersectable::INTERSECTS )
+			{
+				CPPUNIT_ASSERT_EQUAL( conservative[ i ], exact[ i ] );
+			}
+
+			int const	expected	= Reference( frustum, boxes[ i ] );
+			if ( expected >= 0 )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, int( exact[ i ] ) );
+			}
+		}
+	}
+}
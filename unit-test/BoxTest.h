@@ -0,0 +1,39 @@
+/********************************************************************************************************************
+
+                                                      BoxTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Box.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class BoxTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( BoxTest );
+	CPPUNIT_TEST( TestCache );
+	CPPUNIT_TEST( TestUpdate );
+	CPPUNIT_TEST( TestAABox );
+	CPPUNIT_TEST( TestClassifyEmpty );
+	CPPUNIT_TEST( TestClassifyPoints );
+	CPPUNIT_TEST( TestClassifySpheres );
+	CPPUNIT_TEST( TestClassifyRays );
+	CPPUNIT_TEST( TestClassifyFrustum );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestCache();
+	void TestUpdate();
+	void TestAABox();
+	void TestClassifyEmpty();
+	void TestClassifyPoints();
+	void TestClassifySpheres();
+	void TestClassifyRays();
+	void TestClassifyFrustum();
+};
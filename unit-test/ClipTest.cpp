@@ -0,0 +1,299 @@
+/********************************************************************************************************************
+
+                                                     ClipTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	Random convex polygons are clipped and split. Every vertex of a result must be on the kept side, the kept input
+	vertices must all be in the result, and the areas of the two parts of a split must add up to the area of the
+	polygon. Clipping by a frustum must give the same result as clipping by each of its sides in turn, and the batch
+	form must give the same results as the single polygon form. Polygons that are not convex must not write past the
+	end of the buffers.
+
+ ********************************************************************************************************************/
+
+#include "ClipTest.h"
+
+#include "../include/MyMath/Clip.h"
+#include "../include/MyMath/Frustum.h"
+#include "../include/MyMath/Plane.h"
+#include "../include/MyMath/PolyBuffer.h"
+#include "../include/MyMath/Vector3.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ClipTest );
+
+using namespace MyMath;
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 24680;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+// Returns a random convex polygon with n vertices on an ellipse in a random plane
+static std::vector< Vector3 > RandomConvexPolygon( int n )
+{
+	Vector3	u( Random(), Random(), Random() );
+	Vector3	v( Random(), Random(), Random() );
+	v = Cross( Cross( u, v ), u );
+	u *= 2.0f / std::max( u.Length(), 0.1f );
+	v *= 1.5f / std::max( v.Length(), 0.1f );
+	Vector3 const	c( Random(), Random(), Random() );
+
+	std::vector< Vector3 >	vertices( n );
+	for ( int i = 0; i < n; ++i )
+	{
+		float const	a	= 6.2831853f * ( float( i ) + 0.5f * ( Random() + 1.0f ) * 0.9f ) / float( n );
+		vertices[ i ] = c + u * std::cos( a ) + v * std::sin( a );
+	}
+	return vertices;
+}
+
+// Returns a random plane through the unit cube
+static Plane RandomPlane()
+{
+	Vector3	n( Random(), Random(), Random() );
+	n *= 1.0f / std::max( n.Length(), 0.01f );
+	return Plane( n, Point( Vector3( Random(), Random(), Random() ) * 0.5f ) );
+}
+
+// Returns the area of a planar polygon
+static double Area( Vector3 const * paVertices, int nVertices )
+{
+	double	x	= 0.0;
+	double	y	= 0.0;
+	double	z	= 0.0;
+	for ( int i = 2; i < nVertices; ++i )
+	{
+		Vector3 const	c	= Cross( paVertices[ i - 1 ] - paVertices[ 0 ], paVertices[ i ] - paVertices[ 0 ] );
+		x += c.m_X;
+		y += c.m_Y;
+		z += c.m_Z;
+	}
+	return 0.5 * std::sqrt( x * x + y * y + z * z );
+}
+
+// Returns true if two vectors are exactly equal
+static bool IsEqual( Vector3 const & a, Vector3 const & b )
+{
+	return a.m_X == b.m_X && a.m_Y == b.m_Y && a.m_Z == b.m_Z;
+}
+
+// Returns true if a vertex is in a list
+static bool Contains( Vector3 const * paVertices, int nVertices, Vector3 const & v )
+{
+	for ( int i = 0; i < nVertices; ++i )
+	{
+		if ( IsEqual( paVertices[ i ], v ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void ClipTest::TestHalfSpace()
+{
+	for ( int test = 0; test < 2000; ++test )
+	{
+		int const				n			= 3 + test % 20;
+		std::vector< Vector3 >	vertices	= RandomConvexPolygon( n );
+		HalfSpace const			halfspace( RandomPlane() );
+		Plane const &			plane		= halfspace.m_Plane;
+
+		std::vector< Vector3 >	result( n + 1 );
+		int const				nResult		= Clip( vertices.data(), n, halfspace, result.data() );
+
+		CPPUNIT_ASSERT( nResult == 0 || ( nResult >= 3 && nResult <= n + 1 ) );
+
+		for ( int i = 0; i < nResult; ++i )
+		{
+			CPPUNIT_ASSERT( plane.DirectedDistance( Point( result[ i ] ) ) <= 1.0e-5f );
+		}
+
+		int	nBehind	= 0;
+		for ( int i = 0; i < n; ++i )
+		{
+			if ( plane.DirectedDistance( Point( vertices[ i ] ) ) <= 0.0f )
+			{
+				++nBehind;
+				CPPUNIT_ASSERT( nResult == 0 || Contains( result.data(), nResult, vertices[ i ] ) );
+			}
+		}
+		if ( nBehind == n )
+		{
+			CPPUNIT_ASSERT_EQUAL( n, nResult );
+		}
+		if ( nBehind == 0 )
+		{
+			CPPUNIT_ASSERT_EQUAL( 0, nResult );
+		}
+
+		// The Poly form gives the same result
+
+		Poly const	poly( vertices.data(), n );
+		Poly		clipped;
+		CPPUNIT_ASSERT_EQUAL( nResult > 0, Clip( poly, halfspace, &clipped ) );
+		CPPUNIT_ASSERT_EQUAL( nResult, clipped.GetVertexCount() );
+		for ( int i = 0; i < nResult; ++i )
+		{
+			CPPUNIT_ASSERT( IsEqual( result[ i ], clipped.GetVertices()[ i ] ) );
+		}
+	}
+}
+
+void ClipTest::TestSplit()
+{
+	for ( int test = 0; test < 2000; ++test )
+	{
+		int const				n			= 3 + test % 20;
+		std::vector< Vector3 >	vertices	= RandomConvexPolygon( n );
+		Plane const				plane		= RandomPlane();
+
+		std::vector< Vector3 >	front( n + 1 );
+		std::vector< Vector3 >	back( n + 1 );
+		int						nFront;
+		int						nBack;
+		Split( vertices.data(), n, plane, front.data(), &nFront, back.data(), &nBack );
+
+		CPPUNIT_ASSERT( nFront == 0 || ( nFront >= 3 && nFront <= n + 1 ) );
+		CPPUNIT_ASSERT( nBack == 0 || ( nBack >= 3 && nBack <= n + 1 ) );
+		CPPUNIT_ASSERT( nFront > 0 || nBack > 0 );
+
+		for ( int i = 0; i < nFront; ++i )
+		{
+			CPPUNIT_ASSERT( plane.DirectedDistance( Point( front[ i ] ) ) >= -1.0e-5f );
+		}
+		for ( int i = 0; i < nBack; ++i )
+		{
+			CPPUNIT_ASSERT( plane.DirectedDistance( Point( back[ i ] ) ) <= 1.0e-5f );
+		}
+
+		double const	area	= Area( vertices.data(), n );
+		double const	parts	= Area( front.data(), nFront ) + Area( back.data(), nBack );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( area, parts, 1.0e-4 * ( 1.0 + area ) );
+	}
+}
+
+void ClipTest::TestFrustum()
+{
+	Frustum const	frustums[]	=
+	{
+		Frustum::Orthographic( 1.5f, 1.0f, -0.5f, 0.5f ),
+		Frustum::Perspective( 1.2f, 1.3f, 0.1f, 1.0f ),
+		Frustum::Orthographic( 10.0f, 10.0f, -10.0f, 10.0f )
+	};
+
+	for ( Frustum const & frustum : frustums )
+	{
+		PolyBuffer	polys;
+		for ( int test = 0; test < 1000; ++test )
+		{
+			int const				n			= 3 + test % 20;
+			std::vector< Vector3 >	vertices	= RandomConvexPolygon( n );
+			Poly const				poly( vertices.data(), n );
+			polys.PushBack( poly );
+
+			// Reference: clip by each side in turn
+
+			Poly	expected( poly );
+			for ( int s = 0; s < Frustum::NUM_SIDES && expected.GetVertexCount() > 0; ++s )
+			{
+				Poly	clipped;
+				Clip( expected, HalfSpace( frustum.sides_[ s ] ), &clipped );
+				expected = clipped;
+			}
+
+			std::vector< Vector3 >	result( n + Frustum::NUM_SIDES );
+			std::vector< Vector3 >	scratch( n + Frustum::NUM_SIDES );
+			int const				nResult	= Clip( vertices.data(), n, frustum, result.data(), scratch.data() );
+
+			CPPUNIT_ASSERT_EQUAL( expected.GetVertexCount(), nResult );
+			for ( int i = 0; i < nResult && i < expected.GetVertexCount(); ++i )
+			{
+				CPPUNIT_ASSERT( IsEqual( expected.GetVertices()[ i ], result[ i ] ) );
+			}
+
+			Poly	clipped;
+			CPPUNIT_ASSERT_EQUAL( nResult > 0, Clip( poly, frustum, &clipped ) );
+			CPPUNIT_ASSERT_EQUAL( nResult, clipped.GetVertexCount() );
+		}
+
+		// The batch form gives the same results, without the empty ones
+
+		PolyBuffer	clipped;
+		Clip( polys, frustum, &clipped );
+
+		int	j	= 0;
+		for ( int i = 0; i < polys.Size(); ++i )
+		{
+			Poly	expected;
+			if ( Clip( polys[ i ], frustum, &expected ) )
+			{
+				CPPUNIT_ASSERT( j < clipped.Size() );
+				if ( j < clipped.Size() )
+				{
+					CPPUNIT_ASSERT_EQUAL( expected.GetVertexCount(), clipped.GetVertexCount( j ) );
+				}
+				++j;
+			}
+		}
+		CPPUNIT_ASSERT_EQUAL( j, clipped.Size() );
+	}
+}
+
+void ClipTest::TestNotConvex()
+{
+	// A zigzag crosses the plane at every edge, so it gives more vertices than a convex polygon can. The extra
+	// vertices must be dropped rather than written past the end of the result. In a debug build this asserts, so
+	// it is only tested when asserts are disabled.
+
+#if defined( NDEBUG )
+	int const				n		= 12;
+	int const				GUARD	= 8;
+	std::vector< Vector3 >	vertices( n );
+	for ( int i = 0; i < n; ++i )
+	{
+		vertices[ i ] = Vector3( float( i ), ( i % 2 == 0 ) ? 1.0f : -1.0f, 0.0f );
+	}
+
+	Vector3 const			sentinel( 1234.0f, 5678.0f, 9.0f );
+	std::vector< Vector3 >	result( n + 1 + GUARD, sentinel );
+	HalfSpace const			halfspace( Plane( Vector3( 0.0f, 1.0f, 0.0f ), 0.0f ) );
+
+	int const	nResult	= Clip( vertices.data(), n, halfspace, result.data() );
+	CPPUNIT_ASSERT( nResult <= n + 1 );
+	for ( int i = n + 1; i < n + 1 + GUARD; ++i )
+	{
+		CPPUNIT_ASSERT( IsEqual( result[ i ], sentinel ) );
+	}
+
+	std::vector< Vector3 >	front( n + 1 + GUARD, sentinel );
+	std::vector< Vector3 >	back( n + 1 + GUARD, sentinel );
+	int						nFront;
+	int						nBack;
+	Split( vertices.data(), n, halfspace.m_Plane, front.data(), &nFront, back.data(), &nBack );
+	for ( int i = n + 1; i < n + 1 + GUARD; ++i )
+	{
+		CPPUNIT_ASSERT( IsEqual( front[ i ], sentinel ) );
+		CPPUNIT_ASSERT( IsEqual( back[ i ], sentinel ) );
+	}
+
+	Frustum const			frustum	= Frustum::Orthographic( 100.0f, 1.0f, -1.0f, 1.0f );
+	std::vector< Vector3 >	fresult( n + Frustum::NUM_SIDES + GUARD, sentinel );
+	std::vector< Vector3 >	fscratch( n + Frustum::NUM_SIDES + GUARD, sentinel );
+	Clip( vertices.data(), n, frustum, fresult.data(), fscratch.data() );
+	for ( int i = n + Frustum::NUM_SIDES; i < n + Frustum::NUM_SIDES + GUARD; ++i )
+	{
+		CPPUNIT_ASSERT( IsEqual( fresult[ i ], sentinel ) );
+		CPPUNIT_ASSERT( IsEqual( fscratch[ i ], sentinel ) );
+	}
+#endif // defined( NDEBUG )
+}
@@ -0,0 +1,31 @@
+/********************************************************************************************************************
+
+                                                      ClipTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Clip.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class ClipTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ClipTest );
+	CPPUNIT_TEST( TestHalfSpace );
+	CPPUNIT_TEST( TestSplit );
+	CPPUNIT_TEST( TestFrustum );
+	CPPUNIT_TEST( TestNotConvex );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestHalfSpace();
+	void TestSplit();
+	void TestFrustum();
+	void TestNotConvex();
+};
@@ -0,0 +1,215 @@
+/********************************************************************************************************************
+
+                                                 ClosestPointTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	The closest points are compared against brute-force references: the distances to a grid of points in a box or
+	to many points along a segment. A result must be a point of the object, and its distance must not be greater
+	than the distance to any sample. The boxes include ones with negative scales.
+
+ ********************************************************************************************************************/
+
+#include "ClosestPointTest.h"
+
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/ClosestPoint.h"
+#include "../include/MyMath/Intersectable.h"
+#include "../include/MyMath/Line.h"
+#include "../include/MyMath/Point.h"
+#include "../include/MyMath/Quaternion.h"
+#include "../include/MyMath/Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ClosestPointTest );
+
+static float const	TOLERANCE	= 1.0e-4f;
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 12345;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+static Vector3 RandomVector( float scale )
+{
+	return Vector3( Random() * scale, Random() * scale, Random() * scale );
+}
+
+// Returns a box with a random orientation and a scale whose elements have random signs
+static Box RandomBox()
+{
+	Quaternion	q( Random(), Random(), Random(), Random() );
+	q.Normalize();
+
+	Vector3	scale;
+	for ( int k = 0; k < 3; ++k )
+	{
+		float const	s	= 0.5f + std::fabs( Random() ) * 2.5f;
+		scale.m_V[ k ] = ( Random() < 0.0f ) ? -s : s;
+	}
+
+	return Box( q.GetRotationMatrix33(), RandomVector( 3.0f ), scale );
+}
+
+// Returns true if a point is in a box, using the box's own definition: the position plus the scale along each axis
+static bool IsInBox( Box const & box, Vector3 const & point )
+{
+	Vector3 const	local	= box.m_InverseOrientation * ( point - box.m_Position );
+
+	for ( int k = 0; k < 3; ++k )
+	{
+		float const	lo	= std::min( 0.0f, box.m_Scale.m_V[ k ] );
+		float const	hi	= std::max( 0.0f, box.m_Scale.m_V[ k ] );
+		if ( local.m_V[ k ] < lo - TOLERANCE || local.m_V[ k ] > hi + TOLERANCE )
+			return false;
+	}
+	return true;
+}
+
+// Returns the smallest distance from a point to a 9x9x9 grid of points spanning a box
+static float SampledDistance( Box const & box, Vector3 const & point )
+{
+	Matrix33 const	orientation	= box.GetOrientation();
+	float			best		= std::numeric_limits<float>::infinity();
+
+	for ( int i = 0; i <= 8; ++i )
+	{
+		for ( int j = 0; j <= 8; ++j )
+		{
+			for ( int k = 0; k <= 8; ++k )
+			{
+				Vector3 const	local( box.m_Scale.m_X * i / 8.0f, box.m_Scale.m_Y * j / 8.0f, box.m_Scale.m_Z * k / 8.0f );
+				Vector3 const	sample	= box.m_Position + local * orientation;
+				best = std::min( best, ( sample - point ).Length() );
+			}
+		}
+	}
+	return best;
+}
+
+void ClosestPointTest::TestPointBox()
+{
+	for ( int i = 0; i < 200; ++i )
+	{
+		Box const	box	= RandomBox();
+
+		for ( int j = 0; j < 20; ++j )
+		{
+			Vector3 const	point	= RandomVector( 6.0f );
+			Vector3			closest;
+			float const		d		= MyMath::ClosestPoints( point, box, &closest );
+
+			CPPUNIT_ASSERT( IsInBox( box, closest ) );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( ( closest - point ).Length(), d, TOLERANCE );
+			CPPUNIT_ASSERT( d <= SampledDistance( box, point ) + TOLERANCE );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( d, Distance( Point( point ), box ), TOLERANCE );
+
+			// A point in the box is its own closest point, and the intersection test must agree.
+
+			if ( IsInBox( box, point ) )
+			{
+				CPPUNIT_ASSERT_DOUBLES_EQUAL( 0.0, d, TOLERANCE );
+			}
+			if ( d > TOLERANCE )
+			{
+				CPPUNIT_ASSERT( Point( point ).Intersects( box ) == Intersectable::NO_INTERSECTION );
+			}
+		}
+	}
+}
+
+void ClosestPointTest::TestSphereBox()
+{
+	for ( int i = 0; i < 500; ++i )
+	{
+		Box const		box	= RandomBox();
+		Sphere const	sphere( RandomVector( 6.0f ), 0.1f + std::fabs( Random() ) );
+		Vector3			pSphere;
+		Vector3			pBox;
+		float const		d	= MyMath::ClosestPoints( sphere, box, &pSphere, &pBox );
+		float const		e	= std::max( 0.0f, SampledDistance( box, sphere.m_C ) - sphere.m_R );
+
+		CPPUNIT_ASSERT( IsInBox( box, pBox ) );
+		CPPUNIT_ASSERT( ( pSphere - sphere.m_C ).Length() <= sphere.m_R + TOLERANCE );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( ( pSphere - pBox ).Length(), d, TOLERANCE );
+		CPPUNIT_ASSERT( d <= e + TOLERANCE );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( d, Distance( sphere, box ), TOLERANCE );
+	}
+}
+
+void ClosestPointTest::TestSegmentAABox()
+{
+	int const	SAMPLES	= 2000;
+
+	for ( int i = 0; i < 500; ++i )
+	{
+		AABox const		aabox( RandomVector( 3.0f ), RandomVector( 2.0f ) );
+		Vector3 const	lo		= aabox.m_Position;
+		Vector3 const	hi		= aabox.m_Position + aabox.m_Scale;
+		Vector3 const	p0		= RandomVector( 6.0f );
+		Vector3 const	p1		= RandomVector( 6.0f );
+		Segment const	segment( p0, p1 );
+		Vector3			pSegment;
+		Vector3			pAABox;
+		float const		d		= MyMath::ClosestPoints( segment, aabox, &pSegment, &pAABox );
+
+		// The reference clamps samples along the segment to the box.
+
+		float	best	= std::numeric_limits<float>::infinity();
+		for ( int j = 0; j <= SAMPLES; ++j )
+		{
+			Vector3 const	p	= p0 + ( p1 - p0 ) * ( float( j ) / SAMPLES );
+			Vector3			q;
+			best = std::min( best, MyMath::ClosestPoints( p, aabox, &q ) );
+		}
+
+		for ( int k = 0; k < 3; ++k )
+		{
+			CPPUNIT_ASSERT( pAABox.m_V[ k ] >= lo.m_V[ k ] - TOLERANCE && pAABox.m_V[ k ] <= hi.m_V[ k ] + TOLERANCE );
+		}
+		CPPUNIT_ASSERT( Distance( Point( pSegment ), segment ) <= TOLERANCE );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( ( pSegment - pAABox ).Length(), d, TOLERANCE );
+		CPPUNIT_ASSERT( d <= best + TOLERANCE );
+		CPPUNIT_ASSERT( d >= best - ( p1 - p0 ).Length() / SAMPLES - TOLERANCE );
+	}
+}
+
+void ClosestPointTest::TestSegmentSegment()
+{
+	int const	SAMPLES	= 400;
+
+	for ( int i = 0; i < 200; ++i )
+	{
+		Vector3 const	a0	= RandomVector( 5.0f );
+		Vector3 const	a1	= RandomVector( 5.0f );
+		Vector3 const	b0	= RandomVector( 5.0f );
+		Vector3 const	b1	= ( i % 7 == 0 ) ? b0 + ( a1 - a0 ) : RandomVector( 5.0f );    // Some are parallel
+		Segment const	a( a0, a1 );
+		Segment const	b( b0, b1 );
+		Vector3			pA;
+		Vector3			pB;
+		float const		d	= MyMath::ClosestPoints( a, b, &pA, &pB );
+
+		// The reference is the distance from samples along one segment to the other.
+
+		float	best	= std::numeric_limits<float>::infinity();
+		for ( int j = 0; j <= SAMPLES; ++j )
+		{
+			best = std::min( best, Distance( Point( a0 + ( a1 - a0 ) * ( float( j ) / SAMPLES ) ), b ) );
+		}
+
+		CPPUNIT_ASSERT( Distance( Point( pA ), a ) <= TOLERANCE );
+		CPPUNIT_ASSERT( Distance( Point( pB ), b ) <= TOLERANCE );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( ( pA - pB ).Length(), d, TOLERANCE );
+		CPPUNIT_ASSERT( d <= best + TOLERANCE );
+		CPPUNIT_ASSERT( d >= best - ( a1 - a0 ).Length() / SAMPLES - TOLERANCE );
+	}
+}
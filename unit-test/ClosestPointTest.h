@@ -0,0 +1,31 @@
+/********************************************************************************************************************
+
+                                                  ClosestPointTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/ClosestPoint.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class ClosestPointTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ClosestPointTest );
+	CPPUNIT_TEST( TestPointBox );
+	CPPUNIT_TEST( TestSphereBox );
+	CPPUNIT_TEST( TestSegmentAABox );
+	CPPUNIT_TEST( TestSegmentSegment );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestPointBox();
+	void TestSphereBox();
+	void TestSegmentAABox();
+	void TestSegmentSegment();
+};
@@ -0,0 +1,153 @@
+/********************************************************************************************************************
+
+                                                  FixedPointTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	The integer-only functions are compared against the double-precision functions. The error bounds are in units
+	of the least significant bit of the fixed-point value.
+
+ ********************************************************************************************************************/
+
+#include "FixedPointTest.h"
+
+#include "../include/MyMath/FixedPoint.h"
+#include "../include/MyMath/FixedVector3.h"
+
+#include <cmath>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( FixedPointTest );
+
+typedef FixedPoint< int32_t, 16 >	Fixed32;
+typedef FixedPoint< int64_t, 32 >	Fixed64;
+
+static double const	LSB32	= 1.0 / 65536.0;
+static double const	LSB64	= 1.0 / 4294967296.0;
+
+void FixedPointTest::TestSqrt()
+{
+	for ( double x = 0.0; x < 30000.0; x += 7.123 )
+	{
+		Fixed32 const	a( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::sqrt( double( a ) ), double( sqrt( a ) ), 0.5 * LSB32 );
+
+		Fixed64 const	b( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::sqrt( double( b ) ), double( sqrt( b ) ), 0.5 * LSB64 );
+	}
+}
+
+void FixedPointTest::TestTrigonometry()
+{
+	for ( double x = -1000.0; x < 1000.0; x += 0.0917 )
+	{
+		Fixed32 const	a( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::sin( double( a ) ), double( sin( a ) ), 3.0 * LSB32 );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::cos( double( a ) ), double( cos( a ) ), 3.0 * LSB32 );
+
+		Fixed64 const	b( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::sin( double( b ) ), double( sin( b ) ), 4.0 * LSB64 );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::cos( double( b ) ), double( cos( b ) ), 4.0 * LSB64 );
+
+		// The error of tan is amplified by 1 / cos**2
+
+		double const	c	= std::cos( double( a ) );
+		if ( std::fabs( c ) > 0.1 )
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( std::tan( double( a ) ), double( tan( a ) ), 3.0 * LSB32 / ( c * c ) );
+		}
+	}
+}
+
+void FixedPointTest::TestAtan2()
+{
+	for ( double y = -10.0; y < 10.0; y += 0.377 )
+	{
+		for ( double x = -10.0; x < 10.0; x += 0.411 )
+		{
+			Fixed32 const	ay( y );
+			Fixed32 const	ax( x );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( std::atan2( double( ay ), double( ax ) ), double( atan2( ay, ax ) ), 2.0 * LSB32 );
+
+			Fixed64 const	by( y );
+			Fixed64 const	bx( x );
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( std::atan2( double( by ), double( bx ) ), double( atan2( by, bx ) ), 2.0 * LSB64 );
+		}
+	}
+}
+
+void FixedPointTest::TestExpLog()
+{
+	for ( double x = -10.0; x < 10.0; x += 0.0131 )
+	{
+		Fixed32 const	a( x );
+		double const	e	= std::exp( double( a ) );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( e, double( exp( a ) ), 2.0 * LSB32 * ( e > 1.0 ? e : 1.0 ) );
+
+		Fixed64 const	b( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::exp( double( b ) ), double( exp( b ) ), 4.0 * LSB64 * ( e > 1.0 ? e : 1.0 ) );
+	}
+
+	for ( double x = 0.001; x < 30000.0; x = x * 1.01 + 0.001 )
+	{
+		Fixed32 const	a( x );
+		if ( a.Raw() > 0 )
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL( std::log( double( a ) ), double( log( a ) ), 2.0 * LSB32 );
+		}
+
+		Fixed64 const	b( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::log( double( b ) ), double( log( b ) ), 4.0 * LSB64 );
+	}
+
+	// Saturation and underflow
+
+	CPPUNIT_ASSERT( exp( Fixed32( 20.0 ) ).Raw() == std::numeric_limits< int32_t >::max() );
+	CPPUNIT_ASSERT( exp( Fixed32( -20.0 ) ).Raw() == 0 );
+}
+
+void FixedPointTest::TestBatch()
+{
+	typedef FixedVector3< int32_t, 16 >		Vector;
+	typedef FixedQuaternion< int32_t, 16 >	Rotation;
+
+	// The batch operations must produce exactly the same results as the scalar operations.
+
+	Fixed32	x[ 37 ];
+	Fixed32	y[ 37 ];
+	Fixed32	r[ 37 ];
+	Vector	a[ 37 ];
+	Vector	v[ 37 ];
+	Vector	b[ 37 ];
+
+	for ( int i = 0; i < 37; ++i )
+	{
+		x[ i ] = Fixed32::FromRaw( int32_t( 0x9e3779b9u * uint32_t( i + 1 ) ) );
+		y[ i ] = Fixed32::FromRaw( int32_t( 0x85ebca6bu * uint32_t( i + 1 ) ) );
+		a[ i ] = Vector( Fixed32( i ), Fixed32( 0.25 * i ), Fixed32( -i ) );
+		v[ i ] = Vector( Fixed32( 1.5 ), Fixed32( -0.125 * i ), Fixed32( 0.0625 * i ) );
+	}
+
+	Fixed32::Multiply( x, y, r, 37 );
+	for ( int i = 0; i < 37; ++i )
+	{
+		CPPUNIT_ASSERT( r[ i ].Raw() == Fixed32::Multiply( x[ i ], y[ i ] ).Raw() );
+	}
+
+	Fixed32 const	dt( 1.0 / 60.0 );
+	MyMath::MultiplyAdd( a, v, dt, b, 37 );
+	for ( int i = 0; i < 37; ++i )
+	{
+		Vector const	e	= a[ i ] + v[ i ] * dt;
+		CPPUNIT_ASSERT( b[ i ].m_X.Raw() == e.m_X.Raw() && b[ i ].m_Y.Raw() == e.m_Y.Raw() && b[ i ].m_Z.Raw() == e.m_Z.Raw() );
+	}
+
+	Rotation const	q( Vector::ZAxis(), Fixed32( 0.75 ) );
+	MyMath::Rotate( v, q, b, 37 );
+	for ( int i = 0; i < 37; ++i )
+	{
+		Vector	e	= v[ i ];
+		e.Rotate( q );
+		CPPUNIT_ASSERT( b[ i ].m_X.Raw() == e.m_X.Raw() && b[ i ].m_Y.Raw() == e.m_Y.Raw() && b[ i ].m_Z.Raw() == e.m_Z.Raw() );
+	}
+}
@@ -0,0 +1,34 @@
+/********************************************************************************************************************
+
+                                                   FixedPointTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/FixedPoint.h"
+#include "../include/MyMath/FixedVector3.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class FixedPointTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( FixedPointTest );
+	CPPUNIT_TEST( TestSqrt );
+	CPPUNIT_TEST( TestTrigonometry );
+	CPPUNIT_TEST( TestAtan2 );
+	CPPUNIT_TEST( TestExpLog );
+	CPPUNIT_TEST( TestBatch );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestSqrt();
+	void TestTrigonometry();
+	void TestAtan2();
+	void TestExpLog();
+	void TestBatch();
+};
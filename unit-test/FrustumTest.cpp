@@ -0,0 +1,442 @@
+/********************************************************************************************************************
+
+                                                   FrustumTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	Frustums extracted from view-projection matrices are compared with the frustums built directly in view space,
+	and their corners must lie on their sides. The conservative classifications must match Intersects(), and the
+	exact classifications are compared against brute-force references: the distance from a sphere's center to the
+	frustum's faces and edges, and a separating axis test of a box that projects all the corners onto every
+	candidate axis. Objects whose reference results are within a small tolerance of a boundary are skipped.
+
+ ********************************************************************************************************************/
+
+#include "FrustumTest.h"
+
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/Matrix44.h"
+#include "../include/MyMath/Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( FrustumTest );
+
+using namespace MyMath;
+
+static float const	TOLERANCE	= 1.0e-3f;
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 11223;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+static bool IsClose( Vector3 const & a, Vector3 const & b )
+{
+	return ( a - b ).Length() <= TOLERANCE * ( 1.0f + b.Length() );
+}
+
+static bool IsClose( Plane const & a, Plane const & b )
+{
+	return IsClose( a.m_N, b.m_N ) && std::fabs( a.m_D - b.m_D ) <= TOLERANCE * ( 1.0f + std::fabs( b.m_D ) );
+}
+
+// Frustums used for the classification tests
+static std::vector< Frustum > TestFrustums()
+{
+	std::vector< Frustum >	frustums;
+	frustums.push_back( Frustum::Perspective( 1.0f, 1.3f, 1.0f, 10.0f ) );
+	frustums.push_back( Frustum::Perspective( 0.3f, 0.5f, 0.1f, 20.0f ) );
+	frustums.push_back( Frustum::Perspective( 2.5f, 2.0f, 2.0f, 4.0f ) );
+	frustums.push_back( Frustum::Orthographic( 6.0f, 3.0f, -2.0f, 8.0f ) );
+	return frustums;
+}
+
+// Returns the corners of an axis-aligned box
+static void GetCorners( AABox const & box, Vector3 corners[ 8 ] )
+{
+	for ( int i = 0; i < 8; ++i )
+	{
+		corners[ i ] = Vector3( box.m_Position.m_X + ( ( i & 1 ) ? box.m_Scale.m_X : 0.0f ),
+								box.m_Position.m_Y + ( ( i & 2 ) ? box.m_Scale.m_Y : 0.0f ),
+								box.m_Position.m_Z + ( ( i & 4 ) ? box.m_Scale.m_Z : 0.0f ) );
+	}
+}
+
+// Returns the point on a segment closest to a point
+static Vector3 ClosestOnSegment( Vector3 const & p, Vector3 const & a, Vector3 const & b )
+{
+	Vector3 const	d	= b - a;
+	float const		t	= std::min( std::max( Dot( p - a, d ) / Dot( d, d ), 0.0f ), 1.0f );
+	return a + d * t;
+}
+
+// Returns the distance from a point to a frustum (0 if it is inside), using the projections onto the faces and the
+// closest points on the edges
+static float Distance( Frustum const & frustum, Vector3 const & p )
+{
+	float	d[ Frustum::NUM_SIDES ];
+	bool	inside	= true;
+	for ( int i = 0; i < Frustum::NUM_SIDES; ++i )
+	{
+		d[ i ] = frustum.sides_[ i ].DirectedDistance( p );
+		inside = inside && d[ i ] <= 0.0f;
+	}
+	if ( inside )
+	{
+		return 0.0f;
+	}
+
+	float	best	= std::numeric_limits< float >::infinity();
+	for ( int i = 0; i < Frustum::NUM_SIDES; ++i )
+	{
+		Vector3 const	q		= p - frustum.sides_[ i ].m_N * d[ i ];
+		bool			onFace	= true;
+		for ( int j = 0; j < Frustum::NUM_SIDES; ++j )
+		{
+			onFace = onFace && ( j == i || frustum.sides_[ j ].DirectedDistance( q ) <= 1.0e-5f );
+		}
+		if ( onFace )
+		{
+			best = std::min( best, std::fabs( d[ i ] ) );
+		}
+	}
+	for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+	{
+		for ( int bit = 1; bit < Frustum::NUM_CORNERS; bit <<= 1 )
+		{
+			if ( ( i & bit ) == 0 )
+			{
+				Vector3 const	c	= ClosestOnSegment( p, frustum.GetCorner( i ), frustum.GetCorner( i | bit ) );
+				best = std::min( best, ( c - p ).Length() );
+			}
+		}
+	}
+	return best;
+}
+
+// Returns the reference classification of a sphere, or -1 if it is within the tolerance of a boundary
+static int Reference( Frustum const & frustum, Sphere const & sphere )
+{
+	float const	distance	= Distance( frustum, sphere.m_C );
+
+	float	maxSide	= -std::numeric_limits< float >::infinity();
+	for ( Plane const & side : frustum.sides_ )
+	{
+		maxSide = std::max( maxSide, side.DirectedDistance( sphere.m_C ) );
+	}
+
+	float	maxCorner	= 0.0f;
+	for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+	{
+		maxCorner = std::max( maxCorner, ( frustum.GetCorner( i ) - sphere.m_C ).Length() );
+	}
+
+	if ( std::fabs( distance - sphere.m_R ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	if ( distance > sphere.m_R )
+	{
+		return Intersectable::NO_INTERSECTION;
+	}
+	if ( std::fabs( maxSide + sphere.m_R ) <= TOLERANCE || std::fabs( maxCorner - sphere.m_R ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	if ( maxSide + sphere.m_R <= 0.0f )
+	{
+		return Intersectable::ENCLOSED_BY;
+	}
+	if ( maxCorner <= sphere.m_R )
+	{
+		return Intersectable::ENCLOSES;
+	}
+	return Intersectable::INTERSECTS;
+}
+
+// Returns the reference classification of a box, or -1 if it is within the tolerance of a boundary
+static int Reference( Frustum const & frustum, AABox const & box )
+{
+	Vector3	boxCorners[ 8 ];
+	GetCorners( box, boxCorners );
+
+	Vector3	frustumCorners[ Frustum::NUM_CORNERS ];
+	for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+	{
+		frustumCorners[ i ] = frustum.GetCorner( i );
+	}
+
+	// Candidate axes: the box's axes, the frustum's normals and the cross products of the box's axes with the
+	// frustum's edges
+	std::vector< Vector3 >	axes	= { Vector3( 1.0f, 0.0f, 0.0f ),
+										Vector3( 0.0f, 1.0f, 0.0f ),
+										Vector3( 0.0f, 0.0f, 1.0f ) };
+	for ( Plane const & side : frustum.sides_ )
+	{
+		axes.push_back( side.m_N );
+	}
+	for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+	{
+		for ( int bit = 1; bit < Frustum::NUM_CORNERS; bit <<= 1 )
+		{
+			if ( ( i & bit ) == 0 )
+			{
+				Vector3 const	edge	= frustumCorners[ i | bit ] - frustumCorners[ i ];
+				for ( int k = 0; k < 3; ++k )
+				{
+					axes.push_back( Cross( axes[ k ], edge ) );
+				}
+			}
+		}
+	}
+
+	// The greatest gap between the projections. If it is negative, its magnitude is the penetration depth.
+	float	gap	= -std::numeric_limits< float >::infinity();
+	for ( Vector3 axis : axes )
+	{
+		if ( axis.Length() < 1.0e-4f )
+		{
+			continue;
+		}
+		axis *= 1.0f / axis.Length();
+
+		float	boxMin		= std::numeric_limits< float >::infinity();
+		float	boxMax		= -boxMin;
+		float	frustumMin	= boxMin;
+		float	frustumMax	= -boxMin;
+		for ( int i = 0; i < 8; ++i )
+		{
+			boxMin = std::min( boxMin, Dot( boxCorners[ i ], axis ) );
+			boxMax = std::max( boxMax, Dot( boxCorners[ i ], axis ) );
+			frustumMin = std::min( frustumMin, Dot( frustumCorners[ i ], axis ) );
+			frustumMax = std::max( frustumMax, Dot( frustumCorners[ i ], axis ) );
+		}
+		gap = std::max( gap, std::max( boxMin - frustumMax, frustumMin - boxMax ) );
+	}
+
+	float	maxSide	= -std::numeric_limits< float >::infinity();
+	for ( Plane const & side : frustum.sides_ )
+	{
+		for ( Vector3 const & c : boxCorners )
+		{
+			maxSide = std::max( maxSide, side.DirectedDistance( c ) );
+		}
+	}
+
+	float	outside	= -std::numeric_limits< float >::infinity();
+	for ( Vector3 const & c : frustumCorners )
+	{
+		for ( int k = 0; k < 3; ++k )
+		{
+			outside = std::max( outside, box.m_Position.m_V[ k ] - c.m_V[ k ] );
+			outside = std::max( outside, c.m_V[ k ] - box.m_Position.m_V[ k ] - box.m_Scale.m_V[ k ] );
+		}
+	}
+
+	if ( std::fabs( gap ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	if ( gap > 0.0f )
+	{
+		return Intersectable::NO_INTERSECTION;
+	}
+	if ( std::fabs( maxSide ) <= TOLERANCE || std::fabs( outside ) <= TOLERANCE )
+	{
+		return -1;
+	}
+	if ( maxSide < 0.0f )
+	{
+		return Intersectable::ENCLOSED_BY;
+	}
+	if ( outside < 0.0f )
+	{
+		return Intersectable::ENCLOSES;
+	}
+	return Intersectable::INTERSECTS;
+}
+
+void FrustumTest::TestCorners()
+{
+	float const		tanY	= std::tan( 0.5f );
+	float const		tanX	= tanY * 1.5f;
+	Frustum const	frustum	= Frustum::Perspective( 1.0f, 1.5f, 2.0f, 7.0f );
+
+	for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+	{
+		float const		z	= ( i & Frustum::BACK_CORNER ) ? 7.0f : 2.0f;
+		Vector3 const	expected( ( ( i & Frustum::RIGHT_CORNER ) ? tanX : -tanX ) * z,
+								  ( ( i & Frustum::TOP_CORNER ) ? tanY : -tanY ) * z,
+								  z );
+		CPPUNIT_ASSERT( IsClose( frustum.GetCorner( i ), expected ) );
+	}
+
+	// Each corner is on three sides and behind the others
+	for ( Frustum const & f : TestFrustums() )
+	{
+		for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+		{
+			int const	on[ 3 ]	= { ( i & Frustum::RIGHT_CORNER ) ? Frustum::RIGHT_SIDE : Frustum::LEFT_SIDE,
+									( i & Frustum::TOP_CORNER ) ? Frustum::TOP_SIDE : Frustum::BOTTOM_SIDE,
+									( i & Frustum::BACK_CORNER ) ? Frustum::BACK_SIDE : Frustum::FRONT_SIDE };
+			for ( int s = 0; s < Frustum::NUM_SIDES; ++s )
+			{
+				float const	d	= f.sides_[ s ].DirectedDistance( f.GetCorner( i ) );
+				if ( s == on[ 0 ] || s == on[ 1 ] || s == on[ 2 ] )
+				{
+					CPPUNIT_ASSERT( std::fabs( d ) < TOLERANCE );
+				}
+				else
+				{
+					CPPUNIT_ASSERT( d < 0.0f );
+				}
+			}
+		}
+	}
+}
+
+void FrustumTest::TestFromViewProjection()
+{
+	float const	n	= 0.5f;
+	float const	f	= 50.0f;
+
+	// Direct3D projections (row vectors)
+	float const		ys	= 1.0f / std::tan( 0.4f );
+	float const		xs	= ys / 1.6f;
+	Matrix44 const	perspective( xs, 0.0f, 0.0f, 0.0f,
+								 0.0f, ys, 0.0f, 0.0f,
+								 0.0f, 0.0f, f / ( f - n ), 1.0f,
+								 0.0f, 0.0f, -n * f / ( f - n ), 0.0f );
+	Matrix44 const	orthographic( 2.0f / 8.0f, 0.0f, 0.0f, 0.0f,
+								  0.0f, 2.0f / 5.0f, 0.0f, 0.0f,
+								  0.0f, 0.0f, 1.0f / ( f - n ), 0.0f,
+								  0.0f, 0.0f, -n / ( f - n ), 1.0f );
+
+	Frustum const	expected[ 2 ]	= { Frustum::Perspective( 0.8f, 1.6f, n, f ),
+										Frustum::Orthographic( 8.0f, 5.0f, n, f ) };
+	Matrix44 const	projections[ 2 ]	= { perspective, orthographic };
+
+	for ( int p = 0; p < 2; ++p )
+	{
+		Frustum const	frustum	= Frustum::FromViewProjection( projections[ p ] );
+		for ( int s = 0; s < Frustum::NUM_SIDES; ++s )
+		{
+			CPPUNIT_ASSERT( IsClose( frustum.sides_[ s ], expected[ p ].sides_[ s ] ) );
+		}
+		for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+		{
+			CPPUNIT_ASSERT( IsClose( frustum.GetCorner( i ), expected[ p ].GetCorner( i ) ) );
+		}
+
+		// A view matrix that moves the camera to t moves the frustum to t
+		Vector3 const	t( 3.0f, -2.0f, 7.0f );
+		Matrix44		viewProjection( 1.0f, 0.0f, 0.0f, 0.0f,
+										0.0f, 1.0f, 0.0f, 0.0f,
+										0.0f, 0.0f, 1.0f, 0.0f,
+										-t.m_X, -t.m_Y, -t.m_Z, 1.0f );
+		viewProjection *= projections[ p ];
+
+		Frustum const	moved	= Frustum::FromViewProjection( viewProjection );
+		for ( int i = 0; i < Frustum::NUM_CORNERS; ++i )
+		{
+			CPPUNIT_ASSERT( IsClose( moved.GetCorner( i ), expected[ p ].GetCorner( i ) + t ) );
+		}
+	}
+}
+
+void FrustumTest::TestClassifyEmpty()
+{
+	Frustum const			frustum	= Frustum::Perspective( 1.0f, 1.0f, 1.0f, 10.0f );
+	Intersectable::Result	result	= Intersectable::ENCLOSES;
+
+	Classify( frustum, static_cast< Sphere const * >( nullptr ), 0, &result, Frustum::EXACT );
+	Classify( frustum, static_cast< AABox const * >( nullptr ), 0, &result, Frustum::EXACT );
+	CPPUNIT_ASSERT_EQUAL( Intersectable::ENCLOSES, result );
+}
+
+void FrustumTest::TestClassifySpheres()
+{
+	for ( Frustum const & frustum : TestFrustums() )
+	{
+		std::vector< Sphere >	spheres;
+		for ( int i = 0; i < 3000; ++i )
+		{
+			Vector3 const	c( Random() * 12.0f, Random() * 10.0f, 5.0f + Random() * 12.0f );
+			float const		r	= ( i % 50 == 0 ) ? 0.0f : ( i % 17 == 0 ) ? 30.0f : 4.0f * std::fabs( Random() );
+			spheres.push_back( Sphere( c, r ) );
+		}
+
+		int const								n	= int( spheres.size() );
+		std::vector< Intersectable::Result >	conservative( n );
+		std::vector< Intersectable::Result >	exact( n );
+		Classify( frustum, spheres.data(), n, conservative.data(), Frustum::CONSERVATIVE );
+		Classify( frustum, spheres.data(), n, exact.data(), Frustum::EXACT );
+
+		for ( int i = 0; i < n; ++i )
+		{
+			CPPUNIT_ASSERT_EQUAL( spheres[ i ].Intersects( frustum ), conservative[ i ] );
+			if ( conservative[ i ] != Intersectable::INTERSECTS )
+			{
+				CPPUNIT_ASSERT_EQUAL( conservative[ i ], exact[ i ] );
+			}
+
+			int const	expected	= Reference( frustum, spheres[ i ] );
+			if ( expected >= 0 )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, int( exact[ i ] ) );
+			}
+		}
+	}
+}
+
+void FrustumTest::TestClassifyAABoxes()
+{
+	for ( Frustum const & frustum : TestFrustums() )
+	{
+		std::vector< AABox >	boxes;
+		for ( int i = 0; i < 3000; ++i )
+		{
+			Vector3 const	p( Random() * 12.0f, Random() * 10.0f, 5.0f + Random() * 12.0f );
+			Vector3			size( 5.0f * std::fabs( Random() ), 5.0f * std::fabs( Random() ), 5.0f * std::fabs( Random() ) );
+			if ( i % 50 == 0 )
+			{
+				size = Vector3( 0.0f, 0.0f, 0.0f );
+			}
+			else if ( i % 17 == 0 )
+			{
+				size *= 20.0f;
+			}
+			boxes.push_back( AABox( p - size * 0.5f, size ) );
+		}
+
+		int const								n	= int( boxes.size() );
+		std::vector< Intersectable::Result >	conservative( n );
+		std::vector< Intersectable::Result >	exact( n );
+		Classify( frustum, boxes.data(), n, conservative.data(), Frustum::CONSERVATIVE );
+		Classify( frustum, boxes.data(), n, exact.data(), Frustum::EXACT );
+
+		for ( int i = 0; i < n; ++i )
+		{
+			CPPUNIT_ASSERT_EQUAL( boxes[ i ].Intersects( frustum ), conservative[ i ] );
+			if ( conservative[ i ] != Intersectable::INTERSECTS )
+			{
+				CPPUNIT_ASSERT_EQUAL( conservative[ i ], exact[ i ] );
+			}
+
+			int const	expected	= Reference( frustum, boxes[ i ] );
+			if ( expected >= 0 )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, int( exact[ i ] ) );
+			}
+		}
+	}
+}
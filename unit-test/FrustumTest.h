@@ -0,0 +1,33 @@
+/********************************************************************************************************************
+
+                                                    FrustumTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Frustum.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class FrustumTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( FrustumTest );
+	CPPUNIT_TEST( TestCorners );
+	CPPUNIT_TEST( TestFromViewProjection );
+	CPPUNIT_TEST( TestClassifyEmpty );
+	CPPUNIT_TEST( TestClassifySpheres );
+	CPPUNIT_TEST( TestClassifyAABoxes );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestCorners();
+	void TestFromViewProjection();
+	void TestClassifyEmpty();
+	void TestClassifySpheres();
+	void TestClassifyAABoxes();
+};
@@ -0,0 +1,139 @@
+/********************************************************************************************************************
+
+                                                    GammaTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	LogGamma() and Gamma() are compared against std::lgamma() and std::tgamma() for positive values, negative
+	non-integers and values in the table. Non-positive integers and NaN must return without recursing forever, and
+	the batch form must give the same results as the scalar form.
+
+ ********************************************************************************************************************/
+
+#include "GammaTest.h"
+
+#include "../include/MyMath/MyMath.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GammaTest );
+
+using namespace MyMath;
+
+// Values that cover the table, the Stirling series, small values and the reflection
+static std::vector< double > TestValues()
+{
+	std::vector< double >	values;
+	for ( int i = 1; i <= 1100; ++i )
+	{
+		values.push_back( double( i ) );
+	}
+	for ( double x = -20.75; x < 200.0; x += 0.37 )
+	{
+		if ( x != std::floor( x ) )
+		{
+			values.push_back( x );
+		}
+	}
+	values.push_back( 1.0e-8 );
+	values.push_back( 0.5 );
+	values.push_back( -0.5 );
+	values.push_back( 1.0e5 + 0.5 );
+	return values;
+}
+
+void GammaTest::TestLogGamma()
+{
+	for ( double x : TestValues() )
+	{
+		double const	expected	= std::lgamma( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( expected, LogGamma( x ), 1.0e-12 * std::max( 1.0, std::fabs( expected ) ) );
+	}
+}
+
+void GammaTest::TestGamma()
+{
+	for ( double x : TestValues() )
+	{
+		if ( x > 170.0 )
+		{
+			continue;
+		}
+		double const	expected	= std::tgamma( x );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( expected, Gamma( x ), 1.0e-12 * std::fabs( expected ) );
+	}
+
+	for ( int n = 0; n <= 20; ++n )
+	{
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::tgamma( n + 1.0 ), Factorial( double( n ) ), 1.0e-15 * std::tgamma( n + 1.0 ) );
+	}
+}
+
+void GammaTest::TestSpecialValues()
+{
+	double const	nan	= std::numeric_limits<double>::quiet_NaN();
+	double const	inf	= std::numeric_limits<double>::infinity();
+
+	// NaN
+
+	CPPUNIT_ASSERT( std::isnan( LogGamma( nan ) ) );
+	CPPUNIT_ASSERT( std::isnan( LogGamma( -nan ) ) );
+	CPPUNIT_ASSERT( std::isnan( Gamma( nan ) ) );
+	CPPUNIT_ASSERT( std::isnan( Factorial( nan ) ) );
+
+	// Non-positive integers are poles
+
+	for ( int n = 0; n >= -30; --n )
+	{
+		CPPUNIT_ASSERT_EQUAL( inf, LogGamma( double( n ) ) );
+		CPPUNIT_ASSERT( std::isnan( Gamma( double( n ) ) ) );
+	}
+	CPPUNIT_ASSERT_EQUAL( inf, LogGamma( -1.0e10 ) );
+
+	// Negative non-integers are finite and alternate in sign
+
+	for ( int n = 0; n < 30; ++n )
+	{
+		double const	x	= -n - 0.5;
+		double const	g	= Gamma( x );
+		CPPUNIT_ASSERT( std::isfinite( LogGamma( x ) ) );
+		CPPUNIT_ASSERT( std::isfinite( g ) );
+		CPPUNIT_ASSERT( ( g < 0.0 ) == ( n % 2 == 0 ) );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( std::lgamma( x ), LogGamma( x ), 1.0e-12 * std::max( 1.0, std::fabs( std::lgamma( x ) ) ) );
+	}
+
+	// Infinities
+
+	CPPUNIT_ASSERT_EQUAL( inf, LogGamma( inf ) );
+	CPPUNIT_ASSERT_EQUAL( inf, Gamma( inf ) );
+}
+
+void GammaTest::TestBatch()
+{
+	std::vector< double >	x	= TestValues();
+	x.push_back( std::numeric_limits<double>::quiet_NaN() );
+	x.push_back( 0.0 );
+	x.push_back( -3.0 );
+	x.push_back( -3.25 );
+
+	std::vector< double >	r( x.size() );
+	LogGamma( x.data(), r.data(), x.size() );
+
+	for ( size_t i = 0; i < x.size(); ++i )
+	{
+		double const	expected	= LogGamma( x[ i ] );
+		CPPUNIT_ASSERT( r[ i ] == expected || ( std::isnan( r[ i ] ) && std::isnan( expected ) ) );
+	}
+
+	// In place
+
+	std::vector< double >	y	= x;
+	LogGamma( y.data(), y.data(), y.size() );
+	for ( size_t i = 0; i < x.size(); ++i )
+	{
+		CPPUNIT_ASSERT( y[ i ] == r[ i ] || ( std::isnan( y[ i ] ) && std::isnan( r[ i ] ) ) );
+	}
+}
@@ -0,0 +1,31 @@
+/********************************************************************************************************************
+
+                                                     GammaTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/MyMath.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class GammaTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( GammaTest );
+	CPPUNIT_TEST( TestLogGamma );
+	CPPUNIT_TEST( TestGamma );
+	CPPUNIT_TEST( TestSpecialValues );
+	CPPUNIT_TEST( TestBatch );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestLogGamma();
+	void TestGamma();
+	void TestSpecialValues();
+	void TestBatch();
+};
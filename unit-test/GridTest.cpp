@@ -0,0 +1,196 @@
+/********************************************************************************************************************
+
+                                                     GridTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	The batch forms of SampleBilinear() and SampleTrilinear() for float grids (which gather 8 points at a time with
+	AVX2) are compared against the scalar forms for points inside and outside the grid, for infinities and NaN, and
+	for counts that are not multiples of 8. A point on a grid point must sample its value exactly.
+
+ ********************************************************************************************************************/
+
+#include "GridTest.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GridTest );
+
+using namespace MyMath;
+
+static float Random()
+{
+	static uint32_t	state	= 97531;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+// Returns true if a sample from the batch form matches the scalar form (they may round differently)
+static bool IsClose( float a, float b )
+{
+	return std::isfinite( a ) && std::isfinite( b ) && std::fabs( a - b ) <= 1.0e-4f * ( 1.0f + std::fabs( b ) );
+}
+
+// Coordinates that are inside, outside and on the edges of a grid of the given size
+static float Coordinate( int i, int size )
+{
+	float const	inf	= std::numeric_limits< float >::infinity();
+	float const	nan	= std::numeric_limits< float >::quiet_NaN();
+	float const	special[]	= { 0.0f, float( size - 1 ), -1.0f, float( size ), inf, -inf, nan, -0.0f, 1.0e30f };
+
+	int const	nSpecial	= int( sizeof( special ) / sizeof( special[ 0 ] ) );
+	if ( i % 3 == 0 )
+	{
+		return special[ ( i / 3 ) % nSpecial ];
+	}
+	return ( Random() * 0.6f + 0.5f ) * float( size - 1 );
+}
+
+static Grid2< float > MakeGrid2( int sizeX, int sizeY )
+{
+	Grid2< float >	grid( sizeX, sizeY );
+	for ( int y = 0; y < sizeY; ++y )
+	{
+		for ( int x = 0; x < sizeX; ++x )
+		{
+			grid( x, y ) = Random() * 100.0f;
+		}
+	}
+	return grid;
+}
+
+static Grid3< float > MakeGrid3( int sizeX, int sizeY, int sizeZ )
+{
+	Grid3< float >	grid( sizeX, sizeY, sizeZ );
+	for ( int z = 0; z < sizeZ; ++z )
+	{
+		for ( int y = 0; y < sizeY; ++y )
+		{
+			for ( int x = 0; x < sizeX; ++x )
+			{
+				grid( x, y, z ) = Random() * 100.0f;
+			}
+		}
+	}
+	return grid;
+}
+
+static void CheckBilinear( Grid2< float > const & grid, std::vector< Vector2 > const & points )
+{
+	std::vector< float >	results( points.size() + 1, -12345.0f );
+	SampleBilinear( grid, points.data(), results.data(), points.size() );
+
+	for ( size_t i = 0; i < points.size(); ++i )
+	{
+		CPPUNIT_ASSERT( IsClose( results[ i ], SampleBilinear( grid, points[ i ] ) ) );
+	}
+	CPPUNIT_ASSERT_EQUAL( -12345.0f, results[ points.size() ] );
+}
+
+static void CheckTrilinear( Grid3< float > const & grid, std::vector< Vector3 > const & points )
+{
+	std::vector< float >	results( points.size() + 1, -12345.0f );
+	SampleTrilinear( grid, points.data(), results.data(), points.size() );
+
+	for ( size_t i = 0; i < points.size(); ++i )
+	{
+		CPPUNIT_ASSERT( IsClose( results[ i ], SampleTrilinear( grid, points[ i ] ) ) );
+	}
+	CPPUNIT_ASSERT_EQUAL( -12345.0f, results[ points.size() ] );
+}
+
+void GridTest::TestBilinear()
+{
+	int const	sizes[][ 2 ]	= { { 1, 1 }, { 1, 7 }, { 5, 3 }, { 16, 16 }, { 37, 21 } };
+
+	for ( auto const & size : sizes )
+	{
+		Grid2< float > const	grid	= MakeGrid2( size[ 0 ], size[ 1 ] );
+
+		// Grid points sample their values exactly
+		for ( int y = 0; y < size[ 1 ]; ++y )
+		{
+			for ( int x = 0; x < size[ 0 ]; ++x )
+			{
+				CPPUNIT_ASSERT_EQUAL( grid( x, y ), SampleBilinear( grid, Vector2( float( x ), float( y ) ) ) );
+			}
+		}
+
+		// Counts that are not multiples of 8 exercise the scalar tail of the batch form
+		for ( int count : { 0, 1, 7, 8, 9, 23, 200 } )
+		{
+			std::vector< Vector2 >	points;
+			for ( int i = 0; i < count; ++i )
+			{
+				points.push_back( Vector2( Coordinate( i, size[ 0 ] ), Coordinate( i + 1, size[ 1 ] ) ) );
+			}
+			CheckBilinear( grid, points );
+		}
+	}
+}
+
+void GridTest::TestTrilinear()
+{
+	int const	sizes[][ 3 ]	= { { 1, 1, 1 }, { 1, 6, 2 }, { 4, 4, 4 }, { 5, 9, 3 }, { 13, 7, 17 } };
+
+	for ( auto const & size : sizes )
+	{
+		Grid3< float > const	grid	= MakeGrid3( size[ 0 ], size[ 1 ], size[ 2 ] );
+
+		// Grid points sample their values exactly
+		for ( int z = 0; z < size[ 2 ]; ++z )
+		{
+			for ( int y = 0; y < size[ 1 ]; ++y )
+			{
+				for ( int x = 0; x < size[ 0 ]; ++x )
+				{
+					Vector3 const	p( static_cast< float >( x ), static_cast< float >( y ), static_cast< float >( z ) );
+					CPPUNIT_ASSERT_EQUAL( grid( x, y, z ), SampleTrilinear( grid, p ) );
+				}
+			}
+		}
+
+		for ( int count : { 0, 1, 7, 8, 9, 23, 200 } )
+		{
+			std::vector< Vector3 >	points;
+			for ( int i = 0; i < count; ++i )
+			{
+				points.push_back( Vector3( Coordinate( i, size[ 0 ] ),
+										   Coordinate( i + 1, size[ 1 ] ),
+										   Coordinate( i + 2, size[ 2 ] ) ) );
+			}
+			CheckTrilinear( grid, points );
+		}
+	}
+}
+
+void GridTest::TestSpecialValues()
+{
+	float const	inf	= std::numeric_limits< float >::infinity();
+	float const	nan	= std::numeric_limits< float >::quiet_NaN();
+
+	// NaN is clamped to 0 and infinities are clamped to the edges, in both the scalar and the batch forms
+	{
+		Grid2< float > const	grid	= MakeGrid2( 6, 5 );
+
+		CPPUNIT_ASSERT_EQUAL( grid( 0, 0 ), SampleBilinear( grid, Vector2( nan, nan ) ) );
+		CPPUNIT_ASSERT_EQUAL( grid( 5, 0 ), SampleBilinear( grid, Vector2( inf, -inf ) ) );
+		CPPUNIT_ASSERT_EQUAL( grid( 0, 4 ), SampleBilinear( grid, Vector2( nan, inf ) ) );
+
+		std::vector< Vector2 >	points( 11, Vector2( nan, inf ) );
+		CheckBilinear( grid, points );
+	}
+	{
+		Grid3< float > const	grid	= MakeGrid3( 6, 5, 9 );
+
+		CPPUNIT_ASSERT_EQUAL( grid( 0, 0, 0 ), SampleTrilinear( grid, Vector3( nan, nan, nan ) ) );
+		CPPUNIT_ASSERT_EQUAL( grid( 5, 0, 8 ), SampleTrilinear( grid, Vector3( inf, -inf, inf ) ) );
+		CPPUNIT_ASSERT_EQUAL( grid( 0, 4, 0 ), SampleTrilinear( grid, Vector3( nan, inf, -nan ) ) );
+
+		std::vector< Vector3 >	points( 11, Vector3( nan, inf, nan ) );
+		CheckTrilinear( grid, points );
+	}
+}
@@ -0,0 +1,30 @@
+/********************************************************************************************************************
+
+                                                      GridTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Grid2.h"
+#include "../include/MyMath/Grid3.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class GridTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( GridTest );
+	CPPUNIT_TEST( TestBilinear );
+	CPPUNIT_TEST( TestTrilinear );
+	CPPUNIT_TEST( TestSpecialValues );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestBilinear();
+	void TestTrilinear();
+	void TestSpecialValues();
+};
@@ -0,0 +1,155 @@
+/********************************************************************************************************************
+
+                                               InstrumentationTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	Each call of an instrumented function must add exactly 1 to its own counter and nothing to the counters of the
+	functions it is implemented with. Functions that are not implemented must not be counted.
+
+	The library and this test must be built with MYMATH_INSTRUMENTATION=1. Otherwise, the tests do nothing.
+
+ ********************************************************************************************************************/
+
+#include "InstrumentationTest.h"
+
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/Instrumentation.h"
+#include "../include/MyMath/Line.h"
+#include "../include/MyMath/Plane.h"
+#include "../include/MyMath/Point.h"
+
+#include <cstdint>
+#include <string>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( InstrumentationTest );
+
+#if MYMATH_INSTRUMENTATION
+
+using namespace MyMath::Instrumentation;
+
+// Gives access to the static intersection functions
+class Access : public Intersectable
+{
+public:
+	using Intersectable::Intersection;
+};
+
+// Returns the count of a counter in a snapshot, or 0 if it has not been counted
+static uint64_t GetCount( Snapshot const & snapshot, char const * name )
+{
+	for ( Snapshot::Entry const & entry : snapshot.m_Entries )
+	{
+		if ( entry.m_Name == name )
+		{
+			return entry.m_Count;
+		}
+	}
+	return 0;
+}
+
+// Returns the number of times a counter was counted between two snapshots
+static uint64_t GetCalls( Snapshot const & before, Snapshot const & after, char const * name )
+{
+	return GetCount( after, name ) - GetCount( before, name );
+}
+
+#endif // MYMATH_INSTRUMENTATION
+
+
+void InstrumentationTest::TestOneCountPerCall()
+{
+#if MYMATH_INSTRUMENTATION
+	Plane const		plane( Vector3( 0.0f, 0.0f, 1.0f ), 0.0f );
+	HalfSpace const	halfspace( plane );
+	AABox const		aabox( Vector3( -1.0f, -1.0f, -1.0f ), Vector3( 2.0f, 2.0f, 2.0f ) );
+	Line const		line( Vector3( 1.0f, 0.0f, 0.0f ), Vector3( 0.0f, 0.0f, -1.0f ) );
+	Line const		line2( Vector3( 0.0f, 1.0f, 0.0f ), Vector3( 0.0f, 0.0f, -1.0f ) );
+	Line const		crossing( Vector3( 0.0f, 0.0f, 1.0f ), Vector3( 0.0f, 0.0f, 0.0f ) );
+	Segment const	s0( Vector3( -0.5f, 0.0f, 0.0f ), Vector3( 0.5f, 0.0f, 0.0f ) );
+	Segment const	s1( Vector3( 0.0f, -0.5f, 0.0f ), Vector3( 0.0f, 0.5f, 0.0f ) );
+	Point			p;
+
+	{
+		Snapshot const	before	= Snapshot::Take();
+		plane.Intersects( aabox );
+		Snapshot const	after	= Snapshot::Take();
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ), GetCalls( before, after, "Intersects(Plane, AABox)" ) );
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), GetCalls( before, after, "Intersects(HalfSpace, AABox)" ) );
+	}
+
+	{
+		Snapshot const	before	= Snapshot::Take();
+		halfspace.Intersects( aabox );
+		Snapshot const	after	= Snapshot::Take();
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ), GetCalls( before, after, "Intersects(HalfSpace, AABox)" ) );
+	}
+
+	{
+		Snapshot const	before	= Snapshot::Take();
+		line.Intersects( halfspace );
+		Snapshot const	after	= Snapshot::Take();
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ), GetCalls( before, after, "Intersects(Line, HalfSpace)" ) );
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), GetCalls( before, after, "Intersects(Point, HalfSpace)" ) );
+	}
+
+	{
+		Snapshot const	before	= Snapshot::Take();
+		CPPUNIT_ASSERT_EQUAL( 1, Access::Intersection( line, line2, &p ) );
+		Snapshot const	after	= Snapshot::Take();
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ), GetCalls( before, after, "Intersection(Line, Line)" ) );
+	}
+
+	{
+		Snapshot const	before	= Snapshot::Take();
+		Access::Intersection( s0, s1, &p );
+		Snapshot const	after	= Snapshot::Take();
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ), GetCalls( before, after, "Intersection(Segment, Segment)" ) );
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), GetCalls( before, after, "Intersection(Line, Line)" ) );
+	}
+
+	{
+		Snapshot const	before	= Snapshot::Take();
+		CPPUNIT_ASSERT_EQUAL( 1, Access::Intersection( crossing, plane, &p ) );
+		Snapshot const	after	= Snapshot::Take();
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 1 ), GetCalls( before, after, "Intersection(Line, Plane)" ) );
+	}
+
+	{
+		Snapshot const	before	= Snapshot::Take();
+		for ( int i = 0; i < 10; ++i )
+		{
+			plane.Intersects( aabox );
+		}
+		Snapshot const	after	= Snapshot::Take();
+
+		CPPUNIT_ASSERT_EQUAL( uint64_t( 10 ), GetCalls( before, after, "Intersects(Plane, AABox)" ) );
+	}
+#endif // MYMATH_INSTRUMENTATION
+}
+
+void InstrumentationTest::TestStubsNotCounted()
+{
+#if MYMATH_INSTRUMENTATION
+	Line const		line( Vector3( 1.0f, 0.0f, 0.0f ), Vector3( 0.0f, 0.0f, 0.0f ) );
+	Ray const		ray( Vector3( 0.0f, 1.0f, 0.0f ), Vector3( 0.0f, 0.0f, 0.0f ) );
+	Plane const		plane( Vector3( 0.0f, 0.0f, 1.0f ), 0.0f );
+	Box const		box( Matrix33::Identity(), Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 1.0f, 1.0f, 1.0f ) );
+
+	Snapshot const	before	= Snapshot::Take();
+	line.Intersects( ray );
+	plane.Intersects( box );
+	Snapshot const	after	= Snapshot::Take();
+
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), GetCalls( before, after, "Intersects(Ray, Line)" ) );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), GetCalls( before, after, "Intersects(Line, Ray)" ) );
+	CPPUNIT_ASSERT_EQUAL( uint64_t( 0 ), GetCalls( before, after, "Intersects(Plane, Box)" ) );
+#endif // MYMATH_INSTRUMENTATION
+}
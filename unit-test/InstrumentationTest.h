@@ -0,0 +1,27 @@
+/********************************************************************************************************************
+
+                                                InstrumentationTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Instrumentation.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class InstrumentationTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( InstrumentationTest );
+	CPPUNIT_TEST( TestOneCountPerCall );
+	CPPUNIT_TEST( TestStubsNotCounted );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestOneCountPerCall();
+	void TestStubsNotCounted();
+};
@@ -0,0 +1,348 @@
+/********************************************************************************************************************
+
+                                                   IntervalTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	IntervalSet and IntervalTree are compared against testing each of the original ranges with Range's operator ==,
+	for all four combinations of open and closed ends. The ends are integers and the values tested are multiples of
+	0.5, so the ends themselves and the values between them are both tested. Ranges include degenerate ranges with
+	equal ends (which are empty unless both ends are closed), identical ranges, and ranges that touch.
+
+ ********************************************************************************************************************/
+
+#include "IntervalTest.h"
+
+#include <algorithm>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( IntervalTest );
+
+using namespace MyMath;
+
+static uint32_t RandomInt( uint32_t n )
+{
+	static uint32_t	state	= 13579;
+	state = state * 1664525u + 1013904223u;
+	return ( state >> 8 ) % n;
+}
+
+// Returns n random ranges with integer ends in [0, 40]
+template < bool lower_closed, bool upper_closed >
+static std::vector< Range< double, lower_closed, upper_closed > > RandomRanges( int n )
+{
+	std::vector< Range< double, lower_closed, upper_closed > >	ranges;
+	for ( int i = 0; i < n; ++i )
+	{
+		double const	lower	= double( RandomInt( 41 ) );
+		double const	upper	= std::min( 40.0, lower + double( RandomInt( 4 ) == 0 ? 0 : RandomInt( 8 ) ) );
+		ranges.emplace_back( lower, upper );
+	}
+	return ranges;
+}
+
+// Values tested: multiples of 0.5 from below the lowest end to above the highest end
+static std::vector< double > TestValues()
+{
+	std::vector< double >	values;
+	for ( int i = -4; i <= 84; ++i )
+	{
+		values.push_back( 0.5 * i );
+	}
+	return values;
+}
+
+// Returns true if any of the ranges includes v
+template < typename R >
+static bool AnyIncludes( std::vector< R > const & ranges, double v )
+{
+	for ( R const & r : ranges )
+	{
+		if ( r == v )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Checks that the ranges of a set are sorted, disjoint and not empty
+template < bool lower_closed, bool upper_closed >
+static void CheckStructure( IntervalSet< double, lower_closed, upper_closed > const & set )
+{
+	for ( int i = 0; i < set.Size(); ++i )
+	{
+		auto const	r	= set.GetRange( i );
+		CPPUNIT_ASSERT( r.Lower() < r.Upper() || ( lower_closed && upper_closed && r.Lower() == r.Upper() ) );
+		if ( i > 0 )
+		{
+			auto const	previous	= set.GetRange( i - 1 );
+			CPPUNIT_ASSERT( previous.Upper() < r.Lower() ||
+							( !lower_closed && !upper_closed && previous.Upper() == r.Lower() ) );
+		}
+	}
+}
+
+// Checks a set against a predicate for every test value, with both forms of Contains() and with Find()
+template < bool lower_closed, bool upper_closed, typename Predicate >
+static void CheckSet( IntervalSet< double, lower_closed, upper_closed > const & set, Predicate expected )
+{
+	CheckStructure( set );
+
+	std::vector< double > const	values	= TestValues();
+	bool						results[ 100 ];
+	results[ values.size() ] = true;
+	set.Contains( values.data(), results, values.size() );
+	CPPUNIT_ASSERT( results[ values.size() ] );
+
+	for ( size_t i = 0; i < values.size(); ++i )
+	{
+		bool const	e	= expected( values[ i ] );
+		CPPUNIT_ASSERT_EQUAL( e, set.Contains( values[ i ] ) );
+		CPPUNIT_ASSERT_EQUAL( e, results[ i ] );
+
+		int const	k	= set.Find( values[ i ] );
+		CPPUNIT_ASSERT_EQUAL( e, k >= 0 );
+		if ( k >= 0 )
+		{
+			CPPUNIT_ASSERT( set.GetRange( k ) == values[ i ] );
+		}
+	}
+}
+
+template < bool lower_closed, bool upper_closed >
+static void CheckContains()
+{
+	for ( int n : { 1, 2, 5, 20, 100 } )
+	{
+		auto const	ranges	= RandomRanges< lower_closed, upper_closed >( n );
+
+		IntervalSet< double, lower_closed, upper_closed > const	set( ranges.data(), n );
+		CheckSet( set, [ &ranges ]( double v ) { return AnyIncludes( ranges, v ); } );
+	}
+
+	// Identical ranges, and ranges that touch
+	{
+		using R = Range< double, lower_closed, upper_closed >;
+		std::vector< R > const	ranges	= { R( 5.0, 7.0 ), R( 5.0, 7.0 ), R( 7.0, 9.0 ), R( 1.0, 5.0 ), R( 9.0, 9.0 ) };
+
+		IntervalSet< double, lower_closed, upper_closed > const	set( ranges.data(), int( ranges.size() ) );
+		CheckSet( set, [ &ranges ]( double v ) { return AnyIncludes( ranges, v ); } );
+	}
+}
+
+template < bool lower_closed, bool upper_closed >
+static void CheckUnionIntersection()
+{
+	using Set = IntervalSet< double, lower_closed, upper_closed >;
+
+	for ( int n : { 0, 1, 3, 10, 40 } )
+	{
+		for ( int m : { 0, 1, 4, 15 } )
+		{
+			auto const	ra	= RandomRanges< lower_closed, upper_closed >( n );
+			auto const	rb	= RandomRanges< lower_closed, upper_closed >( m );
+			Set const	a( ra.data(), n );
+			Set const	b( rb.data(), m );
+
+			CheckSet( Union( a, b ), [ &a, &b ]( double v ) { return a.Contains( v ) || b.Contains( v ); } );
+			CheckSet( Intersection( a, b ), [ &a, &b ]( double v ) { return a.Contains( v ) && b.Contains( v ); } );
+		}
+	}
+}
+
+template < bool lower_closed, bool upper_closed >
+static void CheckDifference()
+{
+	using Set = IntervalSet< double, lower_closed, upper_closed >;
+
+	for ( int n : { 0, 1, 3, 10, 40 } )
+	{
+		for ( int m : { 0, 1, 4, 15 } )
+		{
+			auto const	ra	= RandomRanges< lower_closed, upper_closed >( n );
+			auto const	rb	= RandomRanges< lower_closed, upper_closed >( m );
+			Set const	a( ra.data(), n );
+			Set const	b( rb.data(), m );
+
+			CheckSet( Difference( a, b ), [ &a, &b ]( double v ) { return a.Contains( v ) && !b.Contains( v ); } );
+			CheckSet( Difference( a, a ), []( double ) { return false; } );
+		}
+	}
+}
+
+// Inserts random ranges, and also removes random ranges if the ranges are half-open
+template < bool lower_closed, bool upper_closed >
+static void CheckInsertRemove()
+{
+	using R = Range< double, lower_closed, upper_closed >;
+
+	IntervalSet< double, lower_closed, upper_closed >	set;
+	std::vector< R >									inserted;
+	std::vector< R >									removed;
+
+	for ( int i = 0; i < 60; ++i )
+	{
+		// A value is in the set if the last operation on a range including it was an insertion
+
+		R const		r		= RandomRanges< lower_closed, upper_closed >( 1 )[ 0 ];
+		bool		insert	= true;
+		if constexpr ( lower_closed != upper_closed )
+		{
+			if ( RandomInt( 3 ) == 0 )
+			{
+				set.Remove( r );
+				insert = false;
+			}
+		}
+		if ( insert )
+		{
+			set.Insert( r );
+		}
+		inserted.push_back( insert ? r : R( -100.0, -100.0 ) );
+		removed.push_back( insert ? R( -100.0, -100.0 ) : r );
+
+		CheckSet( set, [ &inserted, &removed ]( double v ) {
+			for ( size_t k = inserted.size(); k-- > 0; )
+			{
+				if ( inserted[ k ] == v )
+				{
+					return true;
+				}
+				if ( removed[ k ] == v )
+				{
+					return false;
+				}
+			}
+			return false;
+		} );
+	}
+
+	set.Clear();
+	CPPUNIT_ASSERT( set.IsEmpty() );
+	CheckSet( set, []( double ) { return false; } );
+}
+
+template < bool lower_closed, bool upper_closed >
+static void CheckTree()
+{
+	using R = Range< double, lower_closed, upper_closed >;
+
+	std::vector< std::vector< R > >	tests;
+	for ( int n : { 0, 1, 2, 3, 7, 8, 9, 31, 100 } )
+	{
+		tests.push_back( RandomRanges< lower_closed, upper_closed >( n ) );
+	}
+	tests.push_back( std::vector< R >( 5, R( 3.0, 6.0 ) ) );
+	tests.push_back( { R( 0.0, 40.0 ), R( 1.0, 2.0 ), R( 2.0, 2.0 ), R( 3.0, 39.0 ), R( 20.0, 21.0 ) } );
+
+	std::vector< double > const	values	= TestValues();
+
+	for ( std::vector< R > const & ranges : tests )
+	{
+		IntervalTree< double, lower_closed, upper_closed > const	tree( ranges.data(), int( ranges.size() ) );
+		CPPUNIT_ASSERT_EQUAL( int( ranges.size() ), tree.Size() );
+
+		bool	results[ 100 ];
+		tree.Contains( values.data(), results, values.size() );
+
+		for ( size_t i = 0; i < values.size(); ++i )
+		{
+			double const	v	= values[ i ];
+
+			std::vector< int >	expected;
+			for ( size_t k = 0; k < ranges.size(); ++k )
+			{
+				if ( ranges[ k ] == v )
+				{
+					expected.push_back( int( k ) );
+				}
+			}
+
+			std::vector< int >	found;
+			tree.Query( v, &found );
+			std::sort( found.begin(), found.end() );
+
+			CPPUNIT_ASSERT( found == expected );
+			CPPUNIT_ASSERT_EQUAL( !expected.empty(), tree.Contains( v ) );
+			CPPUNIT_ASSERT_EQUAL( !expected.empty(), results[ i ] );
+		}
+	}
+}
+
+void IntervalTest::TestEmpty()
+{
+	IntervalSet< double > const	set;
+	CPPUNIT_ASSERT( set.IsEmpty() );
+	CPPUNIT_ASSERT_EQUAL( 0, set.Size() );
+	CPPUNIT_ASSERT_EQUAL( -1, set.Find( 0.0 ) );
+	CPPUNIT_ASSERT( !set.Contains( 0.0 ) );
+
+	IntervalSet< double > const	fromNone( nullptr, 0 );
+	CPPUNIT_ASSERT( fromNone.IsEmpty() );
+
+	// Ranges that contain no values are dropped
+	using Open = Range< double, false, false >;
+	Open const							empty[]	= { Open( 1.0, 1.0 ), Open( 2.0, 2.0 ) };
+	IntervalSet< double, false, false >	openSet( empty, 2 );
+	CPPUNIT_ASSERT( openSet.IsEmpty() );
+	openSet.Insert( Open( 3.0, 3.0 ) );
+	CPPUNIT_ASSERT( openSet.IsEmpty() );
+
+	IntervalTree< double > const	tree( nullptr, 0 );
+	CPPUNIT_ASSERT_EQUAL( 0, tree.Size() );
+	CPPUNIT_ASSERT( !tree.Contains( 0.0 ) );
+
+	std::vector< int >	found;
+	tree.Query( 0.0, &found );
+	CPPUNIT_ASSERT( found.empty() );
+
+	double const	v[]	= { -1.0, 0.0, 1.0 };
+	bool			r[]	= { true, true, true };
+	set.Contains( v, r, 3 );
+	CPPUNIT_ASSERT( !r[ 0 ] && !r[ 1 ] && !r[ 2 ] );
+
+	r[ 0 ] = r[ 1 ] = r[ 2 ] = true;
+	tree.Contains( v, r, 3 );
+	CPPUNIT_ASSERT( !r[ 0 ] && !r[ 1 ] && !r[ 2 ] );
+
+	// Zero values
+	set.Contains( v, r, 0 );
+	tree.Contains( v, r, 0 );
+}
+
+void IntervalTest::TestSetContains()
+{
+	CheckContains< true, true >();
+	CheckContains< true, false >();
+	CheckContains< false, true >();
+	CheckContains< false, false >();
+}
+
+void IntervalTest::TestSetOperations()
+{
+	CheckUnionIntersection< true, true >();
+	CheckUnionIntersection< true, false >();
+	CheckUnionIntersection< false, true >();
+	CheckUnionIntersection< false, false >();
+
+	CheckDifference< true, false >();
+	CheckDifference< false, true >();
+}
+
+void IntervalTest::TestSetInsertRemove()
+{
+	CheckInsertRemove< true, true >();
+	CheckInsertRemove< false, false >();
+	CheckInsertRemove< true, false >();
+	CheckInsertRemove< false, true >();
+}
+
+void IntervalTest::TestTree()
+{
+	CheckTree< true, true >();
+	CheckTree< true, false >();
+	CheckTree< false, true >();
+	CheckTree< false, false >();
+}
@@ -0,0 +1,34 @@
+/********************************************************************************************************************
+
+                                                    IntervalTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/IntervalSet.h"
+#include "../include/MyMath/IntervalTree.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class IntervalTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( IntervalTest );
+	CPPUNIT_TEST( TestEmpty );
+	CPPUNIT_TEST( TestSetContains );
+	CPPUNIT_TEST( TestSetOperations );
+	CPPUNIT_TEST( TestSetInsertRemove );
+	CPPUNIT_TEST( TestTree );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestEmpty();
+	void TestSetContains();
+	void TestSetOperations();
+	void TestSetInsertRemove();
+	void TestTree();
+};
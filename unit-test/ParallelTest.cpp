@@ -0,0 +1,206 @@
+/********************************************************************************************************************
+
+                                                   ParallelTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	ParallelFor() must call the body exactly once for each index, with chunks that start on multiples of the grain,
+	for any number of threads and when loops are nested. An exception thrown by the body must be rethrown only after
+	every chunk is done or skipped. ParallelClassify() must give the same results as a serial loop, wherever the
+	results are in memory.
+
+ ********************************************************************************************************************/
+
+#include "ParallelTest.h"
+
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/Parallel.h"
+#include "../include/MyMath/Sphere.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ParallelTest );
+
+using namespace MyMath;
+
+// Returns true if every count is 1
+static bool AllOnce( std::vector< std::atomic< int > > const & counts )
+{
+	for ( std::atomic< int > const & count : counts )
+	{
+		if ( count.load() != 1 )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void ParallelTest::TestEachIndexOnce()
+{
+	for ( int nThreads : { 1, 2, 4, 7 } )
+	{
+		TaskScheduler	scheduler( nThreads );
+		CPPUNIT_ASSERT_EQUAL( nThreads, scheduler.GetThreadCount() );
+
+		for ( size_t n : { 0, 1, 2, 3, 17, 64, 100, 1000, 12345 } )
+		{
+			for ( size_t grain : { 0, 1, 3, 16, 64, 5000 } )
+			{
+				std::vector< std::atomic< int > >	counts( n );
+				for ( std::atomic< int > & count : counts )
+				{
+					count = 0;
+				}
+				std::atomic< bool >	aligned( true );
+				std::atomic< bool >	inRange( true );
+
+				ParallelFor( scheduler, n, grain, [ & ]( size_t begin, size_t end )
+				{
+					if ( begin >= end || end > n )
+					{
+						inRange = false;
+						return;
+					}
+					if ( grain > 0 && begin % grain != 0 )
+					{
+						aligned = false;
+					}
+					for ( size_t i = begin; i < end; ++i )
+					{
+						++counts[ i ];
+					}
+				} );
+
+				CPPUNIT_ASSERT( inRange );
+				CPPUNIT_ASSERT( aligned );
+				CPPUNIT_ASSERT( AllOnce( counts ) );
+			}
+		}
+	}
+}
+
+void ParallelTest::TestNested()
+{
+	size_t const	N_OUTER	= 37;
+	size_t const	N_INNER	= 101;
+
+	for ( int nThreads : { 1, 3, 8 } )
+	{
+		TaskScheduler						scheduler( nThreads );
+		std::vector< std::atomic< int > >	counts( N_OUTER * N_INNER );
+		for ( std::atomic< int > & count : counts )
+		{
+			count = 0;
+		}
+
+		ParallelFor( scheduler, N_OUTER, 1, [ & ]( size_t begin, size_t end )
+		{
+			for ( size_t i = begin; i < end; ++i )
+			{
+				ParallelFor( scheduler, N_INNER, 4, [ & ]( size_t b, size_t e )
+				{
+					for ( size_t j = b; j < e; ++j )
+					{
+						++counts[ i * N_INNER + j ];
+					}
+				} );
+			}
+		} );
+
+		CPPUNIT_ASSERT( AllOnce( counts ) );
+	}
+}
+
+void ParallelTest::TestException()
+{
+	for ( int nThreads : { 1, 4 } )
+	{
+		TaskScheduler	scheduler( nThreads );
+
+		for ( size_t thrower : { size_t( 0 ), size_t( 500 ), size_t( 999 ) } )
+		{
+			// The body's state is on the heap and freed as soon as ParallelFor returns, so a chunk that runs
+			// afterwards would be caught by a memory checker. Each chunk also records whether it finished.
+
+			std::unique_ptr< std::atomic< int > >	pRunning( new std::atomic< int >( 0 ) );
+			std::atomic< int > &					running	= *pRunning;
+			bool									caught	= false;
+
+			try
+			{
+				ParallelFor( scheduler, 1000, 10, [ & ]( size_t begin, size_t end )
+				{
+					++running;
+					for ( size_t i = begin; i < end; ++i )
+					{
+						if ( i == thrower )
+						{
+							--running;
+							throw std::runtime_error( "test" );
+						}
+					}
+					--running;
+				} );
+			}
+			catch ( std::runtime_error const & )
+			{
+				caught = true;
+			}
+
+			CPPUNIT_ASSERT( caught );
+			CPPUNIT_ASSERT_EQUAL( 0, running.load() );
+			pRunning.reset();
+		}
+
+		// The scheduler still works
+
+		std::vector< std::atomic< int > >	counts( 1000 );
+		for ( std::atomic< int > & count : counts )
+		{
+			count = 0;
+		}
+		ParallelFor( scheduler, counts.size(), 1, [ & ]( size_t begin, size_t end )
+		{
+			for ( size_t i = begin; i < end; ++i )
+			{
+				++counts[ i ];
+			}
+		} );
+		CPPUNIT_ASSERT( AllOnce( counts ) );
+	}
+}
+
+void ParallelTest::TestClassify()
+{
+	TaskScheduler	scheduler( 4 );
+
+	std::vector< Sphere >	spheres;
+	for ( int i = 0; i < 1000; ++i )
+	{
+		spheres.push_back( Sphere( Vector3( float( i % 37 ), float( i % 11 ), 0.0f ), 1.0f + float( i % 5 ) ) );
+	}
+	AABox const	query( Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 10.0f, 5.0f, 1.0f ) );
+
+	// The results start at every offset within a cache line
+
+	for ( size_t offset = 0; offset < CACHE_LINE_SIZE / sizeof( Intersectable::Result ); ++offset )
+	{
+		for ( size_t n : { 0, 1, 3, 17, 100, 1000 } )
+		{
+			std::vector< Intersectable::Result >	buffer( n + CACHE_LINE_SIZE );
+			Intersectable::Result * const			paResults	= buffer.data() + offset;
+
+			ParallelClassify( scheduler, query, spheres.data(), n, paResults );
+
+			for ( size_t i = 0; i < n; ++i )
+			{
+				CPPUNIT_ASSERT_EQUAL( query.Intersects( spheres[ i ] ), paResults[ i ] );
+			}
+		}
+	}
+}
@@ -0,0 +1,31 @@
+/********************************************************************************************************************
+
+                                                    ParallelTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Parallel.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class ParallelTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ParallelTest );
+	CPPUNIT_TEST( TestEachIndexOnce );
+	CPPUNIT_TEST( TestNested );
+	CPPUNIT_TEST( TestException );
+	CPPUNIT_TEST( TestClassify );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestEachIndexOnce();
+	void TestNested();
+	void TestException();
+	void TestClassify();
+};
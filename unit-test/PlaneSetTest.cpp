@@ -0,0 +1,333 @@
+/********************************************************************************************************************
+
+                                                   PlaneSetTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	PlaneSet's masks are compared against Plane::IsInFrontOf() for each plane, for sets whose sizes are and aren't
+	multiples of 8. The planes and points for the exact comparisons have coordinates that are multiples of 1/8, so
+	the distances are exact and many points are exactly on a plane (which is not in front of it). The batch
+	overloads must give the same masks as single points, for every size up to a few groups, and must not write past
+	the end of the output. The batch Plane operations are compared against the scalar ones, including when the
+	results replace the points.
+
+ ********************************************************************************************************************/
+
+#include "PlaneSetTest.h"
+
+#include "../include/MyMath/Point.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PlaneSetTest );
+
+using namespace MyMath;
+
+static float const		TOLERANCE	= 1.0e-4f;
+static uint32_t const	SENTINEL	= 0xdeadbeef;
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 13579;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+static Vector3 RandomVector( float scale )
+{
+	return Vector3( Random() * scale, Random() * scale, Random() * scale );
+}
+
+// Returns a multiple of 1/8 in [-4, 4]
+static float RandomEighth()
+{
+	return std::floor( Random() * 32.5f ) * 0.125f;
+}
+
+static Vector3 RandomEighthVector()
+{
+	return Vector3( RandomEighth(), RandomEighth(), RandomEighth() );
+}
+
+// Returns a plane with a normal and distance that are multiples of 1/8. The normal is not normalized, which
+// doesn't change which side a point is on.
+static Plane RandomEighthPlane()
+{
+	Plane	plane;
+	plane.m_N = RandomEighthVector();
+	plane.m_D = RandomEighth();
+	return plane;
+}
+
+// Returns a random plane with a unit normal
+static Plane RandomPlane()
+{
+	Vector3	n	= RandomVector( 1.0f );
+	while ( n.Length() < 0.1f )
+	{
+		n = RandomVector( 1.0f );
+	}
+	n *= 1.0f / n.Length();
+	return Plane( n, Random() * 5.0f );
+}
+
+// Returns the reference mask: bit i is set if the point is in front of plane i
+static uint32_t Reference( std::vector< Plane > const & planes, Vector3 const & point )
+{
+	uint32_t	mask	= 0;
+	for ( size_t i = 0; i < planes.size(); ++i )
+	{
+		if ( planes[ i ].IsInFrontOf( Point( point ) ) )
+		{
+			mask |= uint32_t( 1 ) << i;
+		}
+	}
+	return mask;
+}
+
+// Returns true if a point is within the tolerance of any of the planes
+static bool IsNearAPlane( std::vector< Plane > const & planes, Vector3 const & point )
+{
+	for ( Plane const & plane : planes )
+	{
+		if ( std::fabs( plane.DirectedDistance( Point( point ) ) ) <= TOLERANCE )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Compares the masks of a set of N planes with the reference
+template< int N >
+static void CheckClassify()
+{
+	// Exact planes and points, many of which are on a plane
+	{
+		std::vector< Plane >	planes;
+		for ( int i = 0; i < N; ++i )
+		{
+			planes.push_back( RandomEighthPlane() );
+		}
+		PlaneSet< N > const	set( planes.data() );
+
+		for ( int i = 0; i < 2000; ++i )
+		{
+			Vector3 const	point	= RandomEighthVector();
+			uint32_t const	mask	= set.Classify( point );
+			CPPUNIT_ASSERT_EQUAL( Reference( planes, point ), mask );
+			CPPUNIT_ASSERT_EQUAL( uint32_t( 0 ), mask & ~PlaneSet< N >::ALL );
+		}
+
+	}
+
+	// Random planes and points, away from the planes
+	{
+		std::vector< Plane >	planes;
+		for ( int i = 0; i < N; ++i )
+		{
+			planes.push_back( RandomPlane() );
+		}
+		PlaneSet< N > const	set( planes.data() );
+
+		for ( int i = 0; i < 2000; ++i )
+		{
+			Vector3 const	point	= RandomVector( 10.0f );
+			if ( !IsNearAPlane( planes, point ) )
+			{
+				CPPUNIT_ASSERT_EQUAL( Reference( planes, point ), set.Classify( point ) );
+			}
+
+			float	distances[ N ];
+			set.DirectedDistances( point, distances );
+			for ( int k = 0; k < N; ++k )
+			{
+				float const	expected	= planes[ k ].DirectedDistance( Point( point ) );
+				CPPUNIT_ASSERT( std::fabs( distances[ k ] - expected ) <= TOLERANCE );
+			}
+		}
+	}
+}
+
+// Compares the batch masks of a set of N planes with the masks of single points
+template< int N >
+static void CheckBatches()
+{
+	std::vector< Plane >	planes;
+	for ( int i = 0; i < N; ++i )
+	{
+		planes.push_back( RandomEighthPlane() );
+	}
+	PlaneSet< N > const	set( planes.data() );
+
+	for ( size_t n = 0; n <= 35; ++n )
+	{
+		std::vector< Vector3 >	points;
+		for ( size_t i = 0; i < n; ++i )
+		{
+			points.push_back( RandomEighthVector() );
+		}
+		Vector3SoA const	soa( points.data(), n );
+
+		std::vector< uint32_t >	masks( n + 1, SENTINEL );
+		std::vector< uint32_t >	soaMasks( n + 1, SENTINEL );
+		set.Classify( points.data(), masks.data(), n );
+		set.Classify( soa, soaMasks.data() );
+
+		for ( size_t i = 0; i < n; ++i )
+		{
+			CPPUNIT_ASSERT_EQUAL( set.Classify( points[ i ] ), masks[ i ] );
+			CPPUNIT_ASSERT_EQUAL( set.Classify( points[ i ] ), soaMasks[ i ] );
+		}
+		CPPUNIT_ASSERT_EQUAL( SENTINEL, masks[ n ] );
+		CPPUNIT_ASSERT_EQUAL( SENTINEL, soaMasks[ n ] );
+	}
+}
+
+void PlaneSetTest::TestSetGet()
+{
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0x1 ), PlaneSet< 1 >::ALL );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0x1f ), PlaneSet< 5 >::ALL );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0xff ), PlaneSet< 8 >::ALL );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0xffffffff ), PlaneSet< 32 >::ALL );
+
+	// No point is in front of the planes of a default set
+	PlaneSet< 9 >	set;
+	for ( int i = 0; i < 100; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( uint32_t( 0 ), set.Classify( RandomVector( 1.0e6f ) ) );
+	}
+
+	// A plane 2.5 from the origin, facing away from it
+	Plane const	plane( Vector3( 0.0f, 0.6f, -0.8f ), 2.5f );
+	set.Set( 8, plane );
+	Plane const	stored	= set.Get( 8 );
+	CPPUNIT_ASSERT( stored.m_N.m_X == 0.0f && stored.m_N.m_Y == 0.6f && stored.m_N.m_Z == -0.8f );
+	CPPUNIT_ASSERT_EQUAL( -2.5f, stored.m_D );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0 ), set.Classify( Vector3( 0.0f, 0.0f, 0.0f ) ) );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 1 ) << 8, set.Classify( Vector3( 0.0f, 0.0f, -10.0f ) ) );
+}
+
+void PlaneSetTest::TestClassify()
+{
+	CheckClassify< 1 >();
+	CheckClassify< 5 >();
+	CheckClassify< 8 >();
+	CheckClassify< 9 >();
+	CheckClassify< 17 >();
+	CheckClassify< 32 >();
+}
+
+void PlaneSetTest::TestBatches()
+{
+	CheckBatches< 1 >();
+	CheckBatches< 6 >();
+	CheckBatches< 8 >();
+	CheckBatches< 13 >();
+	CheckBatches< 32 >();
+}
+
+void PlaneSetTest::TestSpecialValues()
+{
+	float const	inf	= std::numeric_limits< float >::infinity();
+	float const	nan	= std::numeric_limits< float >::quiet_NaN();
+
+	std::vector< Plane > const	planes	=
+	{
+		Plane( Vector3( 1.0f, 0.0f, 0.0f ), 0.0f ),
+		Plane( Vector3( -1.0f, 0.0f, 0.0f ), 1.0f ),
+		Plane( Vector3( 0.0f, 1.0f, 0.0f ), -1.0f ),
+		Plane( Vector3( 0.0f, 0.0f, -1.0f ), 0.0f ),
+		Plane( Vector3( 0.6f, 0.8f, 0.0f ), 0.0f ),
+	};
+	PlaneSet< 5 > const			set( planes.data() );
+	std::vector< Vector3 > const	points	=
+	{
+		Vector3( inf, 0.0f, 0.0f ), Vector3( -inf, 0.0f, 0.0f ), Vector3( 0.0f, inf, -inf ),
+		Vector3( nan, 0.0f, 0.0f ), Vector3( 0.0f, 0.0f, nan ), Vector3( -0.0f, -0.0f, -0.0f ),
+		Vector3( 0.0f, 1.0f, 0.0f ), Vector3( std::numeric_limits< float >::denorm_min(), 0.0f, 0.0f ),
+	};
+
+	// Infinities give infinite distances, or NaNs where they are multiplied by 0. NaNs are in front of nothing.
+	for ( Vector3 const & point : points )
+	{
+		CPPUNIT_ASSERT_EQUAL( Reference( planes, point ), set.Classify( point ) );
+	}
+
+	Vector3SoA const		soa( points.data(), points.size() );
+	std::vector< uint32_t >	masks( points.size() );
+	set.Classify( soa, masks.data() );
+	for ( size_t i = 0; i < points.size(); ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( Reference( planes, points[ i ] ), masks[ i ] );
+	}
+
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0 ), set.Classify( points[ 3 ] ) );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0x11 ), set.Classify( points[ 0 ] ) );
+	CPPUNIT_ASSERT_EQUAL( uint32_t( 0x1 ), set.Classify( points[ 7 ] ) & 0x3 );
+}
+
+void PlaneSetTest::TestPlaneBatches()
+{
+	for ( int i = 0; i < 20; ++i )
+	{
+		Plane const	plane	= RandomPlane();
+
+		for ( size_t n : { size_t( 0 ), size_t( 1 ), size_t( 7 ), size_t( 8 ), size_t( 9 ), size_t( 50 ) } )
+		{
+			std::vector< Vector3 >	points;
+			for ( size_t k = 0; k < n; ++k )
+			{
+				points.push_back( RandomVector( 10.0f ) );
+			}
+			Vector3SoA const	soa( points.data(), n );
+
+			std::vector< float >	distances( n + 1, 1.0f );
+			std::vector< float >	soaDistances( n + 1, 1.0f );
+			plane.DirectedDistances( points.data(), distances.data(), n );
+			plane.DirectedDistances( soa, soaDistances.data() );
+			CPPUNIT_ASSERT_EQUAL( 1.0f, distances[ n ] );
+			CPPUNIT_ASSERT_EQUAL( 1.0f, soaDistances[ n ] );
+
+			std::vector< Vector3 >	reflected( n );
+			std::vector< Vector3 >	projected( n );
+			Vector3SoA				soaReflected;
+			Vector3SoA				soaProjected;
+			plane.Reflect( points.data(), reflected.data(), n );
+			plane.Project( points.data(), projected.data(), n );
+			plane.Reflect( soa, &soaReflected );
+			plane.Project( soa, &soaProjected );
+			CPPUNIT_ASSERT_EQUAL( n, soaReflected.Size() );
+			CPPUNIT_ASSERT_EQUAL( n, soaProjected.Size() );
+
+			// In place
+			std::vector< Vector3 >	inPlace	= points;
+			Vector3SoA				soaInPlace( points.data(), n );
+			plane.Reflect( inPlace.data(), inPlace.data(), n );
+			plane.Project( soaInPlace, &soaInPlace );
+
+			for ( size_t k = 0; k < n; ++k )
+			{
+				Point const		point( points[ k ] );
+				float const		distance	= plane.DirectedDistance( point );
+				Vector3 const	reflection	= plane.Reflect( point ).value_;
+				Vector3 const	projection	= plane.Project( point ).value_;
+
+				CPPUNIT_ASSERT( std::fabs( distances[ k ] - distance ) <= TOLERANCE );
+				CPPUNIT_ASSERT( std::fabs( soaDistances[ k ] - distance ) <= TOLERANCE );
+				CPPUNIT_ASSERT( ( reflected[ k ] - reflection ).Length() <= TOLERANCE * 10.0f );
+				CPPUNIT_ASSERT( ( projected[ k ] - projection ).Length() <= TOLERANCE * 10.0f );
+				CPPUNIT_ASSERT( ( Vector3( soaReflected[ k ] ) - reflection ).Length() <= TOLERANCE * 10.0f );
+				CPPUNIT_ASSERT( ( Vector3( soaProjected[ k ] ) - projection ).Length() <= TOLERANCE * 10.0f );
+				CPPUNIT_ASSERT( ( inPlace[ k ] - reflection ).Length() <= TOLERANCE * 10.0f );
+				CPPUNIT_ASSERT( ( Vector3( soaInPlace[ k ] ) - projection ).Length() <= TOLERANCE * 10.0f );
+				CPPUNIT_ASSERT( std::fabs( plane.DirectedDistance( Point( projected[ k ] ) ) ) <= TOLERANCE * 10.0f );
+			}
+		}
+	}
+}
@@ -0,0 +1,33 @@
+/********************************************************************************************************************
+
+                                                    PlaneSetTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/PlaneSet.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class PlaneSetTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( PlaneSetTest );
+	CPPUNIT_TEST( TestSetGet );
+	CPPUNIT_TEST( TestClassify );
+	CPPUNIT_TEST( TestBatches );
+	CPPUNIT_TEST( TestSpecialValues );
+	CPPUNIT_TEST( TestPlaneBatches );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestSetGet();
+	void TestClassify();
+	void TestBatches();
+	void TestSpecialValues();
+	void TestPlaneBatches();
+};
@@ -0,0 +1,164 @@
+/********************************************************************************************************************
+
+                                                     PolyTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	A polygon must keep its vertices through growth, copies and moves, whether they are stored inline or in a pooled
+	block. Polygons that are destroyed after their thread's pool (thread_local and static polygons) must still free
+	their blocks safely.
+
+ ********************************************************************************************************************/
+
+#include "PolyTest.h"
+
+#include "../include/MyMath/Plane.h"
+#include "../include/MyMath/Vector3.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PolyTest );
+
+// Returns the i'th vertex of a test polygon
+static Vector3 TestVertex( int i )
+{
+	return Vector3( float( i ), float( i * i ), float( -i ) );
+}
+
+// Returns true if two vectors are exactly equal
+static bool IsEqual( Vector3 const & a, Vector3 const & b )
+{
+	return a.m_X == b.m_X && a.m_Y == b.m_Y && a.m_Z == b.m_Z;
+}
+
+// Returns true if a polygon has the first n test vertices
+static bool HasTestVertices( Poly const & poly, int n )
+{
+	if ( poly.GetVertexCount() != n )
+	{
+		return false;
+	}
+	for ( int i = 0; i < n; ++i )
+	{
+		if ( !IsEqual( poly.GetVertices()[ i ], TestVertex( i ) ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Static polygon with pooled vertices. It is destroyed after the main thread's pool.
+static Poly	s_StaticPoly;
+
+void PolyTest::TestStorage()
+{
+	Poly	poly;
+	CPPUNIT_ASSERT_EQUAL( 0, poly.GetVertexCount() );
+	CPPUNIT_ASSERT_EQUAL( Poly::INLINE_CAPACITY, poly.GetCapacity() );
+
+	for ( int i = 0; i < 1000; ++i )
+	{
+		poly.PushBack( TestVertex( i ) );
+		CPPUNIT_ASSERT( poly.GetCapacity() >= poly.GetVertexCount() );
+	}
+	CPPUNIT_ASSERT( HasTestVertices( poly, 1000 ) );
+
+	poly.Resize( 5 );
+	CPPUNIT_ASSERT( HasTestVertices( poly, 5 ) );
+
+	std::vector< Vector3 >	vertices;
+	for ( int i = 0; i < 40; ++i )
+	{
+		vertices.push_back( TestVertex( i ) );
+	}
+	poly.Assign( vertices.data(), int( vertices.size() ) );
+	CPPUNIT_ASSERT( HasTestVertices( poly, 40 ) );
+
+	poly.Clear();
+	CPPUNIT_ASSERT_EQUAL( 0, poly.GetVertexCount() );
+
+	s_StaticPoly.Assign( vertices.data(), int( vertices.size() ) );
+	CPPUNIT_ASSERT( HasTestVertices( s_StaticPoly, 40 ) );
+}
+
+void PolyTest::TestCopyMove()
+{
+	for ( int n : { 0, 3, Poly::INLINE_CAPACITY, Poly::INLINE_CAPACITY + 1, 100 } )
+	{
+		Poly	a;
+		for ( int i = 0; i < n; ++i )
+		{
+			a.PushBack( TestVertex( i ) );
+		}
+
+		Poly	b( a );
+		CPPUNIT_ASSERT( HasTestVertices( b, n ) );
+		CPPUNIT_ASSERT( b.GetVertices() != a.GetVertices() );
+
+		Poly	c;
+		c = b;
+		CPPUNIT_ASSERT( HasTestVertices( c, n ) );
+
+		Poly	d( std::move( b ) );
+		CPPUNIT_ASSERT( HasTestVertices( d, n ) );
+		CPPUNIT_ASSERT_EQUAL( 0, b.GetVertexCount() );
+
+		Poly	e;
+		e.Resize( 200 );
+		e = std::move( c );
+		CPPUNIT_ASSERT( HasTestVertices( e, n ) );
+		CPPUNIT_ASSERT_EQUAL( 0, c.GetVertexCount() );
+
+		// The moved-from polygons are still usable
+
+		b.PushBack( TestVertex( 0 ) );
+		c.PushBack( TestVertex( 0 ) );
+		CPPUNIT_ASSERT( HasTestVertices( b, 1 ) );
+		CPPUNIT_ASSERT( HasTestVertices( c, 1 ) );
+	}
+}
+
+void PolyTest::TestPushBackOwnVertex()
+{
+	Poly	poly;
+	poly.PushBack( TestVertex( 0 ) );
+
+	// Pushing one of its own vertices must work when the storage grows, too.
+
+	for ( int i = 1; i < 100; ++i )
+	{
+		poly.PushBack( poly.GetVertices()[ 0 ] );
+		CPPUNIT_ASSERT_EQUAL( i + 1, poly.GetVertexCount() );
+		CPPUNIT_ASSERT( IsEqual( poly.GetVertices()[ i ], TestVertex( 0 ) ) );
+	}
+}
+
+void PolyTest::TestThreadExit()
+{
+	// The thread_local polygon is constructed before the thread's pool is first used, so it is destroyed after the
+	// pool. Its block must then be freed directly.
+
+	for ( int t = 0; t < 4; ++t )
+	{
+		int	n	= 0;
+
+		std::thread	thread( [ &n ]
+		{
+			static thread_local Poly	poly;
+			for ( int i = 0; i < 100; ++i )
+			{
+				poly.PushBack( TestVertex( i ) );
+			}
+
+			Poly	temporary( poly );
+			n = temporary.GetVertexCount();
+		} );
+		thread.join();
+
+		CPPUNIT_ASSERT_EQUAL( 100, n );
+	}
+}
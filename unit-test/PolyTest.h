@@ -0,0 +1,31 @@
+/********************************************************************************************************************
+
+                                                      PolyTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Plane.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class PolyTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( PolyTest );
+	CPPUNIT_TEST( TestStorage );
+	CPPUNIT_TEST( TestCopyMove );
+	CPPUNIT_TEST( TestPushBackOwnVertex );
+	CPPUNIT_TEST( TestThreadExit );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestStorage();
+	void TestCopyMove();
+	void TestPushBackOwnVertex();
+	void TestThreadExit();
+};
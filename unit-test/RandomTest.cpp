@@ -0,0 +1,297 @@
+/********************************************************************************************************************
+
+                                                    RandomTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	Philox is checked against the known-answer vectors of the reference implementation (Random123). Fill() and the
+	batch distributions must produce exactly the values returned by the scalar functions, for any count and after
+	any number of values have already been consumed. The frequencies of the values sampled from alias tables are
+	compared with their weights, and values with zero weight must never be sampled.
+
+ ********************************************************************************************************************/
+
+#include "RandomTest.h"
+
+#include <cmath>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( RandomTest );
+
+using namespace MyMath;
+
+// Returns the first 4 values of the block at the given position in the stream
+static void FirstBlock( uint64_t seed, uint64_t stream, uint64_t block, uint32_t r[ 4 ] )
+{
+	Philox	rng( seed, stream );
+	rng.Seek( block );
+	for ( int i = 0; i < 4; ++i )
+	{
+		r[ i ] = rng();
+	}
+}
+
+// Samples an alias table and checks that the frequencies of the values are close to the normalized weights
+static void CheckFrequencies( std::vector< double > const & weights, int nSamples )
+{
+	AliasTable const	table( weights.data(), int( weights.size() ) );
+	CPPUNIT_ASSERT_EQUAL( int( weights.size() ), table.Size() );
+
+	double sum	= 0.0;
+	for ( double w : weights )
+	{
+		sum += w;
+	}
+
+	Philox			rng( 12345 );
+	std::vector< int >	counts( weights.size(), 0 );
+	for ( int i = 0; i < nSamples; ++i )
+	{
+		int const	k	= table.Sample( rng );
+		CPPUNIT_ASSERT( k >= 0 && k < table.Size() );
+		++counts[ k ];
+	}
+
+	for ( size_t i = 0; i < weights.size(); ++i )
+	{
+		double const	expected	= weights[ i ] / sum * nSamples;
+		if ( weights[ i ] == 0.0 )
+		{
+			CPPUNIT_ASSERT_EQUAL( 0, counts[ i ] );
+		}
+		else
+		{
+			// Within 5 standard deviations (or a few samples for very small expected counts)
+			CPPUNIT_ASSERT( std::fabs( counts[ i ] - expected ) <= 5.0 * std::sqrt( expected ) + 3.0 );
+		}
+	}
+}
+
+void RandomTest::TestPhiloxKnownAnswers()
+{
+	uint32_t	r[ 4 ];
+
+	FirstBlock( 0, 0, 0, r );
+	CPPUNIT_ASSERT_EQUAL( 0x6627e8d5u, r[ 0 ] );
+	CPPUNIT_ASSERT_EQUAL( 0xe169c58du, r[ 1 ] );
+	CPPUNIT_ASSERT_EQUAL( 0xbc57ac4cu, r[ 2 ] );
+	CPPUNIT_ASSERT_EQUAL( 0x9b00dbd8u, r[ 3 ] );
+
+	FirstBlock( 0xffffffffffffffffull, 0xffffffffffffffffull, 0xffffffffffffffffull, r );
+	CPPUNIT_ASSERT_EQUAL( 0x408f276du, r[ 0 ] );
+	CPPUNIT_ASSERT_EQUAL( 0x41c83b0eu, r[ 1 ] );
+	CPPUNIT_ASSERT_EQUAL( 0xa20bc7c6u, r[ 2 ] );
+	CPPUNIT_ASSERT_EQUAL( 0x6d5451fdu, r[ 3 ] );
+
+	FirstBlock( 0x299f31d0a4093822ull, 0x0370734413198a2eull, 0x85a308d3243f6a88ull, r );
+	CPPUNIT_ASSERT_EQUAL( 0xd16cfe09u, r[ 0 ] );
+	CPPUNIT_ASSERT_EQUAL( 0x94fdccebu, r[ 1 ] );
+	CPPUNIT_ASSERT_EQUAL( 0x5001e420u, r[ 2 ] );
+	CPPUNIT_ASSERT_EQUAL( 0x24126ea1u, r[ 3 ] );
+}
+
+void RandomTest::TestPhiloxFill()
+{
+	// Counts below, at and above the 32 values generated at a time, after consuming part of a block
+	for ( int skip = 0; skip < 6; ++skip )
+	{
+		for ( size_t count : { 0, 1, 3, 4, 31, 32, 33, 64, 100, 1000 } )
+		{
+			Philox	a( 777, 3 );
+			Philox	b( 777, 3 );
+			for ( int i = 0; i < skip; ++i )
+			{
+				a();
+				b();
+			}
+
+			std::vector< uint32_t >	filled( count + 1, 0xdeadbeef );
+			a.Fill( filled.data(), count );
+			CPPUNIT_ASSERT_EQUAL( 0xdeadbeefu, filled[ count ] );
+
+			for ( size_t i = 0; i < count; ++i )
+			{
+				CPPUNIT_ASSERT_EQUAL( b(), filled[ i ] );
+			}
+
+			// Both generators continue from the same position
+			CPPUNIT_ASSERT_EQUAL( b(), a() );
+		}
+	}
+
+	// The counter carries into the upper word of the position
+	{
+		Philox	a( 1 );
+		Philox	b( 1 );
+		a.Seek( 0xfffffffeull );
+		b.Seek( 0xfffffffeull );
+
+		uint32_t	filled[ 40 ];
+		a.Fill( filled, 40 );
+		for ( uint32_t u : filled )
+		{
+			CPPUNIT_ASSERT_EQUAL( b(), u );
+		}
+
+		uint32_t	r[ 4 ];
+		FirstBlock( 1, 0, 0x100000000ull, r );
+		b.Seek( 0xffffffffull );
+		for ( int i = 0; i < 4; ++i )
+		{
+			b();
+		}
+		CPPUNIT_ASSERT_EQUAL( r[ 0 ], b() );
+	}
+}
+
+void RandomTest::TestPhiloxStreams()
+{
+	Philox	a( 42, 0 );
+	Philox	b( 42, 1 );
+	Philox	c( 43, 0 );
+
+	int nSameB	= 0;
+	int nSameC	= 0;
+	for ( int i = 0; i < 1000; ++i )
+	{
+		uint32_t const	u	= a();
+		nSameB += ( u == b() ) ? 1 : 0;
+		nSameC += ( u == c() ) ? 1 : 0;
+	}
+	CPPUNIT_ASSERT( nSameB < 2 );
+	CPPUNIT_ASSERT( nSameC < 2 );
+
+	// Seeking back reproduces the stream
+	Philox	d( 42, 0 );
+	d.Seek( 0 );
+	Philox	e( 42, 0 );
+	for ( int i = 0; i < 100; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( e(), d() );
+	}
+}
+
+void RandomTest::TestBatchUniform()
+{
+	for ( size_t count : { 0, 1, 7, 255, 256, 257, 1000 } )
+	{
+		Philox	a( 9 );
+		Philox	b( 9 );
+
+		std::vector< float >	f( count );
+		Uniform( a, f.data(), count );
+		for ( float x : f )
+		{
+			CPPUNIT_ASSERT_EQUAL( b.NextFloat(), x );
+			CPPUNIT_ASSERT( x >= 0.0f && x < 1.0f );
+		}
+
+		std::vector< double >	d( count );
+		Uniform( a, d.data(), count );
+		for ( double x : d )
+		{
+			CPPUNIT_ASSERT_EQUAL( b.NextDouble(), x );
+			CPPUNIT_ASSERT( x >= 0.0 && x < 1.0 );
+		}
+
+		CPPUNIT_ASSERT_EQUAL( b(), a() );
+	}
+
+	// Batch normals have the right moments
+	{
+		Philox					rng( 5 );
+		std::vector< double >	z( 100001 );
+		Normal( rng, z.data(), z.size(), 2.0, 3.0 );
+
+		double	sum		= 0.0;
+		double	sum2	= 0.0;
+		for ( double x : z )
+		{
+			CPPUNIT_ASSERT( std::isfinite( x ) );
+			sum += x;
+			sum2 += x * x;
+		}
+		double const	mean	= sum / z.size();
+		double const	var		= sum2 / z.size() - mean * mean;
+		CPPUNIT_ASSERT( std::fabs( mean - 2.0 ) < 0.05 );
+		CPPUNIT_ASSERT( std::fabs( var - 9.0 ) < 0.2 );
+	}
+}
+
+void RandomTest::TestUniformInt()
+{
+	Philox	rng( 31 );
+
+	for ( int i = 0; i < 100; ++i )
+	{
+		CPPUNIT_ASSERT_EQUAL( 0u, UniformInt( rng, 1 ) );
+	}
+
+	for ( uint32_t n : { 2u, 3u, 7u, 1000u, 0x80000001u, 0xffffffffu } )
+	{
+		for ( int i = 0; i < 1000; ++i )
+		{
+			CPPUNIT_ASSERT( UniformInt( rng, n ) < n );
+		}
+	}
+
+	std::vector< int >	counts( 6, 0 );
+	for ( int i = 0; i < 60000; ++i )
+	{
+		++counts[ UniformInt( rng, 6 ) ];
+	}
+	for ( int c : counts )
+	{
+		CPPUNIT_ASSERT( std::abs( c - 10000 ) < 500 );
+	}
+}
+
+void RandomTest::TestAliasTable()
+{
+	CheckFrequencies( { 1.0, 1.0, 1.0, 1.0 }, 100000 );
+	CheckFrequencies( { 1.0, 2.0, 3.0, 4.0, 5.0 }, 100000 );
+	CheckFrequencies( { 0.1, 0.0, 10.0, 0.0, 0.5, 3.0, 0.0 }, 100000 );
+
+	std::vector< double >	weights;
+	for ( int i = 0; i < 100; ++i )
+	{
+		weights.push_back( ( i % 7 == 0 ) ? 0.0 : std::exp( 0.05 * i ) );
+	}
+	CheckFrequencies( weights, 200000 );
+}
+
+void RandomTest::TestAliasTableEdgeCases()
+{
+	// A single value
+	{
+		double const		w	= 0.25;
+		AliasTable const	table( &w, 1 );
+		Philox				rng( 1 );
+		for ( int i = 0; i < 100; ++i )
+		{
+			CPPUNIT_ASSERT_EQUAL( 0, table.Sample( rng ) );
+		}
+	}
+
+	// A single non-zero weight among zeros
+	{
+		std::vector< double >	weights( 33, 0.0 );
+		weights[ 17 ] = 1.0e-30;
+
+		AliasTable const	table( weights.data(), int( weights.size() ) );
+		Philox				rng( 2 );
+		for ( int i = 0; i < 10000; ++i )
+		{
+			CPPUNIT_ASSERT_EQUAL( 17, table.Sample( rng ) );
+		}
+	}
+
+	// Very different magnitudes, where the column heights are affected by rounding
+	CheckFrequencies( { 1.0e-12, 1.0e12, 1.0, 0.0, 1.0e6, 1.0e-300 }, 100000 );
+
+	// Weights that do not divide evenly
+	std::vector< double >	thirds( 999, 1.0 / 3.0 );
+	thirds[ 0 ] = 0.0;
+	CheckFrequencies( thirds, 200000 );
+}
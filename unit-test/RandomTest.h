@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                     RandomTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Random.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class RandomTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( RandomTest );
+	CPPUNIT_TEST( TestPhiloxKnownAnswers );
+	CPPUNIT_TEST( TestPhiloxFill );
+	CPPUNIT_TEST( TestPhiloxStreams );
+	CPPUNIT_TEST( TestBatchUniform );
+	CPPUNIT_TEST( TestUniformInt );
+	CPPUNIT_TEST( TestAliasTable );
+	CPPUNIT_TEST( TestAliasTableEdgeCases );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestPhiloxKnownAnswers();
+	void TestPhiloxFill();
+	void TestPhiloxStreams();
+	void TestBatchUniform();
+	void TestUniformInt();
+	void TestAliasTable();
+	void TestAliasTableEdgeCases();
+};
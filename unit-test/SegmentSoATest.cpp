@@ -0,0 +1,411 @@
+/********************************************************************************************************************
+
+                                                  SegmentSoATest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	The batched segment tests are compared against the scalar tests, Intersectable::Intersects(Segment const &,
+	Segment const &) and Intersectable::Intersects(Segment const &, Poly const &), and against a reference that
+	solves for the common point with cross products. The segments for the exact comparisons have coordinates that
+	are multiples of 1/4, so every product is exact and the results can't depend on the order of the operations,
+	and they include many skew, parallel, collinear and touching pairs, and segments with zero length. The number of
+	segments in a set is varied so that the padding of the last group is exercised. The parameters of the hits are
+	checked against segments constructed to cross at known values, and the polygon test is compared against a
+	point-in-polygon test in the polygon's plane.
+
+ ********************************************************************************************************************/
+
+#include "SegmentSoATest.h"
+
+#include "../include/MyMath/Intersectable.h"
+#include "../include/MyMath/Plane.h"
+#include "../include/MyMath/PolyBuffer.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SegmentSoATest );
+
+using namespace MyMath;
+
+static float const	TOLERANCE	= 1.0e-4f;
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 24680;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+static Vector3 RandomVector( float scale )
+{
+	return Vector3( Random() * scale, Random() * scale, Random() * scale );
+}
+
+// Returns a multiple of 1/4 in [-2, 2]. Elements of directions are often 0 so that many segments are parallel.
+static float RandomQuarter( bool zeros )
+{
+	float const	r	= Random();
+	if ( zeros && r < -0.5f )
+	{
+		return 0.0f;
+	}
+	return std::floor( Random() * 8.5f ) * 0.25f;
+}
+
+static Vector3 RandomQuarterVector( bool zeros )
+{
+	return Vector3( RandomQuarter( zeros ), RandomQuarter( zeros ), RandomQuarter( zeros ) );
+}
+
+// Returns true if two vectors are equal
+static bool IsEqual( Vector3 const & a, Vector3 const & b )
+{
+	return a.m_X == b.m_X && a.m_Y == b.m_Y && a.m_Z == b.m_Z;
+}
+
+// Returns true if two points are within the tolerance of each other
+static bool IsClose( Vector3 const & a, Vector3 const & b )
+{
+	return ( a - b ).Length() <= TOLERANCE * ( 1.0f + a.Length() );
+}
+
+// Returns true if a vector is 0
+static bool IsZero( Vector3 const & v )
+{
+	return v.m_X == 0.0f && v.m_Y == 0.0f && v.m_Z == 0.0f;
+}
+
+// The reference test, for segments with coordinates that are multiples of 1/4. Every cross and dot product is exact,
+// and the divisions are folded into the comparisons.
+static bool Reference( Segment const & a, Segment const & b )
+{
+	Vector3 const	c	= b.m_B - a.m_B;
+	Vector3 const	n	= Cross( a.m_M, b.m_M );
+
+	if ( !IsZero( n ) )
+	{
+		// s = ( c x b.M ) . n / n . n and t = ( c x a.M ) . n / n . n, if the segments are coplanar
+		float const	nn	= Dot( n, n );
+		float const	s	= Dot( Cross( c, b.m_M ), n );
+		float const	t	= Dot( Cross( c, a.m_M ), n );
+		return Dot( c, n ) == 0.0f && s >= 0.0f && s <= nn && t >= 0.0f && t <= nn;
+	}
+
+	// Parallel: they must be collinear and overlap
+	if ( !IsZero( Cross( c, a.m_M ) ) || !IsZero( Cross( c, b.m_M ) ) )
+	{
+		return false;
+	}
+	if ( IsZero( a.m_M ) && IsZero( b.m_M ) )
+	{
+		return IsZero( c );
+	}
+
+	Vector3 const &	u	= ( Dot( a.m_M, a.m_M ) >= Dot( b.m_M, b.m_M ) ) ? a.m_M : b.m_M;
+	float const		a0	= Dot( a.m_B, u );
+	float const		a1	= Dot( a.m_B + a.m_M, u );
+	float const		b0	= Dot( b.m_B, u );
+	float const		b1	= Dot( b.m_B + b.m_M, u );
+	return std::max( std::min( a0, a1 ), std::min( b0, b1 ) ) <= std::min( std::max( a0, a1 ), std::max( b0, b1 ) );
+}
+
+// Tests a segment against a set with the batch test and the scalar test, and checks that they find the hits that the
+// reference finds, and that the parameters of the hits are of a common point
+static void Check( Segment const & segment, SegmentSoA const & segments )
+{
+	size_t const			n	= segments.Size();
+	std::vector< int >		indices( n + 1 );
+	std::vector< float >	s( n + 1 );
+	std::vector< float >	t( n + 1 );
+	int const				hits	= Intersect( segment, segments, indices.data(), s.data(), t.data() );
+
+	int	expected	= 0;
+	for ( size_t i = 0; i < n; ++i )
+	{
+		Segment const	other	= segments[ i ];
+		bool const		hit		= Reference( segment, other );
+
+		CPPUNIT_ASSERT_EQUAL( hit, segment.Intersects( other ) == Intersectable::INTERSECTS );
+		if ( hit )
+		{
+			CPPUNIT_ASSERT( expected < hits );
+			CPPUNIT_ASSERT_EQUAL( int( i ), indices[ expected ] );
+			CPPUNIT_ASSERT( s[ expected ] >= 0.0f && s[ expected ] <= 1.0f );
+			CPPUNIT_ASSERT( t[ expected ] >= 0.0f && t[ expected ] <= 1.0f );
+			CPPUNIT_ASSERT( IsClose( segment.m_B + segment.m_M * s[ expected ],
+									 other.m_B + other.m_M * t[ expected ] ) );
+			++expected;
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL( expected, hits );
+
+	// The parameter arrays are optional
+	CPPUNIT_ASSERT_EQUAL( hits, Intersect( segment, segments, indices.data(), nullptr, nullptr ) );
+}
+
+void SegmentSoATest::TestStorage()
+{
+	std::vector< Segment >	segments;
+	for ( int i = 0; i < 21; ++i )
+	{
+		segments.emplace_back( RandomVector( 5.0f ), RandomVector( 5.0f ) );
+	}
+
+	SegmentSoA	loaded( segments.data(), segments.size() );
+	SegmentSoA	pushed;
+	for ( Segment const & segment : segments )
+	{
+		pushed.PushBack( segment );
+	}
+
+	CPPUNIT_ASSERT_EQUAL( segments.size(), loaded.Size() );
+	CPPUNIT_ASSERT_EQUAL( segments.size(), pushed.Size() );
+	CPPUNIT_ASSERT( loaded.PaddedSize() >= loaded.Size() && loaded.PaddedSize() % 8 == 0 );
+
+	for ( size_t i = 0; i < segments.size(); ++i )
+	{
+		Vector3 const	e	= segments[ i ].m_B + segments[ i ].m_M;
+
+		CPPUNIT_ASSERT( IsEqual( segments[ i ].m_B, loaded[ i ].m_B ) );
+		CPPUNIT_ASSERT( IsEqual( segments[ i ].m_M, loaded[ i ].m_M ) );
+		CPPUNIT_ASSERT( IsEqual( segments[ i ].m_B, pushed[ i ].m_B ) );
+		CPPUNIT_ASSERT( IsEqual( segments[ i ].m_M, pushed[ i ].m_M ) );
+
+		for ( int k = 0; k < 3; ++k )
+		{
+			float const	lo	= loaded.GetStream( SegmentSoA::Stream( SegmentSoA::MIN_X + k ) )[ i ];
+			float const	hi	= loaded.GetStream( SegmentSoA::Stream( SegmentSoA::MAX_X + k ) )[ i ];
+			CPPUNIT_ASSERT_EQUAL( std::min( segments[ i ].m_B.m_V[ k ], e.m_V[ k ] ), lo );
+			CPPUNIT_ASSERT_EQUAL( std::max( segments[ i ].m_B.m_V[ k ], e.m_V[ k ] ), hi );
+		}
+	}
+
+	loaded.Clear();
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), loaded.Size() );
+	loaded.Load( segments.data(), 3 );
+	CPPUNIT_ASSERT_EQUAL( size_t( 3 ), loaded.Size() );
+	CPPUNIT_ASSERT( IsEqual( segments[ 2 ].m_B, loaded[ 2 ].m_B ) );
+}
+
+void SegmentSoATest::TestEmpty()
+{
+	SegmentSoA const	segments;
+	PolyBuffer const	polys;
+	Segment const		segment( Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 1.0f, 1.0f, 1.0f ) );
+	int					index	= -1;
+
+	CPPUNIT_ASSERT_EQUAL( 0, Intersect( segment, segments, &index, nullptr, nullptr ) );
+	CPPUNIT_ASSERT_EQUAL( 0, Intersect( segment, polys, &index, nullptr ) );
+	CPPUNIT_ASSERT_EQUAL( -1, index );
+}
+
+void SegmentSoATest::TestGrid()
+{
+	// Sizes around the width of a group
+	for ( int n : { 1, 7, 8, 9, 16, 31, 200 } )
+	{
+		std::vector< Segment >	segments;
+		for ( int i = 0; i < n; ++i )
+		{
+			Segment	segment;
+			segment.m_B = RandomQuarterVector( false );
+			segment.m_M = RandomQuarterVector( true );
+			segments.push_back( segment );
+		}
+
+		SegmentSoA const	set( segments.data(), segments.size() );
+
+		for ( int j = 0; j < 100; ++j )
+		{
+			Segment	segment;
+			segment.m_B = RandomQuarterVector( false );
+			segment.m_M = RandomQuarterVector( true );
+			Check( segment, set );
+		}
+
+		// Every segment against itself, and a point at each end of it
+		for ( Segment const & segment : segments )
+		{
+			Check( segment, set );
+			Check( Segment( segment.m_B, segment.m_B ), set );
+			Check( Segment( segment.m_B + segment.m_M, segment.m_B + segment.m_M ), set );
+		}
+	}
+}
+
+void SegmentSoATest::TestCrossing()
+{
+	// Segments that cross at known parameters, and the same segments moved apart
+	for ( int i = 0; i < 2000; ++i )
+	{
+		float const		s0	= 0.05f + std::fabs( Random() ) * 0.9f;
+		float const		t0	= 0.05f + std::fabs( Random() ) * 0.9f;
+		Vector3 const	p	= RandomVector( 5.0f );
+		Vector3 const	aM	= RandomVector( 3.0f );
+		Vector3 const	bM	= RandomVector( 3.0f );
+		Vector3 const	normal	= Cross( aM, bM );
+		if ( normal.Length() < 0.5f )
+		{
+			continue;
+		}
+
+		Segment	a;
+		Segment	b;
+		a.m_B = p - aM * s0;
+		a.m_M = aM;
+		b.m_B = p - bM * t0;
+		b.m_M = bM;
+
+		SegmentSoA	set;
+		set.PushBack( Segment( p + normal, p + normal * 2.0f ) );
+		set.PushBack( b );
+
+		int		index[ 2 ];
+		float	s;
+		float	t;
+		CPPUNIT_ASSERT_EQUAL( 1, Intersect( a, set, index, &s, &t ) );
+		CPPUNIT_ASSERT_EQUAL( 1, index[ 0 ] );
+		CPPUNIT_ASSERT( IsClose( p, a.m_B + a.m_M * s ) );
+		CPPUNIT_ASSERT( IsClose( p, b.m_B + b.m_M * t ) );
+
+		b.m_B += normal * ( 0.01f / normal.Length() );
+		set.Load( &b, 1 );
+		CPPUNIT_ASSERT_EQUAL( 0, Intersect( a, set, index, &s, &t ) );
+	}
+}
+
+void SegmentSoATest::TestPolygons()
+{
+	for ( int i = 0; i < 200; ++i )
+	{
+		// Regular polygons with 3 to 8 sides in random planes, wound either way
+		PolyBuffer				polys;
+		std::vector< Vector3 >	centers;
+		std::vector< Vector3 >	us;
+		std::vector< Vector3 >	vs;
+		std::vector< int >		sides;
+
+		for ( int j = 0; j < 10; ++j )
+		{
+			Vector3	u	= RandomVector( 1.0f );
+			Vector3	w	= RandomVector( 1.0f );
+			if ( u.Length() < 0.1f || Cross( u, w ).Length() < 0.1f )
+			{
+				continue;
+			}
+			u = u * ( 1.0f / u.Length() );
+			Vector3	v	= Cross( Cross( u, w ), u );
+			v = v * ( ( Random() < 0.0f ? -1.0f : 1.0f ) / v.Length() );
+
+			Vector3 const	center	= RandomVector( 3.0f );
+			int const		n		= 3 + j % 6;
+			Vector3			vertices[ 8 ];
+			for ( int k = 0; k < n; ++k )
+			{
+				float const	angle	= 2.0f * float( M_PI ) * float( k ) / float( n );
+				vertices[ k ] = center + u * std::cos( angle ) + v * std::sin( angle );
+			}
+
+			polys.PushBack( vertices, n );
+			centers.push_back( center );
+			us.push_back( u );
+			vs.push_back( v );
+			sides.push_back( n );
+		}
+
+		for ( int j = 0; j < 50; ++j )
+		{
+			Segment const	segment( RandomVector( 4.0f ), RandomVector( 4.0f ) );
+			int				indices[ 10 ];
+			float			ts[ 10 ];
+			int const		hits	= Intersect( segment, polys, indices, ts );
+			int				expected	= 0;
+
+			for ( int k = 0; k < polys.Size(); ++k )
+			{
+				// The reference: where the segment crosses the plane, in the polygon's coordinates
+				Plane const &	plane	= polys.GetPlane( k );
+				float const		da		= Dot( plane.m_N, segment.m_B ) + plane.m_D;
+				float const		db		= Dot( plane.m_N, segment.m_B + segment.m_M ) + plane.m_D;
+				bool			inside	= false;
+				bool			clear	= true;
+				float			t		= 0.0f;
+
+				if ( da * db <= 0.0f && da != db )
+				{
+					t = da / ( da - db );
+
+					Vector3 const	p	= segment.m_B + segment.m_M * t - centers[ k ];
+					float const		x	= Dot( p, us[ k ] );
+					float const		y	= Dot( p, vs[ k ] );
+					float const		apothem	= std::cos( float( M_PI ) / float( sides[ k ] ) );
+
+					inside = true;
+					for ( int e = 0; e < sides[ k ]; ++e )
+					{
+						float const	angle	= 2.0f * float( M_PI ) * ( float( e ) + 0.5f ) / float( sides[ k ] );
+						float const	d		= x * std::cos( angle ) + y * std::sin( angle ) - apothem;
+						inside = inside && d <= 0.0f;
+						clear = clear && std::fabs( d ) > TOLERANCE;
+					}
+				}
+				clear = clear && std::fabs( da ) > TOLERANCE && std::fabs( db ) > TOLERANCE;
+
+				bool const	hit	= expected < hits && indices[ expected ] == k;
+				if ( clear )
+				{
+					CPPUNIT_ASSERT_EQUAL( inside, hit );
+				}
+				if ( hit )
+				{
+					if ( clear )
+					{
+						CPPUNIT_ASSERT( std::fabs( ts[ expected ] - t ) <= TOLERANCE );
+					}
+					CPPUNIT_ASSERT_EQUAL( Intersectable::INTERSECTS, segment.Intersects( polys[ k ] ) );
+					++expected;
+				}
+				else
+				{
+					CPPUNIT_ASSERT_EQUAL( Intersectable::NO_INTERSECTION,
+										  segment.Intersects( polys[ k ] ) );
+				}
+			}
+			CPPUNIT_ASSERT_EQUAL( expected, hits );
+		}
+	}
+
+	// A segment in the plane of a square: starting inside, crossing an edge, and missing it
+	Vector3 const	square[ 4 ]	= { Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 2.0f, 0.0f, 0.0f ),
+									Vector3( 2.0f, 2.0f, 0.0f ), Vector3( 0.0f, 2.0f, 0.0f ) };
+	PolyBuffer		polys;
+	polys.PushBack( square, 4 );
+
+	Segment const	inside( Vector3( 1.0f, 1.0f, 0.0f ), Vector3( 5.0f, 1.0f, 0.0f ) );
+	Segment const	crossing( Vector3( -2.0f, 1.0f, 0.0f ), Vector3( 2.0f, 1.0f, 0.0f ) );
+	Segment const	missing( Vector3( -2.0f, 3.0f, 0.0f ), Vector3( 4.0f, 3.0f, 0.0f ) );
+	Segment const	vertex( Vector3( 2.0f, 2.0f, 1.0f ), Vector3( 2.0f, 2.0f, 0.0f ) );
+	Segment const	along( Vector3( -1.0f, 0.0f, 0.0f ), Vector3( 1.0f, 0.0f, 0.0f ) );
+	Segment const	beyond( Vector3( 3.0f, 0.0f, 0.0f ), Vector3( 5.0f, 0.0f, 0.0f ) );
+	int				index;
+	float			t;
+
+	CPPUNIT_ASSERT_EQUAL( 1, Intersect( inside, polys, &index, &t ) );
+	CPPUNIT_ASSERT_EQUAL( 0.0f, t );
+	CPPUNIT_ASSERT_EQUAL( 1, Intersect( crossing, polys, &index, &t ) );
+	CPPUNIT_ASSERT( std::fabs( t - 0.5f ) <= TOLERANCE );
+	CPPUNIT_ASSERT_EQUAL( 0, Intersect( missing, polys, &index, &t ) );
+
+	// Collinear with an edge, overlapping it and beyond it
+	CPPUNIT_ASSERT_EQUAL( 1, Intersect( along, polys, &index, &t ) );
+	CPPUNIT_ASSERT_EQUAL( 0.5f, t );
+	CPPUNIT_ASSERT_EQUAL( 0, Intersect( beyond, polys, &index, &t ) );
+
+	// Touching a vertex from above
+	CPPUNIT_ASSERT_EQUAL( 1, Intersect( vertex, polys, &index, &t ) );
+	CPPUNIT_ASSERT_EQUAL( 1.0f, t );
+}
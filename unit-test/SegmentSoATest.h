@@ -0,0 +1,33 @@
+/********************************************************************************************************************
+
+                                                   SegmentSoATest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/SegmentSoA.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class SegmentSoATest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( SegmentSoATest );
+	CPPUNIT_TEST( TestStorage );
+	CPPUNIT_TEST( TestEmpty );
+	CPPUNIT_TEST( TestGrid );
+	CPPUNIT_TEST( TestCrossing );
+	CPPUNIT_TEST( TestPolygons );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestStorage();
+	void TestEmpty();
+	void TestGrid();
+	void TestCrossing();
+	void TestPolygons();
+};
@@ -0,0 +1,330 @@
+/********************************************************************************************************************
+
+                                                     SlabTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	IntersectSlabs() is compared against a reference slab test that divides by each element of the direction and
+	handles a ray parallel to a slab with an explicit branch. The rays include ones with zero (and negative zero)
+	elements, ones that start in the planes of a slab, and boxes with zero thickness. Cases where the ray grazes
+	the box (the range of t is within a small tolerance of being empty) are skipped, since the two tests may round
+	differently. The line, ray and segment overloads of Intersects() for axis-aligned and oriented boxes are
+	compared against the same reference.
+
+ ********************************************************************************************************************/
+
+#include "SlabTest.h"
+
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/Quaternion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SlabTest );
+
+using namespace MyMath;
+
+static float const	TOLERANCE	= 1.0e-4f;
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 55555;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+// Returns a random vector with elements in [-s, s], some of which are 0 or -0
+static Vector3 RandomVector( float s, bool zeros )
+{
+	Vector3	v;
+	for ( int k = 0; k < 3; ++k )
+	{
+		float const	r	= Random();
+		v.m_V[ k ] = ( zeros && r < -0.6f ) ? ( ( r < -0.8f ) ? -0.0f : 0.0f ) : Random() * s;
+	}
+	return v;
+}
+
+// The reference slab test. Returns false if the range of t inside the box is empty. The range is returned even if
+// it is empty (so that cases near the boundary can be skipped).
+static bool Reference( Vector3 const & o, Vector3 const & d, Vector3 const bounds[ 2 ], float tMin, float tMax,
+					   float * pEnter, float * pExit )
+{
+	bool	outside	= false;
+	for ( int k = 0; k < 3; ++k )
+	{
+		if ( d.m_V[ k ] == 0.0f )
+		{
+			outside = outside || o.m_V[ k ] < bounds[ 0 ].m_V[ k ] || o.m_V[ k ] > bounds[ 1 ].m_V[ k ];
+			continue;
+		}
+
+		float	t0	= ( bounds[ 0 ].m_V[ k ] - o.m_V[ k ] ) / d.m_V[ k ];
+		float	t1	= ( bounds[ 1 ].m_V[ k ] - o.m_V[ k ] ) / d.m_V[ k ];
+		if ( t0 > t1 )
+		{
+			std::swap( t0, t1 );
+		}
+		tMin = std::max( tMin, t0 );
+		tMax = std::min( tMax, t1 );
+	}
+
+	*pEnter = tMin;
+	*pExit = tMax;
+	return !outside && tMin <= tMax;
+}
+
+// Returns true if the reference range is not within the tolerance of being empty (or of touching the range of t)
+static bool IsClear( float enter, float exit )
+{
+	return !( std::fabs( exit - enter ) <= TOLERANCE * ( 1.0f + std::fabs( enter ) + std::fabs( exit ) ) );
+}
+
+// Calls IntersectSlabs() for a ray from o in the direction d
+static bool Slabs( Vector3 const & o, Vector3 const & d, Vector3 const bounds[ 2 ], float tMin, float tMax,
+				   float * pEnter, float * pExit )
+{
+	return IntersectSlabs( RayPrecomputed( o, d ), bounds, tMin, tMax, pEnter, pExit );
+}
+
+// Compares IntersectSlabs() with the reference
+static void Check( Vector3 const & o, Vector3 const & d, Vector3 const bounds[ 2 ], float tMin, float tMax )
+{
+	float		enter;
+	float		exit;
+	float		refEnter;
+	float		refExit;
+	bool const	expected	= Reference( o, d, bounds, tMin, tMax, &refEnter, &refExit );
+	bool const	hit			= IntersectSlabs( RayPrecomputed( o, d ), bounds, tMin, tMax, &enter, &exit );
+
+	if ( !IsClear( refEnter, refExit ) )
+	{
+		return;
+	}
+
+	CPPUNIT_ASSERT_EQUAL( expected, hit );
+	if ( expected && hit )
+	{
+		CPPUNIT_ASSERT( std::fabs( enter - refEnter ) <= TOLERANCE * ( 1.0f + std::fabs( refEnter ) ) ||
+						enter == refEnter );
+		CPPUNIT_ASSERT( std::fabs( exit - refExit ) <= TOLERANCE * ( 1.0f + std::fabs( refExit ) ) ||
+						exit == refExit );
+		CPPUNIT_ASSERT( enter >= tMin && exit <= tMax );
+	}
+}
+
+void SlabTest::TestPrecompute()
+{
+	RayPrecomputed const	ray( Vector3( 1.0f, 2.0f, 3.0f ), Vector3( 2.0f, -0.0f, 0.0f ) );
+
+	CPPUNIT_ASSERT_EQUAL( 0.5f, ray.m_InvDirection.m_X );
+	CPPUNIT_ASSERT( std::isinf( ray.m_InvDirection.m_Y ) && ray.m_InvDirection.m_Y < 0.0f );
+	CPPUNIT_ASSERT( std::isinf( ray.m_InvDirection.m_Z ) && ray.m_InvDirection.m_Z > 0.0f );
+	CPPUNIT_ASSERT_EQUAL( 0, ray.m_Signs[ 0 ] );
+	CPPUNIT_ASSERT_EQUAL( 1, ray.m_Signs[ 1 ] );
+	CPPUNIT_ASSERT_EQUAL( 0, ray.m_Signs[ 2 ] );
+
+	Segment const			segment( Vector3( 0.0f, 0.0f, 0.0f ), Vector3( -1.0f, 4.0f, 0.0f ) );
+	RayPrecomputed const	fromSegment( segment );
+	CPPUNIT_ASSERT_EQUAL( -1.0f, fromSegment.m_InvDirection.m_X );
+	CPPUNIT_ASSERT_EQUAL( 0.25f, fromSegment.m_InvDirection.m_Y );
+	CPPUNIT_ASSERT_EQUAL( 1, fromSegment.m_Signs[ 0 ] );
+	CPPUNIT_ASSERT_EQUAL( 0, fromSegment.m_Signs[ 1 ] );
+}
+
+void SlabTest::TestRandom()
+{
+	float const	inf	= std::numeric_limits< float >::infinity();
+
+	for ( int i = 0; i < 20000; ++i )
+	{
+		Vector3 const	lo		= RandomVector( 3.0f, false );
+		Vector3 const	size	= RandomVector( 2.0f, false );
+		Vector3 const	bounds[ 2 ]	= { lo, lo + Vector3( std::fabs( size.m_X ), std::fabs( size.m_Y ),
+													  std::fabs( size.m_Z ) ) };
+		Vector3 const	o		= RandomVector( 6.0f, false );
+		Vector3 const	d		= RandomVector( 1.0f, i % 2 == 0 );
+
+		Check( o, d, bounds, -inf, inf );
+		Check( o, d, bounds, 0.0f, inf );
+		Check( o, d, bounds, 0.0f, 1.0f );
+		Check( o, d, bounds, -2.0f, 0.5f );
+	}
+}
+
+void SlabTest::TestParallel()
+{
+	float const		inf			= std::numeric_limits< float >::infinity();
+	Vector3 const	bounds[ 2 ]	= { Vector3( -1.0f, -2.0f, -3.0f ), Vector3( 1.0f, 2.0f, 3.0f ) };
+	float			enter;
+	float			exit;
+
+	for ( float zero : { 0.0f, -0.0f } )
+	{
+		Vector3 const	d( 1.0f, zero, zero );
+
+		// Inside the y and z slabs, on the planes of the slabs, and outside them
+		CPPUNIT_ASSERT( Slabs( Vector3( -5.0f, 0.0f, 0.0f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+		CPPUNIT_ASSERT_EQUAL( 4.0f, enter );
+		CPPUNIT_ASSERT_EQUAL( 6.0f, exit );
+
+		CPPUNIT_ASSERT( Slabs( Vector3( -5.0f, -2.0f, 3.0f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+		CPPUNIT_ASSERT_EQUAL( 4.0f, enter );
+		CPPUNIT_ASSERT_EQUAL( 6.0f, exit );
+
+		CPPUNIT_ASSERT( Slabs( Vector3( -5.0f, 2.0f, -3.0f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+
+		CPPUNIT_ASSERT( !Slabs( Vector3( -5.0f, 2.0001f, 0.0f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+		CPPUNIT_ASSERT( !Slabs( Vector3( -5.0f, 0.0f, -3.0001f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+
+		// Pointing away from the box
+		CPPUNIT_ASSERT( !Slabs( Vector3( 5.0f, 0.0f, 0.0f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+		CPPUNIT_ASSERT( Slabs( Vector3( 5.0f, 0.0f, 0.0f ), d, bounds, -inf, inf, &enter, &exit ) );
+		CPPUNIT_ASSERT_EQUAL( -6.0f, enter );
+		CPPUNIT_ASSERT_EQUAL( -4.0f, exit );
+
+		// Starting in the plane of the x slab
+		CPPUNIT_ASSERT( Slabs( Vector3( -1.0f, 0.0f, 0.0f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+		CPPUNIT_ASSERT_EQUAL( 0.0f, enter );
+		CPPUNIT_ASSERT_EQUAL( 2.0f, exit );
+	}
+
+	// Parallel to two slabs, starting on an edge of the box
+	for ( Vector3 const & d : { Vector3( 0.0f, 0.0f, 1.0f ), Vector3( 0.0f, 0.0f, -1.0f ) } )
+	{
+		CPPUNIT_ASSERT( Slabs( Vector3( 1.0f, -2.0f, 0.0f ), d, bounds, 0.0f, inf, &enter, &exit ) );
+		CPPUNIT_ASSERT_EQUAL( 0.0f, enter );
+		CPPUNIT_ASSERT_EQUAL( 3.0f, exit );
+	}
+}
+
+void SlabTest::TestDegenerate()
+{
+	float const	inf	= std::numeric_limits< float >::infinity();
+	float		enter;
+	float		exit;
+
+	Vector3 const	origin( 0.0f, 0.0f, 0.0f );
+	Vector3 const	xAxis( 1.0f, 0.0f, 0.0f );
+	Vector3 const	zAxis( 0.0f, 0.0f, 1.0f );
+	Vector3 const	diagonal( 1.0f, 2.0f, 3.0f );
+
+	// A box with zero thickness
+	Vector3 const	flat[ 2 ]	= { Vector3( -1.0f, -1.0f, 2.0f ), Vector3( 1.0f, 1.0f, 2.0f ) };
+	CPPUNIT_ASSERT( Slabs( origin, zAxis, flat, 0.0f, inf, &enter, &exit ) );
+	CPPUNIT_ASSERT_EQUAL( 2.0f, enter );
+	CPPUNIT_ASSERT_EQUAL( 2.0f, exit );
+	CPPUNIT_ASSERT( Slabs( Vector3( -3.0f, 0.5f, 2.0f ), xAxis, flat, 0.0f, inf, &enter, &exit ) );
+	CPPUNIT_ASSERT( !Slabs( Vector3( -3.0f, 0.5f, 2.5f ), xAxis, flat, 0.0f, inf, &enter, &exit ) );
+
+	// A point
+	Vector3 const	point[ 2 ]	= { diagonal, diagonal };
+	CPPUNIT_ASSERT( Slabs( origin, diagonal, point, 0.0f, 1.0f, &enter, &exit ) );
+	CPPUNIT_ASSERT_EQUAL( 1.0f, enter );
+	CPPUNIT_ASSERT( !Slabs( origin, diagonal, point, 0.0f, 0.5f, &enter, &exit ) );
+
+	// A zero direction (a segment with zero length) is inside the box if its origin is
+	Vector3 const	bounds[ 2 ]	= { Vector3( -1.0f, -1.0f, -1.0f ), Vector3( 1.0f, 1.0f, 1.0f ) };
+	CPPUNIT_ASSERT( Slabs( Vector3( 0.5f, -0.5f, 0.0f ), origin, bounds, 0.0f, 1.0f, &enter, &exit ) );
+	CPPUNIT_ASSERT( Slabs( Vector3( 1.0f, -1.0f, 1.0f ), origin, bounds, 0.0f, 1.0f, &enter, &exit ) );
+	CPPUNIT_ASSERT( !Slabs( Vector3( 1.5f, 0.0f, 0.0f ), origin, bounds, 0.0f, 1.0f, &enter, &exit ) );
+
+	// An empty range of t
+	CPPUNIT_ASSERT( !Slabs( origin, xAxis, bounds, 1.0f, 0.0f, &enter, &exit ) );
+}
+
+void SlabTest::TestIntersects()
+{
+	float const	inf	= std::numeric_limits< float >::infinity();
+
+	for ( int i = 0; i < 5000; ++i )
+	{
+		Vector3 const	o	= RandomVector( 6.0f, false );
+		Vector3			d	= RandomVector( 1.0f, i % 2 == 0 );
+		if ( d.Length2() < 0.01f )
+		{
+			continue;
+		}
+
+		Vector3 const	unit	= d * ( 1.0f / d.Length() );
+		Line const		line( unit, o );
+		Ray const		ray( unit, o );
+		Segment const	segment( o, o + d * 4.0f );
+
+		// Axis-aligned box
+		{
+			Vector3 const	lo	= RandomVector( 3.0f, false );
+			Vector3 const	size( 0.5f + std::fabs( Random() ) * 2.0f, 0.5f + std::fabs( Random() ) * 2.0f,
+								  0.5f + std::fabs( Random() ) * 2.0f );
+			AABox const		aabox( lo, size );
+			Vector3 const	bounds[ 2 ]	= { lo, lo + size };
+
+			float	enter;
+			float	exit;
+			bool	expected;
+
+			expected = Reference( o, unit, bounds, -inf, inf, &enter, &exit );
+			if ( IsClear( enter, exit ) )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, line.Intersects( aabox ) == Intersectable::INTERSECTS );
+			}
+			expected = Reference( o, unit, bounds, 0.0f, inf, &enter, &exit );
+			if ( IsClear( enter, exit ) )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, ray.Intersects( aabox ) == Intersectable::INTERSECTS );
+			}
+			expected = Reference( o, segment.m_M, bounds, 0.0f, 1.0f, &enter, &exit );
+			if ( IsClear( enter, exit ) )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, segment.Intersects( aabox ) == Intersectable::INTERSECTS );
+			}
+		}
+
+		// Oriented box, with scales of either sign. The reference works in the box's space.
+		{
+			Quaternion	q( Random(), Random(), Random(), Random() );
+			q.Normalize();
+
+			Vector3	scale;
+			for ( int k = 0; k < 3; ++k )
+			{
+				float const	s	= 0.5f + std::fabs( Random() ) * 2.0f;
+				scale.m_V[ k ] = ( Random() < 0.0f ) ? -s : s;
+			}
+
+			Box const		box( q.GetRotationMatrix33(), RandomVector( 3.0f, false ), scale );
+			Vector3 const	localO		= box.m_InverseOrientation * ( o - box.m_Position );
+			Vector3 const	localD		= box.m_InverseOrientation * unit;
+			Vector3 const	localM		= box.m_InverseOrientation * segment.m_M;
+			Vector3 const	bounds[ 2 ]	= { Vector3( std::min( 0.0f, scale.m_X ), std::min( 0.0f, scale.m_Y ),
+												 std::min( 0.0f, scale.m_Z ) ),
+											Vector3( std::max( 0.0f, scale.m_X ), std::max( 0.0f, scale.m_Y ),
+												 std::max( 0.0f, scale.m_Z ) ) };
+
+			float	enter;
+			float	exit;
+			bool	expected;
+
+			expected = Reference( localO, localD, bounds, -inf, inf, &enter, &exit );
+			if ( IsClear( enter, exit ) )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, line.Intersects( box ) == Intersectable::INTERSECTS );
+			}
+			expected = Reference( localO, localD, bounds, 0.0f, inf, &enter, &exit );
+			if ( IsClear( enter, exit ) )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, ray.Intersects( box ) == Intersectable::INTERSECTS );
+			}
+			expected = Reference( localO, localM, bounds, 0.0f, 1.0f, &enter, &exit );
+			if ( IsClear( enter, exit ) )
+			{
+				CPPUNIT_ASSERT_EQUAL( expected, segment.Intersects( box ) == Intersectable::INTERSECTS );
+			}
+		}
+	}
+}
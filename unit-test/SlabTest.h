@@ -0,0 +1,33 @@
+/********************************************************************************************************************
+
+                                                      SlabTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/Line.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class SlabTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( SlabTest );
+	CPPUNIT_TEST( TestPrecompute );
+	CPPUNIT_TEST( TestRandom );
+	CPPUNIT_TEST( TestParallel );
+	CPPUNIT_TEST( TestDegenerate );
+	CPPUNIT_TEST( TestIntersects );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestPrecompute();
+	void TestRandom();
+	void TestParallel();
+	void TestDegenerate();
+	void TestIntersects();
+};
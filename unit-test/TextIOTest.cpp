@@ -0,0 +1,461 @@
+/********************************************************************************************************************
+
+                                                    TextIOTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	Values written by TextWriter must be read back by TextReader with the same bits, including infinities, NaNs
+	(with their signs), negative zeros, denormals and the extremes of float and int. The text must also match the
+	layout of the stream operators: text written by TextWriter is read with operator >> and text written with
+	operator << is read with TextReader, and both must give the same values. Small chunk and buffer sizes are used so
+	that tokens are split across reads. Reading stops cleanly at the end of the stream or at a bad token.
+
+ ********************************************************************************************************************/
+
+#include "TextIOTest.h"
+
+#include "../include/MyMath/Matrix43.h"
+#include "../include/MyMath/Matrix44.h"
+#include "../include/MyMath/Quaternion.h"
+#include "../include/MyMath/QuaternionSoA.h"
+#include "../include/MyMath/Vector2i.h"
+#include "../include/MyMath/Vector3.h"
+#include "../include/MyMath/Vector3i.h"
+#include "../include/MyMath/Vector3SoA.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TextIOTest );
+
+using namespace MyMath;
+
+// Returns a repeatable pseudo-random 32-bit value
+static uint32_t RandomBits()
+{
+	static uint32_t	state	= 86420;
+	state = state * 1664525u + 1013904223u;
+	return state;
+}
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	return float( RandomBits() >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+// Returns a float with random bits that is finite
+static float RandomFinite()
+{
+	for ( ;; )
+	{
+		uint32_t const	bits	= RandomBits() ^ ( RandomBits() >> 16 );
+		float			f;
+		std::memcpy( &f, &bits, sizeof( f ) );
+		if ( std::isfinite( f ) )
+		{
+			return f;
+		}
+	}
+}
+
+// Returns true if two floats have the same bits (NaNs are compared by their signs only)
+static bool IsSame( float a, float b )
+{
+	if ( std::isnan( a ) || std::isnan( b ) )
+	{
+		return std::isnan( a ) && std::isnan( b ) && std::signbit( a ) == std::signbit( b );
+	}
+	return std::memcmp( &a, &b, sizeof( float ) ) == 0;
+}
+
+// Returns true if two arrays of floats have the same bits
+static bool IsSame( float const * a, float const * b, size_t n )
+{
+	for ( size_t i = 0; i < n; ++i )
+	{
+		if ( !IsSame( a[ i ], b[ i ] ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Writes floats with a TextWriter and returns the text
+static std::string WriteFloats( std::vector< float > const & values, size_t bufferSize )
+{
+	std::ostringstream	out;
+	{
+		TextWriter	writer( out, bufferSize );
+		writer.Write( values.data(), values.size() );
+	}
+	return out.str();
+}
+
+// Reads floats with a TextReader until the end of the text
+static std::vector< float > ReadFloats( std::string const & text, size_t chunkSize, bool * pFail )
+{
+	std::istringstream		in( text );
+	TextReader				reader( in, chunkSize );
+	std::vector< float >	values;
+	float					buffer[ 7 ];
+	size_t					n;
+
+	while ( ( n = reader.Read( buffer, 7 ) ) > 0 )
+	{
+		values.insert( values.end(), buffer, buffer + n );
+	}
+	*pFail = reader.Fail();
+	return values;
+}
+
+void TextIOTest::TestFloatRoundTrip()
+{
+	std::vector< float >	values;
+	for ( int i = 0; i < 20000; ++i )
+	{
+		values.push_back( RandomFinite() );
+	}
+
+	bool						fail;
+	std::string const			text	= WriteFloats( values, 1 );
+	std::vector< float > const	read	= ReadFloats( text, 100, &fail );
+
+	CPPUNIT_ASSERT( !fail );
+	CPPUNIT_ASSERT_EQUAL( values.size(), read.size() );
+	CPPUNIT_ASSERT( IsSame( values.data(), read.data(), values.size() ) );
+
+	// One number per line
+	CPPUNIT_ASSERT_EQUAL( values.size(), size_t( std::count( text.begin(), text.end(), '\n' ) ) );
+}
+
+void TextIOTest::TestSpecialValues()
+{
+	float const	inf	= std::numeric_limits< float >::infinity();
+	float const	nan	= std::numeric_limits< float >::quiet_NaN();
+
+	std::vector< float > const	values	=
+	{
+		inf, -inf, nan, -nan, 0.0f, -0.0f,
+		std::numeric_limits< float >::denorm_min(), -std::numeric_limits< float >::denorm_min(),
+		std::numeric_limits< float >::min(), std::numeric_limits< float >::max(),
+		-std::numeric_limits< float >::max(), std::numeric_limits< float >::epsilon(), 1.0f / 3.0f
+	};
+
+	bool						fail;
+	std::vector< float > const	read	= ReadFloats( WriteFloats( values, 1 ), 1, &fail );
+	CPPUNIT_ASSERT( !fail );
+	CPPUNIT_ASSERT_EQUAL( values.size(), read.size() );
+	CPPUNIT_ASSERT( IsSame( values.data(), read.data(), values.size() ) );
+
+	// Other spellings, and a leading '+' as operator >> allows
+	std::vector< float > const	spelled	= ReadFloats( "infinity -INF NaN +inf +1.5 +0 -0 1e-45 +.5", 4, &fail );
+	std::vector< float > const	meant	= { inf, -inf, nan, inf, 1.5f, 0.0f, -0.0f,
+											std::numeric_limits< float >::denorm_min(), 0.5f };
+	CPPUNIT_ASSERT( !fail );
+	CPPUNIT_ASSERT_EQUAL( meant.size(), spelled.size() );
+	CPPUNIT_ASSERT( IsSame( meant.data(), spelled.data(), meant.size() ) );
+}
+
+void TextIOTest::TestInts()
+{
+	std::vector< int >	values	= { 0, 1, -1, std::numeric_limits< int >::max(), std::numeric_limits< int >::min() };
+	for ( int i = 0; i < 1000; ++i )
+	{
+		values.push_back( int( RandomBits() ) );
+	}
+
+	std::ostringstream	out;
+	{
+		TextWriter	writer( out, 1 );
+		writer.Write( values.data(), values.size() );
+	}
+
+	std::istringstream	in( out.str() );
+	TextReader			reader( in, 3 );
+	std::vector< int >	read( values.size() + 1 );
+	CPPUNIT_ASSERT_EQUAL( values.size(), reader.Read( read.data(), read.size() ) );
+	CPPUNIT_ASSERT( !reader.Fail() );
+	CPPUNIT_ASSERT( std::equal( values.begin(), values.end(), read.begin() ) );
+
+	// Out of range, and not an int
+	for ( char const * text : { "2147483648", "-2147483649", "1.5", "1e3", "0x10" } )
+	{
+		std::istringstream	bad( text );
+		TextReader			badReader( bad );
+		int					value;
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), badReader.Read( &value, 1 ) );
+		CPPUNIT_ASSERT( badReader.Fail() );
+	}
+}
+
+void TextIOTest::TestElements()
+{
+	size_t const				n	= 50;
+	std::vector< Vector3 >		vectors( n );
+	std::vector< Vector2i >		vectors2i( n );
+	std::vector< Vector3i >		vectors3i( n );
+	std::vector< Quaternion >	quaternions( n );
+	std::vector< Matrix43 >		matrices43( n );
+	std::vector< Matrix44 >		matrices44( n );
+	Vector3SoA					vectorSoA;
+	QuaternionSoA				quaternionSoA;
+
+	for ( size_t i = 0; i < n; ++i )
+	{
+		vectors[ i ] = Vector3( RandomFinite(), Random(), -Random() );
+		vectors2i[ i ] = Vector2i( int( RandomBits() ), -int( i ) );
+		vectors3i[ i ] = Vector3i( int( i ), int( RandomBits() ), 7 );
+		quaternions[ i ] = Quaternion( Random(), Random(), Random(), RandomFinite() );
+		for ( int k = 0; k < 4 * 3; ++k )
+		{
+			( &matrices43[ i ].m_M[ 0 ][ 0 ] )[ k ] = RandomFinite();
+		}
+		for ( int k = 0; k < 4 * 4; ++k )
+		{
+			( &matrices44[ i ].m_M[ 0 ][ 0 ] )[ k ] = RandomFinite();
+		}
+		vectorSoA.PushBack( vectors[ i ] );
+		quaternionSoA.PushBack( quaternions[ i ] );
+	}
+
+	std::ostringstream	out;
+	{
+		TextWriter	writer( out, 1 );
+		writer.Write( vectors.data(), n );
+		writer.Write( vectors2i.data(), n );
+		writer.Write( vectors3i.data(), n );
+		writer.Write( quaternions.data(), n );
+		writer.Write( matrices43.data(), n );
+		writer.Write( matrices44.data(), n );
+		writer.Write( vectorSoA );
+		writer.Write( quaternionSoA );
+	}
+
+	std::vector< Vector3 >		readVectors( n );
+	std::vector< Vector2i >		readVectors2i( n );
+	std::vector< Vector3i >		readVectors3i( n );
+	std::vector< Quaternion >	readQuaternions( n );
+	std::vector< Matrix43 >		readMatrices43( n );
+	std::vector< Matrix44 >		readMatrices44( n );
+	Vector3SoA					readVectorSoA;
+	QuaternionSoA				readQuaternionSoA;
+
+	std::istringstream	in( out.str() );
+	TextReader			reader( in, 64 );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( readVectors.data(), n ) );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( readVectors2i.data(), n ) );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( readVectors3i.data(), n ) );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( readQuaternions.data(), n ) );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( readMatrices43.data(), n ) );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( readMatrices44.data(), n ) );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( &readVectorSoA, n ) );
+	CPPUNIT_ASSERT_EQUAL( n, reader.Read( &readQuaternionSoA, n + 1 ) );
+	CPPUNIT_ASSERT( !reader.Fail() );
+	CPPUNIT_ASSERT_EQUAL( n, readVectorSoA.Size() );
+	CPPUNIT_ASSERT_EQUAL( n, readQuaternionSoA.Size() );
+
+	for ( size_t i = 0; i < n; ++i )
+	{
+		CPPUNIT_ASSERT( IsSame( vectors[ i ].m_V, readVectors[ i ].m_V, 3 ) );
+		CPPUNIT_ASSERT( vectors2i[ i ].m_V[ 0 ] == readVectors2i[ i ].m_V[ 0 ] );
+		CPPUNIT_ASSERT( vectors2i[ i ].m_V[ 1 ] == readVectors2i[ i ].m_V[ 1 ] );
+		CPPUNIT_ASSERT( std::equal( vectors3i[ i ].m_V, vectors3i[ i ].m_V + 3, readVectors3i[ i ].m_V ) );
+		CPPUNIT_ASSERT( IsSame( quaternions[ i ].m_Q, readQuaternions[ i ].m_Q, 4 ) );
+		CPPUNIT_ASSERT( IsSame( &matrices43[ i ].m_M[ 0 ][ 0 ], &readMatrices43[ i ].m_M[ 0 ][ 0 ], 4 * 3 ) );
+		CPPUNIT_ASSERT( IsSame( &matrices44[ i ].m_M[ 0 ][ 0 ], &readMatrices44[ i ].m_M[ 0 ][ 0 ], 4 * 4 ) );
+		CPPUNIT_ASSERT( IsSame( vectors[ i ].m_V, Vector3( readVectorSoA[ i ] ).m_V, 3 ) );
+		CPPUNIT_ASSERT( IsSame( quaternions[ i ].m_Q, Quaternion( readQuaternionSoA[ i ] ).m_Q, 4 ) );
+	}
+}
+
+void TextIOTest::TestStreamOperators()
+{
+	std::vector< Vector3 >	vectors;
+	for ( int i = 0; i < 1000; ++i )
+	{
+		vectors.push_back( Vector3( RandomFinite(), Random() * 1000.0f, Random() * 1.0e-6f ) );
+	}
+
+	// TextWriter's text read with operator >>
+	std::ostringstream	out;
+	{
+		TextWriter	writer( out, 1 );
+		writer.Write( vectors.data(), vectors.size() );
+	}
+	std::istringstream	in( out.str() );
+	for ( Vector3 const & v : vectors )
+	{
+		Vector3	read;
+		in >> read;
+		CPPUNIT_ASSERT( !in.fail() );
+		CPPUNIT_ASSERT( IsSame( v.m_V, read.m_V, 3 ) );
+	}
+
+	// operator <<'s text (with enough digits to round-trip) read with TextReader, and compared with operator >>
+	std::ostringstream	streamed;
+	streamed.precision( std::numeric_limits< float >::max_digits10 );
+	for ( Vector3 const & v : vectors )
+	{
+		streamed << v << '\n';
+	}
+
+	std::istringstream		textIn( streamed.str() );
+	std::istringstream		streamIn( streamed.str() );
+	TextReader				reader( textIn, 5 );
+	std::vector< Vector3 >	read( vectors.size() );
+	CPPUNIT_ASSERT_EQUAL( vectors.size(), reader.Read( read.data(), read.size() ) );
+
+	for ( size_t i = 0; i < vectors.size(); ++i )
+	{
+		Vector3	expected;
+		streamIn >> expected;
+		CPPUNIT_ASSERT( IsSame( expected.m_V, read[ i ].m_V, 3 ) );
+		CPPUNIT_ASSERT( IsSame( vectors[ i ].m_V, read[ i ].m_V, 3 ) );
+	}
+}
+
+void TextIOTest::TestChunkBoundaries()
+{
+	std::vector< float >	values;
+	for ( int i = 0; i < 300; ++i )
+	{
+		values.push_back( ( i % 3 == 0 ) ? RandomFinite() : Random() );
+	}
+
+	// Separated by runs of mixed whitespace, so tokens and whitespace are split at every position
+	std::string	text	= " \t";
+	for ( float value : values )
+	{
+		char	buffer[ 64 ];
+		std::snprintf( buffer, sizeof( buffer ), "%.9g", double( value ) );
+		text += buffer;
+		text += ( value > 0.0f ) ? "\r\n" : " \t \v\f ";
+	}
+
+	// With and without whitespace at the end
+	std::string const	trimmed	= text.substr( 0, text.find_last_not_of( " \t\v\f\r\n" ) + 1 );
+
+	for ( size_t chunkSize : { size_t( 1 ), size_t( 2 ), size_t( 3 ), size_t( 7 ), size_t( 16 ), size_t( 1000 ) } )
+	{
+		for ( std::string const & t : { text, trimmed } )
+		{
+			bool						fail;
+			std::vector< float > const	read	= ReadFloats( t, chunkSize, &fail );
+			CPPUNIT_ASSERT( !fail );
+			CPPUNIT_ASSERT_EQUAL( values.size(), read.size() );
+			CPPUNIT_ASSERT( IsSame( values.data(), read.data(), values.size() ) );
+		}
+	}
+
+	// A token much longer than the chunk
+	std::string const	longToken	= "1." + std::string( 200, '0' ) + "1";
+	bool				fail;
+	CPPUNIT_ASSERT( IsSame( 1.0f, ReadFloats( longToken, 4, &fail ).at( 0 ) ) );
+	CPPUNIT_ASSERT( !fail );
+}
+
+void TextIOTest::TestEmpty()
+{
+	for ( char const * text : { "", " ", "\n\n\t  \r\n" } )
+	{
+		std::istringstream	in( text );
+		TextReader			reader( in, 2 );
+		float				f;
+		Vector3				v;
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.Read( &f, 1 ) );
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.Read( &v, 1 ) );
+		CPPUNIT_ASSERT( !reader.Fail() );
+	}
+
+	// Reading or writing nothing
+	std::istringstream	in( "1 2 3" );
+	TextReader			reader( in );
+	Vector3				v;
+	CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.Read( &v, 0 ) );
+	CPPUNIT_ASSERT_EQUAL( size_t( 1 ), reader.Read( &v, 1 ) );
+
+	std::ostringstream	out;
+	{
+		TextWriter	writer( out );
+		writer.Write( &v, 0 );
+		writer.Write( Vector3SoA() );
+	}
+	CPPUNIT_ASSERT( out.str().empty() );
+}
+
+void TextIOTest::TestTruncated()
+{
+	// The last vector and matrix are incomplete, which is the end of the stream rather than a failure. The stream ends
+	// in a token, which may be at the end of a chunk.
+	for ( size_t chunkSize = 1; chunkSize <= 16; ++chunkSize )
+	{
+		std::istringstream	in( "1 2 3\n4 5 6\n7 8" );
+		TextReader			reader( in, chunkSize );
+		float				f[ 9 ];
+		CPPUNIT_ASSERT_EQUAL( size_t( 8 ), reader.Read( f, 9 ) );
+		CPPUNIT_ASSERT( !reader.Fail() );
+		CPPUNIT_ASSERT( IsSame( 8.0f, f[ 7 ] ) );
+
+		std::istringstream	inVectors( "1 2 3\n4 5 6\n7 8" );
+		TextReader			vectorReader( inVectors, chunkSize );
+		Vector3				v[ 3 ];
+		CPPUNIT_ASSERT_EQUAL( size_t( 2 ), vectorReader.Read( v, 3 ) );
+		CPPUNIT_ASSERT( !vectorReader.Fail() );
+		CPPUNIT_ASSERT( IsSame( 6.0f, v[ 1 ].m_Z ) );
+	}
+	{
+		std::istringstream	in( "1 2 3 4 5 6 7 8 9 10 11" );
+		TextReader			reader( in );
+		Matrix43			m;
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.Read( &m, 1 ) );
+		CPPUNIT_ASSERT( !reader.Fail() );
+	}
+
+	// A number cut off in its exponent, or a sign alone, is not a number
+	{
+		std::istringstream	in( "1.25e" );
+		TextReader			reader( in );
+		float				f;
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.Read( &f, 1 ) );
+		CPPUNIT_ASSERT( reader.Fail() );
+	}
+	{
+		std::istringstream	in( "-" );
+		TextReader			reader( in );
+		float				f;
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.Read( &f, 1 ) );
+		CPPUNIT_ASSERT( reader.Fail() );
+	}
+}
+
+void TextIOTest::TestErrors()
+{
+	// Reading stops at the first token that isn't a number, and stays stopped
+	for ( char const * text : { "1 2 x 4", "1 2 3x 4", "1 2 +-3 4", "1 2 1e50 4", "1 2 , 4", "1 2 0x1p3 4" } )
+	{
+		std::istringstream	in( text );
+		TextReader			reader( in, 2 );
+		float				f[ 4 ];
+		CPPUNIT_ASSERT_EQUAL( size_t( 2 ), reader.Read( f, 4 ) );
+		CPPUNIT_ASSERT( reader.Fail() );
+		CPPUNIT_ASSERT_EQUAL( size_t( 0 ), reader.Read( f, 1 ) );
+		CPPUNIT_ASSERT( reader.Fail() );
+	}
+
+	// An incomplete vector before a bad token
+	std::istringstream	in( "1 2 3 4 5 bad" );
+	TextReader			reader( in );
+	Vector3				v[ 2 ];
+	CPPUNIT_ASSERT_EQUAL( size_t( 1 ), reader.Read( v, 2 ) );
+	CPPUNIT_ASSERT( reader.Fail() );
+}
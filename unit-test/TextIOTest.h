@@ -0,0 +1,41 @@
+/********************************************************************************************************************
+
+                                                     TextIOTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/TextIO.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class TextIOTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( TextIOTest );
+	CPPUNIT_TEST( TestFloatRoundTrip );
+	CPPUNIT_TEST( TestSpecialValues );
+	CPPUNIT_TEST( TestInts );
+	CPPUNIT_TEST( TestElements );
+	CPPUNIT_TEST( TestStreamOperators );
+	CPPUNIT_TEST( TestChunkBoundaries );
+	CPPUNIT_TEST( TestEmpty );
+	CPPUNIT_TEST( TestTruncated );
+	CPPUNIT_TEST( TestErrors );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestFloatRoundTrip();
+	void TestSpecialValues();
+	void TestInts();
+	void TestElements();
+	void TestStreamOperators();
+	void TestChunkBoundaries();
+	void TestEmpty();
+	void TestTruncated();
+	void TestErrors();
+};
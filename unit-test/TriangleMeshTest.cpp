@@ -0,0 +1,466 @@
+/********************************************************************************************************************
+
+                                                 TriangleMeshTest.cpp
+
+	--------------------------------------------------------------------------------------------------------------
+
+	The queries of TriangleMesh are compared against brute-force references that test every triangle with the
+	scalar functions (Intersect() and ClosestPointOnTriangle()). The meshes include degenerate triangles (repeated
+	and collinear vertices), a flat grid that rays travel along, and enough triangles for several levels of the
+	hierarchy. Sphere sweeps are checked by sampling the distance from the sphere's center to the mesh along the
+	sweep.
+
+ ********************************************************************************************************************/
+
+#include "TriangleMeshTest.h"
+
+#include "../include/MyMath/Box.h"
+#include "../include/MyMath/Frustum.h"
+#include "../include/MyMath/Line.h"
+#include "../include/MyMath/Plane.h"
+#include "../include/MyMath/Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TriangleMeshTest );
+
+using namespace MyMath;
+
+static float const	TOLERANCE	= 1.0e-4f;
+
+// Returns a repeatable pseudo-random value in [-1, 1]
+static float Random()
+{
+	static uint32_t	state	= 86420;
+	state = state * 1664525u + 1013904223u;
+	return float( state >> 8 ) / float( 1 << 23 ) - 1.0f;
+}
+
+static Vector3 RandomVector()
+{
+	return Vector3( Random(), Random(), Random() );
+}
+
+static Vector3 RandomDirection()
+{
+	Vector3	d;
+	do
+	{
+		d = RandomVector();
+	} while ( d.Length2() < 0.01f || d.Length2() > 1.0f );
+	return d * ( 1.0f / d.Length() );
+}
+
+static bool IsClose( float a, float b )
+{
+	return std::fabs( a - b ) <= TOLERANCE * ( 1.0f + std::fabs( b ) );
+}
+
+// A mesh and the vertices of each of its triangles
+struct TestMesh
+{
+	std::vector< Vector3 >	vertices;
+	std::vector< int >		indices;
+
+	int TriangleCount() const { return int( indices.size() / 3 ); }
+
+	void GetTriangle( int i, Vector3 * pV0, Vector3 * pV1, Vector3 * pV2 ) const
+	{
+		*pV0 = vertices[ indices[ 3 * i + 0 ] ];
+		*pV1 = vertices[ indices[ 3 * i + 1 ] ];
+		*pV2 = vertices[ indices[ 3 * i + 2 ] ];
+	}
+
+	void AddTriangle( Vector3 const & v0, Vector3 const & v1, Vector3 const & v2 )
+	{
+		for ( Vector3 const & v : { v0, v1, v2 } )
+		{
+			indices.push_back( int( vertices.size() ) );
+			vertices.push_back( v );
+		}
+	}
+
+	TriangleMesh Build() const
+	{
+		return TriangleMesh( vertices.data(), int( vertices.size() ), indices.data(), TriangleCount() );
+	}
+};
+
+// Returns random triangles in [-5, 5]^2 x [1, 11], including degenerate ones, and a flat grid at z = 6
+static TestMesh MakeMesh( int nTriangles )
+{
+	TestMesh	mesh;
+	Vector3 const	center( 0.0f, 0.0f, 6.0f );
+
+	for ( int i = 0; i < nTriangles; ++i )
+	{
+		Vector3 const	v0	= center + RandomVector() * 5.0f;
+		Vector3 const	v1	= v0 + RandomVector();
+		Vector3 const	v2	= v0 + RandomVector();
+
+		switch ( i % 10 )
+		{
+		case 0:		mesh.AddTriangle( v0, v0, v0 );						break;	// A point
+		case 1:		mesh.AddTriangle( v0, v1, v1 );						break;	// A segment
+		case 2:		mesh.AddTriangle( v0, ( v0 + v1 ) * 0.5f, v1 );	break;	// Collinear
+		default:	mesh.AddTriangle( v0, v1, v2 );						break;
+		}
+	}
+
+	// A flat grid with shared vertices
+	int const	n		= 6;
+	int const	first	= int( mesh.vertices.size() );
+	for ( int y = 0; y <= n; ++y )
+	{
+		for ( int x = 0; x <= n; ++x )
+		{
+			mesh.vertices.push_back( Vector3( float( x - n / 2 ), float( y - n / 2 ), 6.0f ) );
+		}
+	}
+	for ( int y = 0; y < n; ++y )
+	{
+		for ( int x = 0; x < n; ++x )
+		{
+			int const	v	= first + y * ( n + 1 ) + x;
+			int const	quad[ 6 ]	= { v, v + 1, v + n + 2, v, v + n + 2, v + n + 1 };
+			mesh.indices.insert( mesh.indices.end(), quad, quad + 6 );
+		}
+	}
+
+	return mesh;
+}
+
+// Returns the nearest hit of a ray with any triangle, found by testing every triangle
+static bool BruteForceRaycast( TestMesh const & mesh, Ray const & ray, float maxT, TriangleMesh::Hit * pHit )
+{
+	bool	hit		= false;
+	float	best	= maxT;
+	for ( int i = 0; i < mesh.TriangleCount(); ++i )
+	{
+		Vector3	v0, v1, v2;
+		mesh.GetTriangle( i, &v0, &v1, &v2 );
+
+		float	t, u, v;
+		if ( Intersect( ray, v0, v1, v2, best, &t, &u, &v ) )
+		{
+			hit = true;
+			best = t;
+			pHit->m_Triangle = i;
+			pHit->m_T = t;
+			pHit->m_U = u;
+			pHit->m_V = v;
+		}
+	}
+	return hit;
+}
+
+// Returns the distance from a point to the nearest triangle
+static float BruteForceDistance( TestMesh const & mesh, Vector3 const & p )
+{
+	float	best	= std::numeric_limits< float >::infinity();
+	for ( int i = 0; i < mesh.TriangleCount(); ++i )
+	{
+		Vector3	v0, v1, v2;
+		mesh.GetTriangle( i, &v0, &v1, &v2 );
+		best = std::min( best, ( ClosestPointOnTriangle( p, v0, v1, v2 ) - p ).Length() );
+	}
+	return best;
+}
+
+// Checks a ray against the brute-force reference
+static void CheckRay( TestMesh const & mesh, TriangleMesh const & tm, Ray const & ray, float maxT )
+{
+	TriangleMesh::Hit	expected	= {};
+	TriangleMesh::Hit	hit			= {};
+	bool const			e			= BruteForceRaycast( mesh, ray, maxT, &expected );
+	bool const			h			= tm.Raycast( ray, maxT, &hit );
+
+	CPPUNIT_ASSERT_EQUAL( e, h );
+	CPPUNIT_ASSERT_EQUAL( e, tm.AnyHit( ray, maxT ) );
+	if ( e && h )
+	{
+		// Triangles that are hit at the same distance (e.g. at a shared edge) may be reported in either order
+		CPPUNIT_ASSERT( IsClose( hit.m_T, expected.m_T ) );
+		CPPUNIT_ASSERT( hit.m_T < maxT );
+
+		Vector3	v0, v1, v2;
+		mesh.GetTriangle( hit.m_Triangle, &v0, &v1, &v2 );
+		Vector3 const	p	= v0 + ( v1 - v0 ) * hit.m_U + ( v2 - v0 ) * hit.m_V;
+		CPPUNIT_ASSERT( ( p - ( ray.m_B + ray.m_M * hit.m_T ) ).Length() < 1.0e-3f );
+	}
+}
+
+void TriangleMeshTest::TestEmpty()
+{
+	Vector3 const			v( 1.0f, 2.0f, 3.0f );
+	TriangleMesh const		mesh( &v, 1, nullptr, 0 );
+	TriangleMesh const		none( nullptr, 0, nullptr, 0 );
+	Ray const				ray( Vector3( 0.0f, 0.0f, 1.0f ), Vector3( 1.0f, 2.0f, 0.0f ) );
+	TriangleMesh::Hit		hit;
+
+	for ( TriangleMesh const * p : { &mesh, &none } )
+	{
+		CPPUNIT_ASSERT_EQUAL( 0, p->GetTriangleCount() );
+		CPPUNIT_ASSERT( !p->Raycast( ray, 100.0f, &hit ) );
+		CPPUNIT_ASSERT( !p->AnyHit( ray, 100.0f ) );
+		CPPUNIT_ASSERT( !p->SphereSweep( Sphere( v, 1.0f ), Vector3( 1.0f, 0.0f, 0.0f ), 10.0f, &hit ) );
+
+		int				triangle	= 0;
+		Vector3 const	c			= p->ClosestPoint( v, &triangle );
+		CPPUNIT_ASSERT_EQUAL( -1, triangle );
+		CPPUNIT_ASSERT( c.m_X == v.m_X && c.m_Y == v.m_Y && c.m_Z == v.m_Z );
+
+		std::vector< int >	triangles;
+		p->Overlaps( Frustum::Perspective( 1.0f, 1.0f, 0.1f, 100.0f ), &triangles );
+		CPPUNIT_ASSERT( triangles.empty() );
+	}
+}
+
+void TriangleMeshTest::TestPacket()
+{
+	// The 8-wide test must find the nearest of the triangles found by the scalar test, with unused lanes
+	for ( int test = 0; test < 2000; ++test )
+	{
+		int const			n		= 1 + test % TrianglePacket8::SIZE;
+		TrianglePacket8		packet	= {};
+		Vector3				v[ TrianglePacket8::SIZE ][ 3 ];
+
+		for ( int lane = 0; lane < TrianglePacket8::SIZE; ++lane )
+		{
+			packet.m_Index[ lane ] = -1;
+		}
+		for ( int lane = 0; lane < n; ++lane )
+		{
+			v[ lane ][ 0 ] = RandomVector() * 2.0f + Vector3( 0.0f, 0.0f, 4.0f );
+			v[ lane ][ 1 ] = ( lane == 0 ) ? v[ lane ][ 0 ] : v[ lane ][ 0 ] + RandomVector() * 2.0f;
+			v[ lane ][ 2 ] = v[ lane ][ 0 ] + RandomVector() * 2.0f;
+			for ( int k = 0; k < 3; ++k )
+			{
+				packet.m_V0[ k ][ lane ] = v[ lane ][ 0 ].m_V[ k ];
+				packet.m_E1[ k ][ lane ] = v[ lane ][ 1 ].m_V[ k ] - v[ lane ][ 0 ].m_V[ k ];
+				packet.m_E2[ k ][ lane ] = v[ lane ][ 2 ].m_V[ k ] - v[ lane ][ 0 ].m_V[ k ];
+			}
+			packet.m_Index[ lane ] = lane;
+		}
+
+		Vector3 const	d		= RandomDirection() * 0.5f + Vector3( 0.0f, 0.0f, 0.5f );
+		Ray const		unit( d * ( 1.0f / d.Length() ), RandomVector() );
+		float const	maxT	= ( test % 3 == 0 ) ? 3.0f : 100.0f;
+
+		int		expected	= -1;
+		float	best		= maxT;
+		for ( int lane = 0; lane < n; ++lane )
+		{
+			float	t, u, w;
+			if ( Intersect( unit, v[ lane ][ 0 ], v[ lane ][ 1 ], v[ lane ][ 2 ], best, &t, &u, &w ) )
+			{
+				expected = lane;
+				best = t;
+			}
+		}
+
+		float		t, u, w;
+		int const	lane	= Intersect( unit, packet, maxT, &t, &u, &w );
+		CPPUNIT_ASSERT_EQUAL( expected, lane );
+		if ( expected >= 0 && lane >= 0 )
+		{
+			CPPUNIT_ASSERT( IsClose( t, best ) );
+		}
+	}
+}
+
+void TriangleMeshTest::TestRaycast()
+{
+	for ( int nTriangles : { 1, 7, 8, 9, 100, 1000 } )
+	{
+		TestMesh const		mesh	= MakeMesh( nTriangles );
+		TriangleMesh const	tm		= mesh.Build();
+		CPPUNIT_ASSERT_EQUAL( mesh.TriangleCount(), tm.GetTriangleCount() );
+
+		for ( int i = 0; i < 300; ++i )
+		{
+			Vector3 const	origin	= Vector3( 0.0f, 0.0f, 6.0f ) + RandomVector() * 8.0f;
+			Vector3 const	target	= Vector3( 0.0f, 0.0f, 6.0f ) + RandomVector() * 5.0f;
+			Vector3 const	d		= target - origin;
+			if ( d.Length2() < 1.0e-6f )
+			{
+				continue;
+			}
+
+			Ray const	ray( d * ( 1.0f / d.Length() ), origin );
+			CheckRay( mesh, tm, ray, std::numeric_limits< float >::infinity() );
+			CheckRay( mesh, tm, ray, 4.0f );
+		}
+	}
+}
+
+void TriangleMeshTest::TestParallelRays()
+{
+	TestMesh const		mesh	= MakeMesh( 50 );
+	TriangleMesh const	tm		= mesh.Build();
+	float const			inf		= std::numeric_limits< float >::infinity();
+
+	// Axis-aligned rays (with zero elements in the direction), including rays in the plane of the flat grid and rays
+	// along the boundaries of the mesh's bounds
+	AABox const		bounds	= tm.GetBounds();
+	Vector3 const	axes[]	= { Vector3( 1.0f, 0.0f, 0.0f ), Vector3( 0.0f, 1.0f, 0.0f ), Vector3( 0.0f, 0.0f, 1.0f ),
+								Vector3( -1.0f, 0.0f, 0.0f ), Vector3( 0.0f, -1.0f, 0.0f ), Vector3( 0.0f, 0.0f, -1.0f ) };
+
+	for ( Vector3 const & axis : axes )
+	{
+		for ( int i = 0; i < 100; ++i )
+		{
+			Vector3	origin	= Vector3( 0.0f, 0.0f, 6.0f ) + RandomVector() * 6.0f - axis * 10.0f;
+			if ( i % 4 == 0 )
+			{
+				origin.m_Z = 6.0f;
+			}
+			CheckRay( mesh, tm, Ray( axis, origin ), inf );
+		}
+
+		CheckRay( mesh, tm, Ray( axis, bounds.m_Position ), inf );
+		CheckRay( mesh, tm, Ray( axis, bounds.m_Position + bounds.m_Scale ), inf );
+		CheckRay( mesh, tm, Ray( axis, bounds.m_Position - axis * 20.0f ), inf );
+	}
+
+	// A ray in the plane of the flat grid cannot hit it
+	TestMesh	flat;
+	flat.AddTriangle( Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 1.0f, 0.0f, 0.0f ), Vector3( 0.0f, 1.0f, 0.0f ) );
+	TriangleMesh const	single	= flat.Build();
+	Vector3 const		d		= Vector3( 1.0f, 1.0f, 0.0f ) * ( 1.0f / std::sqrt( 2.0f ) );
+	TriangleMesh::Hit	hit;
+	CPPUNIT_ASSERT( !single.Raycast( Ray( d, Vector3( -1.0f, -1.0f, 0.0f ) ), inf, &hit ) );
+	CPPUNIT_ASSERT( !single.AnyHit( Ray( d, Vector3( -1.0f, -1.0f, 0.0f ) ), inf ) );
+	CPPUNIT_ASSERT( single.Raycast( Ray( Vector3( 0.0f, 0.0f, -1.0f ), Vector3( 0.25f, 0.25f, 1.0f ) ), inf, &hit ) );
+	CPPUNIT_ASSERT( IsClose( hit.m_T, 1.0f ) );
+}
+
+void TriangleMeshTest::TestClosestPoint()
+{
+	for ( int nTriangles : { 1, 3, 9, 100, 1000 } )
+	{
+		TestMesh const		mesh	= MakeMesh( nTriangles );
+		TriangleMesh const	tm		= mesh.Build();
+
+		for ( int i = 0; i < 300; ++i )
+		{
+			Vector3 const	p	= Vector3( 0.0f, 0.0f, 6.0f ) + RandomVector() * ( ( i % 2 == 0 ) ? 6.0f : 30.0f );
+
+			int				triangle	= -1;
+			Vector3 const	c			= tm.ClosestPoint( p, &triangle );
+			CPPUNIT_ASSERT( triangle >= 0 && triangle < mesh.TriangleCount() );
+
+			// The point must be on the triangle, and as close as the closest point found by brute force
+			Vector3	v0, v1, v2;
+			mesh.GetTriangle( triangle, &v0, &v1, &v2 );
+			Vector3 const	onTriangle	= ClosestPointOnTriangle( p, v0, v1, v2 );
+			CPPUNIT_ASSERT( ( onTriangle - c ).Length() < 1.0e-4f );
+			CPPUNIT_ASSERT( IsClose( ( c - p ).Length(), BruteForceDistance( mesh, p ) ) );
+		}
+	}
+
+	// Degenerate triangles alone
+	TestMesh	degenerate;
+	degenerate.AddTriangle( Vector3( 1.0f, 1.0f, 1.0f ), Vector3( 1.0f, 1.0f, 1.0f ), Vector3( 1.0f, 1.0f, 1.0f ) );
+	degenerate.AddTriangle( Vector3( 0.0f, 0.0f, 0.0f ), Vector3( 1.0f, 0.0f, 0.0f ), Vector3( 2.0f, 0.0f, 0.0f ) );
+	TriangleMesh const	tm	= degenerate.Build();
+	for ( int i = 0; i < 200; ++i )
+	{
+		Vector3 const	p	= RandomVector() * 3.0f;
+		Vector3 const	c	= tm.ClosestPoint( p );
+		CPPUNIT_ASSERT( std::isfinite( c.m_X ) && std::isfinite( c.m_Y ) && std::isfinite( c.m_Z ) );
+		CPPUNIT_ASSERT( IsClose( ( c - p ).Length(), BruteForceDistance( degenerate, p ) ) );
+	}
+}
+
+void TriangleMeshTest::TestSphereSweep()
+{
+	TestMesh const		mesh	= MakeMesh( 60 );
+	TriangleMesh const	tm		= mesh.Build();
+	int const			STEPS	= 200;
+
+	for ( int i = 0; i < 200; ++i )
+	{
+		Vector3 const	origin		= Vector3( 0.0f, 0.0f, 6.0f ) + RandomVector() * 9.0f;
+		Vector3 const	direction	= ( i % 10 == 0 ) ? Vector3( 0.0f, 0.0f, 1.0f ) : RandomDirection();
+		float const		r			= 0.05f + 0.5f * std::fabs( Random() );
+		float const		maxT		= 15.0f;
+
+		TriangleMesh::Hit	hit;
+		bool const			h	= tm.SphereSweep( Sphere( origin, r ), direction, maxT, &hit );
+		float const			end	= h ? hit.m_T : maxT;
+
+		// The sphere does not touch the mesh before the hit
+		for ( int k = 0; k < STEPS; ++k )
+		{
+			float const	t	= end * float( k ) / float( STEPS );
+			if ( h && t >= hit.m_T - 1.0e-3f )
+			{
+				break;
+			}
+			CPPUNIT_ASSERT( BruteForceDistance( mesh, origin + direction * t ) > r - 1.0e-3f );
+		}
+
+		// It touches the triangle that was hit at the hit
+		if ( h )
+		{
+			CPPUNIT_ASSERT( hit.m_T >= 0.0f && hit.m_T <= maxT );
+
+			Vector3	v0, v1, v2;
+			mesh.GetTriangle( hit.m_Triangle, &v0, &v1, &v2 );
+			Vector3 const	c	= origin + direction * hit.m_T;
+			float const		d	= ( ClosestPointOnTriangle( c, v0, v1, v2 ) - c ).Length();
+			CPPUNIT_ASSERT( d <= r + 1.0e-3f );
+			CPPUNIT_ASSERT( hit.m_T == 0.0f || d >= r - 1.0e-3f );
+		}
+	}
+}
+
+void TriangleMeshTest::TestOverlaps()
+{
+	for ( int nTriangles : { 1, 8, 9, 100, 1000 } )
+	{
+		TestMesh const		mesh	= MakeMesh( nTriangles );
+		TriangleMesh const	tm		= mesh.Build();
+
+		for ( int i = 0; i < 20; ++i )
+		{
+			Frustum const	frustum	= Frustum::Perspective( 0.2f + 1.2f * std::fabs( Random() ),
+															 0.5f + std::fabs( Random() ),
+															 1.0f + 5.0f * std::fabs( Random() ),
+															 7.0f + 6.0f * std::fabs( Random() ) );
+
+			std::vector< int >	triangles;
+			tm.Overlaps( frustum, &triangles );
+
+			// The reference rejects a triangle only if all of its vertices are in front of one side
+			std::vector< int >	expected;
+			for ( int t = 0; t < mesh.TriangleCount(); ++t )
+			{
+				Vector3	v[ 3 ];
+				mesh.GetTriangle( t, &v[ 0 ], &v[ 1 ], &v[ 2 ] );
+
+				bool	rejected	= false;
+				for ( Plane const & side : frustum.sides_ )
+				{
+					rejected = rejected || ( Dot( side.m_N, v[ 0 ] ) + side.m_D > 0.0f &&
+											 Dot( side.m_N, v[ 1 ] ) + side.m_D > 0.0f &&
+											 Dot( side.m_N, v[ 2 ] ) + side.m_D > 0.0f );
+				}
+				if ( !rejected )
+				{
+					expected.push_back( t );
+				}
+			}
+
+			std::sort( triangles.begin(), triangles.end() );
+			CPPUNIT_ASSERT( std::adjacent_find( triangles.begin(), triangles.end() ) == triangles.end() );
+			CPPUNIT_ASSERT( triangles == expected );
+		}
+	}
+}
@@ -0,0 +1,37 @@
+/********************************************************************************************************************
+
+                                                 TriangleMeshTest.h
+
+	--------------------------------------------------------------------------------------------------------------
+
+ ********************************************************************************************************************/
+
+#pragma once
+
+#include "../include/MyMath/TriangleMesh.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+
+class TriangleMeshTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( TriangleMeshTest );
+	CPPUNIT_TEST( TestEmpty );
+	CPPUNIT_TEST( TestPacket );
+	CPPUNIT_TEST( TestRaycast );
+	CPPUNIT_TEST( TestParallelRays );
+	CPPUNIT_TEST( TestClosestPoint );
+	CPPUNIT_TEST( TestSphereSweep );
+	CPPUNIT_TEST( TestOverlaps );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+
+	void TestEmpty();
+	void TestPacket();
+	void TestRaycast();
+	void TestParallelRays();
+	void TestClosestPoint();
+	void TestSphereSweep();
+	void TestOverlaps();
+};